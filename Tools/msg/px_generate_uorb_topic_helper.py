@@ -171,6 +171,50 @@ def get_children_fields(base_type, search_path):
     return spec_temp.parsed_fields()
 
 
+def get_cdr_fields(msg_fields, search_path, name_prefix='', offset=0):
+    """
+    Flatten the (nested) fields into CDR (XCDR1) order with their alignment.
+    Returns the list of (type_name, field_name, size, padding, cdr_offset) and the total CDR size
+    """
+    fields = []
+    for field in msg_fields:
+        if not field.is_header:
+            field_size = sizeof_field_type(field)
+
+            type_name = field.type
+            # detect embedded types
+            sl_pos = type_name.find('/')
+            if (sl_pos >= 0):
+                type_name = type_name[sl_pos + 1:]
+
+            # detect arrays
+            a_pos = type_name.find('[')
+            array_size = 1
+            if (a_pos >= 0):
+                # field is array
+                array_size = int(type_name[a_pos+1:-1])
+                type_name = type_name[:a_pos]
+
+            if sl_pos >= 0:  # nested type
+                children_fields = get_children_fields(field.base_type, search_path)
+
+                for i in range(array_size):
+                    sub_name_prefix = name_prefix + field.name
+                    if array_size > 1:
+                        sub_name_prefix += '[' + str(i) + ']'
+                    sub_fields, offset = get_cdr_fields(children_fields, search_path, sub_name_prefix + '.', offset)
+                    fields.extend(sub_fields)
+            else:
+                assert field_size > 0
+
+                # note: the maximum alignment for XCDR is 8 and for XCDR2 it is 4
+                padding = (field_size - (offset % field_size)) & (field_size - 1)
+
+                fields.append((type_name, name_prefix + field.name, field_size * array_size, padding, offset + padding))
+                offset += array_size * field_size + padding
+    return fields, offset
+
+
 def get_message_fields_str_for_message_hash(msg_fields, search_path):
     """
     Get all fields (including for nested types) in the form of:
@@ -0,0 +1,78 @@
+@###############################################
+@#
+@# EmPy template for generating uorb_cdr_topics.hpp
+@#
+@###############################################
+@# Start of Template
+@#
+@# Context:
+@#  - msgs (List) list of all msg files (snake case)
+@#  - msg_base_names (List) list of all msg names
+@###############################################
+/****************************************************************************
+ *
+ *   Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Table of the CDR conversions of all uORB message types, the cdrstream
+ * interpreter descriptor together with the type-specialized functions.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+@[for base_name in msg_base_names]@
+#include <px4/msg/@(base_name).h>
+@[end for]@
+
+struct UorbCdrType {
+	const char *name;
+	uint32_t uorb_size;
+	uint32_t cdr_size;
+	const struct dds_cdrstream_desc *desc;
+	uint32_t (*serialize)(const void *data, uint8_t *cdr);
+	void (*deserialize)(const uint8_t *cdr, void *data);
+};
+
+static const UorbCdrType uorb_cdr_types[] = {
+@[for msg, base_name in zip(msgs, msg_base_names)]@
+	{
+		"@(msg.replace('.msg', ''))",
+		sizeof(px4_msgs_msg_@(base_name)),
+		px4_msgs_msg_@(base_name)_cdr_size,
+		&px4_msgs_msg_@(base_name)_cdrstream_desc,
+		&px4_msgs_msg_@(base_name)_cdr_serialize,
+		&px4_msgs_msg_@(base_name)_cdr_deserialize,
+	},
+@[end for]@
+};
@@ -6,6 +6,10 @@ from px_generate_uorb_topic_helper import * # this is in Tools/
 
 uorb_struct = '%s_s'%name_snake_case
 uorb_struct_upper = name_snake_case.upper()
+cdr_type = 'px4_msgs_msg_%s'%file_base_name
+
+# fields in CDR order, matches the ops of the cdrstream descriptor
+cdr_fields, cdr_size = get_cdr_fields(spec.parsed_fields(), search_path)
 }@
 
 /****************************************************************
@@ -62,4 +66,33 @@ extern const struct dds_cdrstream_desc px4_msgs_msg_@(file_base_name)_cdrstream_
 }
 #endif
 
+#ifdef __cplusplus
+#include <stddef.h>
+#include <uORB/UcdrCopyPlan.hpp>
+
+// Type-specialized XCDR1 conversion, produces the same stream as dds_stream_write() with the descriptor ops
+// but as a few memcpy's of contiguous runs instead of interpreting the ops at runtime.
+static constexpr uint32_t @(cdr_type)_cdr_size = @(cdr_size);
+
+static constexpr uORB::UcdrCopyRun @(cdr_type)_cdr_fields[] = {
+@[for field_type, field_name, field_size, padding, cdr_offset in cdr_fields]@
+	{offsetof(@(uorb_struct), @(field_name)), @(cdr_offset), @(field_size)},
+@[end for]@
+};
+
+static constexpr auto @(cdr_type)_cdr_plan = uORB::ucdr_make_copy_plan(@(cdr_type)_cdr_fields);
+
+/** serialize into cdr (at least _cdr_size bytes, padding is not written), returns the serialized size */
+static inline uint32_t @(cdr_type)_cdr_serialize(const void *data, uint8_t *cdr)
+{
+	uORB::ucdr_copy_plan_serialize(@(cdr_type)_cdr_plan, data, cdr);
+	return @(cdr_type)_cdr_size;
+}
+
+static inline void @(cdr_type)_cdr_deserialize(const uint8_t *cdr, void *data)
+{
+	uORB::ucdr_copy_plan_deserialize(@(cdr_type)_cdr_plan, cdr, data);
+}
+#endif
+
 #endif /* DDSC_IDL_UORB_@(uorb_struct_upper)_H */
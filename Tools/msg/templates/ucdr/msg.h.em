@@ -52,49 +52,8 @@ from px_generate_uorb_topic_helper import * # this is in Tools/
 topic = name_snake_case
 uorb_struct = '%s_s'%name_snake_case
 
-# get fields, struct size and paddings
-def add_fields(msg_fields, name_prefix='', offset=0):
-	fields = []
-	for field in msg_fields:
-		if not field.is_header:
-			field_size = sizeof_field_type(field)
-
-			type_name = field.type
-			# detect embedded types
-			sl_pos = type_name.find('/')
-			if (sl_pos >= 0):
-				package = type_name[:sl_pos]
-				type_name = type_name[sl_pos + 1:]
-
-			# detect arrays
-			a_pos = type_name.find('[')
-			array_size = 1
-			if (a_pos >= 0):
-				# field is array
-				array_size = int(type_name[a_pos+1:-1])
-				type_name = type_name[:a_pos]
-
-			if sl_pos >= 0: # nested type
-
-				children_fields = get_children_fields(field.base_type, search_path)
-
-				for i in range(array_size):
-					sub_name_prefix = name_prefix+field.name
-					if array_size > 1:
-						sub_name_prefix += '['+str(i)+']'
-					sub_fields, offset = add_fields(children_fields, sub_name_prefix+'.', offset)
-					fields.extend(sub_fields)
-			else:
-				assert field_size > 0
-
-				# note: the maximum alignment for XCDR is 8 and for XCDR2 it is 4
-				padding = (field_size - (offset % field_size)) & (field_size - 1)
-
-				fields.append((type_name, name_prefix+field.name, field_size * array_size, padding))
-				offset += array_size * field_size + padding
-	return fields, offset
-
-fields, struct_size = add_fields(spec.parsed_fields())
+# get fields in CDR order, struct size and paddings
+fields, struct_size = get_cdr_fields(spec.parsed_fields(), search_path)
 
 }@
 
@@ -103,7 +62,9 @@ fields, struct_size = add_fields(spec.parsed_fields())
 #pragma once
 
 #include <ucdr/microcdr.h>
+#include <stddef.h>
 #include <string.h>
+#include <uORB/UcdrCopyPlan.hpp>
 #include <uORB/topics/@(topic).h>
 
 @##############################
@@ -124,39 +85,37 @@ static inline constexpr int ucdr_topic_size_@(topic)()
 	return @(struct_size);
 }
 
+// fields in CDR order, merged at compile time into runs that are contiguous in both layouts
+static constexpr uORB::UcdrCopyRun ucdr_fields_@(topic)[] = {
+@{
+for field_type, field_name, field_size, padding, cdr_offset in fields:
+	print('\t{{offsetof({0}, {1}), {2}, {3}}},'.format(uorb_struct, field_name, cdr_offset, field_size))
+}@
+};
+
+static constexpr auto ucdr_copy_plan_@(topic) = uORB::ucdr_make_copy_plan(ucdr_fields_@(topic));
+
 static inline bool ucdr_serialize_@(topic)(const void* data, ucdrBuffer& buf, int64_t time_offset = 0)
 {
 	const @(uorb_struct)& topic = *static_cast<const @(uorb_struct)*>(data);
+	uORB::ucdr_copy_plan_serialize(ucdr_copy_plan_@(topic), &topic, buf.iterator);
 @{
-for field_type, field_name, field_size, padding in fields:
-	if padding > 0:
-		print('\tbuf.iterator += {:}; // padding'.format(padding))
-		print('\tbuf.offset += {:}; // padding'.format(padding))
-
+for field_type, field_name, field_size, padding, cdr_offset in fields:
 	print('\tstatic_assert(sizeof(topic.{0}) == {1}, "size mismatch");'.format(field_name, field_size))
 
-	if field_type == 'uint64' and field_name == 'timestamp':
-		print('\tconst uint64_t timestamp_adjusted = topic.timestamp + time_offset;')
-		print('\tmemcpy(buf.iterator, &timestamp_adjusted, sizeof(topic.{0}));'.format(field_name))
-
-	elif field_type == 'uint64' and field_name == 'timestamp_sample':
-		print('\tconst uint64_t timestamp_sample_adjusted = topic.timestamp_sample + time_offset;')
-		print('\tmemcpy(buf.iterator, &timestamp_sample_adjusted, sizeof(topic.{0}));'.format(field_name))
-
-	else:
-		print('\tmemcpy(buf.iterator, &topic.{0}, sizeof(topic.{0}));'.format(field_name))
-
-	print('\tbuf.iterator += sizeof(topic.{:});'.format(field_name))
-	print('\tbuf.offset += sizeof(topic.{:});'.format(field_name))
-
+	if field_type == 'uint64' and field_name in ('timestamp', 'timestamp_sample'):
+		print('\tconst uint64_t {0}_adjusted = topic.{0} + time_offset;'.format(field_name))
+		print('\tmemcpy(buf.iterator + {0}, &{1}_adjusted, sizeof(topic.{1}));'.format(cdr_offset, field_name))
 }@
+	buf.iterator += @(struct_size);
+	buf.offset += @(struct_size);
 	return true;
 }
 
 static inline bool ucdr_deserialize_@(topic)(ucdrBuffer& buf, @(uorb_struct)& topic, int64_t time_offset = 0)
 {
 @{
-for field_type, field_name, field_size, padding in fields:
+for field_type, field_name, field_size, padding, cdr_offset in fields:
 	if padding > 0:
 		print('\tbuf.iterator += {:}; // padding'.format(padding))
 		print('\tbuf.offset += {:}; // padding'.format(padding))
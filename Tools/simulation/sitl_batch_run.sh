@@ -0,0 +1,64 @@
+#!/bin/bash
+# Run several headless SIH instances of the 'px4' binary in parallel as fast as possible,
+# e.g. for Monte-Carlo regression runs. Each instance gets its own instance id and working
+# directory, so parameters, dataman and logs do not collide. MAVLink and DDS are not started.
+# It assumes px4 is already built, with 'make px4_sitl_default'
+#
+# Usage: sitl_batch_run.sh [num_instances] [simulated_duration_s] [model]
+#
+# Per instance environment can be added by the caller, for example PX4_PARAM_<name>=<value>
+# to override parameters, or PX4_SIM_BATCH_LOG=1 to enable logging.
+
+sitl_num=4
+[ -n "$1" ] && sitl_num="$1"
+
+duration=60
+[ -n "$2" ] && duration="$2"
+
+model=quadx
+[ -n "$3" ] && model="$3"
+
+# first instance id, to run next to other instances
+instance_offset=${PX4_BATCH_INSTANCE_OFFSET:-0}
+
+SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+src_path="$SCRIPT_DIR/../../"
+
+build_path=${src_path}/build/px4_sitl_default
+
+export PX4_SIM_MODEL=sihsim_${model}
+export PX4_SIMULATOR=sihsim
+export PX4_SIM_BATCH=1
+export PX4_SIM_BATCH_DURATION=$duration
+
+pids=()
+n=0
+while [ $n -lt $sitl_num ]; do
+	instance=$(($instance_offset + $n))
+	working_dir="$build_path/batch/instance_$instance"
+	[ ! -d "$working_dir" ] && mkdir -p "$working_dir"
+
+	pushd "$working_dir" &>/dev/null
+	echo "starting instance $instance in $(pwd)"
+	$build_path/bin/px4 -i $instance -d "$build_path/etc" >out.log 2>err.log &
+	pids+=($!)
+	popd &>/dev/null
+
+	n=$(($n + 1))
+done
+
+failed=0
+n=0
+for pid in "${pids[@]}"; do
+	instance=$(($instance_offset + $n))
+
+	if ! wait $pid; then
+		echo "instance $instance failed"
+		failed=$(($failed + 1))
+	fi
+
+	grep "Simulated .* wall time" "$build_path/batch/instance_$instance/out.log" | sed "s/^/instance $instance: /"
+	n=$(($n + 1))
+done
+
+[ $failed -eq 0 ]
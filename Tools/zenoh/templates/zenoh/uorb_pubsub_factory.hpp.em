@@ -107,6 +107,7 @@ const orb_metadata* @(topic_name)_topic_meta[@(len(topic_names))] = {
 typedef struct {
 	const char *data_type_name;
 	const uint32_t *ops;
+	UorbCdrFunctions cdr;
 	const uint8_t *hash;
 	const orb_metadata** orb_topic;
 	const uint8_t orb_topics_size;
@@ -124,6 +125,11 @@ topic_names = datatypes_with_topics[topic_name]
 		{
 		  "@(topic_name)",
 		  px4_msgs_msg_@(topic_dict[topic_name])_cdrstream_desc.ops.ops,
+		  {
+		    px4_msgs_msg_@(topic_dict[topic_name])_cdr_size,
+		    &px4_msgs_msg_@(topic_dict[topic_name])_cdr_serialize,
+		    &px4_msgs_msg_@(topic_dict[topic_name])_cdr_deserialize,
+		  },
 		  @(topic_dict[topic_name])_hash,
 		  @(topic_name)_topic_meta,
 		  @(len(topic_names)),
@@ -136,7 +142,7 @@ uORB_Zenoh_Publisher* genPublisher(const orb_metadata *meta, int instance) {
     for (auto &pub : _topics) {
         for(int i = 0; i < pub.orb_topics_size; i++) {
             if(pub.orb_topic[i]->o_id == meta->o_id) {
-                return new uORB_Zenoh_Publisher(meta, pub.ops, instance);
+                return new uORB_Zenoh_Publisher(meta, pub.ops, pub.cdr, instance);
             }
         }
     }
@@ -148,7 +154,7 @@ uORB_Zenoh_Publisher* genPublisher(const char *name, int instance) {
     for (auto &pub : _topics) {
         for(int i = 0; i < pub.orb_topics_size; i++) {
             if(strcmp(pub.orb_topic[i]->o_name, name) == 0) {
-                return new uORB_Zenoh_Publisher(pub.orb_topic[i], pub.ops, instance);
+                return new uORB_Zenoh_Publisher(pub.orb_topic[i], pub.ops, pub.cdr, instance);
             }
         }
     }
@@ -160,7 +166,7 @@ Zenoh_Subscriber* genSubscriber(const orb_metadata *meta, int instance) {
     for (auto &sub : _topics) {
         for(int i = 0; i < sub.orb_topics_size; i++) {
             if(sub.orb_topic[i]->o_id == meta->o_id) {
-                return new uORB_Zenoh_Subscriber(meta, sub.ops, instance);
+                return new uORB_Zenoh_Subscriber(meta, sub.ops, sub.cdr, instance);
             }
         }
     }
@@ -172,7 +178,7 @@ Zenoh_Subscriber* genSubscriber(const char *name, int instance) {
     for (auto &sub : _topics) {
         for(int i = 0; i < sub.orb_topics_size; i++) {
             if(strcmp(sub.orb_topic[i]->o_name, name) == 0) {
-                return new uORB_Zenoh_Subscriber(sub.orb_topic[i], sub.ops, instance);
+                return new uORB_Zenoh_Subscriber(sub.orb_topic[i], sub.ops, sub.cdr, instance);
             }
         }
     }
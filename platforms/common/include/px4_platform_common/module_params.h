@@ -87,7 +87,14 @@ protected:
 			child->updateParams();
 		}
 
+		// only the parameters that changed since the last update are read again
+		param_changes_t changes;
+		param_changes_since(_param_generation, &changes);
+		_param_generation = changes.generation;
+
+		_param_changes = &changes;
 		updateParamsImpl();
+		_param_changes = nullptr;
 	}
 
 	/**
@@ -95,8 +102,31 @@ protected:
 	 */
 	virtual void updateParamsImpl() {}
 
+	/**
+	 * @brief Check if a parameter needs to be read again by updateParamsImpl().
+	 * @return true if the parameter changed since the previous updateParams() call,
+	 *         or if updateParamsImpl() is called directly.
+	 */
+	bool paramChanged(param_t param) const
+	{
+		if (_param_changes == nullptr || _param_changes->all) {
+			return true;
+		}
+
+		for (int i = 0; i < _param_changes->count; i++) {
+			if (_param_changes->params[i] == param) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
 private:
 	/** @list _children The module parameter list of inheriting classes. */
 	List<ModuleParams *> _children;
 	ModuleParams *_parent{nullptr};
+
+	const param_changes_t *_param_changes{nullptr}; ///< set while updateParams() runs updateParamsImpl()
+	uint32_t _param_generation{param_generation()}; ///< parameter values are up to date until this generation
 };
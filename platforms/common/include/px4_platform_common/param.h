@@ -60,9 +60,10 @@ inline static param_t param_handle(px4::params p)
 	do_not_explicitly_use_this_namespace::PAIR(x);
 
 #define _CALL_UPDATE(x) \
-	STRIP(x).update();
+	if (STRIP(x).modified() || paramChanged(STRIP(x).handle())) { STRIP(x).update(); }
 
-// define the parameter update method, which will update all parameters.
+// define the parameter update method, which will update all parameters that changed since the last update,
+// as well as those that were modified locally with set() (so that the stored value is restored).
 // It is marked as 'final', so that wrong usages lead to a compile error (see below)
 #define _DEFINE_PARAMETER_UPDATE_METHOD(...) \
 	protected: \
@@ -144,7 +145,7 @@ public:
 		return false;
 	}
 
-	void set(float val) { _val = val; }
+	void set(float val) { _val = val; _modified = true; }
 
 	void reset()
 	{
@@ -152,11 +153,19 @@ public:
 		update();
 	}
 
-	bool update() { return param_get(handle(), &_val) == 0; }
+	bool update()
+	{
+		_modified = false;
+		return param_get(handle(), &_val) == 0;
+	}
+
+	/// Whether the value was changed locally with set() since the last update()
+	bool modified() const { return _modified; }
 
 	param_t handle() const { return param_handle(p); }
 private:
 	float _val;
+	bool _modified{false};
 };
 
 // external version
@@ -206,6 +215,9 @@ public:
 
 	bool update() { return param_get(handle(), &_val) == 0; }
 
+	/// The external variable can be written without set(), so it is always updated
+	bool modified() const { return true; }
+
 	param_t handle() const { return param_handle(p); }
 private:
 	float &_val;
@@ -246,7 +258,7 @@ public:
 		return false;
 	}
 
-	void set(int32_t val) { _val = val; }
+	void set(int32_t val) { _val = val; _modified = true; }
 
 	void reset()
 	{
@@ -254,11 +266,19 @@ public:
 		update();
 	}
 
-	bool update() { return param_get(handle(), &_val) == 0; }
+	bool update()
+	{
+		_modified = false;
+		return param_get(handle(), &_val) == 0;
+	}
+
+	/// Whether the value was changed locally with set() since the last update()
+	bool modified() const { return _modified; }
 
 	param_t handle() const { return param_handle(p); }
 private:
 	int32_t _val;
+	bool _modified{false};
 };
 
 //external version
@@ -308,6 +328,9 @@ public:
 
 	bool update() { return param_get(handle(), &_val) == 0; }
 
+	/// The external variable can be written without set(), so it is always updated
+	bool modified() const { return true; }
+
 	param_t handle() const { return param_handle(p); }
 private:
 	int32_t &_val;
@@ -356,7 +379,7 @@ public:
 		return false;
 	}
 
-	void set(bool val) { _val = val; }
+	void set(bool val) { _val = val; _modified = true; }
 
 	void reset()
 	{
@@ -366,6 +389,7 @@ public:
 
 	bool update()
 	{
+		_modified = false;
 		int32_t value_int;
 		int ret = param_get(handle(), &value_int);
 
@@ -377,9 +401,13 @@ public:
 		return false;
 	}
 
+	/// Whether the value was changed locally with set() since the last update()
+	bool modified() const { return _modified; }
+
 	param_t handle() const { return param_handle(p); }
 private:
 	bool _val;
+	bool _modified{false};
 };
 
 template <px4::params p>
@@ -0,0 +1,115 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file UcdrCopyPlan.hpp
+ *
+ * Compile-time memcpy plan for CDR serialization of uORB messages.
+ *
+ * The generated ucdr headers list every (flattened) field with its offset in the uORB struct and in the
+ * CDR stream. Fields that are adjacent in both layouts are merged into a single run at compile time, so
+ * serializing a topic whose field order matches its struct layout costs one or a few memcpy's instead of
+ * one per field.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace uORB
+{
+
+struct UcdrCopyRun {
+	uint16_t uorb_offset; ///< offset in the uORB struct
+	uint16_t cdr_offset;  ///< offset in the CDR stream, relative to the start of the message
+	uint16_t size;
+};
+
+template<size_t N>
+struct UcdrCopyPlan {
+	UcdrCopyRun runs[N] {};
+	size_t num_runs{0};
+};
+
+/**
+ * Merge the fields (in CDR order) into the minimal number of runs.
+ */
+template<size_t N>
+constexpr UcdrCopyPlan<N> ucdr_make_copy_plan(const UcdrCopyRun(&fields)[N])
+{
+	UcdrCopyPlan<N> plan{};
+
+	for (size_t i = 0; i < N; i++) {
+		if (plan.num_runs > 0) {
+			UcdrCopyRun &last = plan.runs[plan.num_runs - 1];
+
+			if ((fields[i].uorb_offset == last.uorb_offset + last.size)
+			    && (fields[i].cdr_offset == last.cdr_offset + last.size)) {
+				last.size += fields[i].size;
+				continue;
+			}
+		}
+
+		plan.runs[plan.num_runs++] = fields[i];
+	}
+
+	return plan;
+}
+
+/**
+ * Copy a uORB message into a CDR buffer according to the plan. Padding in the CDR stream is left untouched.
+ */
+template<size_t N>
+static inline void ucdr_copy_plan_serialize(const UcdrCopyPlan<N> &plan, const void *src, uint8_t *dst)
+{
+	for (size_t i = 0; i < plan.num_runs; i++) {
+		memcpy(dst + plan.runs[i].cdr_offset, static_cast<const uint8_t *>(src) + plan.runs[i].uorb_offset,
+		       plan.runs[i].size);
+	}
+}
+
+/**
+ * Copy a CDR buffer into a uORB message according to the plan. Padding in the uORB struct is left untouched.
+ */
+template<size_t N>
+static inline void ucdr_copy_plan_deserialize(const UcdrCopyPlan<N> &plan, const uint8_t *src, void *dst)
+{
+	for (size_t i = 0; i < plan.num_runs; i++) {
+		memcpy(static_cast<uint8_t *>(dst) + plan.runs[i].uorb_offset, src + plan.runs[i].cdr_offset,
+		       plan.runs[i].size);
+	}
+}
+
+} // namespace uORB
@@ -0,0 +1,141 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test for UcdrCopyPlan
+ */
+
+#include <gtest/gtest.h>
+#include <uORB/UcdrCopyPlan.hpp>
+
+namespace
+{
+
+struct nested_s {
+	float x;
+	uint8_t flag;
+	uint8_t _padding0[3];
+};
+
+// uORB layout: sorted by size, CDR layout: declaration order
+struct test_s {
+	uint64_t timestamp;
+	uint64_t timestamp_sample;
+	float a[3];
+	nested_s n[2];
+	uint16_t c;
+	uint8_t _padding0[6];
+};
+
+// CDR order: timestamp, a, timestamp_sample, n[0], n[1], c
+constexpr uORB::UcdrCopyRun test_fields[] = {
+	{offsetof(test_s, timestamp), 0, 8},
+	{offsetof(test_s, a), 8, 12},
+	{offsetof(test_s, timestamp_sample), 24, 8},
+	{offsetof(test_s, n[0].x), 32, 4},
+	{offsetof(test_s, n[0].flag), 36, 1},
+	{offsetof(test_s, n[1].x), 40, 4},
+	{offsetof(test_s, n[1].flag), 44, 1},
+	{offsetof(test_s, c), 46, 2},
+};
+
+// same layout in uORB and CDR
+constexpr uORB::UcdrCopyRun compatible_fields[] = {
+	{offsetof(test_s, timestamp), 0, 8},
+	{offsetof(test_s, timestamp_sample), 8, 8},
+	{offsetof(test_s, a), 16, 12},
+	{offsetof(test_s, n[0].x), 28, 4},
+};
+
+} // namespace
+
+TEST(UcdrCopyPlanTest, MergesContiguousFields)
+{
+	constexpr auto plan = uORB::ucdr_make_copy_plan(test_fields);
+	static_assert(plan.num_runs == 6, "nested members adjacent in both layouts are merged");
+
+	EXPECT_EQ(plan.runs[3].uorb_offset, offsetof(test_s, n[0].x));
+	EXPECT_EQ(plan.runs[3].size, 5);
+
+	constexpr auto compatible_plan = uORB::ucdr_make_copy_plan(compatible_fields);
+	static_assert(compatible_plan.num_runs == 1, "layout compatible topic is a single memcpy");
+	EXPECT_EQ(compatible_plan.runs[0].size, 32);
+}
+
+TEST(UcdrCopyPlanTest, SerializeMatchesFieldByField)
+{
+	test_s topic{};
+	topic.timestamp = 0x0102030405060708;
+	topic.timestamp_sample = 0x1112131415161718;
+	topic.a[0] = 1.f;
+	topic.a[1] = 2.f;
+	topic.a[2] = 3.f;
+	topic.n[0].x = 4.f;
+	topic.n[0].flag = 5;
+	topic.n[1].x = 6.f;
+	topic.n[1].flag = 7;
+	topic.c = 0xabcd;
+
+	uint8_t expected[48] {};
+	uint8_t buffer[48] {};
+
+	for (const auto &field : test_fields) {
+		memcpy(expected + field.cdr_offset, reinterpret_cast<const uint8_t *>(&topic) + field.uorb_offset, field.size);
+	}
+
+	constexpr auto plan = uORB::ucdr_make_copy_plan(test_fields);
+	uORB::ucdr_copy_plan_serialize(plan, &topic, buffer);
+
+	EXPECT_EQ(memcmp(expected, buffer, sizeof(buffer)), 0);
+}
+
+TEST(UcdrCopyPlanTest, DeserializeRoundTrip)
+{
+	test_s topic{};
+	topic.timestamp = 0x0102030405060708;
+	topic.timestamp_sample = 0x1112131415161718;
+	topic.a[1] = 2.f;
+	topic.n[1].x = 6.f;
+	topic.n[1].flag = 7;
+	topic.c = 0xabcd;
+
+	constexpr auto plan = uORB::ucdr_make_copy_plan(test_fields);
+
+	uint8_t buffer[48] {};
+	uORB::ucdr_copy_plan_serialize(plan, &topic, buffer);
+
+	test_s out{};
+	uORB::ucdr_copy_plan_deserialize(plan, buffer, &out);
+
+	EXPECT_EQ(memcmp(&topic, &out, sizeof(out)), 0);
+}
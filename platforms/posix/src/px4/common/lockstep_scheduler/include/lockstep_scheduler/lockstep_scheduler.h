@@ -75,11 +75,10 @@ private:
 				done = true;
 			}
 
-			// If a thread quickly exits after a cond_timedwait(), the
-			// thread_local object can still be in the linked list. In that case
-			// we need to wait until it's removed.
-			while (!removed) {
-				system_usleep(5000);
+			// If the thread got canceled, the thread_local object is still in the
+			// timer heap, so we need to remove it before it goes away.
+			if (!removed && scheduler) {
+				scheduler->remove_timed_wait(this);
 			}
 		}
 
@@ -90,14 +89,24 @@ private:
 		std::atomic<bool> done{false};
 		std::atomic<bool> removed{true};
 
-		TimedWait *next{nullptr}; ///< linked list
+		LockstepScheduler *scheduler{nullptr};
+		size_t heap_index{0}; ///< position in _timed_waits
 	};
 
+	// Timer heap operations, _timed_waits_mutex must be held
+	void heap_push(TimedWait *timed_wait);
+	void heap_erase(TimedWait *timed_wait);
+	void heap_sift_up(size_t index);
+	void heap_sift_down(size_t index);
+	void heap_set(size_t index, TimedWait *timed_wait);
+
+	void remove_timed_wait(TimedWait *timed_wait);
+
 	LockstepComponents _components;
 
 	std::atomic<uint64_t> _time_us{0};
 
-	TimedWait *_timed_waits{nullptr}; ///< head of linked list
+	/// min-heap of the waiting threads, ordered by time_us, so a time step only touches the expired ones
+	std::vector<TimedWait *> _timed_waits;
 	std::mutex _timed_waits_mutex;
-	std::atomic<bool> _setting_time{false}; ///< true if set_absolute_time() is currently being executed
 };
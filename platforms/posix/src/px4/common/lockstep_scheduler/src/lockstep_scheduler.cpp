@@ -37,13 +37,93 @@
 
 LockstepScheduler::~LockstepScheduler()
 {
-	// cleanup the linked list
+	// cleanup the timer heap
 	std::unique_lock<std::mutex> lock_timed_waits(_timed_waits_mutex);
 
-	while (_timed_waits) {
-		TimedWait *tmp = _timed_waits;
-		_timed_waits = _timed_waits->next;
-		tmp->removed = true;
+	for (TimedWait *timed_wait : _timed_waits) {
+		timed_wait->removed = true;
+	}
+
+	_timed_waits.clear();
+}
+
+void LockstepScheduler::heap_set(size_t index, TimedWait *timed_wait)
+{
+	_timed_waits[index] = timed_wait;
+	timed_wait->heap_index = index;
+}
+
+void LockstepScheduler::heap_sift_up(size_t index)
+{
+	TimedWait *timed_wait = _timed_waits[index];
+
+	while (index > 0) {
+		const size_t parent = (index - 1) / 2;
+
+		if (_timed_waits[parent]->time_us <= timed_wait->time_us) {
+			break;
+		}
+
+		heap_set(index, _timed_waits[parent]);
+		index = parent;
+	}
+
+	heap_set(index, timed_wait);
+}
+
+void LockstepScheduler::heap_sift_down(size_t index)
+{
+	TimedWait *timed_wait = _timed_waits[index];
+	const size_t size = _timed_waits.size();
+
+	while (true) {
+		size_t child = 2 * index + 1;
+
+		if (child >= size) {
+			break;
+		}
+
+		if ((child + 1 < size) && (_timed_waits[child + 1]->time_us < _timed_waits[child]->time_us)) {
+			++child;
+		}
+
+		if (timed_wait->time_us <= _timed_waits[child]->time_us) {
+			break;
+		}
+
+		heap_set(index, _timed_waits[child]);
+		index = child;
+	}
+
+	heap_set(index, timed_wait);
+}
+
+void LockstepScheduler::heap_push(TimedWait *timed_wait)
+{
+	_timed_waits.push_back(timed_wait);
+	heap_sift_up(_timed_waits.size() - 1);
+}
+
+void LockstepScheduler::heap_erase(TimedWait *timed_wait)
+{
+	const size_t index = timed_wait->heap_index;
+	TimedWait *last = _timed_waits.back();
+	_timed_waits.pop_back();
+
+	if (last != timed_wait) {
+		heap_set(index, last);
+		heap_sift_up(index);
+		heap_sift_down(last->heap_index);
+	}
+}
+
+void LockstepScheduler::remove_timed_wait(TimedWait *timed_wait)
+{
+	std::lock_guard<std::mutex> lock_timed_waits(_timed_waits_mutex);
+
+	if (!timed_wait->removed) {
+		heap_erase(timed_wait);
+		timed_wait->removed = true;
 	}
 }
 
@@ -57,30 +137,13 @@ void LockstepScheduler::set_absolute_time(uint64_t time_us)
 
 	{
 		std::unique_lock<std::mutex> lock_timed_waits(_timed_waits_mutex);
-		_setting_time = true;
-
-		TimedWait *timed_wait = _timed_waits;
-		TimedWait *timed_wait_prev = nullptr;
-
-		while (timed_wait) {
-			// Clean up the ones that are already done from last iteration.
-			if (timed_wait->done) {
-				// Erase from the linked list
-				if (timed_wait_prev) {
-					timed_wait_prev->next = timed_wait->next;
-
-				} else {
-					_timed_waits = timed_wait->next;
-				}
-
-				TimedWait *tmp = timed_wait;
-				timed_wait = timed_wait->next;
-				tmp->removed = true;
-				continue;
-			}
 
-			if (timed_wait->time_us <= time_us &&
-			    !timed_wait->timeout) {
+		// Only the expired waits are at the top of the heap, all others stay untouched.
+		while (!_timed_waits.empty() && _timed_waits.front()->time_us <= time_us) {
+			TimedWait *timed_wait = _timed_waits.front();
+			heap_erase(timed_wait);
+
+			if (!timed_wait->done) {
 				// We are abusing the condition here to signal that the time
 				// has passed.
 				pthread_mutex_lock(timed_wait->passed_lock);
@@ -89,11 +152,8 @@ void LockstepScheduler::set_absolute_time(uint64_t time_us)
 				pthread_mutex_unlock(timed_wait->passed_lock);
 			}
 
-			timed_wait_prev = timed_wait;
-			timed_wait = timed_wait->next;
+			timed_wait->removed = true;
 		}
-
-		_setting_time = false;
 	}
 }
 
@@ -115,13 +175,9 @@ int LockstepScheduler::cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *loc
 		timed_wait.passed_lock = lock;
 		timed_wait.timeout = false;
 		timed_wait.done = false;
-
-		// Add to linked list if not removed yet (otherwise just re-use the object)
-		if (timed_wait.removed) {
-			timed_wait.removed = false;
-			timed_wait.next = _timed_waits;
-			_timed_waits = &timed_wait;
-		}
+		timed_wait.scheduler = this;
+		timed_wait.removed = false;
+		heap_push(&timed_wait);
 	}
 
 	int result = pthread_cond_wait(cond, lock);
@@ -134,20 +190,26 @@ int LockstepScheduler::cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *loc
 
 	timed_wait.done = true;
 
-	if (!timeout && _setting_time) {
-		// This is where it gets tricky: the timeout has not been triggered yet,
-		// and another thread is in set_absolute_time().
-		// If it already passed the 'done' check, it will access the mutex and
-		// the condition variable next. However they might be invalid as soon as we
-		// return here, so we wait until set_absolute_time() is done.
-		// In addition we have to unlock 'lock', otherwise we risk a
-		// deadlock due to a different locking order in set_absolute_time().
-		// Note that this case does not happen too frequently, and thus can be
-		// a bit more expensive.
-		pthread_mutex_unlock(lock);
-		_timed_waits_mutex.lock();
-		_timed_waits_mutex.unlock();
-		pthread_mutex_lock(lock);
+	if (!timeout) {
+		// The timeout has not been triggered yet, so the entry is still in the heap and
+		// set_absolute_time() might be about to access the mutex and the condition variable,
+		// which might be invalid as soon as we return here. So we remove it ourselves.
+		// set_absolute_time() locks in the opposite order, so if the heap is busy we have
+		// to unlock 'lock' to avoid a deadlock. Note that this case does not happen too
+		// frequently, and thus can be a bit more expensive.
+		if (_timed_waits_mutex.try_lock()) {
+			if (!timed_wait.removed) {
+				heap_erase(&timed_wait);
+				timed_wait.removed = true;
+			}
+
+			_timed_waits_mutex.unlock();
+
+		} else {
+			pthread_mutex_unlock(lock);
+			remove_timed_wait(&timed_wait);
+			pthread_mutex_lock(lock);
+		}
 	}
 
 	return result;
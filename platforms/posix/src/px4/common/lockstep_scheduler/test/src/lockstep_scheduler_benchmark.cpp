@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Benchmark of the lockstep scheduler with many threads waiting at different rates,
+ * as in SITL with many modules running faster than realtime.
+ */
+
+#include <lockstep_scheduler/lockstep_scheduler.h>
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+namespace
+{
+
+constexpr uint64_t start_time_us = 12345678;
+
+/**
+ * Run num_waiters threads, each sleeping periodically with a period between 1 and 50 ms,
+ * while stepping the time in steps of step_us. The measurement only ends once all threads
+ * have caught up, so threads lagging behind the time steps are accounted for.
+ * @return simulated seconds per wall-clock second
+ */
+double run_benchmark(int num_waiters, uint64_t step_us, uint64_t duration_us, uint64_t &wakeups)
+{
+	LockstepScheduler ls;
+	ls.set_absolute_time(start_time_us);
+
+	const uint64_t end_time_us = start_time_us + duration_us;
+	std::atomic<uint64_t> num_wakeups{0};
+	std::atomic<int> num_started{0};
+	std::vector<std::thread> threads;
+
+	std::default_random_engine engine{0};
+	std::uniform_int_distribution<uint64_t> period_distribution(1000, 50000);
+
+	for (int i = 0; i < num_waiters; ++i) {
+		const uint64_t period_us = period_distribution(engine);
+
+		threads.emplace_back([&ls, &num_wakeups, &num_started, end_time_us, period_us]() {
+			uint64_t next_us = start_time_us + period_us;
+			num_started++;
+
+			while (next_us <= end_time_us) {
+				ls.usleep_until(next_us);
+				num_wakeups++;
+				next_us += period_us;
+			}
+		});
+	}
+
+	while (num_started < num_waiters) {
+		std::this_thread::yield();
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (uint64_t time_us = start_time_us; time_us <= end_time_us; time_us += step_us) {
+		ls.set_absolute_time(time_us);
+	}
+
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+
+	wakeups = num_wakeups;
+	return (duration_us * 1e-6) / std::chrono::duration<double>(end - start).count();
+}
+
+} // namespace
+
+TEST(LockstepScheduler, BenchmarkManyWaiters)
+{
+	for (int num_waiters : {10, 100, 200}) {
+		uint64_t wakeups = 0;
+		const double realtime_factor = run_benchmark(num_waiters, 100, 10000000, wakeups);
+		std::cout << num_waiters << " waiters: " << realtime_factor << " simulated s per wall-clock s, "
+			  << wakeups << " wakeups\n";
+		EXPECT_GT(wakeups, 0u);
+	}
+}
@@ -48,6 +48,7 @@
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 #include <drivers/drv_sensor.h>
 #include <lib/drivers/magnetometer/PX4Magnetometer.hpp>
+#include <lib/world_magnetic_model/geo_mag_declination.h>
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/vehicle_attitude.h>
 #include <uORB/topics/sensor_gps.h>
@@ -78,6 +79,8 @@ private:
 
 	matrix::Vector3f _mag_earth_pred{};
 
+	MagneticFieldCache _mag_field_cache{};
+
 	uORB::Subscription _vehicle_attitude_sub{ORB_ID(vehicle_attitude)};
 	uORB::Subscription _vehicle_gps_position_sub{ORB_ID(vehicle_gps_position)};
 };
@@ -37,6 +37,13 @@
 #include <stdlib.h>
 #include <dds/cdr/dds_cdrstream.h>
 
+/** type-specialized CDR conversion, generated alongside the cdrstream descriptor of each message */
+typedef struct {
+	uint32_t cdr_size;
+	uint32_t (*serialize)(const void *data, uint8_t *cdr);
+	void (*deserialize)(const uint8_t *cdr, void *data);
+} UorbCdrFunctions;
+
 extern const struct dds_cdrstream_allocator dds_allocator;
 extern const uint8_t ros2_header[4];
 
@@ -55,12 +55,50 @@ ControlAllocation::setEffectivenessMatrix(
 	bool update_normalization_scale)
 {
 	_effectiveness = effectiveness;
+	_num_actuators = num_actuators;
+	_configured_actuators = (num_actuators > 0) ? (0xffffu >> (NUM_ACTUATORS - num_actuators)) : 0;
 	ActuatorVector linearization_point_clipped = linearization_point;
 	clipActuatorSetpoint(linearization_point_clipped);
 	_actuator_trim = actuator_trim + linearization_point_clipped;
 	clipActuatorSetpoint(_actuator_trim);
-	_num_actuators = num_actuators;
 	_control_trim = _effectiveness * linearization_point_clipped;
+
+	// Remember the structural zeros (e.g. control surfaces only acting on 1-2 axes)
+	for (int i = 0; i < NUM_ACTUATORS; i++) {
+		_effectiveness_axes[i] = 0;
+
+		if (!(_configured_actuators & (1u << i))) {
+			continue;
+		}
+
+		for (int axis = 0; axis < NUM_AXES; axis++) {
+			if (fabsf(_effectiveness(axis, i)) > 0.f) {
+				_effectiveness_axes[i] |= 1u << axis;
+			}
+		}
+	}
+}
+
+matrix::Vector<float, ControlAllocation::NUM_AXES>
+ControlAllocation::getAllocatedControl() const
+{
+	matrix::Vector<float, NUM_AXES> allocated_control;
+
+	for (int i = 0; i < _num_actuators; i++) {
+		const float delta = _actuator_sp(i) - _actuator_trim(i);
+
+		if (_effectiveness_axes[i] == 0 || fabsf(delta) <= 0.f) {
+			continue;
+		}
+
+		for (int axis = 0; axis < NUM_AXES; axis++) {
+			if (_effectiveness_axes[i] & (1u << axis)) {
+				allocated_control(axis) += _effectiveness(axis, i) * delta;
+			}
+		}
+	}
+
+	return allocated_control.emult(_control_allocation_scale);
 }
 
 void
@@ -77,7 +115,9 @@ ControlAllocation::setActuatorSetpoint(
 void
 ControlAllocation::clipActuatorSetpoint(matrix::Vector<float, ControlAllocation::NUM_ACTUATORS> &actuator) const
 {
-	for (int i = 0; i < _num_actuators; i++) {
+	for (uint32_t remaining = _configured_actuators; remaining != 0; remaining &= remaining - 1) {
+		const int i = __builtin_ctz(remaining);
+
 		if (_actuator_max(i) < _actuator_min(i)) {
 			actuator(i) = _actuator_trim(i);
 
@@ -81,6 +81,9 @@ public:
 
 	static constexpr uint8_t NUM_ACTUATORS = ActuatorEffectiveness::NUM_ACTUATORS;
 	static constexpr uint8_t NUM_AXES = ActuatorEffectiveness::NUM_AXES;
+	static constexpr uint8_t ALL_AXES = (1u << NUM_AXES) - 1;
+
+	static_assert(NUM_ACTUATORS <= 16, "configured actuators mask too small");
 
 	using ActuatorVector = matrix::Vector<float, NUM_ACTUATORS>;
 
@@ -140,10 +143,11 @@ public:
 	/**
 	 * Get the allocated control vector
 	 *
+	 * Only the configured actuators and their non-zero effectiveness entries are evaluated.
+	 *
 	 * @return Control vector
 	 */
-	matrix::Vector<float, NUM_AXES> getAllocatedControl() const
-	{ return (_effectiveness * (_actuator_sp - _actuator_trim)).emult(_control_allocation_scale); }
+	matrix::Vector<float, NUM_AXES> getAllocatedControl() const;
 
 	/**
 	 * Get the control effectiveness matrix
@@ -202,7 +206,7 @@ public:
 	/**
 	 * Clip the actuator setpoint between minimum and maximum values.
 	 *
-	 * The output is in the range [min; max]
+	 * The output is in the range [min; max]. Only the configured actuators are clipped.
 	 *
 	 * @param actuator Actuator vector to clip
 	 */
@@ -241,6 +245,8 @@ protected:
 	ActuatorVector _actuator_sp;  	///< Actuator setpoint
 	matrix::Vector<float, NUM_AXES> _control_sp;   		///< Control setpoint
 	matrix::Vector<float, NUM_AXES> _control_trim; 		///< Control at trim actuator values
+	uint8_t _effectiveness_axes[NUM_ACTUATORS] {};	///< per actuator, bitmask of the axes with non-zero effectiveness
+	uint16_t _configured_actuators{0};			///< bitmask of the configured actuators
 	int _num_actuators{0};
 	bool _normalize_rpy{false};				///< if true, normalize roll, pitch and yaw columns
 	bool _had_actuator_failure{false};
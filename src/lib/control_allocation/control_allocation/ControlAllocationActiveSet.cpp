@@ -0,0 +1,294 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ControlAllocationActiveSet.cpp
+ *
+ * Active-set bounded least-squares Control Allocation Algorithm
+ */
+
+#include "ControlAllocationActiveSet.hpp"
+
+#include <mathlib/mathlib.h>
+
+ControlAllocationActiveSet::ControlAllocationActiveSet()
+{
+	_axis_weights(ROLL) = DEFAULT_WEIGHT_ROLL_PITCH;
+	_axis_weights(PITCH) = DEFAULT_WEIGHT_ROLL_PITCH;
+	_axis_weights(YAW) = DEFAULT_WEIGHT_YAW;
+	_axis_weights(THRUST_X) = DEFAULT_WEIGHT_THRUST;
+	_axis_weights(THRUST_Y) = DEFAULT_WEIGHT_THRUST;
+	_axis_weights(THRUST_Z) = DEFAULT_WEIGHT_THRUST;
+}
+
+void
+ControlAllocationActiveSet::setEffectivenessMatrix(
+	const matrix::Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS> &effectiveness,
+	const ActuatorVector &actuator_trim, const ActuatorVector &linearization_point, int num_actuators,
+	bool update_normalization_scale)
+{
+	ControlAllocationPseudoInverse::setEffectivenessMatrix(effectiveness, actuator_trim, linearization_point,
+			num_actuators, update_normalization_scale);
+
+	// The previous active set is meaningless for a different matrix
+	for (int i = 0; i < NUM_ACTUATORS; i++) {
+		_bound_state[i] = BoundState::FREE;
+	}
+}
+
+bool
+ControlAllocationActiveSet::isFeasible(const ActuatorVector &actuator_sp) const
+{
+	for (int i = 0; i < _num_actuators; i++) {
+		if (_actuator_min(i) <= _actuator_max(i)
+		    && (actuator_sp(i) < _actuator_min(i) - BOUND_TOLERANCE || actuator_sp(i) > _actuator_max(i) + BOUND_TOLERANCE)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void
+ControlAllocationActiveSet::allocate()
+{
+	//Compute new gains if needed
+	updatePseudoInverse();
+
+	_prev_actuator_sp = _actuator_sp;
+	_num_iterations = 0;
+
+	// Unconstrained solution, identical to the pseudo-inverse
+	const matrix::Vector<float, NUM_AXES> control_delta = _control_sp - _control_trim;
+	mixControl(control_delta, _actuator_sp);
+
+	if (isFeasible(_actuator_sp)) {
+		for (int i = 0; i < NUM_ACTUATORS; i++) {
+			_bound_state[i] = BoundState::FREE;
+		}
+
+		return;
+	}
+
+	// Express the control in the same normalized space the pseudo-inverse is using
+	matrix::Vector<float, NUM_AXES> target = control_delta;
+
+	if (!_metric_allocation) {
+		for (int axis = 0; axis < NUM_AXES; axis++) {
+			if (_control_allocation_scale(axis) > FLT_EPSILON) {
+				target(axis) /= _control_allocation_scale(axis);
+			}
+		}
+	}
+
+	_actuator_sp = _actuator_trim + solveActiveSet(target);
+}
+
+matrix::Vector<float, ControlAllocation::NUM_AXES>
+ControlAllocationActiveSet::weightedControl(const matrix::Matrix<float, NUM_AXES, NUM_ACTUATORS> &A,
+		const ActuatorVector &x) const
+{
+	matrix::Vector<float, NUM_AXES> control;
+
+	for (int i = 0; i < _num_actuators; i++) {
+		for (int axis = 0; axis < NUM_AXES; axis++) {
+			if (_effectiveness_axes[i] & (1u << axis)) {
+				control(axis) += A(axis, i) * x(i);
+			}
+		}
+	}
+
+	return control;
+}
+
+ControlAllocationActiveSet::ActuatorVector
+ControlAllocationActiveSet::solveActiveSet(const matrix::Vector<float, NUM_AXES> &target)
+{
+	// Weighted problem: min || A x - b ||, with A = W * B, b = W * target and x = u - trim
+	matrix::Matrix<float, NUM_AXES, NUM_ACTUATORS> A;
+	matrix::Vector<float, NUM_AXES> b;
+
+	for (int axis = 0; axis < NUM_AXES; axis++) {
+		for (int i = 0; i < _num_actuators; i++) {
+			A(axis, i) = _effectiveness(axis, i) * _axis_weights(axis);
+		}
+
+		b(axis) = target(axis) * _axis_weights(axis);
+	}
+
+	ActuatorVector lower;
+	ActuatorVector upper;
+	ActuatorVector x;
+
+	// Warm start: previous setpoint moved onto the bounds of the previous active set
+	for (int i = 0; i < NUM_ACTUATORS; i++) {
+		if (i >= _num_actuators || _actuator_max(i) < _actuator_min(i)) {
+			_bound_state[i] = BoundState::FIXED;
+			continue;
+		}
+
+		if (_bound_state[i] == BoundState::FIXED) {
+			_bound_state[i] = BoundState::FREE;
+		}
+
+		lower(i) = _actuator_min(i) - _actuator_trim(i);
+		upper(i) = _actuator_max(i) - _actuator_trim(i);
+
+		switch (_bound_state[i]) {
+		case BoundState::LOWER:
+			x(i) = lower(i);
+			break;
+
+		case BoundState::UPPER:
+			x(i) = upper(i);
+			break;
+
+		default:
+			x(i) = math::constrain(_prev_actuator_sp(i) - _actuator_trim(i), lower(i), upper(i));
+			break;
+		}
+	}
+
+	matrix::Matrix<float, NUM_AXES, NUM_ACTUATORS> A_free;
+	matrix::Matrix<float, NUM_ACTUATORS, NUM_AXES> A_free_inv;
+
+	while (_num_iterations < MAX_ITERATIONS) {
+		++_num_iterations;
+
+		// Optimal step for the free actuators, the others are kept on their bound
+		A_free = A;
+
+		for (int i = 0; i < NUM_ACTUATORS; i++) {
+			if (_bound_state[i] != BoundState::FREE) {
+				for (int axis = 0; axis < NUM_AXES; axis++) {
+					A_free(axis, i) = 0.f;
+				}
+			}
+		}
+
+		matrix::geninv(A_free, A_free_inv);
+		const matrix::Vector<float, NUM_AXES> residual = b - weightedControl(A, x);
+		ActuatorVector step;
+
+		for (int i = 0; i < _num_actuators; i++) {
+			if (_bound_state[i] == BoundState::FREE) {
+				for (int axis = 0; axis < NUM_AXES; axis++) {
+					step(i) += A_free_inv(i, axis) * residual(axis);
+				}
+			}
+		}
+
+		// Largest feasible fraction of the step, and the actuator limiting it
+		float alpha = 1.f;
+		int blocking_index = -1;
+		BoundState blocking_bound = BoundState::FREE;
+
+		for (int i = 0; i < _num_actuators; i++) {
+			if (_bound_state[i] != BoundState::FREE) {
+				continue;
+			}
+
+			const float x_next = x(i) + step(i);
+
+			if (x_next < lower(i) - BOUND_TOLERANCE) {
+				const float alpha_i = (lower(i) - x(i)) / step(i);
+
+				if (alpha_i < alpha) {
+					alpha = alpha_i;
+					blocking_index = i;
+					blocking_bound = BoundState::LOWER;
+				}
+
+			} else if (x_next > upper(i) + BOUND_TOLERANCE) {
+				const float alpha_i = (upper(i) - x(i)) / step(i);
+
+				if (alpha_i < alpha) {
+					alpha = alpha_i;
+					blocking_index = i;
+					blocking_bound = BoundState::UPPER;
+				}
+			}
+		}
+
+		if (blocking_index >= 0) {
+			// Step is infeasible: move up to the first bound and add it to the active set
+			x += step * math::max(alpha, 0.f);
+			x(blocking_index) = (blocking_bound == BoundState::LOWER) ? lower(blocking_index) : upper(blocking_index);
+			_bound_state[blocking_index] = blocking_bound;
+			continue;
+		}
+
+		x += step;
+
+		// Lagrange multipliers of the active bounds, a negative one means the cost decreases when leaving the bound
+		const matrix::Vector<float, NUM_AXES> error = weightedControl(A, x) - b;
+		float lambda_min = -BOUND_TOLERANCE;
+		int release_index = -1;
+
+		for (int i = 0; i < _num_actuators; i++) {
+			if (_bound_state[i] != BoundState::LOWER && _bound_state[i] != BoundState::UPPER) {
+				continue;
+			}
+
+			float gradient = 0.f;
+
+			for (int axis = 0; axis < NUM_AXES; axis++) {
+				gradient += A(axis, i) * error(axis);
+			}
+
+			const float lambda = (_bound_state[i] == BoundState::LOWER) ? gradient : -gradient;
+
+			if (lambda < lambda_min) {
+				lambda_min = lambda;
+				release_index = i;
+			}
+		}
+
+		if (release_index < 0) {
+			// Optimal
+			break;
+		}
+
+		_bound_state[release_index] = BoundState::FREE;
+	}
+
+	// Keep numerical noise from leaking out of the bounds
+	for (int i = 0; i < _num_actuators; i++) {
+		if (_bound_state[i] != BoundState::FIXED) {
+			x(i) = math::constrain(x(i), lower(i), upper(i));
+		}
+	}
+
+	return x;
+}
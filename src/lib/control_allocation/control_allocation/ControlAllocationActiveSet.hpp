@@ -0,0 +1,128 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ControlAllocationActiveSet.hpp
+ *
+ * Control Allocation Algorithm based on an active-set solver for the
+ * bounded weighted least-squares problem
+ *
+ *   min || W (B du - v) ||^2   s.t.  u_min <= trim + du <= u_max
+ *
+ * The solver is warm started with the active set (saturated actuators)
+ * of the previous cycle and runs a bounded number of iterations, so that
+ * the worst-case execution time is deterministic. The returned setpoint is
+ * always feasible, even if the iteration limit is reached.
+ *
+ * If the unconstrained pseudo-inverse solution does not saturate any actuator
+ * it is used directly and the result is identical to ControlAllocationPseudoInverse.
+ */
+
+#pragma once
+
+#include "ControlAllocationPseudoInverse.hpp"
+
+class ControlAllocationActiveSet: public ControlAllocationPseudoInverse
+{
+public:
+	ControlAllocationActiveSet();
+	virtual ~ControlAllocationActiveSet() = default;
+
+	void allocate() override;
+
+	void setEffectivenessMatrix(const matrix::Matrix<float, NUM_AXES, NUM_ACTUATORS> &effectiveness,
+				    const ActuatorVector &actuator_trim, const ActuatorVector &linearization_point, int num_actuators,
+				    bool update_normalization_scale) override;
+
+	/**
+	 * Set the per-axis weights of the least-squares cost
+	 *
+	 * Axes with a larger weight are tracked with priority when the actuators saturate.
+	 *
+	 * @param weights Weight for each control axis, must be positive
+	 */
+	void setAxisWeights(const matrix::Vector<float, NUM_AXES> &weights) { _axis_weights = weights; }
+
+	const matrix::Vector<float, NUM_AXES> &getAxisWeights() const { return _axis_weights; }
+
+	/**
+	 * @return number of active-set iterations used in the last call to allocate()
+	 */
+	int numIterations() const { return _num_iterations; }
+
+	/**
+	 * Maximum number of active-set iterations per allocation.
+	 * Each iteration adds or removes exactly one actuator bound.
+	 */
+	static constexpr int MAX_ITERATIONS{NUM_ACTUATORS};
+
+	/**
+	 * Default weights: roll/pitch tracking has priority over thrust, yaw is the least important axis.
+	 */
+	static constexpr float DEFAULT_WEIGHT_ROLL_PITCH{1.f};
+	static constexpr float DEFAULT_WEIGHT_YAW{0.1f};
+	static constexpr float DEFAULT_WEIGHT_THRUST{0.5f};
+
+protected:
+	enum class BoundState : uint8_t {
+		FREE = 0,
+		LOWER,
+		UPPER,
+		FIXED	///< actuator not configured or disabled (max < min)
+	};
+
+	/**
+	 * Run the active-set iterations, starting from the previous actuator setpoint
+	 * and the previous active set.
+	 *
+	 * @param target Control vector to allocate, relative to the trim and normalized
+	 * @return actuator deflection relative to the trim
+	 */
+	ActuatorVector solveActiveSet(const matrix::Vector<float, NUM_AXES> &target);
+
+	bool isFeasible(const ActuatorVector &actuator_sp) const;
+
+	/**
+	 * @return A * x, evaluated only over the configured actuators
+	 */
+	matrix::Vector<float, NUM_AXES> weightedControl(const matrix::Matrix<float, NUM_AXES, NUM_ACTUATORS> &A,
+			const ActuatorVector &x) const;
+
+	BoundState _bound_state[NUM_ACTUATORS] {};
+	matrix::Vector<float, NUM_AXES> _axis_weights;
+	int _num_iterations{0};
+
+private:
+	static constexpr float BOUND_TOLERANCE{1e-5f};
+};
@@ -0,0 +1,172 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <gtest/gtest.h>
+#include <ActuatorEffectivenessRotors.hpp>
+#include "ControlAllocationActiveSet.hpp"
+
+using namespace matrix;
+using ActuatorVector = ControlAllocation::ActuatorVector;
+
+class ControlAllocationActiveSetTestOctoX : public ::testing::Test
+{
+public:
+	static constexpr uint8_t NUM_ACTUATORS = 8;
+	ControlAllocationActiveSet _control_allocation;
+	ControlAllocationPseudoInverse _pseudo_inverse;
+
+	void SetUp() override
+	{
+		param_control_autosave(false); // Disable autosaving parameters to avoid busy loop in param_set()
+
+		// Octorotor x geometry
+		ActuatorEffectivenessRotors::Geometry octox_geometry{};
+		octox_geometry.num_rotors = NUM_ACTUATORS;
+
+		for (int i = 0; i < NUM_ACTUATORS; ++i) {
+			const float angle = M_PI_F / NUM_ACTUATORS + i * 2.f * M_PI_F / NUM_ACTUATORS;
+			octox_geometry.rotors[i].position = {cosf(angle), sinf(angle), 0.f};
+			octox_geometry.rotors[i].moment_ratio = (i % 2 == 0) ? 0.05f : -0.05f;
+			octox_geometry.rotors[i].axis = Vector3f(0.f, 0.f, -1.f); // thrust downwards
+			octox_geometry.rotors[i].thrust_coef = 1.f;
+			octox_geometry.rotors[i].tilt_index = -1;
+		}
+
+		ActuatorEffectiveness::Configuration actuator_configuration{};
+		int num_actuators = ActuatorEffectivenessRotors::computeEffectivenessMatrix(octox_geometry,
+				    actuator_configuration.effectiveness_matrices[0],
+				    actuator_configuration.num_actuators_matrix[0]);
+		EXPECT_EQ(num_actuators, NUM_ACTUATORS);
+		actuator_configuration.actuatorsAdded(ActuatorType::MOTORS, num_actuators);
+
+		_control_allocation.setEffectivenessMatrix(actuator_configuration.effectiveness_matrices[0],
+				actuator_configuration.trim[0], actuator_configuration.linearization_point[0],
+				actuator_configuration.num_actuators_matrix[0], true /*update_normalization_scale*/);
+		_pseudo_inverse.setEffectivenessMatrix(actuator_configuration.effectiveness_matrices[0],
+						       actuator_configuration.trim[0], actuator_configuration.linearization_point[0],
+						       actuator_configuration.num_actuators_matrix[0], true /*update_normalization_scale*/);
+	}
+
+	Vector<float, ControlAllocation::NUM_AXES> setpoint(float roll, float pitch, float yaw, float thrust)
+	{
+		Vector<float, ControlAllocation::NUM_AXES> control_setpoint{};
+		control_setpoint(ControlAllocation::ControlAxis::ROLL) = roll;
+		control_setpoint(ControlAllocation::ControlAxis::PITCH) = pitch;
+		control_setpoint(ControlAllocation::ControlAxis::YAW) = yaw;
+		control_setpoint(ControlAllocation::ControlAxis::THRUST_Z) = thrust;
+		return control_setpoint;
+	}
+
+	const ActuatorVector &allocate(const Vector<float, ControlAllocation::NUM_AXES> &control_setpoint)
+	{
+		_control_allocation.setControlSetpoint(control_setpoint);
+		_control_allocation.allocate();
+		return _control_allocation.getActuatorSetpoint();
+	}
+
+	float weightedError(const ControlAllocation &allocation)
+	{
+		const Vector<float, ControlAllocation::NUM_AXES> error = allocation.getAllocatedControl() -
+				allocation.getControlSetpoint();
+		return error.emult(_control_allocation.getAxisWeights()).norm();
+	}
+
+	void expectWithinBounds(const ActuatorVector &actuator_sp)
+	{
+		for (int i = 0; i < NUM_ACTUATORS; ++i) {
+			EXPECT_GE(actuator_sp(i), 0.f);
+			EXPECT_LE(actuator_sp(i), 1.f);
+		}
+
+		// All unused actuators shall stay zero
+		for (int i = NUM_ACTUATORS; i < ControlAllocation::NUM_ACTUATORS; ++i) {
+			EXPECT_EQ(actuator_sp(i), 0.f);
+		}
+	}
+};
+
+constexpr uint8_t ControlAllocationActiveSetTestOctoX::NUM_ACTUATORS;
+
+TEST_F(ControlAllocationActiveSetTestOctoX, UnsaturatedMatchesPseudoInverse)
+{
+	const Vector<float, ControlAllocation::NUM_AXES> control_setpoint = setpoint(0.1f, -0.1f, 0.05f, -0.5f);
+	_pseudo_inverse.setControlSetpoint(control_setpoint);
+	_pseudo_inverse.allocate();
+
+	EXPECT_EQ(allocate(control_setpoint), _pseudo_inverse.getActuatorSetpoint());
+	EXPECT_EQ(_control_allocation.numIterations(), 0);
+}
+
+TEST_F(ControlAllocationActiveSetTestOctoX, SaturatedWithinBounds)
+{
+	const float setpoints[][4] = {
+		{2.f, 0.5f, 0.f, -0.9f},
+		{1.5f, 1.5f, 0.2f, -0.2f},
+		{0.f, 0.f, 5.f, -0.5f},
+		{-3.f, 0.f, 0.f, -0.5f},
+		{0.f, 0.f, 0.f, -2.f},
+	};
+
+	for (const auto &sp : setpoints) {
+		expectWithinBounds(allocate(setpoint(sp[0], sp[1], sp[2], sp[3])));
+		EXPECT_LE(_control_allocation.numIterations(), ControlAllocationActiveSet::MAX_ITERATIONS);
+	}
+}
+
+TEST_F(ControlAllocationActiveSetTestOctoX, BetterTrackingThanClipping)
+{
+	const Vector<float, ControlAllocation::NUM_AXES> control_setpoint = setpoint(2.f, 0.5f, 0.f, -0.9f);
+
+	_pseudo_inverse.setControlSetpoint(control_setpoint);
+	_pseudo_inverse.allocate();
+	_pseudo_inverse.clipActuatorSetpoint();
+
+	allocate(control_setpoint);
+
+	EXPECT_LT(weightedError(_control_allocation), weightedError(_pseudo_inverse));
+}
+
+TEST_F(ControlAllocationActiveSetTestOctoX, WarmStart)
+{
+	const Vector<float, ControlAllocation::NUM_AXES> control_setpoint = setpoint(1.5f, 1.5f, 0.2f, -0.2f);
+
+	const ActuatorVector actuator_sp_cold = allocate(control_setpoint);
+	const int iterations_cold = _control_allocation.numIterations();
+
+	// Same setpoint again: the previous active set is already optimal
+	const ActuatorVector actuator_sp_warm = allocate(control_setpoint);
+	EXPECT_EQ(_control_allocation.numIterations(), 1);
+	EXPECT_LT(_control_allocation.numIterations(), iterations_cold);
+	EXPECT_TRUE(isEqual(actuator_sp_warm, actuator_sp_cold, 1e-4f));
+}
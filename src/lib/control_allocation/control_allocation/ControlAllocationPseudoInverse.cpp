@@ -73,6 +73,20 @@ ControlAllocationPseudoInverse::updatePseudoInverse()
 			normalizeControlAllocationMatrix();
 		}
 
+		for (int i = 0; i < NUM_ACTUATORS; i++) {
+			_mix_axes[i] = 0;
+
+			if (!(_configured_actuators & (1u << i))) {
+				continue;
+			}
+
+			for (int axis = 0; axis < NUM_AXES; axis++) {
+				if (fabsf(_mix(i, axis)) > 0.f) {
+					_mix_axes[i] |= 1u << axis;
+				}
+			}
+		}
+
 		_mix_update_needed = false;
 	}
 }
@@ -185,5 +199,22 @@ ControlAllocationPseudoInverse::allocate()
 	_prev_actuator_sp = _actuator_sp;
 
 	// Allocate
-	_actuator_sp = _actuator_trim + _mix * (_control_sp - _control_trim);
+	mixControl(_control_sp - _control_trim, _actuator_sp);
+}
+
+void
+ControlAllocationPseudoInverse::mixControl(const matrix::Vector<float, NUM_AXES> &control_delta,
+		ActuatorVector &actuator_sp, uint8_t axes) const
+{
+	for (int i = 0; i < NUM_ACTUATORS; i++) {
+		actuator_sp(i) = _actuator_trim(i);
+
+		const uint8_t mix_axes = _mix_axes[i] & axes;
+
+		for (int axis = 0; mix_axes != 0 && axis < NUM_AXES; axis++) {
+			if (mix_axes & (1u << axis)) {
+				actuator_sp(i) += _mix(i, axis) * control_delta(axis);
+			}
+		}
+	}
 }
@@ -61,6 +61,7 @@ public:
 
 protected:
 	matrix::Matrix<float, NUM_ACTUATORS, NUM_AXES> _mix;
+	uint8_t _mix_axes[NUM_ACTUATORS] {};	///< per actuator, bitmask of the axes with a non-zero mix entry
 
 	bool _mix_update_needed{false};
 	bool _metric_allocation{false};
@@ -71,6 +72,17 @@ protected:
 	 */
 	void updatePseudoInverse();
 
+	/**
+	 * Compute trim + mix * control_delta, only for the configured actuators
+	 * and skipping the zero entries of the mix.
+	 *
+	 * @param control_delta control setpoint relative to the control trim
+	 * @param actuator_sp resulting actuator setpoint
+	 * @param axes bitmask of the control axes to mix, the other axes are left out
+	 */
+	void mixControl(const matrix::Vector<float, NUM_AXES> &control_delta, ActuatorVector &actuator_sp,
+			uint8_t axes = ALL_AXES) const;
+
 private:
 	void normalizeControlAllocationMatrix();
 	void updateControlAllocationMatrixScale();
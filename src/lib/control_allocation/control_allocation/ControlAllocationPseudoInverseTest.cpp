@@ -91,3 +91,74 @@ TEST(ControlAllocationMetricTest, AllZeroCase)
 	EXPECT_EQ(actuator_sp, actuator_sp_expected);
 	EXPECT_EQ(control_allocated, control_allocated_expected);
 }
+
+TEST(ControlAllocationTest, SparseEffectiveness)
+{
+	// Fixed-wing like configuration: 1 motor and 4 control surfaces, each acting on 1-2 axes only
+	ControlAllocationPseudoInverse method;
+	static constexpr int NUM_CONFIGURED = 5;
+
+	matrix::Matrix<float, 6, 16> effectiveness;
+	effectiveness(3, 0) = 1.f; // motor: thrust x
+	effectiveness(0, 1) = -0.5f; // left aileron: roll
+	effectiveness(0, 2) = 0.5f; // right aileron: roll
+	effectiveness(1, 3) = 0.5f; // elevator: pitch
+	effectiveness(2, 4) = 0.4f; // rudder: yaw
+	effectiveness(0, 4) = 0.1f; // rudder: roll coupling
+
+	matrix::Vector<float, 16> actuator_trim;
+	matrix::Vector<float, 16> linearization_point;
+	matrix::Vector<float, 16> actuator_min;
+	actuator_min.setAll(-1.f);
+
+	method.setMetricAllocation(true);
+	method.setActuatorMin(actuator_min);
+	method.setEffectivenessMatrix(effectiveness, actuator_trim, linearization_point, NUM_CONFIGURED, false);
+
+	matrix::Vector<float, 6> control_sp;
+	control_sp(0) = 0.2f;
+	control_sp(1) = -0.1f;
+	control_sp(2) = 0.05f;
+	control_sp(3) = 0.6f;
+	method.setControlSetpoint(control_sp);
+	method.allocate();
+
+	const matrix::Vector<float, 16> &actuator_sp = method.getActuatorSetpoint();
+
+	// Unconfigured actuators are not touched
+	for (int i = NUM_CONFIGURED; i < 16; i++) {
+		EXPECT_FLOAT_EQ(actuator_sp(i), 0.f);
+	}
+
+	// Same result as the dense matrix product
+	const matrix::Vector<float, 6> control_allocated_expected = effectiveness * (actuator_sp - actuator_trim);
+	EXPECT_TRUE(isEqual(method.getAllocatedControl(), control_allocated_expected, 1e-5f));
+	EXPECT_TRUE(isEqual(method.getAllocatedControl(), control_sp, 1e-5f));
+}
+
+TEST(ControlAllocationTest, ClipConfiguredActuatorsOnly)
+{
+	ControlAllocationPseudoInverse method;
+	static constexpr int NUM_CONFIGURED = 4;
+
+	matrix::Matrix<float, 6, 16> effectiveness;
+	matrix::Vector<float, 16> actuator_trim;
+	matrix::Vector<float, 16> linearization_point;
+	linearization_point.setAll(5.f);
+
+	// The trim is clipped with the new actuator count already on the first update
+	method.setEffectivenessMatrix(effectiveness, actuator_trim, linearization_point, NUM_CONFIGURED, false);
+	method.allocate();
+
+	for (int i = 0; i < NUM_CONFIGURED; i++) {
+		EXPECT_FLOAT_EQ(method.getActuatorSetpoint()(i), 1.f);
+	}
+
+	matrix::Vector<float, 16> actuator_sp;
+	actuator_sp.setAll(5.f);
+	method.clipActuatorSetpoint(actuator_sp);
+
+	for (int i = 0; i < 16; i++) {
+		EXPECT_FLOAT_EQ(actuator_sp(i), (i < NUM_CONFIGURED) ? 1.f : 5.f);
+	}
+}
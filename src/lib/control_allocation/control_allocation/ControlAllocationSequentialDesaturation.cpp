@@ -124,17 +124,8 @@ ControlAllocationSequentialDesaturation::mixAirmodeRP()
 	// Airmode for roll and pitch, but not yaw
 
 	// Mix without yaw
-	ActuatorVector thrust_z;
-
-	for (int i = 0; i < _num_actuators; i++) {
-		_actuator_sp(i) = _actuator_trim(i) +
-				  _mix(i, ControlAxis::ROLL) * (_control_sp(ControlAxis::ROLL) - _control_trim(ControlAxis::ROLL)) +
-				  _mix(i, ControlAxis::PITCH) * (_control_sp(ControlAxis::PITCH) - _control_trim(ControlAxis::PITCH)) +
-				  _mix(i, ControlAxis::THRUST_X) * (_control_sp(ControlAxis::THRUST_X) - _control_trim(ControlAxis::THRUST_X)) +
-				  _mix(i, ControlAxis::THRUST_Y) * (_control_sp(ControlAxis::THRUST_Y) - _control_trim(ControlAxis::THRUST_Y)) +
-				  _mix(i, ControlAxis::THRUST_Z) * (_control_sp(ControlAxis::THRUST_Z) - _control_trim(ControlAxis::THRUST_Z));
-		thrust_z(i) = _mix(i, ControlAxis::THRUST_Z);
-	}
+	mixControl(_control_sp - _control_trim, _actuator_sp, ALL_AXES & ~(1u << ControlAxis::YAW));
+	const ActuatorVector thrust_z = mixColumn(ControlAxis::THRUST_Z);
 
 	desaturateActuators(_actuator_sp, thrust_z);
 
@@ -148,20 +139,9 @@ ControlAllocationSequentialDesaturation::mixAirmodeRPY()
 	// Airmode for roll, pitch and yaw
 
 	// Do full mixing
-	ActuatorVector thrust_z;
-	ActuatorVector yaw;
-
-	for (int i = 0; i < _num_actuators; i++) {
-		_actuator_sp(i) = _actuator_trim(i) +
-				  _mix(i, ControlAxis::ROLL) * (_control_sp(ControlAxis::ROLL) - _control_trim(ControlAxis::ROLL)) +
-				  _mix(i, ControlAxis::PITCH) * (_control_sp(ControlAxis::PITCH) - _control_trim(ControlAxis::PITCH)) +
-				  _mix(i, ControlAxis::YAW) * (_control_sp(ControlAxis::YAW) - _control_trim(ControlAxis::YAW)) +
-				  _mix(i, ControlAxis::THRUST_X) * (_control_sp(ControlAxis::THRUST_X) - _control_trim(ControlAxis::THRUST_X)) +
-				  _mix(i, ControlAxis::THRUST_Y) * (_control_sp(ControlAxis::THRUST_Y) - _control_trim(ControlAxis::THRUST_Y)) +
-				  _mix(i, ControlAxis::THRUST_Z) * (_control_sp(ControlAxis::THRUST_Z) - _control_trim(ControlAxis::THRUST_Z));
-		thrust_z(i) = _mix(i, ControlAxis::THRUST_Z);
-		yaw(i) = _mix(i, ControlAxis::YAW);
-	}
+	mixControl(_control_sp - _control_trim, _actuator_sp);
+	const ActuatorVector thrust_z = mixColumn(ControlAxis::THRUST_Z);
+	const ActuatorVector yaw = mixColumn(ControlAxis::YAW);
 
 	desaturateActuators(_actuator_sp, thrust_z);
 
@@ -176,21 +156,10 @@ ControlAllocationSequentialDesaturation::mixAirmodeDisabled()
 	// Airmode disabled: never allow to increase the thrust to unsaturate a motor
 
 	// Mix without yaw
-	ActuatorVector thrust_z;
-	ActuatorVector roll;
-	ActuatorVector pitch;
-
-	for (int i = 0; i < _num_actuators; i++) {
-		_actuator_sp(i) = _actuator_trim(i) +
-				  _mix(i, ControlAxis::ROLL) * (_control_sp(ControlAxis::ROLL) - _control_trim(ControlAxis::ROLL)) +
-				  _mix(i, ControlAxis::PITCH) * (_control_sp(ControlAxis::PITCH) - _control_trim(ControlAxis::PITCH)) +
-				  _mix(i, ControlAxis::THRUST_X) * (_control_sp(ControlAxis::THRUST_X) - _control_trim(ControlAxis::THRUST_X)) +
-				  _mix(i, ControlAxis::THRUST_Y) * (_control_sp(ControlAxis::THRUST_Y) - _control_trim(ControlAxis::THRUST_Y)) +
-				  _mix(i, ControlAxis::THRUST_Z) * (_control_sp(ControlAxis::THRUST_Z) - _control_trim(ControlAxis::THRUST_Z));
-		thrust_z(i) = _mix(i, ControlAxis::THRUST_Z);
-		roll(i) = _mix(i, ControlAxis::ROLL);
-		pitch(i) = _mix(i, ControlAxis::PITCH);
-	}
+	mixControl(_control_sp - _control_trim, _actuator_sp, ALL_AXES & ~(1u << ControlAxis::YAW));
+	const ActuatorVector thrust_z = mixColumn(ControlAxis::THRUST_Z);
+	const ActuatorVector roll = mixColumn(ControlAxis::ROLL);
+	const ActuatorVector pitch = mixColumn(ControlAxis::PITCH);
 
 	// only reduce thrust
 	desaturateActuators(_actuator_sp, thrust_z, true);
@@ -207,14 +176,9 @@ void
 ControlAllocationSequentialDesaturation::mixYaw()
 {
 	// Add yaw to outputs
-	ActuatorVector yaw;
-	ActuatorVector thrust_z;
-
-	for (int i = 0; i < _num_actuators; i++) {
-		_actuator_sp(i) += _mix(i, ControlAxis::YAW) * (_control_sp(ControlAxis::YAW) - _control_trim(ControlAxis::YAW));
-		yaw(i) = _mix(i, ControlAxis::YAW);
-		thrust_z(i) = _mix(i, ControlAxis::THRUST_Z);
-	}
+	const ActuatorVector yaw = mixColumn(ControlAxis::YAW);
+	const ActuatorVector thrust_z = mixColumn(ControlAxis::THRUST_Z);
+	_actuator_sp += yaw * (_control_sp(ControlAxis::YAW) - _control_trim(ControlAxis::YAW));
 
 	// Change yaw acceleration to unsaturate the outputs if needed (do not change roll/pitch),
 	// and allow some yaw response at maximum thrust
@@ -227,6 +191,20 @@ ControlAllocationSequentialDesaturation::mixYaw()
 	desaturateActuators(_actuator_sp, thrust_z, true);
 }
 
+ControlAllocation::ActuatorVector
+ControlAllocationSequentialDesaturation::mixColumn(ControlAxis axis) const
+{
+	ActuatorVector column;
+
+	for (int i = 0; i < _num_actuators; i++) {
+		if (_mix_axes[i] & (1u << axis)) {
+			column(i) = _mix(i, axis);
+		}
+	}
+
+	return column;
+}
+
 void
 ControlAllocationSequentialDesaturation::updateParameters()
 {
@@ -126,6 +126,11 @@ private:
 	 */
 	void mixYaw();
 
+	/**
+	 * @return column of the mix for the given axis, only filled for the actuators acting on it
+	 */
+	ActuatorVector mixColumn(ControlAxis axis) const;
+
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::MC_AIRMODE>) _param_mc_airmode   ///< air-mode
 	);
@@ -57,7 +57,7 @@ DatamanClient::DatamanClient()
 
 		hrt_abstime timestamp = hrt_absolute_time();
 
-		dataman_request_s request;
+		dataman_request_s request{};
 		request.timestamp = timestamp;
 		request.request_type = DM_GET_ID;
 		request.client_id = CLIENT_ID_NOT_SET;
@@ -91,22 +91,28 @@ bool DatamanClient::syncHandler(const dataman_request_s &request, dataman_respon
 	hrt_abstime time_elapsed = hrt_elapsed_time(&start_time);
 	perf_begin(_sync_perf);
 	_dataman_request_pub.publish(request);
+	hrt_abstime last_publish = hrt_absolute_time();
 
 	while (!response_received && (time_elapsed < timeout)) {
 
-		uint32_t timeout_ms = 100;
+		// Retry based on the time since the last publish: responses to other clients wake up
+		// the poll as well and must not postpone the retry.
+		const hrt_abstime since_publish = hrt_elapsed_time(&last_publish);
+
+		if (since_publish >= REQUEST_RETRY_INTERVAL) {
+			_dataman_request_pub.publish(request);
+			last_publish = hrt_absolute_time();
+			continue;
+		}
+
+		const int timeout_ms = static_cast<int>((REQUEST_RETRY_INTERVAL - since_publish) / 1000) + 1;
 		ret = px4_poll(&_fds, 1, timeout_ms);
 
 		if (ret < 0) {
 			PX4_ERR("px4_poll returned error: %" PRIu32, ret);
 			break;
 
-		} else if (ret == 0) {
-
-			// No response received, send new request
-			_dataman_request_pub.publish(request);
-
-		} else {
+		} else if (ret > 0) {
 
 			bool updated = false;
 			orb_check(_dataman_response_sub, &updated);
@@ -118,11 +124,14 @@ bool DatamanClient::syncHandler(const dataman_request_s &request, dataman_respon
 
 					if ((response.request_type == request.request_type) &&
 					    (response.item == request.item) &&
-					    (response.index == request.index)) {
+					    (response.index == request.index) &&
+					    (response.tag == request.tag)) {
 						response_received = true;
 						break;
 					}
 
+					handleBatchResponse(response);
+
 				} else if (request.client_id == CLIENT_ID_NOT_SET) {
 
 					// validate timestamp from response.data
@@ -155,12 +164,13 @@ bool DatamanClient::readSync(dm_item_t item, uint32_t index, uint8_t *buffer, ui
 
 	hrt_abstime timestamp = hrt_absolute_time();
 
-	dataman_request_s request;
+	dataman_request_s request{};
 	request.timestamp = timestamp;
 	request.index = index;
 	request.data_length = length;
 	request.client_id = _client_id;
 	request.request_type = DM_READ;
+	request.sequence = nextSequence();
 	request.item = static_cast<uint8_t>(item);
 
 	dataman_response_s response{};
@@ -191,12 +201,13 @@ bool DatamanClient::writeSync(dm_item_t item, uint32_t index, uint8_t *buffer, u
 
 	hrt_abstime timestamp = hrt_absolute_time();
 
-	dataman_request_s request;
+	dataman_request_s request{};
 	request.timestamp = timestamp;
 	request.index = index;
 	request.data_length = length;
 	request.client_id = _client_id;
 	request.request_type = DM_WRITE;
+	request.sequence = nextSequence();
 	request.item = static_cast<uint8_t>(item);
 
 	memcpy(request.data, buffer, length);
@@ -221,10 +232,11 @@ bool DatamanClient::clearSync(dm_item_t item, hrt_abstime timeout)
 {
 	hrt_abstime timestamp = hrt_absolute_time();
 
-	dataman_request_s request;
+	dataman_request_s request{};
 	request.timestamp = timestamp;
 	request.client_id = _client_id;
 	request.request_type = DM_CLEAR;
+	request.sequence = nextSequence();
 	request.item = static_cast<uint8_t>(item);
 
 	dataman_response_s response{};
@@ -256,16 +268,18 @@ bool DatamanClient::readAsync(dm_item_t item, uint32_t index, uint8_t *buffer, u
 
 		hrt_abstime timestamp = hrt_absolute_time();
 
-		dataman_request_s request;
+		dataman_request_s request{};
 		request.timestamp = timestamp;
 		request.index = index;
 		request.data_length = length;
 		request.client_id = _client_id;
 		request.request_type = DM_READ;
+		request.sequence = nextSequence();
 		request.item = static_cast<uint8_t>(item);
 
 		_active_request.timestamp = timestamp;
 		_active_request.request_type = DM_READ;
+		_active_request.sequence = request.sequence;
 		_active_request.item = item;
 		_active_request.index = index;
 		_active_request.buffer = buffer;
@@ -294,18 +308,20 @@ bool DatamanClient::writeAsync(dm_item_t item, uint32_t index, uint8_t *buffer,
 
 		hrt_abstime timestamp = hrt_absolute_time();
 
-		dataman_request_s request;
+		dataman_request_s request{};
 		request.timestamp = timestamp;
 		request.index = index;
 		request.data_length = length;
 		request.client_id = _client_id;
 		request.request_type = DM_WRITE;
+		request.sequence = nextSequence();
 		request.item = static_cast<uint8_t>(item);
 
 		memcpy(request.data, buffer, length);
 
 		_active_request.timestamp = timestamp;
 		_active_request.request_type = DM_WRITE;
+		_active_request.sequence = request.sequence;
 		_active_request.item = item;
 		_active_request.index = index;
 		_active_request.buffer = buffer;
@@ -329,15 +345,17 @@ bool DatamanClient::clearAsync(dm_item_t item)
 
 		hrt_abstime timestamp = hrt_absolute_time();
 
-		dataman_request_s request;
+		dataman_request_s request{};
 		request.timestamp = timestamp;
 		request.client_id = _client_id;
 		request.request_type = DM_CLEAR;
+		request.sequence = nextSequence();
 		request.item = static_cast<uint8_t>(item);
 		request.index = 0;
 
 		_active_request.timestamp = timestamp;
 		_active_request.request_type = DM_CLEAR;
+		_active_request.sequence = request.sequence;
 		_active_request.item = item;
 		_active_request.index = request.index;
 		_state = State::RequestSent;
@@ -352,66 +370,73 @@ bool DatamanClient::clearAsync(dm_item_t item)
 
 void DatamanClient::update()
 {
-	if (_state == State::RequestSent) {
-
-		bool updated = false;
-		orb_check(_dataman_response_sub, &updated);
+	bool updated = false;
+	orb_check(_dataman_response_sub, &updated);
 
+	// Drain all queued responses, there can be one per in-flight batch request
+	while (updated) {
 		dataman_response_s response;
+		orb_copy(ORB_ID(dataman_response), _dataman_response_sub, &response);
 
-		if (updated) {
-			orb_copy(ORB_ID(dataman_response), _dataman_response_sub, &response);
+		if ((_state == State::RequestSent) &&
+		    (response.client_id == _client_id) &&
+		    (response.request_type == _active_request.request_type) &&
+		    (response.item == _active_request.item) &&
+		    (response.index == _active_request.index) &&
+		    (response.tag == TAG_SINGLE_REQUEST)) {
 
-			if ((response.client_id == _client_id) &&
-			    (response.request_type == _active_request.request_type) &&
-			    (response.item == _active_request.item) &&
-			    (response.index == _active_request.index)) {
+			if (response.request_type == DM_READ) {
+				memcpy(_active_request.buffer, response.data, _active_request.length);
+			}
 
-				if (response.request_type == DM_READ) {
-					memcpy(_active_request.buffer, response.data, _active_request.length);
-				}
+			_response_status = response.status;
 
-				_response_status = response.status;
+			if (_response_status != dataman_response_s::STATUS_SUCCESS) {
 
-				if (_response_status != dataman_response_s::STATUS_SUCCESS) {
+				PX4_ERR("Async request type %" PRIu8 " failed! status=%" PRIu8 " item=%" PRIu8 " index=%" PRIu32,
+					response.request_type, response.status, static_cast<uint8_t>(_active_request.item), _active_request.index);
+			}
 
-					PX4_ERR("Async request type %" PRIu8 " failed! status=%" PRIu8 " item=%" PRIu8 " index=%" PRIu32,
-						response.request_type, response.status, static_cast<uint8_t>(_active_request.item), _active_request.index);
-				}
+			_state = State::ResponseReceived;
 
-				_state = State::ResponseReceived;
-			}
+		} else {
+			handleBatchResponse(response);
 		}
 
-		if (_state == State::RequestSent) {
-
-			/* Retry the request if there is no answer */
-			if (((_active_request.request_type != DM_CLEAR) && (hrt_elapsed_time(&_active_request.timestamp) > 100_ms)) ||
-			    (hrt_elapsed_time(&_active_request.timestamp) > 1000_ms)
-			   ) {
+		orb_check(_dataman_response_sub, &updated);
+	}
 
-				hrt_abstime timestamp = hrt_absolute_time();
+	if (_state == State::RequestSent) {
 
-				_active_request.timestamp = timestamp;
+		/* Retry the request if there is no answer */
+		if (((_active_request.request_type != DM_CLEAR) && (hrt_elapsed_time(&_active_request.timestamp) > REQUEST_RETRY_INTERVAL)) ||
+		    (hrt_elapsed_time(&_active_request.timestamp) > 1000_ms)
+		   ) {
 
-				dataman_request_s request;
-				request.timestamp = timestamp;
-				request.index = _active_request.index;
-				request.data_length = _active_request.length;
-				request.client_id = _client_id;
-				request.request_type = static_cast<uint8_t>(_active_request.request_type);
-				request.item = static_cast<uint8_t>(_active_request.item);
+			hrt_abstime timestamp = hrt_absolute_time();
 
-				if (_active_request.request_type == DM_WRITE) {
-					memcpy(request.data, _active_request.buffer, _active_request.length);
-				}
+			_active_request.timestamp = timestamp;
 
-				_dataman_request_pub.publish(request);
+			dataman_request_s request{};
+			request.timestamp = timestamp;
+			request.index = _active_request.index;
+			request.data_length = _active_request.length;
+			request.client_id = _client_id;
+			request.request_type = static_cast<uint8_t>(_active_request.request_type);
+			request.item = static_cast<uint8_t>(_active_request.item);
+			request.sequence = _active_request.sequence;
 
-				_state = State::RequestSent;
+			if (_active_request.request_type == DM_WRITE) {
+				memcpy(request.data, _active_request.buffer, _active_request.length);
 			}
+
+			_dataman_request_pub.publish(request);
+
+			_state = State::RequestSent;
 		}
 	}
+
+	updateBatch();
 }
 
 bool DatamanClient::lastOperationCompleted(bool &success)
@@ -437,6 +462,207 @@ void DatamanClient::abortCurrentOperation()
 	_state = State::Idle;
 }
 
+bool DatamanClient::readBatchAsync(dm_item_t item, uint32_t first_index, uint32_t count, uint8_t *buffer,
+				   uint32_t length)
+{
+	return queueBatchRange(DM_READ, item, first_index, count, buffer, length);
+}
+
+bool DatamanClient::writeBatchAsync(dm_item_t item, uint32_t first_index, uint32_t count, const uint8_t *buffer,
+				    uint32_t length)
+{
+	// the buffer is only read from for writes
+	return queueBatchRange(DM_WRITE, item, first_index, count, const_cast<uint8_t *>(buffer), length);
+}
+
+bool DatamanClient::queueBatchRange(dm_function_t request_type, dm_item_t item, uint32_t first_index, uint32_t count,
+				    uint8_t *buffer, uint32_t length)
+{
+	if (length > g_per_item_size[item]) {
+		PX4_ERR("Length  %" PRIu32 " can't fit in data size for item  %" PRIi8, length, static_cast<uint8_t>(item));
+		return false;
+	}
+
+	if ((count == 0) || (buffer == nullptr) || (_batch_range.remaining > 0)) {
+		return false;
+	}
+
+	if (!_batch_pending) {
+		// start of a new batch
+		_batch_failed = false;
+		_batch_completed = false;
+	}
+
+	_batch_range.request_type = request_type;
+	_batch_range.item = item;
+	_batch_range.next_index = first_index;
+	_batch_range.remaining = count;
+	_batch_range.buffer = buffer;
+	_batch_range.length = length;
+
+	_batch_pending = true;
+
+	// dispatch as much as the window allows right away
+	updateBatch();
+
+	return true;
+}
+
+bool DatamanClient::handleBatchResponse(const dataman_response_s &response)
+{
+	if ((_batch_in_flight == 0) || (response.client_id != _client_id) || (response.tag != _batch_tag)) {
+		// not ours, or a stale response of an aborted batch
+		return false;
+	}
+
+	for (BatchRequest &batch_request : _batch_requests) {
+		const dataman_request_s &request = batch_request.request;
+
+		if (batch_request.active &&
+		    (response.request_type == request.request_type) &&
+		    (response.item == request.item) &&
+		    (response.index == request.index)) {
+
+			if (response.status == dataman_response_s::STATUS_SUCCESS) {
+				if (batch_request.buffer != nullptr) {
+					memcpy(batch_request.buffer, response.data, request.data_length);
+				}
+
+			} else {
+				_batch_failed = true;
+				PX4_ERR("Batch request type %" PRIu8 " failed! status=%" PRIu8 " item=%" PRIu8 " index=%" PRIu32,
+					response.request_type, response.status, response.item, response.index);
+			}
+
+			batch_request.active = false;
+			--_batch_in_flight;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void DatamanClient::updateBatch()
+{
+	if (!_batch_pending) {
+		return;
+	}
+
+	const hrt_abstime now = hrt_absolute_time();
+
+	for (BatchRequest &batch_request : _batch_requests) {
+
+		if (batch_request.active) {
+
+			/* Retry the request if there is no answer */
+			if (now - batch_request.request.timestamp > REQUEST_RETRY_INTERVAL) {
+				batch_request.request.timestamp = now;
+				_dataman_request_pub.publish(batch_request.request);
+			}
+
+		} else if (_batch_range.remaining > 0) {
+
+			dataman_request_s &request = batch_request.request;
+			request.timestamp = now;
+			request.index = _batch_range.next_index;
+			request.data_length = _batch_range.length;
+			request.client_id = _client_id;
+			request.request_type = static_cast<uint8_t>(_batch_range.request_type);
+			request.item = static_cast<uint8_t>(_batch_range.item);
+			request.tag = _batch_tag;
+			request.sequence = nextSequence();
+
+			if (_batch_range.request_type == DM_WRITE) {
+				memcpy(request.data, _batch_range.buffer, _batch_range.length);
+				batch_request.buffer = nullptr;
+
+			} else {
+				batch_request.buffer = _batch_range.buffer;
+			}
+
+			_batch_range.buffer += _batch_range.length;
+			++_batch_range.next_index;
+			--_batch_range.remaining;
+
+			batch_request.active = true;
+			++_batch_in_flight;
+
+			_dataman_request_pub.publish(request);
+		}
+	}
+
+	if ((_batch_in_flight == 0) && (_batch_range.remaining == 0)) {
+		_batch_pending = false;
+		_batch_completed = true;
+
+		if (_batch_callback) {
+			_batch_callback(_batch_callback_context, !_batch_failed);
+		}
+	}
+}
+
+bool DatamanClient::batchCompleted(bool &success)
+{
+	success = false;
+
+	if (_batch_completed) {
+		success = !_batch_failed;
+		_batch_completed = false;
+		_batch_failed = false;
+		return true;
+	}
+
+	return false;
+}
+
+bool DatamanClient::waitBatch(hrt_abstime timeout)
+{
+	bool success = false;
+
+	if (!_batch_pending && !_batch_completed) {
+		// nothing queued
+		return true;
+	}
+
+	const hrt_abstime start_time = hrt_absolute_time();
+	perf_begin(_sync_perf);
+
+	while (!batchCompleted(success)) {
+
+		if (hrt_elapsed_time(&start_time) > timeout) {
+			PX4_ERR("batch timeout after %" PRIu32 " ms!", static_cast<uint32_t>(timeout / 1000));
+			abortBatch();
+			break;
+		}
+
+		px4_poll(&_fds, 1, 10);
+		update();
+	}
+
+	perf_end(_sync_perf);
+
+	return success;
+}
+
+void DatamanClient::abortBatch()
+{
+	for (BatchRequest &batch_request : _batch_requests) {
+		batch_request.active = false;
+	}
+
+	_batch_range.remaining = 0;
+	_batch_in_flight = 0;
+	_batch_pending = false;
+	_batch_failed = false;
+	_batch_completed = false;
+
+	// responses to the aborted requests can still arrive, make sure they don't match the next batch
+	if (++_batch_tag == TAG_SINGLE_REQUEST) {
+		++_batch_tag;
+	}
+}
+
 DatamanCache::DatamanCache(const char *cache_miss_perf_counter_name, uint32_t num_items)
 	: _cache_miss_perf(perf_alloc(PC_COUNT, cache_miss_perf_counter_name))
 {
@@ -527,6 +753,16 @@ bool DatamanCache::loadWait(dm_item_t item, uint32_t index, uint8_t *buffer, uin
 	bool success = false;
 	bool item_found = false;
 
+	// Items loaded in sequence end up at their index, check there before searching the whole cache
+	const Item &hint = _items[index % _num_items];
+
+	if ((hint.response.item == item) &&
+	    (hint.response.index == index) &&
+	    (hint.cache_state == State::ResponseReceived)) {
+		memcpy(buffer, hint.response.data, length);
+		return true;
+	}
+
 	for (uint32_t i = 0; i < _num_items; ++i) {
 		if ((_items[i].response.item == item) &&
 		    (_items[i].response.index == index)) {
@@ -592,63 +828,65 @@ void DatamanCache::update()
 
 		_client.update();
 
-		bool success = false;
 		bool response_success = false;
 
-		switch (_items[_update_index].cache_state) {
-		case State::Idle:
-			break;
+		if ((_batch_count > 0) && _client.batchCompleted(response_success)) {
 
-		case State::ResponseReceived:
-			// Skip it
-			changeUpdateIndex();
-			break;
+			for (uint32_t i = 0; i < _batch_count; ++i) {
+				Item &entry = _items[_update_index];
 
-		case State::RequestPrepared:
+				if (entry.cache_state == State::RequestSent) {
 
-			success = _client.readAsync(static_cast<dm_item_t>(_items[_update_index].response.item),
-						    _items[_update_index].response.index,
-						    _items[_update_index].response.data,
-						    g_per_item_size[_items[_update_index].response.item]);
+					if (response_success) {
+						entry.cache_state = State::ResponseReceived;
 
-			if (success) {
-				_items[_update_index].cache_state = State::RequestSent;
+					} else {
+						// the client does not report which request failed, loadWait() will read these again
+						entry.cache_state = State::Error;
+						PX4_ERR("Caching: item %" PRIu8 ", index %" PRIu32, entry.response.item, entry.response.index);
+					}
+				}
 
-			} else {
-				_items[_update_index].cache_state = State::Error;
+				changeUpdateIndex();
 			}
 
-			break;
+			_batch_count = 0;
+		}
 
-		case State::RequestSent:
+		if (_batch_count == 0) {
 
-			if (_client.lastOperationCompleted(response_success)) {
+			// Request the next window of prepared items in one batch
+			uint32_t index = _update_index;
+			uint32_t requests_sent = 0;
 
-				if (response_success) {
+			while ((_batch_count < _item_counter) && (_batch_count < DatamanClient::BATCH_WINDOW)) {
+				Item &entry = _items[index];
 
-					_items[_update_index].cache_state = State::ResponseReceived;
-					changeUpdateIndex();
+				if (entry.cache_state == State::RequestPrepared) {
 
-				} else {
-					_items[_update_index].cache_state = State::Error;
-				}
-			}
+					const dm_item_t item = static_cast<dm_item_t>(entry.response.item);
 
-			break;
+					if (!_client.readBatchAsync(item, entry.response.index, 1, entry.response.data, g_per_item_size[item])) {
+						break;
+					}
 
-		case State::Error:
-			// Handled below
-			break;
-		}
+					entry.cache_state = State::RequestSent;
+					++requests_sent;
+				}
 
-		if (_items[_update_index].cache_state == State::Error) {
-			PX4_ERR("Caching: item %" PRIu8 ", index %" PRIu32", status %" PRIu8,
-				_items[_update_index].response.item, _items[_update_index].response.index,
-				_items[_update_index].response.status);
+				++_batch_count;
+				index = (index + 1) % _num_items;
+			}
 
-			changeUpdateIndex();
-		}
+			if (requests_sent == 0) {
+				// Nothing to load in this window (already cached)
+				for (uint32_t i = 0; i < _batch_count; ++i) {
+					changeUpdateIndex();
+				}
 
+				_batch_count = 0;
+			}
+		}
 	}
 }
 
@@ -661,7 +899,9 @@ void DatamanCache::invalidate()
 	_update_index = 0;
 	_item_counter = 0;
 	_load_index = 0;
+	_batch_count = 0;
 	_client.abortCurrentOperation();
+	_client.abortBatch();
 }
 
 inline void DatamanCache::changeUpdateIndex()
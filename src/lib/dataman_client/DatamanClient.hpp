@@ -153,6 +153,81 @@ public:
 	 */
 	void abortCurrentOperation();
 
+	/**
+	 * Completion callback of a batch, called from update() once all queued batch requests finished.
+	 */
+	typedef void (*BatchCallback)(void *context, bool success);
+
+	/**
+	 * @brief Queues an asynchronous read of 'count' consecutive indexes of an item.
+	 *
+	 * Up to BATCH_WINDOW requests are kept in flight at the same time, so a range is loaded
+	 * in count / BATCH_WINDOW round-trips instead of count. Progress is made by update().
+	 *
+	 * @param[in] item The item to read from.
+	 * @param[in] first_index The first index of the range.
+	 * @param[in] count The number of indexes to read.
+	 * @param[out] buffer Buffer of at least count * length bytes, index i is stored at offset (i - first_index) * length.
+	 * @param[in] length The length of a single entry.
+	 *
+	 * @return True if the range was queued, false if the previous range is not dispatched yet or the arguments are invalid.
+	 *
+	 * @note The buffer must be kept alive until the batch completed, see batchCompleted().
+	 */
+	bool readBatchAsync(dm_item_t item, uint32_t first_index, uint32_t count, uint8_t *buffer, uint32_t length);
+
+	/**
+	 * @brief Queues an asynchronous write of 'count' consecutive indexes of an item.
+	 *
+	 * Same as readBatchAsync() but for writes. The data of each entry is copied when its request is sent,
+	 * so the buffer can be released as soon as batchIdle() returns true.
+	 */
+	bool writeBatchAsync(dm_item_t item, uint32_t first_index, uint32_t count, const uint8_t *buffer, uint32_t length);
+
+	/**
+	 * @brief Check if all queued batch requests have completed and whether they were all successful.
+	 *
+	 * @param[out] success Output parameter indicating whether all requests of the batch succeeded.
+	 * @return true if the batch has completed, false otherwise.
+	 */
+	bool batchCompleted(bool &success);
+
+	/**
+	 * @brief Blocks until all queued batch requests have completed or the timeout expired.
+	 *
+	 * @return true if the batch completed and all requests succeeded.
+	 */
+	bool waitBatch(hrt_abstime timeout = 5000_ms);
+
+	/**
+	 * @brief Sets a callback that is called from update() when a batch completes.
+	 *
+	 * As update() is driven by the caller, the callback runs in the context of the caller (e.g. its WorkItem).
+	 */
+	void setBatchCallback(BatchCallback callback, void *context)
+	{
+		_batch_callback = callback;
+		_batch_callback_context = context;
+	}
+
+	/**
+	 * @return true if there is no batch range waiting to be dispatched.
+	 */
+	bool batchIdle() const { return _batch_range.remaining == 0; }
+
+	/**
+	 * Abort all queued batch requests
+	 */
+	void abortBatch();
+
+	/**
+	 * Maximum number of batch requests in flight. The request queue is shared by all clients,
+	 * so the window only takes a fraction of it to let several clients pipeline at the same time.
+	 */
+	static constexpr uint8_t BATCH_WINDOW{4};
+	static_assert(BATCH_WINDOW * 4 <= dataman_request_s::ORB_QUEUE_LENGTH, "dataman request queue too short");
+	static_assert(BATCH_WINDOW * 4 <= dataman_response_s::ORB_QUEUE_LENGTH, "dataman response queue too short");
+
 private:
 
 	enum class State {
@@ -168,26 +243,75 @@ private:
 		uint32_t index;
 		uint8_t *buffer;
 		uint32_t length;
+		uint16_t sequence;
+	};
+
+	struct BatchRange {
+		dm_function_t request_type;
+		dm_item_t item;
+		uint32_t next_index;
+		uint32_t remaining;
+		uint8_t *buffer;
+		uint32_t length;
+	};
+
+	struct BatchRequest {
+		dataman_request_s request;
+		uint8_t *buffer;	///< read destination, nullptr for writes
+		bool active;
 	};
 
 	/* Synchronous response/request handler */
 	bool syncHandler(const dataman_request_s &request, dataman_response_s &response,
 			 const hrt_abstime &start_time, hrt_abstime timeout);
 
+	bool queueBatchRange(dm_function_t request_type, dm_item_t item, uint32_t first_index, uint32_t count,
+			     uint8_t *buffer, uint32_t length);
+
+	/* Match a response against the in-flight batch requests, returns true if it was consumed */
+	bool handleBatchResponse(const dataman_response_s &response);
+
+	/* Retry timed out batch requests and fill the window from the pending range */
+	void updateBatch();
+
+	/* Sequence number of a new request, retries of the request reuse it */
+	uint16_t nextSequence()
+	{
+		if (++_sequence == SEQUENCE_NOT_SET) {
+			++_sequence;
+		}
+
+		return _sequence;
+	}
+
 	State _state{State::Idle};
 	Request _active_request{};
 	uint8_t _response_status{};
 
+	BatchRange _batch_range{};
+	BatchRequest _batch_requests[BATCH_WINDOW] {};
+	uint32_t _batch_in_flight{0};
+	bool _batch_pending{false};	///< a batch was queued and did not complete yet
+	bool _batch_failed{false};
+	bool _batch_completed{false};
+	uint8_t _batch_tag{1};		///< tag of the current batch, responses with another tag are stale
+	BatchCallback _batch_callback{nullptr};
+	void *_batch_callback_context{nullptr};
+
 	int32_t _dataman_response_sub{};
 	uORB::Publication<dataman_request_s> _dataman_request_pub{ORB_ID(dataman_request)};
 
 	px4_pollfd_struct_t _fds;
 
 	uint8_t _client_id{0};
+	uint16_t _sequence{SEQUENCE_NOT_SET};	///< sequence number of the latest request
 
 	perf_counter_t _sync_perf{nullptr};
 
 	static constexpr uint8_t CLIENT_ID_NOT_SET{0};
+	static constexpr uint8_t TAG_SINGLE_REQUEST{0};
+	static constexpr uint16_t SEQUENCE_NOT_SET{0};
+	static constexpr hrt_abstime REQUEST_RETRY_INTERVAL{100_ms};
 };
 
 
@@ -254,9 +378,9 @@ public:
 	 * @brief Updates the dataman cache by checking for responses from the DatamanClient and processing them.
 	 *
 	 * If there are items in the cache, this function will call the DatamanClient's 'update()' function to check for responses.
-	 * Depending on the state of each item, it will either send a request, wait for a response, or report an error.
-	 * If a response is received for an item, it will be marked as "response received" and the update index will be changed
-	 * to the next item in the cache. This function does not block and returns immediately.
+	 * Prepared items are requested in batches of up to DatamanClient::BATCH_WINDOW items. Once a batch completed, its items
+	 * are marked as "response received" (or as error) and the update index is moved past them.
+	 * This function does not block and returns immediately.
 	 * The data can be acquired with the 'loadWait()' function after it has been cached.
 	 */
 	void update();
@@ -299,6 +423,7 @@ private:
 	uint32_t _update_index{0};	///< index for tracking last index used by update function
 	uint32_t _item_counter{0};	///< number of items to process with update function
 	uint32_t _num_items{0};		///< number of items that cache can store
+	uint32_t _batch_count{0};	///< number of items starting at the update index covered by the current batch
 
 	DatamanClient _client{};
 
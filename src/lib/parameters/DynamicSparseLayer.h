@@ -37,64 +37,157 @@
 
 #include <px4_platform_common/atomic.h>
 
+#include <string.h>
+
+/**
+ * Sparse parameter layer that grows on demand.
+ *
+ * The slots are kept sorted by parameter: store() inserts in place and get() is a binary search.
+ * Writers are serialized with an AtomicTransaction, while readers do not lock: they retry if a
+ * writer modified the slots during the lookup (sequence counter). A replaced slot buffer is retired
+ * instead of freed, and retired buffers are only freed once no reader is active, so a reader that
+ * still uses one never reads freed memory.
+ */
 class DynamicSparseLayer : public ParamLayer
 {
 public:
+	struct Slot {
+		param_t param;
+		param_value_u value;
+	};
+
 	DynamicSparseLayer(ParamLayer *parent, int n_prealloc = 32, int n_grow = 4) : ParamLayer(parent),
-		_n_slots(n_prealloc), _n_grow(n_grow)
+		_n_grow(n_grow)
 	{
-		Slot *slots = (Slot *)malloc(sizeof(Slot) * n_prealloc);
+		Slot *slots = _allocSlots(n_prealloc);
 
 		if (slots == nullptr) {
 			PX4_ERR("Failed to allocate memory for dynamic sparse layer");
-			_n_slots = 0;
 			return;
 		}
 
-		for (int i = 0; i < _n_slots; i++) {
-			slots[i] = {UINT16_MAX, param_value_u{}};
-		}
-
 		_slots.store(slots);
+		_n_slots.store(n_prealloc);
 	}
 
 	virtual ~DynamicSparseLayer()
 	{
-		if (_slots.load()) {
-			free(_slots.load());
-		}
+		_freeSlots(_slots.load());
+		_freeRetired(_retired);
 	}
 
 	bool store(param_t param, param_value_u value) override
 	{
 		AtomicTransaction transaction;
-		Slot *slots = _slots.load();
 
-		const int index = _getIndex(param);
+		for (;;) {
+			Slot *slots = _slots.load();
+			const int next_slot = _next_slot.load();
+			const int index = _lowerBound(slots, next_slot, param);
+
+			if (index < next_slot && slots[index].param == param) { // already exists
+				_beginWrite();
+				slots[index].value = value;
+				_endWrite();
+				_collectRetired(transaction);
+				return true;
+			}
+
+			if (next_slot < _n_slots.load()) {
+				_beginWrite();
+				memmove(&slots[index + 1], &slots[index], sizeof(Slot) * (next_slot - index));
+				slots[index] = {param, value};
+				_next_slot.store(next_slot + 1);
+				_endWrite();
+				_collectRetired(transaction);
+				return true;
+			}
+
+			if (!_grow(transaction, next_slot + 1)) {
+				return false;
+			}
+		}
+	}
+
+	/**
+	 * Store multiple parameters at once.
+	 * The new values are merged with the existing slots in a single pass, which is linear if slots is
+	 * already sorted by parameter (e.g. an exported parameter file).
+	 * @param slots parameters to store. Gets sorted in place.
+	 */
+	bool storeMultiple(Slot *slots, int count)
+	{
+		if (count <= 0) {
+			return true;
+		}
+
+		for (int i = 1; i < count; i++) {
+			if (slots[i - 1].param > slots[i].param) {
+				qsort(slots, count, sizeof(Slot), _slotCompare);
+				break;
+			}
+		}
+
+		AtomicTransaction transaction;
+
+		if (_n_slots.load() == 0) {
+			return false;
+		}
 
-		if (index < _next_slot) { // already exists
-			slots[index].value = value;
+		// merge into a new buffer: the existing one stays consistent for readers until the switch
+		Slot *merged = nullptr;
+		int n_merged = 0;
 
-		} else if (_next_slot < _n_slots) {
-			slots[_next_slot++] = {param, value};
-			_sort();
+		for (;;) {
+			const int next_slot = _next_slot.load();
+
+			if (merged && n_merged >= next_slot + count) {
+				break;
+			}
+
+			transaction.unlock();
+			_freeSlots(merged);
+			n_merged = next_slot + count + _n_grow;
+			merged = _allocSlots(n_merged);
+			transaction.lock();
 
-		} else {
-			if (!_grow(transaction)) {
+			if (merged == nullptr) {
 				return false;
 			}
+		}
+
+		Slot *current = _slots.load();
+		const int next_slot = _next_slot.load();
+		int i = 0;
+		int j = 0;
+		int n = 0;
+
+		while (i < next_slot || j < count) {
+			if (j == count || (i < next_slot && current[i].param < slots[j].param)) {
+				merged[n++] = current[i++];
+
+			} else {
+				if (i < next_slot && current[i].param == slots[j].param) {
+					i++; // replaced by the new value
+				}
+
+				if (n > 0 && merged[n - 1].param == slots[j].param) {
+					merged[n - 1] = slots[j++]; // duplicate in slots
 
-			_slots.load()[_next_slot++] = {param, value};
-			_sort();
+				} else {
+					merged[n++] = slots[j++];
+				}
+			}
 		}
 
+		_replace(transaction, merged, n_merged, n);
 		return true;
 	}
 
 	bool contains(param_t param) const override
 	{
-		const AtomicTransaction transaction;
-		return _getIndex(param) < _next_slot;
+		param_value_u value;
+		return _find(param, value);
 	}
 
 	px4::AtomicBitset<PARAM_COUNT> containedAsBitset() const override
@@ -103,7 +196,7 @@ public:
 		const AtomicTransaction transaction;
 		Slot *slots = _slots.load();
 
-		for (int i = 0; i < _next_slot; i++) {
+		for (int i = 0; i < _next_slot.load(); i++) {
 			set.set(slots[i].param);
 		}
 
@@ -112,13 +205,10 @@ public:
 
 	param_value_u get(param_t param) const override
 	{
-		const AtomicTransaction transaction;
-		Slot *slots = _slots.load();
-
-		const int index = _getIndex(param);
+		param_value_u value;
 
-		if (index < _next_slot) { // exists in our data structure
-			return slots[index].value;
+		if (_find(param, value)) { // exists in our data structure
+			return value;
 		}
 
 		// Workaround for C++ static initialization bug on SAMV7
@@ -133,13 +223,15 @@ public:
 	void reset(param_t param) override
 	{
 		const AtomicTransaction transaction;
-		int index = _getIndex(param);
 		Slot *slots = _slots.load();
-
-		if (index < _next_slot) {
-			slots[index] = {UINT16_MAX, param_value_u{}};
-			_sort();
-			_next_slot--;
+		const int next_slot = _next_slot.load();
+		const int index = _lowerBound(slots, next_slot, param);
+
+		if (index < next_slot && slots[index].param == param) {
+			_beginWrite();
+			memmove(&slots[index], &slots[index + 1], sizeof(Slot) * (next_slot - index - 1));
+			_next_slot.store(next_slot - 1);
+			_endWrite();
 		}
 	}
 
@@ -150,102 +242,218 @@ public:
 
 	int size() const override
 	{
-		return _next_slot;
+		return _next_slot.load();
 	}
 
 	int byteSize() const override
 	{
-		return _n_slots * sizeof(Slot);
+		return _n_slots.load() * sizeof(Slot);
 	}
 
 private:
-	struct Slot {
-		param_t param;
-		param_value_u value;
+	static constexpr int MAX_READ_RETRIES = 5;
+
+	/**
+	 * Every slot buffer is allocated with this header in front of the slots. It links the buffer into
+	 * the list of retired buffers once it got replaced. The union keeps the slots after it aligned.
+	 */
+	union BufferHeader {
+		BufferHeader *next_retired;
+		Slot alignment;
 	};
 
-	static int _slotCompare(const void *a, const void *b)
+	static Slot *_allocSlots(int n_slots)
 	{
-		return ((int)((Slot *)a)->param) - ((int)((Slot *)b)->param);
+		BufferHeader *header = (BufferHeader *)malloc(sizeof(BufferHeader) + sizeof(Slot) * n_slots);
+
+		if (header == nullptr) {
+			return nullptr;
+		}
+
+		header->next_retired = nullptr;
+		return (Slot *)(header + 1);
 	}
 
-	void _sort()
+	static BufferHeader *_header(Slot *slots) { return ((BufferHeader *)slots) - 1; }
+
+	static void _freeSlots(Slot *slots)
 	{
-		qsort(_slots.load(), _n_slots, sizeof(Slot), _slotCompare);
+		if (slots) {
+			free(_header(slots));
+		}
 	}
 
-	int _getIndex(param_t param) const
+	static void _freeRetired(BufferHeader *retired)
 	{
-		int left = 0;
-		int right = _next_slot - 1;
-		Slot *slots = _slots.load();
+		while (retired) {
+			BufferHeader *next = retired->next_retired;
+			free(retired);
+			retired = next;
+		}
+	}
+
+	static int _slotCompare(const void *a, const void *b)
+	{
+		return ((int)((Slot *)a)->param) - ((int)((Slot *)b)->param);
+	}
 
-		while (left <= right) {
-			int mid = (left + right) / 2;
+	/**
+	 * @return index of the first slot with a parameter >= param
+	 */
+	static int _lowerBound(const Slot *slots, int count, param_t param)
+	{
+		int left = 0;
+		int right = count;
 
-			if (slots[mid].param == param) {
-				return mid;
+		while (left < right) {
+			const int mid = (left + right) / 2;
 
-			} else if (slots[mid].param < param) {
+			if (slots[mid].param < param) {
 				left = mid + 1;
 
 			} else {
-				right = mid - 1;
+				right = mid;
 			}
 		}
 
-		return _next_slot;
+		return left;
 	}
 
-	bool _grow(AtomicTransaction &transaction)
+	bool _lookup(param_t param, param_value_u &value) const
 	{
-		if (_n_slots == 0) {
-			return false;
+		// load the capacity before the buffer: a buffer is published before its capacity,
+		// so the buffer is always at least this large
+		const int n_slots = _n_slots.load();
+		const Slot *slots = _slots.load();
+		const int next_slot = _next_slot.load() < n_slots ? _next_slot.load() : n_slots;
+		const int index = _lowerBound(slots, next_slot, param);
+
+		if (index < next_slot && slots[index].param == param) {
+			value = slots[index].value;
+			return true;
 		}
 
-		int max_retries = 5;
+		return false;
+	}
 
-		// As malloc uses locking, so we need to re-enable IRQ's during malloc/free and
-		// then atomically exchange the buffer
-		while (_next_slot >= _n_slots && max_retries-- > 0) {
-			Slot *previous_slots = nullptr;
-			Slot *new_slots = nullptr;
+	bool _find(param_t param, param_value_u &value) const
+	{
+		// announce the reader before loading the buffer, so that a writer does not free it while in use
+		_active_readers.fetch_add(1);
+		bool found = false;
+		bool done = false;
 
-			do {
-				previous_slots = _slots.load();
-				transaction.unlock();
+		for (int retry = 0; retry < MAX_READ_RETRIES && !done; retry++) {
+			const uint32_t sequence = _sequence.load();
 
-				if (new_slots) {
-					free(new_slots);
-				}
+			if (sequence & 1) {
+				continue; // write in progress
+			}
 
-				new_slots = (Slot *) malloc(sizeof(Slot) * (_n_slots + _n_grow));
-				transaction.lock();
+			found = _lookup(param, value);
 
-				if (new_slots == nullptr) {
-					return false;
-				}
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
 
-			} while (!_slots.compare_exchange(&previous_slots, new_slots));
+			done = (_sequence.load() == sequence);
+		}
 
-			memcpy(new_slots, previous_slots, sizeof(Slot) * _n_slots);
+		if (!done) {
+			// a writer keeps modifying the slots (or got preempted while doing so): wait for it
+			const AtomicTransaction transaction;
+			found = _lookup(param, value);
+		}
 
-			for (int i = _n_slots; i < _n_slots + _n_grow; i++) {
-				new_slots[i] = {UINT16_MAX, param_value_u{}};
-			}
+		_active_readers.fetch_sub(1);
+		return found;
+	}
 
-			_n_slots += _n_grow;
+	void _beginWrite() { _sequence.fetch_add(1); }
+	void _endWrite() { _sequence.fetch_add(1); }
 
+	/**
+	 * Switch to a new slot buffer. The previous buffer is retired instead of freed, as a reader might still use it.
+	 */
+	void _replace(AtomicTransaction &transaction, Slot *slots, int n_slots, int next_slot)
+	{
+		_beginWrite();
+		Slot *previous_slots = _slots.load();
+		_slots.store(slots);
+		_n_slots.store(n_slots);
+		_next_slot.store(next_slot);
+		_endWrite();
+
+		BufferHeader *previous = _header(previous_slots);
+		previous->next_retired = _retired;
+		_retired = previous;
+
+		_collectRetired(transaction);
+	}
+
+	/**
+	 * Free the retired buffers if no reader is active (quiescent point).
+	 * A reader announces itself before loading _slots and a writer checks the readers after publishing
+	 * a new buffer (both sequentially consistent), so a reader that is not counted here can only have
+	 * loaded the current buffer. Otherwise the buffers are kept until a later write finds no reader.
+	 */
+	void _collectRetired(AtomicTransaction &transaction)
+	{
+		if (_retired == nullptr || _active_readers.load() != 0) {
+			return;
+		}
+
+		BufferHeader *retired = _retired;
+		_retired = nullptr;
+
+		// As malloc uses locking, we need to re-enable IRQ's during malloc/free
+		transaction.unlock();
+		_freeRetired(retired);
+		transaction.lock();
+	}
+
+	bool _grow(AtomicTransaction &transaction, int min_slots)
+	{
+		const int n_slots = _n_slots.load();
+
+		if (n_slots == 0) {
+			return false;
+		}
+
+		// grow geometrically, so that adding many parameters does not reallocate each time
+		int n_new = n_slots + ((n_slots / 2 > _n_grow) ? n_slots / 2 : _n_grow);
+
+		if (n_new < min_slots) {
+			n_new = min_slots;
+		}
+
+		// As malloc uses locking, so we need to re-enable IRQ's during malloc/free and
+		// then atomically exchange the buffer
+		transaction.unlock();
+		Slot *new_slots = _allocSlots(n_new);
+		transaction.lock();
+
+		if (new_slots == nullptr) {
+			return false;
+		}
+
+		if (_n_slots.load() != n_slots) {
+			// another writer grew the buffer in the meantime
 			transaction.unlock();
-			free(previous_slots);
+			_freeSlots(new_slots);
 			transaction.lock();
+			return true;
 		}
 
-		return _next_slot < _n_slots;
+		const int next_slot = _next_slot.load();
+		memcpy(new_slots, _slots.load(), sizeof(Slot) * next_slot);
+		_replace(transaction, new_slots, n_new, next_slot);
+		return true;
 	}
 
-	int _next_slot = 0;
-	int _n_slots = 0;
 	const int _n_grow;
 	px4::atomic<Slot *> _slots{nullptr};
+	px4::atomic<int> _n_slots{0};
+	px4::atomic<int> _next_slot{0};
+	px4::atomic<uint32_t> _sequence{0};	///< odd while a writer modifies the slots in place
+	mutable px4::atomic<int> _active_readers{0};	///< readers currently in _find()
+	BufferHeader *_retired{nullptr};	///< replaced slot buffers, freed once no reader is active
 };
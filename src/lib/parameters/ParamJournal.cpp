@@ -0,0 +1,239 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ParamJournal.cpp
+ */
+
+#include "ParamJournal.h"
+
+#include <crc32.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <px4_platform_common/defines.h>
+#include <px4_platform_common/log.h>
+
+ParamJournal::~ParamJournal()
+{
+	close();
+}
+
+uint32_t ParamJournal::recordCrc(const RecordHeader &header, const uint8_t *name)
+{
+	RecordHeader crc_header = header;
+	crc_header.crc = 0;
+
+	const uint32_t crc = crc32part(reinterpret_cast<const uint8_t *>(&crc_header), sizeof(crc_header), 0);
+	return crc32part(name, header.name_length, crc);
+}
+
+int ParamJournal::open(const char *path, replay_callback callback, void *arg)
+{
+	close();
+
+	_fd = ::open(path, O_RDWR | O_CREAT | O_BINARY, PX4_O_MODE_666);
+
+	if (_fd < 0) {
+		return -errno;
+	}
+
+	FileHeader header{};
+	const bool valid_header = (::read(_fd, &header, sizeof(header)) == sizeof(header)) &&
+				  (header.magic == FILE_MAGIC) && (header.version == FILE_VERSION);
+
+	int records = 0;
+
+	if (!valid_header) {
+		header.magic = FILE_MAGIC;
+		header.version = FILE_VERSION;
+		header.reserved = 0;
+
+		if ((ftruncate(_fd, 0) != 0) || (lseek(_fd, 0, SEEK_SET) != 0) ||
+		    (::write(_fd, &header, sizeof(header)) != sizeof(header)) || (fsync(_fd) != 0)) {
+			const int ret = -errno;
+			close();
+			return ret;
+		}
+
+		_size = sizeof(header);
+
+	} else {
+		_size = replay(callback, arg, records);
+
+		// drop a partially written record at the end
+		if ((lseek(_fd, 0, SEEK_END) != (off_t)_size) && (ftruncate(_fd, _size) == 0)) {
+			PX4_WARN("param journal: truncated invalid tail at %" PRIu32, _size);
+			fsync(_fd);
+		}
+	}
+
+	_written = _size;
+	_buffered = 0;
+
+	if (lseek(_fd, _size, SEEK_SET) != (off_t)_size) {
+		const int ret = -errno;
+		close();
+		return ret;
+	}
+
+	return records;
+}
+
+void ParamJournal::close()
+{
+	if (_fd >= 0) {
+		::close(_fd);
+		_fd = -1;
+	}
+
+	_size = 0;
+	_written = 0;
+	_buffered = 0;
+}
+
+uint32_t ParamJournal::replay(replay_callback callback, void *arg, int &records)
+{
+	uint32_t offset = sizeof(FileHeader);
+	RecordHeader header;
+	uint8_t name[NAME_MAX_LENGTH];
+
+	records = 0;
+	lseek(_fd, offset, SEEK_SET);
+
+	while (::read(_fd, &header, sizeof(header)) == sizeof(header)) {
+
+		if ((header.sync != RECORD_SYNC) || (header.type > RecordType::Reset)
+		    || (header.name_length == 0) || (header.name_length > NAME_MAX_LENGTH)) {
+			break;
+		}
+
+		if ((::read(_fd, name, header.name_length) != header.name_length) || (recordCrc(header, name) != header.crc)) {
+			break;
+		}
+
+		if (callback) {
+			Record record{};
+			record.type = header.type;
+			memcpy(record.name, name, header.name_length);
+			record.name[header.name_length] = '\0';
+			memcpy(&record.value, &header.value, sizeof(record.value));
+			callback(record, arg);
+		}
+
+		offset += sizeof(header) + header.name_length;
+		++records;
+	}
+
+	return offset;
+}
+
+int ParamJournal::append(const Record &record)
+{
+	if (_fd < 0) {
+		return -EBADF;
+	}
+
+	const size_t name_length = strnlen(record.name, NAME_MAX_LENGTH + 1);
+
+	if ((name_length == 0) || (name_length > NAME_MAX_LENGTH)) {
+		return -EINVAL;
+	}
+
+	if (_buffered + sizeof(RecordHeader) + name_length > BUFFER_SIZE) {
+		const int ret = flush();
+
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	RecordHeader header{};
+	header.sync = RECORD_SYNC;
+	header.type = record.type;
+	header.name_length = name_length;
+	memcpy(&header.value, &record.value, sizeof(header.value));
+	header.crc = recordCrc(header, reinterpret_cast<const uint8_t *>(record.name));
+
+	memcpy(_buffer + _buffered, &header, sizeof(header));
+	memcpy(_buffer + _buffered + sizeof(header), record.name, name_length);
+	_buffered += sizeof(header) + name_length;
+
+	return 0;
+}
+
+int ParamJournal::flush()
+{
+	if (_buffered == 0) {
+		return 0;
+	}
+
+	if (::write(_fd, _buffer, _buffered) != (ssize_t)_buffered) {
+		return errno ? -errno : -EIO;
+	}
+
+	_written += _buffered;
+	_buffered = 0;
+	return 0;
+}
+
+int ParamJournal::commit()
+{
+	if (_fd < 0) {
+		return -EBADF;
+	}
+
+	int ret = flush();
+
+	if ((ret == 0) && (fsync(_fd) != 0)) {
+		ret = -errno;
+	}
+
+	if (ret != 0) {
+		// drop the records of the failed batch, the file has to end at a record boundary for further appends
+		_buffered = 0;
+
+		if ((ftruncate(_fd, _size) == 0) && (lseek(_fd, _size, SEEK_SET) == (off_t)_size)) {
+			fsync(_fd);
+		}
+
+		_written = _size;
+		return ret;
+	}
+
+	_size = _written;
+	return 0;
+}
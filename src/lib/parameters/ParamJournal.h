@@ -0,0 +1,150 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ParamJournal.h
+ *
+ * Append-only journal of parameter changes on top of the default parameter file.
+ * Instead of rewriting the whole file for every change, small batches of changes are
+ * appended as records keyed by parameter name (handles are not stable across firmware
+ * versions) and replayed after the default file has been imported. The journal is
+ * discarded whenever the full file is rewritten (compaction).
+ *
+ * File layout: FileHeader, followed by records of RecordHeader + name (not terminated).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+
+class ParamJournal
+{
+public:
+	enum class RecordType : uint8_t {
+		SetInt32 = 0,
+		SetFloat = 1,
+		Reset = 2,
+	};
+
+	static constexpr unsigned NAME_MAX_LENGTH{16};
+
+	struct Record {
+		RecordType type;
+		char name[NAME_MAX_LENGTH + 1];
+
+		union {
+			int32_t i;
+			float f;
+		} value;
+	};
+
+	typedef void (*replay_callback)(const Record &record, void *arg);
+
+	ParamJournal() = default;
+	~ParamJournal();
+
+	ParamJournal(const ParamJournal &) = delete;
+	ParamJournal &operator=(const ParamJournal &) = delete;
+
+	/**
+	 * Open or create the journal. Existing records are passed to the callback in order.
+	 * A torn or corrupted tail (e.g. after power loss) is truncated.
+	 * @return number of valid records, <0 on error
+	 */
+	int open(const char *path, replay_callback callback = nullptr, void *arg = nullptr);
+	void close();
+
+	/**
+	 * Add a record, it only becomes persistent with the next commit().
+	 * @return 0 on success, <0 on error
+	 */
+	int append(const Record &record);
+
+	/**
+	 * Write all records appended since the last call and sync the file. On failure the journal
+	 * is truncated back to the last commit, so it never ends in a partial batch.
+	 * @return 0 on success, <0 on error
+	 */
+	int commit();
+
+	bool isOpen() const { return _fd >= 0; }
+
+	/** @return committed file size in bytes */
+	uint32_t size() const { return _size; }
+
+	/** Upper bound of the size of a single record in bytes */
+	static constexpr uint32_t MAX_RECORD_SIZE{12 + NAME_MAX_LENGTH};
+
+	/** Journal size above which changes are no longer appended, but the default file is rewritten */
+	static constexpr uint32_t MAX_SIZE{4096};
+
+private:
+	struct FileHeader {
+		uint32_t magic;
+		uint16_t version;
+		uint16_t reserved;
+	};
+
+	struct RecordHeader {
+		uint8_t sync;
+		RecordType type;
+		uint8_t name_length;
+		uint8_t reserved;
+		uint32_t value;
+		uint32_t crc;	///< over the header (with crc = 0) and name
+	};
+
+	static_assert(sizeof(FileHeader) == 8, "unexpected FileHeader size");
+	static_assert(sizeof(RecordHeader) + NAME_MAX_LENGTH == MAX_RECORD_SIZE, "unexpected RecordHeader size");
+
+	static constexpr uint32_t FILE_MAGIC{0x4c4e4a50};	// "PJNL"
+	static constexpr uint16_t FILE_VERSION{1};
+	static constexpr uint8_t RECORD_SYNC{0xa5};
+	static constexpr unsigned BUFFER_SIZE{256};
+
+	static uint32_t recordCrc(const RecordHeader &header, const uint8_t *name);
+
+	/* read all valid records, returns the end of the last one */
+	uint32_t replay(replay_callback callback, void *arg, int &records);
+
+	/* write out the buffered records without syncing */
+	int flush();
+
+	int _fd{-1};
+	uint32_t _size{0};	///< end of the last committed record
+	uint32_t _written{0};	///< end of the last record written to the file
+
+	uint8_t _buffer[BUFFER_SIZE];
+	unsigned _buffered{0};
+};
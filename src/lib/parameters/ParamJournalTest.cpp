@@ -0,0 +1,199 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test for ParamJournal
+ */
+
+#include <gtest/gtest.h>
+#include "ParamJournal.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+namespace
+{
+
+constexpr char journal_path[] = "param_journal_test";
+
+struct Replayed {
+	ParamJournal::Record records[8];
+	int count{0};
+};
+
+void replayCallback(const ParamJournal::Record &record, void *arg)
+{
+	Replayed *replayed = static_cast<Replayed *>(arg);
+
+	if (replayed->count < 8) {
+		replayed->records[replayed->count++] = record;
+	}
+}
+
+ParamJournal::Record makeRecord(ParamJournal::RecordType type, const char *name, int32_t value)
+{
+	ParamJournal::Record record{};
+	record.type = type;
+	strncpy(record.name, name, sizeof(record.name) - 1);
+	record.value.i = value;
+	return record;
+}
+
+class ParamJournalTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		unlink(journal_path);
+		ASSERT_EQ(_journal.open(journal_path), 0);
+	}
+
+	void TearDown() override
+	{
+		_journal.close();
+		unlink(journal_path);
+	}
+
+	ParamJournal _journal;
+};
+
+} // namespace
+
+TEST_F(ParamJournalTest, AppendReplay)
+{
+	ParamJournal::Record record = makeRecord(ParamJournal::RecordType::SetFloat, "MPC_XY_VEL_MAX", 0);
+	record.value.f = 12.5f;
+
+	ASSERT_EQ(_journal.append(makeRecord(ParamJournal::RecordType::SetInt32, "SYS_AUTOSTART", 4001)), 0);
+	ASSERT_EQ(_journal.append(record), 0);
+	ASSERT_EQ(_journal.append(makeRecord(ParamJournal::RecordType::Reset, "CAL_ACC0_ID", 0)), 0);
+	ASSERT_EQ(_journal.commit(), 0);
+
+	// empty names and names longer than a parameter name are rejected
+	ParamJournal::Record invalid = makeRecord(ParamJournal::RecordType::Reset, "", 0);
+	EXPECT_LT(_journal.append(invalid), 0);
+	memset(invalid.name, 'A', sizeof(invalid.name));
+	EXPECT_LT(_journal.append(invalid), 0);
+
+	// a record is a lot smaller than a full parameter file
+	EXPECT_LE(_journal.size(), 8 + 3 * ParamJournal::MAX_RECORD_SIZE);
+	_journal.close();
+
+	Replayed replayed;
+	ASSERT_EQ(_journal.open(journal_path, replayCallback, &replayed), 3);
+	ASSERT_EQ(replayed.count, 3);
+
+	EXPECT_EQ(replayed.records[0].type, ParamJournal::RecordType::SetInt32);
+	EXPECT_STREQ(replayed.records[0].name, "SYS_AUTOSTART");
+	EXPECT_EQ(replayed.records[0].value.i, 4001);
+
+	EXPECT_EQ(replayed.records[1].type, ParamJournal::RecordType::SetFloat);
+	EXPECT_STREQ(replayed.records[1].name, "MPC_XY_VEL_MAX");
+	EXPECT_FLOAT_EQ(replayed.records[1].value.f, 12.5f);
+
+	EXPECT_EQ(replayed.records[2].type, ParamJournal::RecordType::Reset);
+	EXPECT_STREQ(replayed.records[2].name, "CAL_ACC0_ID");
+}
+
+TEST_F(ParamJournalTest, TornTail)
+{
+	ASSERT_EQ(_journal.append(makeRecord(ParamJournal::RecordType::SetInt32, "SYS_AUTOSTART", 4001)), 0);
+	ASSERT_EQ(_journal.commit(), 0);
+	const uint32_t committed_size = _journal.size();
+
+	ASSERT_EQ(_journal.append(makeRecord(ParamJournal::RecordType::SetInt32, "COM_RC_IN_MODE", 1)), 0);
+	ASSERT_EQ(_journal.commit(), 0);
+	const uint32_t full_size = _journal.size();
+	_journal.close();
+
+	// simulate a power loss at every byte of the last record
+	for (uint32_t size = committed_size; size < full_size; ++size) {
+		ASSERT_EQ(truncate(journal_path, size), 0);
+
+		Replayed replayed;
+		ASSERT_EQ(_journal.open(journal_path, replayCallback, &replayed), 1);
+		EXPECT_EQ(_journal.size(), committed_size);
+		EXPECT_STREQ(replayed.records[0].name, "SYS_AUTOSTART");
+
+		// appending continues after the last valid record
+		ASSERT_EQ(_journal.append(makeRecord(ParamJournal::RecordType::SetInt32, "COM_RC_IN_MODE", 1)), 0);
+		ASSERT_EQ(_journal.commit(), 0);
+		EXPECT_EQ(_journal.size(), full_size);
+		_journal.close();
+	}
+
+	Replayed replayed;
+	ASSERT_EQ(_journal.open(journal_path, replayCallback, &replayed), 2);
+	EXPECT_STREQ(replayed.records[1].name, "COM_RC_IN_MODE");
+	EXPECT_EQ(replayed.records[1].value.i, 1);
+}
+
+TEST_F(ParamJournalTest, CorruptRecord)
+{
+	ASSERT_EQ(_journal.append(makeRecord(ParamJournal::RecordType::SetInt32, "SYS_AUTOSTART", 4001)), 0);
+	ASSERT_EQ(_journal.append(makeRecord(ParamJournal::RecordType::SetInt32, "COM_RC_IN_MODE", 1)), 0);
+	ASSERT_EQ(_journal.commit(), 0);
+	_journal.close();
+
+	// flip a bit in the value of the first record: it and everything after it is dropped
+	int fd = open(journal_path, O_RDWR);
+	ASSERT_GE(fd, 0);
+	uint8_t byte = 0;
+	ASSERT_EQ(pread(fd, &byte, 1, 8 + 4), 1);
+	byte ^= 0x01;
+	ASSERT_EQ(pwrite(fd, &byte, 1, 8 + 4), 1);
+	close(fd);
+
+	Replayed replayed;
+	ASSERT_EQ(_journal.open(journal_path, replayCallback, &replayed), 0);
+	EXPECT_EQ(replayed.count, 0);
+	EXPECT_EQ(_journal.size(), 8u);
+}
+
+TEST_F(ParamJournalTest, InvalidHeader)
+{
+	_journal.close();
+
+	int fd = open(journal_path, O_WRONLY | O_TRUNC);
+	ASSERT_GE(fd, 0);
+	const char garbage[] = "not a journal";
+	ASSERT_EQ(write(fd, garbage, sizeof(garbage)), (ssize_t)sizeof(garbage));
+	close(fd);
+
+	// the file is reinitialized
+	ASSERT_EQ(_journal.open(journal_path), 0);
+	EXPECT_EQ(_journal.size(), 8u);
+	ASSERT_EQ(_journal.append(makeRecord(ParamJournal::RecordType::Reset, "SYS_AUTOSTART", 0)), 0);
+	EXPECT_EQ(_journal.commit(), 0);
+}
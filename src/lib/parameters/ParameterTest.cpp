@@ -32,12 +32,26 @@
  ****************************************************************************/
 
 #include <px4_platform_common/module_params.h>
+#include <px4_platform_common/px4_config.h>
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/obstacle_distance.h>
 #include <uORB/uORBManager.hpp>
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ConstLayer.h"
+#include "DynamicSparseLayer.h"
+#if defined(CONFIG_PARAM_JOURNAL)
+#include "ParamJournal.h"
+#endif
+
 class ParameterTest : public ::testing::Test
 {
 public:
@@ -49,6 +63,25 @@ public:
 };
 
 
+class ChangeSetParams : public ModuleParams
+{
+public:
+	ChangeSetParams() : ModuleParams(nullptr) {}
+
+	void update() { updateParams(); }
+
+	float dist() const { return _param_cp_dist.get(); }
+	float delay() const { return _param_cp_delay.get(); }
+
+	void setDelayLocally(float delay) { _param_cp_delay.set(delay); }
+
+private:
+	DEFINE_PARAMETERS(
+		(ParamFloat<px4::params::CP_DIST>) _param_cp_dist,
+		(ParamFloat<px4::params::CP_DELAY>) _param_cp_delay
+	)
+};
+
 TEST_F(ParameterTest, testParamReadWrite)
 {
 	// GIVEN a parameter handle
@@ -106,3 +139,347 @@ TEST_F(ParameterTest, testUorbSendReceive)
 	// AND: all the bytes should be equal
 	EXPECT_EQ(0, memcmp(&message, &obstacle_distance, sizeof(message)));
 }
+
+TEST_F(ParameterTest, testParamChangesSince)
+{
+	// GIVEN: the current parameter generation
+	const uint32_t generation = param_generation();
+	param_changes_t changes{};
+
+	// WHEN: nothing changed
+	param_changes_since(generation, &changes);
+
+	// THEN: the change set is empty
+	EXPECT_EQ(generation, changes.generation);
+	EXPECT_EQ(0, changes.count);
+	EXPECT_FALSE(changes.all);
+
+	// WHEN: we set a parameter to its current value and another one to a new value
+	float value = -1.f;
+	param_set(param_handle(px4::params::CP_DIST), &value);
+	value = 1.5f;
+	param_set_no_notification(param_handle(px4::params::CP_DELAY), &value);
+
+	// THEN: only the one that actually changed is in the change set
+	param_changes_since(generation, &changes);
+	EXPECT_EQ(generation + 1, changes.generation);
+	ASSERT_EQ(1, changes.count);
+	EXPECT_EQ(param_handle(px4::params::CP_DELAY), changes.params[0]);
+	EXPECT_FALSE(changes.all);
+
+	// WHEN: more parameters changed than the change log holds
+	for (int i = 0; i <= PARAM_CHANGES_MAX; i++) {
+		value = 2.f + i;
+		param_set_no_notification(param_handle(px4::params::CP_DIST), &value);
+	}
+
+	// THEN: every parameter has to be considered changed
+	param_changes_since(generation, &changes);
+	EXPECT_TRUE(changes.all);
+}
+
+TEST_F(ParameterTest, testModuleParamsChangeSet)
+{
+	// GIVEN: a module with parameters
+	ChangeSetParams module_params;
+	EXPECT_FLOAT_EQ(-1.f, module_params.dist());
+	EXPECT_FLOAT_EQ(0.4f, module_params.delay());
+
+	// AND: a parameter value that was modified locally (e.g. clamped by the module)
+	module_params.setDelayLocally(0.8f);
+
+	// WHEN: another parameter changes and the module updates its parameters
+	float value = 5.f;
+	param_set(param_handle(px4::params::CP_DIST), &value);
+	module_params.update();
+
+	// THEN: the changed parameter is read again and the local modification is replaced by the stored value
+	EXPECT_FLOAT_EQ(5.f, module_params.dist());
+	EXPECT_FLOAT_EQ(0.4f, module_params.delay());
+
+	// WHEN: the other parameter changes as well
+	value = 0.6f;
+	param_set(param_handle(px4::params::CP_DELAY), &value);
+	module_params.update();
+
+	// THEN: both are up to date
+	EXPECT_FLOAT_EQ(5.f, module_params.dist());
+	EXPECT_FLOAT_EQ(0.6f, module_params.delay());
+
+	// WHEN: all parameters are reset
+	param_reset_all();
+	module_params.update();
+
+	// THEN: the defaults are read again
+	EXPECT_FLOAT_EQ(-1.f, module_params.dist());
+	EXPECT_FLOAT_EQ(0.4f, module_params.delay());
+}
+
+TEST_F(ParameterTest, testDynamicSparseLayer)
+{
+	// GIVEN: a layer that starts with 2 slots and has to grow
+	ConstLayer defaults;
+	DynamicSparseLayer layer{&defaults, 2, 1};
+
+	// WHEN: we store parameters in descending order
+	for (int i = 9; i >= 0; i--) {
+		param_value_u value{};
+		value.i = 100 + i;
+		EXPECT_TRUE(layer.store(i, value));
+	}
+
+	// THEN: all can be read back
+	EXPECT_EQ(10, layer.size());
+
+	for (int i = 0; i < 10; i++) {
+		EXPECT_TRUE(layer.contains(i));
+		EXPECT_EQ(100 + i, layer.get(i).i);
+	}
+
+	// WHEN: we reset one in the middle
+	layer.reset(4);
+
+	// THEN: it falls through to the parent while the others are unchanged
+	EXPECT_EQ(9, layer.size());
+	EXPECT_FALSE(layer.contains(4));
+	EXPECT_EQ(defaults.get(4).i, layer.get(4).i);
+	EXPECT_EQ(105, layer.get(5).i);
+
+	// WHEN: we store several unsorted parameters at once, overlapping with existing ones
+	DynamicSparseLayer::Slot slots[4] {};
+	const param_t params[4] {12, 4, 2, 11};
+
+	for (int i = 0; i < 4; i++) {
+		slots[i].param = params[i];
+		slots[i].value.i = 200 + params[i];
+	}
+
+	EXPECT_TRUE(layer.storeMultiple(slots, 4));
+
+	// THEN: new ones are added and existing ones replaced
+	EXPECT_EQ(12, layer.size());
+	EXPECT_EQ(202, layer.get(2).i);
+	EXPECT_EQ(204, layer.get(4).i);
+	EXPECT_EQ(211, layer.get(11).i);
+	EXPECT_EQ(212, layer.get(12).i);
+	EXPECT_EQ(103, layer.get(3).i);
+	EXPECT_EQ(109, layer.get(9).i);
+
+	// AND: the slots are still sorted, so single stores keep working
+	param_value_u value{};
+	value.i = 310;
+	EXPECT_TRUE(layer.store(10, value));
+	EXPECT_EQ(13, layer.size());
+	EXPECT_EQ(310, layer.get(10).i);
+	EXPECT_EQ(211, layer.get(11).i);
+}
+
+TEST_F(ParameterTest, testDynamicSparseLayerConcurrentReallocation)
+{
+	// GIVEN: a layer that is read concurrently by another thread
+	ConstLayer defaults;
+	DynamicSparseLayer layer{&defaults, 2, 1};
+	std::atomic<bool> stop{false};
+	std::atomic<int> mismatches{0};
+
+	std::thread reader([&]() {
+		while (!stop.load()) {
+			for (param_t i = 0; i < 64; i++) {
+				if (layer.contains(i) && layer.get(i).i != (int32_t)i) {
+					mismatches++;
+				}
+			}
+		}
+	});
+
+	// WHEN: every bulk store replaces the slot buffer while the reader might still use the previous ones
+	DynamicSparseLayer::Slot slots[64] {};
+
+	for (int round = 0; round < 500; round++) {
+		for (int i = 0; i < 64; i++) {
+			slots[i].param = i;
+			slots[i].value.i = i;
+		}
+
+		EXPECT_TRUE(layer.storeMultiple(slots, 1 + round % 64));
+	}
+
+	stop.store(true);
+	reader.join();
+
+	// THEN: the reader always saw consistent values (and never read freed memory, checked when run with ASan)
+	EXPECT_EQ(0, mismatches.load());
+	EXPECT_EQ(64, layer.size());
+}
+
+TEST_F(ParameterTest, testImport)
+{
+	static constexpr const char *FILENAME = "parameter_test_import.bson";
+
+	// GIVEN: an exported parameter file with two changed parameters
+	float dist = 3.f;
+	float delay = 0.7f;
+	param_set(param_handle(px4::params::CP_DIST), &dist);
+	param_set(param_handle(px4::params::CP_DELAY), &delay);
+	unlink(FILENAME);
+	ASSERT_EQ(0, param_export(FILENAME, nullptr));
+
+	// WHEN: we reset all parameters and import the file
+	param_reset_all();
+	const uint32_t generation = param_generation();
+
+	int fd = open(FILENAME, O_RDONLY);
+	ASSERT_GE(fd, 0);
+	EXPECT_EQ(0, param_import(fd));
+	close(fd);
+	unlink(FILENAME);
+
+	// THEN: the values are restored and marked as saved
+	float value = 0.f;
+	param_get(param_handle(px4::params::CP_DIST), &value);
+	EXPECT_FLOAT_EQ(dist, value);
+	param_get(param_handle(px4::params::CP_DELAY), &value);
+	EXPECT_FLOAT_EQ(delay, value);
+	EXPECT_FALSE(param_value_unsaved(param_handle(px4::params::CP_DIST)));
+
+	// AND: both show up as changed
+	param_changes_t changes{};
+	param_changes_since(generation, &changes);
+	EXPECT_FALSE(changes.all);
+	EXPECT_EQ(2, changes.count);
+}
+
+#if defined(CONFIG_PARAM_JOURNAL)
+static off_t fileSize(const char *path)
+{
+	struct stat st;
+	return (stat(path, &st) == 0) ? st.st_size : -1;
+}
+
+TEST_F(ParameterTest, testJournal)
+{
+	static constexpr const char *FILENAME = "parameter_test_journal.bson";
+	static constexpr const char *JOURNAL = "parameter_test_journal.bson.jnl";
+
+	char *default_file = param_get_default_file() ? strdup(param_get_default_file()) : nullptr;
+	unlink(FILENAME);
+	unlink(JOURNAL);
+	ASSERT_EQ(0, param_set_default_file(FILENAME));
+
+	// GIVEN: a parameter file written by a full save
+	float dist = 3.f;
+	param_set(param_handle(px4::params::CP_DIST), &dist);
+	ASSERT_EQ(0, param_save_default(true));
+	const off_t file_size = fileSize(FILENAME);
+	EXPECT_GT(file_size, 0);
+	EXPECT_EQ(-1, fileSize(JOURNAL));
+
+	// WHEN: autosaving a single change and a reset
+	float delay = 0.7f;
+	param_set(param_handle(px4::params::CP_DELAY), &delay);
+	EXPECT_EQ(0, param_save_default(false));
+	const off_t journal_size = fileSize(JOURNAL);
+
+	param_reset(param_handle(px4::params::CP_DIST));
+	EXPECT_EQ(0, param_save_default(false));
+
+	// THEN: only a record per change is appended, the file is not rewritten
+	EXPECT_EQ(file_size, fileSize(FILENAME));
+	EXPECT_LE(fileSize(JOURNAL) - journal_size, (off_t)ParamJournal::MAX_RECORD_SIZE);
+	EXPECT_FALSE(param_value_unsaved(param_handle(px4::params::CP_DELAY)));
+
+	// AND: loading replays the journal on top of the file
+	param_reset_all();
+	EXPECT_EQ(0, param_load_default());
+	float value = 0.f;
+	param_get(param_handle(px4::params::CP_DELAY), &value);
+	EXPECT_FLOAT_EQ(delay, value);
+	EXPECT_TRUE(param_value_is_default(param_handle(px4::params::CP_DIST)));
+
+	// WHEN: power is lost while writing the last record
+	ASSERT_EQ(0, truncate(JOURNAL, fileSize(JOURNAL) - 3));
+	param_reset_all();
+	EXPECT_EQ(0, param_load_default());
+
+	// THEN: all complete records are applied and the torn one is dropped
+	param_get(param_handle(px4::params::CP_DELAY), &value);
+	EXPECT_FLOAT_EQ(delay, value);
+	param_get(param_handle(px4::params::CP_DIST), &value);
+	EXPECT_FLOAT_EQ(dist, value);
+	EXPECT_EQ(journal_size, fileSize(JOURNAL));
+
+	// WHEN: saving explicitly
+	EXPECT_EQ(0, param_save_default(true));
+
+	// THEN: the journal is folded into the file
+	EXPECT_EQ(-1, fileSize(JOURNAL));
+	param_reset_all();
+	EXPECT_EQ(0, param_load_default());
+	param_get(param_handle(px4::params::CP_DELAY), &value);
+	EXPECT_FLOAT_EQ(delay, value);
+
+	unlink(FILENAME);
+	unlink(JOURNAL);
+	param_set_default_file(default_file);
+	free(default_file);
+}
+
+TEST_F(ParameterTest, testJournalUserChangesAndBackup)
+{
+	static constexpr const char *FILENAME = "parameter_test_journal_base.bson";
+	static constexpr const char *BACKUP = "parameter_test_journal_backup.bson";
+	static constexpr const char *JOURNAL = "parameter_test_journal_base.bson.jnl";
+
+	char *default_file = param_get_default_file() ? strdup(param_get_default_file()) : nullptr;
+	char *backup_file = param_get_backup_file() ? strdup(param_get_backup_file()) : nullptr;
+	unlink(FILENAME);
+	unlink(BACKUP);
+	unlink(JOURNAL);
+	ASSERT_EQ(0, param_set_default_file(FILENAME));
+	ASSERT_EQ(0, param_set_backup_file(BACKUP));
+
+	// GIVEN: a parameter and backup file written by a full save
+	ASSERT_EQ(0, param_save_default(true));
+	EXPECT_GT(fileSize(BACKUP), 0);
+
+	// WHEN: a default value changes (e.g. airframe defaults) and an autosave runs
+	float default_delay = 0.f;
+	param_get_default_value(param_handle(px4::params::CP_DELAY), &default_delay);
+	const float airframe_delay = 0.9f;
+	param_set_default_value(param_handle(px4::params::CP_DELAY), &airframe_delay);
+	EXPECT_EQ(0, param_save_default(false));
+
+	// THEN: nothing is journaled, defaults are not stored in the file
+	EXPECT_EQ(-1, fileSize(JOURNAL));
+	param_set_default_value(param_handle(px4::params::CP_DELAY), &default_delay);
+
+	// WHEN: a user change is autosaved and the default file gets lost
+	float dist = 4.f;
+	param_set(param_handle(px4::params::CP_DIST), &dist);
+	EXPECT_EQ(0, param_save_default(false));
+	EXPECT_GT(fileSize(JOURNAL), 0);
+	unlink(FILENAME);
+
+	// AND: the backup file is imported instead
+	param_reset_all();
+	int fd = open(BACKUP, O_RDONLY);
+	ASSERT_GE(fd, 0);
+	EXPECT_EQ(0, param_import(fd));
+	close(fd);
+	param_replay_journal();
+
+	// THEN: the journal is replayed on top of the backup
+	float value = 0.f;
+	param_get(param_handle(px4::params::CP_DIST), &value);
+	EXPECT_FLOAT_EQ(dist, value);
+	EXPECT_GT(fileSize(JOURNAL), 0);
+
+	unlink(FILENAME);
+	unlink(BACKUP);
+	unlink(JOURNAL);
+	param_set_default_file(default_file);
+	param_set_backup_file(backup_file);
+	free(default_file);
+	free(backup_file);
+}
+#endif // CONFIG_PARAM_JOURNAL
@@ -285,6 +285,36 @@ __EXPORT int		param_set_no_remote_update(param_t param, const void *val, bool no
  */
 __EXPORT void		param_notify_changes(void);
 
+/**
+ * Number of parameter value changes kept in the change log (see param_changes_since()).
+ */
+#define PARAM_CHANGES_MAX		16
+
+/**
+ * Set of parameters that changed since a given generation.
+ */
+typedef struct {
+	uint32_t	generation;			/**< current generation, pass this to the next param_changes_since() call */
+	uint8_t		count;				/**< number of entries in params (may contain duplicates) */
+	bool		all;				/**< the change log does not reach back far enough, any parameter may have changed */
+	param_t		params[PARAM_CHANGES_MAX];
+} param_changes_t;
+
+/**
+ * Get the current parameter generation. It is incremented with every change of a parameter value
+ * (set, reset or changed default), regardless of whether the change is notified.
+ */
+__EXPORT uint32_t	param_generation(void);
+
+/**
+ * Get the parameters that changed since a generation. This allows a user to only refresh the
+ * parameters that actually changed instead of reading all of them on every parameter update.
+ *
+ * @param generation	Generation returned by param_generation() or by a previous call.
+ * @param changes	Filled with the changed parameters and the current generation.
+ */
+__EXPORT void		param_changes_since(uint32_t generation, param_changes_t *changes);
+
 /**
  * Reset a parameter to its default value.
  *
@@ -431,6 +461,17 @@ __EXPORT int 		param_save_default(bool blocking);
  */
 __EXPORT int 		param_load_default(void);
 
+/**
+ * Apply the changes journaled by autosaves on top of the default parameter file.
+ *
+ * Autosaves of a few changed parameters only append them to a journal next to the default
+ * file (if CONFIG_PARAM_JOURNAL is enabled), so this has to be called after importing the
+ * default file. param_load_default() already does it.
+ *
+ * @return		Number of replayed changes, <0 on error.
+ */
+__EXPORT int 		param_replay_journal(void);
+
 /**
  * Generate the hash of all parameters and their values
  *
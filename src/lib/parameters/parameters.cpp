@@ -55,6 +55,7 @@
 #include <drivers/drv_hrt.h>
 #include <lib/perf/perf_counter.h>
 #include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/atomic.h>
 #include <px4_platform_common/atomic_bitset.h>
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/posix.h>
@@ -94,11 +95,27 @@ inline static int flash_param_import() { return -1; }
 static char *param_default_file = nullptr;
 static char *param_backup_file = nullptr;
 
+#if defined(CONFIG_PARAM_JOURNAL)
+#include "ParamJournal.h"
+static char *param_journal_file = nullptr;
+static bool param_journal_base_valid = false; ///< the default file holds the state the journal applies to
+
+/** autosaves with more changed parameters than this rewrite the default file */
+static constexpr size_t PARAM_JOURNAL_MAX_RECORDS = 32;
+#endif
+
 #include "autosave.h"
 static ParamAutosave *autosave_instance {nullptr};
 
 static px4::AtomicBitset<param_info_count> params_active;  // params found
 static px4::AtomicBitset<param_info_count> params_unsaved;
+#if defined(CONFIG_PARAM_JOURNAL)
+static px4::AtomicBitset<param_info_count> params_journal_pending; ///< set or reset by the user since written to the journal or default file
+#endif
+
+/** change log: the parameter of the value change with generation g is stored at g % PARAM_CHANGES_MAX */
+static param_t param_change_log[PARAM_CHANGES_MAX];
+static px4::atomic<uint32_t> param_change_generation{0};
 
 static ConstLayer firmware_defaults;
 static DynamicSparseLayer runtime_defaults{&firmware_defaults};
@@ -118,6 +135,9 @@ static perf_counter_t param_set_perf;
 static pthread_mutex_t file_mutex  =
 	PTHREAD_MUTEX_INITIALIZER; ///< this protects against concurrent param saves (file or flash access).
 
+static pthread_mutex_t import_mutex =
+	PTHREAD_MUTEX_INITIALIZER; ///< protects the import staging buffer against concurrent imports.
+
 // Support for remote parameter node
 #if defined(CONFIG_PARAM_PRIMARY)
 # include "parameters_primary.h"
@@ -179,6 +199,38 @@ param_notify_changes()
 #endif
 }
 
+static void
+param_record_change(param_t param)
+{
+	const AtomicTransaction transaction;
+	const uint32_t generation = param_change_generation.load();
+	param_change_log[generation % PARAM_CHANGES_MAX] = param;
+	param_change_generation.store(generation + 1);
+}
+
+uint32_t
+param_generation()
+{
+	return param_change_generation.load();
+}
+
+void
+param_changes_since(uint32_t generation, param_changes_t *changes)
+{
+	const AtomicTransaction transaction;
+	const uint32_t current = param_change_generation.load();
+
+	changes->generation = current;
+	changes->count = 0;
+	changes->all = (current - generation) > PARAM_CHANGES_MAX;
+
+	if (!changes->all) {
+		for (uint32_t g = generation; g != current; g++) {
+			changes->params[changes->count++] = param_change_log[g % PARAM_CHANGES_MAX];
+		}
+	}
+}
+
 static param_t param_find_internal(const char *name, bool notification)
 {
 	perf_count(param_find_perf);
@@ -439,6 +491,13 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 
 	if (user_config.store(param, new_value)) {
 		params_unsaved.set(param, !mark_saved);
+#if defined(CONFIG_PARAM_JOURNAL)
+
+		if (!mark_saved) {
+			params_journal_pending.set(param);
+		}
+
+#endif
 		result = PX4_OK;
 
 	} else {
@@ -446,8 +505,12 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 		result = PX4_ERROR;
 	}
 
-	if ((result == PX4_OK) && param_changed && !mark_saved) { // this is false when importing parameters
-		param_autosave();
+	if ((result == PX4_OK) && param_changed) {
+		param_record_change(param);
+
+		if (!mark_saved) { // this is false when importing parameters
+			param_autosave();
+		}
 	}
 
 	// If this is the parameter server, make sure that the remote is updated
@@ -600,6 +663,11 @@ int param_set_default_value(param_t param, const void *val)
 	}
 
 
+	if (result == PX4_OK) {
+		// the value changes unless the parameter is set in the user config
+		param_record_change(param);
+	}
+
 	if ((result == PX4_OK) && param_used(param)) {
 		// send notification if param is already in use
 		param_notify_changes();
@@ -619,6 +687,14 @@ static int param_reset_internal(param_t param, bool notify = true, bool autosave
 
 	if (handle_in_range(param)) {
 		user_config.reset(param);
+
+		if (param_found) {
+			param_record_change(param);
+#if defined(CONFIG_PARAM_JOURNAL)
+			// the reset has to be persisted (replaying the journal clears this again)
+			params_journal_pending.set(param);
+#endif
+		}
 	}
 
 	if (autosave) {
@@ -741,6 +817,21 @@ param_set_default_file(const char *filename)
 		param_default_file = strdup(filename);
 	}
 
+#if defined(CONFIG_PARAM_JOURNAL)
+	free(param_journal_file);
+	param_journal_file = nullptr;
+	param_journal_base_valid = false;
+
+	if (param_default_file) {
+		const size_t length = strlen(param_default_file) + sizeof(".jnl");
+		param_journal_file = (char *)malloc(length);
+
+		if (param_journal_file) {
+			snprintf(param_journal_file, length, "%s.jnl", param_default_file);
+		}
+	}
+
+#endif /* CONFIG_PARAM_JOURNAL */
 #endif /* FLASH_BASED_PARAMS */
 
 	return 0;
@@ -753,7 +844,7 @@ const char *param_get_default_file()
 
 int param_set_backup_file(const char *filename)
 {
-	if (param_default_file && strcmp(filename, param_default_file) == 0) {
+	if (filename && param_default_file && strcmp(filename, param_default_file) == 0) {
 		PX4_ERR("backup file can't be the same as the default file %s", filename);
 		return PX4_ERROR;
 	}
@@ -782,6 +873,147 @@ const char *param_get_backup_file()
 static int param_export_internal(int fd, param_filter_func filter);
 static int param_verify(int fd);
 
+#if defined(CONFIG_PARAM_JOURNAL)
+/**
+ * Append the pending parameter changes to the journal. Requires the file lock.
+ * @param compacting the default file is about to be rewritten, skip the journal size limit
+ * @return PX4_OK if all pending changes are persisted in the journal
+ */
+static int param_journal_append(bool compacting)
+{
+	if ((param_journal_file == nullptr) || !param_journal_base_valid) {
+		return PX4_ERROR;
+	}
+
+	const size_t pending = params_journal_pending.count();
+
+	if (pending == 0) {
+		return PX4_OK;
+
+	} else if (pending > PARAM_JOURNAL_MAX_RECORDS) {
+		return PX4_ERROR;
+	}
+
+	ParamJournal journal;
+
+	if (journal.open(param_journal_file) < 0) {
+		return PX4_ERROR;
+	}
+
+	if (!compacting && (journal.size() + pending * ParamJournal::MAX_RECORD_SIZE > ParamJournal::MAX_SIZE)) {
+		return PX4_ERROR;
+	}
+
+	px4::Bitset<param_info_count> journaled;
+	int ret = PX4_OK;
+
+	for (param_t param = 0; handle_in_range(param) && (ret == PX4_OK); param++) {
+		if (!params_journal_pending[param]) {
+			continue;
+		}
+
+		if (strlen(param_name(param)) > ParamJournal::NAME_MAX_LENGTH) {
+			// not representable in the journal, the default file is rewritten instead
+			return PX4_ERROR;
+		}
+
+		// clear before reading the value, a concurrent change marks the parameter pending again
+		params_journal_pending.set(param, false);
+
+		ParamJournal::Record record{};
+		strncpy(record.name, param_name(param), sizeof(record.name) - 1);
+
+		{
+			const AtomicTransaction transaction;
+
+			if (user_config.contains(param)) {
+				const param_value_u value = user_config.get(param);
+				record.type = (param_type(param) == PARAM_TYPE_FLOAT) ? ParamJournal::RecordType::SetFloat :
+					      ParamJournal::RecordType::SetInt32;
+				memcpy(&record.value, &value, sizeof(record.value));
+
+			} else {
+				record.type = ParamJournal::RecordType::Reset;
+			}
+		}
+
+		ret = journal.append(record);
+		journaled.set(param);
+	}
+
+	if (ret == PX4_OK) {
+		ret = journal.commit();
+	}
+
+	if (ret != PX4_OK) {
+		PX4_ERR("param journal append failed (%d)", ret);
+		return PX4_ERROR;
+	}
+
+	for (param_t param = 0; handle_in_range(param); param++) {
+		if (journaled[param]) {
+			params_unsaved.set(param, false);
+		}
+	}
+
+	return PX4_OK;
+}
+
+/**
+ * Prepare rewriting the default file. At any time the journal has to describe the changes on top
+ * of the default file, so it either receives the pending changes or is removed beforehand.
+ */
+static void param_journal_begin_compaction()
+{
+	if ((param_journal_append(true) != PX4_OK) && param_journal_file) {
+		unlink(param_journal_file);
+	}
+
+	param_journal_base_valid = false;
+
+	// from here on all changes are either written to the default file or marked pending again
+	params_journal_pending.reset();
+}
+
+static void param_journal_end_compaction(bool success)
+{
+	if (success && param_journal_file) {
+		unlink(param_journal_file);
+		param_journal_base_valid = true;
+	}
+}
+
+static void param_journal_replay_callback(const ParamJournal::Record &record, void *arg)
+{
+	const param_t param = param_find_no_notification(record.name);
+
+	if (param == PARAM_INVALID) {
+		PX4_DEBUG("param journal: %s not found", record.name);
+		return;
+	}
+
+	switch (record.type) {
+	case ParamJournal::RecordType::SetInt32:
+		if (param_type(param) == PARAM_TYPE_INT32) {
+			param_set_internal(param, &record.value.i, true, false);
+		}
+
+		break;
+
+	case ParamJournal::RecordType::SetFloat:
+		if (param_type(param) == PARAM_TYPE_FLOAT) {
+			param_set_internal(param, &record.value.f, true, false);
+		}
+
+		break;
+
+	case ParamJournal::RecordType::Reset:
+		param_reset_internal(param, false, false);
+		break;
+	}
+}
+#endif /* CONFIG_PARAM_JOURNAL */
+
 int param_save_default(bool blocking)
 {
 	PX4_DEBUG("param_save_default");
@@ -805,8 +1037,25 @@ int param_save_default(bool blocking)
 
 	int res = PX4_ERROR;
 	const char *filename = param_get_default_file();
+	bool journaled = false;
+
+#if defined(CONFIG_PARAM_JOURNAL)
 
 	if (filename) {
+		// autosaves of a few changes are only appended to the journal, explicit saves rewrite the file
+		journaled = !blocking && (param_journal_append(false) == PX4_OK);
+
+		if (!journaled) {
+			param_journal_begin_compaction();
+		}
+	}
+
+#endif /* CONFIG_PARAM_JOURNAL */
+
+	if (journaled) {
+		res = PX4_OK;
+
+	} else if (filename) {
 		static constexpr int MAX_ATTEMPTS = 3;
 
 		for (int attempt = 1; attempt <= MAX_ATTEMPTS; attempt++) {
@@ -842,10 +1091,18 @@ int param_save_default(bool blocking)
 		perf_end(param_export_perf);
 	}
 
+#if defined(CONFIG_PARAM_JOURNAL)
+
+	if (filename && !journaled) {
+		param_journal_end_compaction(res == PX4_OK);
+	}
+
+#endif /* CONFIG_PARAM_JOURNAL */
+
 	if (res != PX4_OK) {
 		PX4_ERR("param export failed (%d)", res);
 
-	} else {
+	} else if (!journaled) {
 		params_unsaved.reset();
 
 		// backup file
@@ -900,6 +1157,7 @@ param_load_default()
 			return -1;
 		}
 
+		param_replay_journal();
 		return 1;
 	}
 
@@ -911,9 +1169,56 @@ param_load_default()
 		return -2;
 	}
 
+	param_replay_journal();
+
 	return res;
 }
 
+int
+param_replay_journal()
+{
+	int ret = 0;
+#if defined(CONFIG_PARAM_JOURNAL)
+
+	if ((param_default_file == nullptr) || (param_journal_file == nullptr)) {
+		return 0;
+	}
+
+	pthread_mutex_lock(&file_mutex);
+
+	if ((access(param_default_file, F_OK) != 0)
+	    && ((param_backup_file == nullptr) || (access(param_backup_file, F_OK) != 0))) {
+		// without the default or backup file (e.g. removed to reset all parameters) the journal has no base
+		unlink(param_journal_file);
+		param_journal_base_valid = false;
+
+	} else if (access(param_journal_file, F_OK) == 0) {
+		ParamJournal journal;
+		ret = journal.open(param_journal_file, param_journal_replay_callback, nullptr);
+		param_journal_base_valid = (ret >= 0);
+
+		if (ret < 0) {
+			PX4_ERR("param journal %s replay failed (%d)", param_journal_file, ret);
+		}
+
+	} else {
+		param_journal_base_valid = true;
+	}
+
+	// everything loaded so far is persisted
+	params_journal_pending.reset();
+
+	pthread_mutex_unlock(&file_mutex);
+
+	if (ret > 0) {
+		PX4_DEBUG("param journal: replayed %d changes", ret);
+		param_notify_changes();
+	}
+
+#endif /* CONFIG_PARAM_JOURNAL */
+	return ret;
+}
+
 static int param_verify_callback(bson_decoder_t decoder, bson_node_t node)
 {
 	if (node->type == BSON_EOO) {
@@ -1150,6 +1455,115 @@ out:
 	return result;
 }
 
+/** parameters decoded by param_import_callback(), stored all at once by param_import_apply() */
+static struct {
+	DynamicSparseLayer::Slot *slots;
+	int count;
+	int capacity;
+	px4::AtomicBitset<param_info_count> staged;
+} param_import_buffer{};
+
+static void
+param_import_stage(param_t param, param_value_u value)
+{
+	if (param_import_buffer.staged[param]) {
+		// the same parameter appears more than once: the last value wins
+		for (int i = 0; i < param_import_buffer.count; i++) {
+			if (param_import_buffer.slots[i].param == param) {
+				param_import_buffer.slots[i].value = value;
+				return;
+			}
+		}
+	}
+
+	if (param_import_buffer.count == param_import_buffer.capacity) {
+		const int capacity = (param_import_buffer.capacity > 0) ? param_import_buffer.capacity * 2 : 64;
+		DynamicSparseLayer::Slot *slots = (DynamicSparseLayer::Slot *)realloc(param_import_buffer.slots,
+						  sizeof(DynamicSparseLayer::Slot) * capacity);
+
+		if (slots == nullptr) {
+			// fall back to storing the parameter individually
+			param_set_internal(param, &value, true, true);
+			return;
+		}
+
+		param_import_buffer.slots = slots;
+		param_import_buffer.capacity = capacity;
+	}
+
+	param_import_buffer.slots[param_import_buffer.count++] = {param, value};
+	param_import_buffer.staged.set(param, true);
+}
+
+/**
+ * Store all staged parameters with a single merge into the user config and send one notification.
+ */
+static void
+param_import_apply()
+{
+	const int count = param_import_buffer.count;
+	DynamicSparseLayer::Slot *slots = param_import_buffer.slots;
+	bool changed = false;
+
+	// keep the staged flag only for the parameters whose value changes
+	for (int i = 0; i < count; i++) {
+		const param_value_u current_value = user_config.get(slots[i].param);
+		bool param_changed = false;
+
+		switch (param_type(slots[i].param)) {
+		case PARAM_TYPE_INT32:
+			param_changed = current_value.i != slots[i].value.i;
+			break;
+
+		case PARAM_TYPE_FLOAT:
+			param_changed = fabsf(current_value.f - slots[i].value.f) > FLT_EPSILON;
+			break;
+		}
+
+		param_import_buffer.staged.set(slots[i].param, param_changed);
+		changed |= param_changed;
+	}
+
+	perf_begin(param_set_perf);
+	const bool stored = user_config.storeMultiple(slots, count);
+	perf_end(param_set_perf);
+
+	for (int i = 0; i < count; i++) {
+		const param_t param = slots[i].param;
+
+		if (!stored) {
+			// fall back to storing the parameters individually
+			param_import_buffer.staged.set(param, false);
+			param_set_internal(param, &slots[i].value, true, false);
+
+		} else if (param_import_buffer.staged[param]) {
+			param_import_buffer.staged.set(param, false);
+			params_unsaved.set(param, false);
+			param_record_change(param);
+
+#if defined(CONFIG_PARAM_PRIMARY)
+			param_primary_set_value(param, &slots[i].value);
+#endif
+
+#if defined(CONFIG_PARAM_REMOTE)
+			param_remote_set_value(param, &slots[i].value);
+#endif
+
+		} else {
+			params_unsaved.set(param, false);
+		}
+	}
+
+	free(param_import_buffer.slots);
+	param_import_buffer.slots = nullptr;
+	param_import_buffer.count = 0;
+	param_import_buffer.capacity = 0;
+
+	if (changed) {
+		param_notify_changes();
+	}
+}
+
 static int
 param_import_callback(bson_decoder_t decoder, bson_node_t node)
 {
@@ -1179,9 +1593,10 @@ param_import_callback(bson_decoder_t decoder, bson_node_t node)
 	switch (node->type) {
 	case BSON_INT32: {
 			if (param_type(param) == PARAM_TYPE_INT32) {
-				int32_t i = node->i32;
-				param_set_internal(param, &i, true, true);
-				PX4_DEBUG("Imported %s with value %" PRIi32, param_name(param), i);
+				param_value_u value{};
+				value.i = node->i32;
+				param_import_stage(param, value);
+				PX4_DEBUG("Imported %s with value %" PRIi32, param_name(param), value.i);
 
 			} else {
 				PX4_WARN("unexpected type for %s", node->name);
@@ -1191,9 +1606,10 @@ param_import_callback(bson_decoder_t decoder, bson_node_t node)
 
 	case BSON_DOUBLE: {
 			if (param_type(param) == PARAM_TYPE_FLOAT) {
-				float f = node->d;
-				param_set_internal(param, &f, true, true);
-				PX4_DEBUG("Imported %s with value %f", param_name(param), (double)f);
+				param_value_u value{};
+				value.f = node->d;
+				param_import_stage(param, value);
+				PX4_DEBUG("Imported %s with value %f", param_name(param), (double)value.f);
 
 			} else {
 				PX4_WARN("unexpected type for %s", node->name);
@@ -1214,6 +1630,10 @@ param_import_internal(int fd)
 {
 	static constexpr int MAX_ATTEMPTS = 3;
 
+	// the decoded parameters are staged and then stored at once, instead of inserting them one by one
+	pthread_mutex_lock(&import_mutex);
+	int ret = -1;
+
 	for (int attempt = 1; attempt <= MAX_ATTEMPTS; attempt++) {
 		bson_decoder_s decoder{};
 
@@ -1225,13 +1645,17 @@ param_import_internal(int fd)
 
 			} while (result > 0);
 
+			// also store what was decoded before an error, same as individual stores would have
+			param_import_apply();
+
 			if (result == 0) {
 				if (decoder.total_document_size == decoder.total_decoded_size) {
 					PX4_INFO("BSON document size %" PRId32 " bytes, decoded %" PRId32 " bytes (INT32:%" PRIu16 ", FLOAT:%" PRIu16 ")",
 						 decoder.total_document_size, decoder.total_decoded_size,
 						 decoder.count_node_int32, decoder.count_node_double);
 
-					return 0;
+					ret = 0;
+					break;
 
 				} else {
 					PX4_ERR("BSON document size (%" PRId32 ") doesn't match bytes decoded (%" PRId32 ")",
@@ -1242,7 +1666,8 @@ param_import_internal(int fd)
 				// silently retry as a precaution unless this is our last attempt
 				if (attempt == MAX_ATTEMPTS) {
 					PX4_DEBUG("BSON: no data");
-					return 0;
+					ret = 0;
+					break;
 				}
 
 			} else {
@@ -1262,7 +1687,8 @@ param_import_internal(int fd)
 		}
 	}
 
-	return -1;
+	pthread_mutex_unlock(&import_mutex);
+	return ret;
 }
 
 int
@@ -190,6 +190,24 @@ int	param_ioctl(unsigned int cmd, unsigned long arg)
 		}
 		break;
 
+	case PARAMIOCGENERATION: {
+			paramiocgeneration_t *data = (paramiocgeneration_t *)arg;
+			data->ret = param_generation();
+		}
+		break;
+
+	case PARAMIOCCHANGES: {
+			paramiocchanges_t *data = (paramiocchanges_t *)arg;
+			param_changes_since(data->generation, data->changes);
+		}
+		break;
+
+	case PARAMIOCREPLAYJOURNAL: {
+			paramiocreplayjournal_t *data = (paramiocreplayjournal_t *)arg;
+			data->ret = param_replay_journal();
+		}
+		break;
+
 	default:
 		ret = -ENOTTY;
 		break;
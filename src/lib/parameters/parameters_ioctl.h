@@ -161,4 +161,20 @@ typedef struct paramiochash {
 	uint32_t ret;
 } paramiochash_t;
 
+#define PARAMIOCGENERATION	_PARAMIOC(19)
+typedef struct paramiocgeneration {
+	uint32_t ret;
+} paramiocgeneration_t;
+
+#define PARAMIOCCHANGES	_PARAMIOC(20)
+typedef struct paramiocchanges {
+	uint32_t generation;
+	param_changes_t *changes;
+} paramiocchanges_t;
+
+#define PARAMIOCREPLAYJOURNAL	_PARAMIOC(21)
+typedef struct paramiocreplayjournal {
+	int ret;
+} paramiocreplayjournal_t;
+
 int param_ioctl(unsigned int cmd, unsigned long arg);
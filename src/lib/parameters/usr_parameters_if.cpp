@@ -52,6 +52,21 @@ param_notify_changes()
 	boardctl(PARAMIOCNOTIFY, NULL);
 }
 
+uint32_t
+param_generation()
+{
+	paramiocgeneration_t data = {0};
+	boardctl(PARAMIOCGENERATION, reinterpret_cast<unsigned long>(&data));
+	return data.ret;
+}
+
+void
+param_changes_since(uint32_t generation, param_changes_t *changes)
+{
+	paramiocchanges_t data = {generation, changes};
+	boardctl(PARAMIOCCHANGES, reinterpret_cast<unsigned long>(&data));
+}
+
 param_t param_find(const char *name)
 {
 	paramiocfind_t data = {name, true, PARAM_INVALID};
@@ -202,6 +217,14 @@ param_load_default()
 	return data.ret;
 }
 
+int
+param_replay_journal()
+{
+	paramiocreplayjournal_t data = {PX4_ERROR};
+	boardctl(PARAMIOCREPLAYJOURNAL, reinterpret_cast<unsigned long>(&data));
+	return data.ret;
+}
+
 int
 param_export(const char *filename, param_filter_func filter)
 {
@@ -44,6 +44,7 @@
 #include <drivers/drv_hrt.h>
 #include <math.h>
 #include <pthread.h>
+#include <px4_platform_common/atomic.h>
 #include <systemlib/err.h>
 
 #include "perf_counter.h"
@@ -91,6 +92,38 @@ struct perf_ctr_interval : public perf_ctr_header {
 	float			M2{0.0f};
 };
 
+/**
+ * PC_HISTOGRAM counter.
+ *
+ * Log-linear histogram of the measured times in us: values below 8us have their own bucket,
+ * above that each power of two is split into 8 buckets, so a bucket spans at most 12.5% of its
+ * value. Updates are lock-free. To avoid contention between threads on multi-core targets,
+ * each thread records into one of several shards, which are merged when reading the counter.
+ */
+static constexpr int PERF_HIST_SUB_BITS = 3;
+static constexpr int PERF_HIST_SUB_BUCKETS = 1 << PERF_HIST_SUB_BITS;
+static constexpr int PERF_HIST_MAX_BITS = 20;	// values >= 2^20 us go into the overflow bucket
+static constexpr int PERF_HIST_BUCKETS = (PERF_HIST_MAX_BITS - PERF_HIST_SUB_BITS + 1) * PERF_HIST_SUB_BUCKETS + 1;
+
+#if defined(__PX4_NUTTX)
+static constexpr int PERF_HIST_SHARDS = 1;
+#else
+static constexpr int PERF_HIST_SHARDS = 4;
+#endif
+
+struct perf_hist_shard {
+	px4::atomic<uint32_t>	buckets[PERF_HIST_BUCKETS];
+	px4::atomic<uint64_t>	time_total{0};
+	px4::atomic<uint32_t>	time_least{UINT32_MAX};
+	px4::atomic<uint32_t>	time_most{0};
+};
+
+struct perf_ctr_histogram : public perf_ctr_header {
+	uint64_t		time_start{0};
+	uint64_t		time_last{0};
+	perf_hist_shard		shards[PERF_HIST_SHARDS];
+};
+
 /**
  * List of all known counters.
  */
@@ -126,6 +159,10 @@ perf_alloc(enum perf_counter_type type, const char *name)
 		ctr = new perf_ctr_interval();
 		break;
 
+	case PC_HISTOGRAM:
+		ctr = new perf_ctr_histogram();
+		break;
+
 	default:
 		break;
 	}
@@ -194,11 +231,146 @@ perf_free(perf_counter_t handle)
 		delete (struct perf_ctr_interval *)handle;
 		break;
 
+	case PC_HISTOGRAM:
+		delete (struct perf_ctr_histogram *)handle;
+		break;
+
 	default:
 		break;
 	}
 }
 
+static int
+perf_hist_bucket(uint32_t value)
+{
+	if (value < PERF_HIST_SUB_BUCKETS) {
+		return value;
+	}
+
+	const int msb = 31 - __builtin_clz(value);
+
+	if (msb >= PERF_HIST_MAX_BITS) {
+		return PERF_HIST_BUCKETS - 1;
+	}
+
+	const int sub_bucket = (value >> (msb - PERF_HIST_SUB_BITS)) & (PERF_HIST_SUB_BUCKETS - 1);
+	return (msb - PERF_HIST_SUB_BITS + 1) * PERF_HIST_SUB_BUCKETS + sub_bucket;
+}
+
+/**
+ * largest value in us that falls into a bucket (UINT32_MAX for the overflow bucket)
+ */
+static uint32_t
+perf_hist_bucket_max(int bucket)
+{
+	if (bucket < PERF_HIST_SUB_BUCKETS) {
+		return bucket;
+	}
+
+	if (bucket >= PERF_HIST_BUCKETS - 1) {
+		return UINT32_MAX;
+	}
+
+	const int shift = bucket / PERF_HIST_SUB_BUCKETS - 1;
+	const uint32_t sub_bucket = bucket % PERF_HIST_SUB_BUCKETS;
+	return ((PERF_HIST_SUB_BUCKETS + sub_bucket + 1) << shift) - 1;
+}
+
+static unsigned
+perf_hist_shard_index()
+{
+#if defined(__PX4_NUTTX)
+	return 0;
+#else
+	// threads are assigned to shards round-robin on their first measurement
+	static px4::atomic<unsigned> next_shard{0};
+	static thread_local unsigned shard = next_shard.fetch_add(1) % PERF_HIST_SHARDS;
+	return shard;
+#endif
+}
+
+static void
+perf_hist_record(struct perf_ctr_histogram *pch, uint64_t value)
+{
+	const uint32_t value_us = (value > UINT32_MAX) ? UINT32_MAX : (uint32_t)value;
+	perf_hist_shard &shard = pch->shards[perf_hist_shard_index()];
+
+	shard.buckets[perf_hist_bucket(value_us)].fetch_add(1);
+	shard.time_total.fetch_add(value_us);
+
+	uint32_t least = shard.time_least.load();
+
+	while ((value_us < least) && !shard.time_least.compare_exchange(&least, value_us)) {}
+
+	uint32_t most = shard.time_most.load();
+
+	while ((value_us > most) && !shard.time_most.compare_exchange(&most, value_us)) {}
+}
+
+/**
+ * Merged statistics of all shards of a histogram counter
+ */
+struct perf_hist_summary {
+	uint64_t event_count{0};
+	uint64_t time_total{0};
+	uint32_t time_least{0};
+	uint32_t time_most{0};
+};
+
+static perf_hist_summary
+perf_hist_summarize(const struct perf_ctr_histogram *pch)
+{
+	perf_hist_summary summary{};
+	uint32_t least = UINT32_MAX;
+
+	for (const perf_hist_shard &shard : pch->shards) {
+		for (const auto &bucket : shard.buckets) {
+			summary.event_count += bucket.load();
+		}
+
+		summary.time_total += shard.time_total.load();
+
+		if (shard.time_least.load() < least) {
+			least = shard.time_least.load();
+		}
+
+		if (shard.time_most.load() > summary.time_most) {
+			summary.time_most = shard.time_most.load();
+		}
+	}
+
+	summary.time_least = (summary.event_count > 0) ? least : 0;
+	return summary;
+}
+
+/**
+ * Compute percentiles in a single pass over the merged buckets.
+ * @param fractions percentiles in increasing order
+ */
+static void
+perf_hist_percentiles(const struct perf_ctr_histogram *pch, const perf_hist_summary &summary,
+		      const float *fractions, uint32_t *percentiles, int num)
+{
+	uint64_t cumulative = 0;
+	int i = 0;
+
+	for (int bucket = 0; (bucket < PERF_HIST_BUCKETS) && (i < num); bucket++) {
+		for (const perf_hist_shard &shard : pch->shards) {
+			cumulative += shard.buckets[bucket].load();
+		}
+
+		while ((i < num) && (cumulative > 0) && (cumulative >= ceilf(fractions[i] * summary.event_count))) {
+			// the largest value seen is a tighter bound for the last bucket in use
+			const uint32_t bucket_max = perf_hist_bucket_max(bucket);
+			percentiles[i++] = (bucket_max < summary.time_most) ? bucket_max : summary.time_most;
+		}
+	}
+
+	while (i < num) {
+		percentiles[i++] = summary.time_most;
+	}
+}
+
 void
 perf_count(perf_counter_t handle)
 {
@@ -215,6 +387,18 @@ perf_count(perf_counter_t handle)
 		perf_count_interval(handle, hrt_absolute_time());
 		break;
 
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+			const hrt_abstime now = hrt_absolute_time();
+
+			if (pch->time_last != 0) {
+				perf_hist_record(pch, now - pch->time_last);
+			}
+
+			pch->time_last = now;
+		}
+		break;
+
 	default:
 		break;
 	}
@@ -232,6 +416,10 @@ perf_begin(perf_counter_t handle)
 		((struct perf_ctr_elapsed *)handle)->time_start = hrt_absolute_time();
 		break;
 
+	case PC_HISTOGRAM:
+		((struct perf_ctr_histogram *)handle)->time_start = hrt_absolute_time();
+		break;
+
 	default:
 		break;
 	}
@@ -254,6 +442,15 @@ perf_end(perf_counter_t handle)
 		}
 		break;
 
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+
+			if (pch->time_start != 0) {
+				perf_set_elapsed(handle, hrt_elapsed_time(&pch->time_start));
+			}
+		}
+		break;
+
 	default:
 		break;
 	}
@@ -294,6 +491,16 @@ perf_set_elapsed(perf_counter_t handle, int64_t elapsed)
 		}
 		break;
 
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+
+			if (elapsed >= 0) {
+				perf_hist_record(pch, elapsed);
+				pch->time_start = 0;
+			}
+		}
+		break;
+
 	default:
 		break;
 	}
@@ -387,6 +594,10 @@ perf_cancel(perf_counter_t handle)
 		}
 		break;
 
+	case PC_HISTOGRAM:
+		((struct perf_ctr_histogram *)handle)->time_start = 0;
+		break;
+
 	default:
 		break;
 	}
@@ -428,6 +639,24 @@ perf_reset(perf_counter_t handle)
 			pci->M2 = 0.0f;
 			break;
 		}
+
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+			pch->time_start = 0;
+			pch->time_last = 0;
+
+			for (perf_hist_shard &shard : pch->shards) {
+				for (auto &bucket : shard.buckets) {
+					bucket.store(0);
+				}
+
+				shard.time_total.store(0);
+				shard.time_least.store(UINT32_MAX);
+				shard.time_most.store(0);
+			}
+
+			break;
+		}
 	}
 }
 
@@ -474,11 +703,59 @@ perf_print_counter(perf_counter_t handle)
 			break;
 		}
 
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+			const perf_hist_summary summary = perf_hist_summarize(pch);
+			const float fractions[3] {0.5f, 0.99f, 0.999f};
+			uint32_t percentiles[3];
+			perf_hist_percentiles(pch, summary, fractions, percentiles, 3);
+
+			PX4_INFO_RAW("%s: %" PRIu64 " events, %.2fus avg, min %" PRIu32 "us max %" PRIu32 "us, p50 %" PRIu32
+				     "us p99 %" PRIu32 "us p99.9 %" PRIu32 "us\n",
+				     handle->name,
+				     summary.event_count,
+				     (summary.event_count == 0) ? 0 : (double)summary.time_total / (double)summary.event_count,
+				     summary.time_least,
+				     summary.time_most,
+				     percentiles[0], percentiles[1], percentiles[2]);
+			break;
+		}
+
 	default:
 		break;
 	}
 }
 
+void
+perf_print_histogram(perf_counter_t handle)
+{
+	if ((handle == nullptr) || (handle->type != PC_HISTOGRAM)) {
+		return;
+	}
+
+	struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+	PX4_INFO_RAW("%s:\n", handle->name);
+
+	for (int bucket = 0; bucket < PERF_HIST_BUCKETS; bucket++) {
+		uint64_t count = 0;
+
+		for (const perf_hist_shard &shard : pch->shards) {
+			count += shard.buckets[bucket].load();
+		}
+
+		if (count == 0) {
+			continue;
+		}
+
+		if (bucket == PERF_HIST_BUCKETS - 1) {
+			PX4_INFO_RAW("  >%10" PRIu32 "us: %" PRIu64 "\n", perf_hist_bucket_max(bucket - 1), count);
+
+		} else {
+			PX4_INFO_RAW("  <=%9" PRIu32 "us: %" PRIu64 "\n", perf_hist_bucket_max(bucket), count);
+		}
+	}
+}
+
 
 int
 perf_print_counter_buffer(char *buffer, int length, perf_counter_t handle)
@@ -526,6 +803,25 @@ perf_print_counter_buffer(char *buffer, int length, perf_counter_t handle)
 			break;
 		}
 
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+			const perf_hist_summary summary = perf_hist_summarize(pch);
+			const float fractions[3] {0.5f, 0.99f, 0.999f};
+			uint32_t percentiles[3];
+			perf_hist_percentiles(pch, summary, fractions, percentiles, 3);
+
+			num_written = snprintf(buffer, length,
+					       "%s: %" PRIu64 " events, %.2fus avg, min %" PRIu32 "us max %" PRIu32 "us, p50 %" PRIu32 "us p99 %" PRIu32
+					       "us p99.9 %" PRIu32 "us",
+					       handle->name,
+					       summary.event_count,
+					       (summary.event_count == 0) ? 0 : (double)summary.time_total / (double)summary.event_count,
+					       summary.time_least,
+					       summary.time_most,
+					       percentiles[0], percentiles[1], percentiles[2]);
+			break;
+		}
+
 	default:
 		break;
 	}
@@ -555,6 +851,9 @@ perf_event_count(perf_counter_t handle)
 			return pci->event_count;
 		}
 
+	case PC_HISTOGRAM:
+		return perf_hist_summarize((struct perf_ctr_histogram *)handle).event_count;
+
 	default:
 		break;
 	}
@@ -580,6 +879,11 @@ perf_mean(perf_counter_t handle)
 			return pci->mean;
 		}
 
+	case PC_HISTOGRAM: {
+			const perf_hist_summary summary = perf_hist_summarize((struct perf_ctr_histogram *)handle);
+			return (summary.event_count == 0) ? 0.f : summary.time_total / 1e6f / summary.event_count;
+		}
+
 	default:
 		break;
 	}
@@ -587,6 +891,24 @@ perf_mean(perf_counter_t handle)
 	return 0.0f;
 }
 
+uint32_t
+perf_percentile(perf_counter_t handle, float fraction)
+{
+	if ((handle == nullptr) || (handle->type != PC_HISTOGRAM)) {
+		return 0;
+	}
+
+	struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+	const perf_hist_summary summary = perf_hist_summarize(pch);
+	uint32_t percentile = 0;
+
+	if (summary.event_count > 0) {
+		perf_hist_percentiles(pch, summary, &fraction, &percentile, 1);
+	}
+
+	return percentile;
+}
+
 void
 perf_iterate_all(perf_callback cb, void *user)
 {
@@ -48,7 +48,8 @@
 enum perf_counter_type {
 	PC_COUNT,		/**< count the number of times an event occurs */
 	PC_ELAPSED,		/**< measure the time elapsed performing an event */
-	PC_INTERVAL		/**< measure the interval between instances of an event */
+	PC_INTERVAL,		/**< measure the interval between instances of an event */
+	PC_HISTOGRAM		/**< distribution of the elapsed time (perf_begin/perf_end) or interval (perf_count) */
 };
 
 struct perf_ctr_header;
@@ -230,6 +231,25 @@ __EXPORT extern uint64_t	perf_event_count(perf_counter_t handle);
  */
 __EXPORT extern float		perf_mean(perf_counter_t handle);
 
+/**
+ * Return a percentile of a PC_HISTOGRAM counter
+ *
+ * The result is the upper bound of the histogram bucket the percentile falls into,
+ * which overestimates the exact value by at most 12.5%.
+ *
+ * @param handle		The handle returned from perf_alloc.
+ * @param fraction		Percentile as a fraction, e.g. 0.99f
+ * @param return		percentile in us, 0 if the counter is empty or not a histogram
+ */
+__EXPORT extern uint32_t	perf_percentile(perf_counter_t handle, float fraction);
+
+/**
+ * Print the buckets of a PC_HISTOGRAM counter to stdout. Other counter types are ignored.
+ *
+ * @param handle		The counter to print.
+ */
+__EXPORT extern void		perf_print_histogram(perf_counter_t handle);
+
 __END_DECLS
 
 #endif
@@ -32,11 +32,11 @@
 #
 ############################################################################
 
+import argparse
 import math
 import numpy
 import json
 import statistics
-import sys
 import urllib.request
 
 SAMPLING_RES = 10
@@ -82,7 +82,18 @@ header = """/*******************************************************************
  ****************************************************************************/
 """
 
-key=sys.argv[1] # NOAA key (https://www.ngdc.noaa.gov/geomag/CalcSurvey.shtml)
+parser = argparse.ArgumentParser(description='Generate the world magnetic model lookup tables from NOAA data')
+parser.add_argument('key', help='NOAA key (https://www.ngdc.noaa.gov/geomag/CalcSurvey.shtml)')
+parser.add_argument('--resolution', type=int, default=SAMPLING_RES,
+                    help='grid resolution in degrees (default: %(default)s), a finer grid improves accuracy '
+                         'at high latitudes at the cost of flash (3 tables of LAT_DIM * LON_DIM int16)')
+args = parser.parse_args()
+
+if args.resolution <= 0 or (180 % args.resolution) != 0:
+    parser.error('resolution must evenly divide 180 degrees')
+
+SAMPLING_RES = args.resolution
+key = args.key
 
 print(header)
 
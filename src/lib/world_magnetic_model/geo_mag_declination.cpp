@@ -37,8 +37,8 @@
 * Calculation / lookup table for Earth's magnetic field declination (deg), inclination (deg) and strength (mTesla).
 * Data generated by https://www.ngdc.noaa.gov/geomag-web/#igrfgrid IGRF calculator on 22 Jan 2018
 *
-* XXX Lookup table currently too coarse in resolution (only full degrees)
-* and lat/lon res - needs extension medium term.
+* The default table resolution is coarse (10 degrees), a finer table can be generated
+* with fetch_noaa_table.py --resolution for high-latitude operation.
 *
 */
 
@@ -66,7 +66,14 @@ static unsigned get_lookup_table_index(float *val, float min, float max)
 	return static_cast<unsigned>((-(min) + *val) / SAMPLING_RES);
 }
 
-static float get_table_data(float latitude_deg, float longitude_deg, const int16_t table[LAT_DIM][LON_DIM])
+struct TableLookup {
+	unsigned lat_index;
+	unsigned lon_index;
+	float lat_scale;
+	float lon_scale;
+};
+
+static TableLookup get_table_lookup(float latitude_deg, float longitude_deg)
 {
 	latitude_deg = math::constrain(latitude_deg, SAMPLING_MIN_LAT, SAMPLING_MAX_LAT);
 
@@ -82,23 +89,36 @@ static float get_table_data(float latitude_deg, float longitude_deg, const int16
 	float min_lat = floorf(latitude_deg / SAMPLING_RES) * SAMPLING_RES;
 	float min_lon = floorf(longitude_deg / SAMPLING_RES) * SAMPLING_RES;
 
+	TableLookup lookup;
+
 	/* find index of nearest low sampling point */
-	unsigned min_lat_index = get_lookup_table_index(&min_lat, SAMPLING_MIN_LAT, SAMPLING_MAX_LAT);
-	unsigned min_lon_index = get_lookup_table_index(&min_lon, SAMPLING_MIN_LON, SAMPLING_MAX_LON);
+	lookup.lat_index = get_lookup_table_index(&min_lat, SAMPLING_MIN_LAT, SAMPLING_MAX_LAT);
+	lookup.lon_index = get_lookup_table_index(&min_lon, SAMPLING_MIN_LON, SAMPLING_MAX_LON);
 
-	const float data_sw = table[min_lat_index][min_lon_index];
-	const float data_se = table[min_lat_index][min_lon_index + 1];
-	const float data_ne = table[min_lat_index + 1][min_lon_index + 1];
-	const float data_nw = table[min_lat_index + 1][min_lon_index];
+	/* bilinear interpolation weights of the four grid corners */
+	lookup.lat_scale = constrain((latitude_deg - min_lat) / SAMPLING_RES, 0.f, 1.f);
+	lookup.lon_scale = constrain((longitude_deg - min_lon) / SAMPLING_RES, 0.f, 1.f);
+
+	return lookup;
+}
+
+static float get_table_data(const TableLookup &lookup, const int16_t table[LAT_DIM][LON_DIM])
+{
+	const float data_sw = table[lookup.lat_index][lookup.lon_index];
+	const float data_se = table[lookup.lat_index][lookup.lon_index + 1];
+	const float data_ne = table[lookup.lat_index + 1][lookup.lon_index + 1];
+	const float data_nw = table[lookup.lat_index + 1][lookup.lon_index];
 
 	/* perform bilinear interpolation on the four grid corners */
-	const float lat_scale = constrain((latitude_deg - min_lat) / SAMPLING_RES, 0.f, 1.f);
-	const float lon_scale = constrain((longitude_deg - min_lon) / SAMPLING_RES, 0.f, 1.f);
+	const float data_min = lookup.lon_scale * (data_se - data_sw) + data_sw;
+	const float data_max = lookup.lon_scale * (data_ne - data_nw) + data_nw;
 
-	const float data_min = lon_scale * (data_se - data_sw) + data_sw;
-	const float data_max = lon_scale * (data_ne - data_nw) + data_nw;
+	return lookup.lat_scale * (data_max - data_min) + data_min;
+}
 
-	return lat_scale * (data_max - data_min) + data_min;
+static float get_table_data(float latitude_deg, float longitude_deg, const int16_t table[LAT_DIM][LON_DIM])
+{
+	return get_table_data(get_table_lookup(latitude_deg, longitude_deg), table);
 }
 
 float get_mag_declination_degrees(float latitude_deg, float longitude_deg)
@@ -125,3 +145,33 @@ float get_mag_strength_tesla(float latitude_deg, float longitude_deg)
 	return get_table_data(latitude_deg, longitude_deg, totalintensity_table)
 	       * WMM_TOTALINTENSITY_SCALE_TO_NANOTESLA * 1e-9f;
 }
+
+MagneticField get_mag_field(float latitude_deg, float longitude_deg)
+{
+	const TableLookup lookup = get_table_lookup(latitude_deg, longitude_deg);
+
+	MagneticField field;
+	field.declination_deg = get_table_data(lookup, declination_table) * WMM_DECLINATION_SCALE_TO_DEGREES;
+	field.inclination_deg = get_table_data(lookup, inclination_table) * WMM_INCLINATION_SCALE_TO_DEGREES;
+
+	// table stored as scaled nanotesla, 1 Gauss = 1e4 Tesla
+	field.strength_gauss = get_table_data(lookup, totalintensity_table) * WMM_TOTALINTENSITY_SCALE_TO_NANOTESLA * 1e-9f * 1e4f;
+
+	return field;
+}
+
+const MagneticField &MagneticFieldCache::get(float latitude_deg, float longitude_deg)
+{
+	// written so that a non-finite position never matches the cached one
+	const bool position_changed = !(fabsf(latitude_deg - _latitude_deg) <= MAX_POSITION_CHANGE_DEG)
+				      || !(fabsf(longitude_deg - _longitude_deg) <= MAX_POSITION_CHANGE_DEG);
+
+	if (!_valid || position_changed) {
+		_field = get_mag_field(latitude_deg, longitude_deg);
+		_latitude_deg = latitude_deg;
+		_longitude_deg = longitude_deg;
+		_valid = true;
+	}
+
+	return _field;
+}
@@ -50,3 +50,41 @@ float get_mag_inclination_degrees(float latitude_deg, float longitude_deg);
 // return magnetic field strength in Gauss or Tesla
 float get_mag_strength_gauss(float latitude_deg, float longitude_deg);
 float get_mag_strength_tesla(float latitude_deg, float longitude_deg);
+
+struct MagneticField {
+	float declination_deg;
+	float inclination_deg;
+	float strength_gauss;
+};
+
+// Return magnetic declination, inclination and strength, sharing a single table lookup
+MagneticField get_mag_field(float latitude_deg, float longitude_deg);
+
+/**
+ * Position keyed cache of the last magnetic field lookup, for callers that query the
+ * world magnetic model at a high rate from a slowly changing position.
+ * Not shared between threads, each caller owns its own instance.
+ */
+class MagneticFieldCache
+{
+public:
+	/**
+	 * Return the magnetic field at the given position.
+	 * The previous result is reused while the position is within MAX_POSITION_CHANGE_DEG
+	 * of the position it was computed at.
+	 */
+	const MagneticField &get(float latitude_deg, float longitude_deg);
+
+	void reset() { _valid = false; }
+
+	// ~100 m, well below the resolution of the lookup tables
+	static constexpr float MAX_POSITION_CHANGE_DEG = 0.001f;
+
+private:
+	MagneticField _field{};
+
+	float _latitude_deg{0.f};
+	float _longitude_deg{0.f};
+
+	bool _valid{false};
+};
@@ -0,0 +1,85 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <math.h>
+
+#include "geo_mag_declination.h"
+
+TEST(GeoMagFieldTest, MatchesSingleLookups)
+{
+	for (float latitude_deg = -90.f; latitude_deg <= 90.f; latitude_deg += 3.7f) {
+		for (float longitude_deg = -200.f; longitude_deg <= 200.f; longitude_deg += 4.3f) {
+			const MagneticField field = get_mag_field(latitude_deg, longitude_deg);
+
+			EXPECT_FLOAT_EQ(field.declination_deg, get_mag_declination_degrees(latitude_deg, longitude_deg));
+			EXPECT_FLOAT_EQ(field.inclination_deg, get_mag_inclination_degrees(latitude_deg, longitude_deg));
+			EXPECT_FLOAT_EQ(field.strength_gauss, get_mag_strength_gauss(latitude_deg, longitude_deg));
+		}
+	}
+}
+
+TEST(GeoMagFieldTest, CacheReusesNearbyPosition)
+{
+	MagneticFieldCache cache;
+
+	const MagneticField first = cache.get(47.3977f, 8.5456f);
+	const MagneticField expected = get_mag_field(47.3977f, 8.5456f);
+	EXPECT_FLOAT_EQ(first.declination_deg, expected.declination_deg);
+	EXPECT_FLOAT_EQ(first.inclination_deg, expected.inclination_deg);
+	EXPECT_FLOAT_EQ(first.strength_gauss, expected.strength_gauss);
+
+	// within tolerance: cached result returned unchanged
+	const float offset_deg = 0.5f * MagneticFieldCache::MAX_POSITION_CHANGE_DEG;
+	const MagneticField nearby = cache.get(47.3977f + offset_deg, 8.5456f - offset_deg);
+	EXPECT_EQ(nearby.declination_deg, first.declination_deg);
+	EXPECT_EQ(nearby.inclination_deg, first.inclination_deg);
+	EXPECT_EQ(nearby.strength_gauss, first.strength_gauss);
+
+	// moved away: lookup repeated
+	const MagneticField moved = cache.get(-33.8688f, 151.2093f);
+	EXPECT_FLOAT_EQ(moved.declination_deg, get_mag_declination_degrees(-33.8688f, 151.2093f));
+	EXPECT_FLOAT_EQ(moved.inclination_deg, get_mag_inclination_degrees(-33.8688f, 151.2093f));
+	EXPECT_FLOAT_EQ(moved.strength_gauss, get_mag_strength_gauss(-33.8688f, 151.2093f));
+}
+
+TEST(GeoMagFieldTest, CacheRejectsNonFinitePosition)
+{
+	MagneticFieldCache cache;
+	cache.get(NAN, NAN);
+
+	// a non-finite position must not be matched by the next query
+	const MagneticField field = cache.get(10.f, 20.f);
+	EXPECT_FLOAT_EQ(field.declination_deg, get_mag_declination_degrees(10.f, 20.f));
+	EXPECT_FLOAT_EQ(field.strength_gauss, get_mag_strength_gauss(10.f, 20.f));
+}
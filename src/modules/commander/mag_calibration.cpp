@@ -1023,9 +1023,10 @@ int do_mag_calibration_quick(orb_advert_t *mavlink_log_pub, float heading_radian
 
 	} else {
 		// magnetic field data returned by the geo library using the current GPS position
-		const float declination_rad = math::radians(get_mag_declination_degrees(latitude_deg, longitude_deg));
-		const float inclination_rad = math::radians(get_mag_inclination_degrees(latitude_deg, longitude_deg));
-		const float field_strength_gauss = get_mag_strength_gauss(latitude_deg, longitude_deg);
+		const MagneticField field = get_mag_field(latitude_deg, longitude_deg);
+		const float declination_rad = math::radians(field.declination_deg);
+		const float inclination_rad = math::radians(field.inclination_deg);
+		const float field_strength_gauss = field.strength_gauss;
 
 		const Vector3f mag_earth_pred = Dcmf(Eulerf(0, -inclination_rad, declination_rad))
 						* Vector3f(field_strength_gauss, 0, 0);
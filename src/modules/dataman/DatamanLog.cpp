@@ -0,0 +1,491 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file DatamanLog.cpp
+ */
+
+#include "DatamanLog.hpp"
+
+#include <crc32.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <px4_platform_common/defines.h>
+#include <px4_platform_common/log.h>
+
+DatamanLog::DatamanLog(const unsigned *max_index, unsigned num_items) :
+	_max_index(max_index),
+	_num_items(num_items)
+{
+}
+
+DatamanLog::~DatamanLog()
+{
+	close();
+}
+
+uint32_t DatamanLog::recordCrc(const RecordHeader &header, const uint8_t *data)
+{
+	RecordHeader crc_header = header;
+	crc_header.crc = 0;
+
+	const uint32_t crc = crc32part(reinterpret_cast<const uint8_t *>(&crc_header), sizeof(crc_header), 0);
+	return crc32part(data, header.length, crc);
+}
+
+int DatamanLog::open(const char *path)
+{
+	close();
+
+	_item_base = new unsigned[_num_items];
+
+	if (_item_base == nullptr) {
+		return -ENOMEM;
+	}
+
+	_num_slots = 0;
+
+	for (unsigned item = 0; item < _num_items; ++item) {
+		_item_base[item] = _num_slots;
+		_num_slots += _max_index[item];
+	}
+
+	_offsets = new uint32_t[_num_slots];
+	_lengths = new uint8_t[_num_slots];
+
+	const size_t path_length = strlen(path);
+	_path = strdup(path);
+	_compact_path = (char *)malloc(path_length + sizeof(".compact"));
+
+	if ((_offsets == nullptr) || (_lengths == nullptr) || (_path == nullptr) || (_compact_path == nullptr)) {
+		close();
+		return -ENOMEM;
+	}
+
+	snprintf(_compact_path, path_length + sizeof(".compact"), "%s.compact", path);
+
+	for (unsigned i = 0; i < _num_slots; ++i) {
+		_offsets[i] = NO_RECORD;
+		_lengths[i] = 0;
+	}
+
+	// finish a compaction interrupted after the old log was removed
+	if ((access(path, F_OK) != 0) && (access(_compact_path, F_OK) == 0)) {
+		rename(_compact_path, path);
+	}
+
+	_existed = (access(path, F_OK) == 0);
+
+	_fd = ::open(path, O_RDWR | O_CREAT | O_BINARY, PX4_O_MODE_666);
+
+	if (_fd < 0) {
+		const int ret = -errno;
+		close();
+		return ret;
+	}
+
+	FileHeader header{};
+	bool valid_header = (::read(_fd, &header, sizeof(header)) == sizeof(header)) &&
+			    (header.magic == FILE_MAGIC) && (header.version == FILE_VERSION);
+
+	if (!valid_header) {
+		if (_existed) {
+			PX4_WARN("dataman log: invalid header, resetting");
+			_existed = false;
+		}
+
+		header.magic = FILE_MAGIC;
+		header.version = FILE_VERSION;
+		header.reserved = 0;
+
+		if ((ftruncate(_fd, 0) != 0) || (lseek(_fd, 0, SEEK_SET) != 0) ||
+		    (::write(_fd, &header, sizeof(header)) != sizeof(header)) || (fsync(_fd) != 0)) {
+			const int ret = -errno;
+			close();
+			return ret;
+		}
+
+		_log_size = sizeof(header);
+
+	} else {
+		_log_size = replay();
+
+		// drop a partially written record at the end
+		if ((lseek(_fd, 0, SEEK_END) != (off_t)_log_size) && (ftruncate(_fd, _log_size) == 0)) {
+			PX4_WARN("dataman log: truncated invalid tail at %" PRIu32, _log_size);
+			fsync(_fd);
+		}
+	}
+
+	return 0;
+}
+
+void DatamanLog::close()
+{
+	if (_fd >= 0) {
+		sync();
+		::close(_fd);
+		_fd = -1;
+	}
+
+	delete[] _item_base;
+	_item_base = nullptr;
+	delete[] _offsets;
+	_offsets = nullptr;
+	delete[] _lengths;
+	_lengths = nullptr;
+	free(_path);
+	_path = nullptr;
+	free(_compact_path);
+	_compact_path = nullptr;
+
+	_log_size = 0;
+	_live_size = 0;
+	_records = 0;
+}
+
+uint32_t DatamanLog::replay()
+{
+	uint32_t offset = sizeof(FileHeader);
+	RecordHeader header;
+	uint8_t *data = _record + sizeof(RecordHeader);
+
+	lseek(_fd, offset, SEEK_SET);
+
+	while (::read(_fd, &header, sizeof(header)) == sizeof(header)) {
+
+		if ((header.sync != RECORD_SYNC) || (header.item >= _num_items) ||
+		    ((header.type == RecordType::Write) && (header.index >= _max_index[header.item]))) {
+			break;
+		}
+
+		if ((header.length > 0) && (::read(_fd, data, header.length) != header.length)) {
+			break;
+		}
+
+		if (recordCrc(header, data) != header.crc) {
+			break;
+		}
+
+		if (header.type == RecordType::Clear) {
+			dropItem(header.item);
+
+		} else {
+			const unsigned i = slot(header.item, header.index);
+
+			if (_offsets[i] != NO_RECORD) {
+				_live_size -= sizeof(RecordHeader) + _lengths[i];
+			}
+
+			_offsets[i] = offset;
+			_lengths[i] = header.length;
+			_live_size += sizeof(RecordHeader) + header.length;
+		}
+
+		offset += sizeof(RecordHeader) + header.length;
+		++_records;
+	}
+
+	return offset;
+}
+
+void DatamanLog::dropItem(unsigned item)
+{
+	for (unsigned index = 0; index < _max_index[item]; ++index) {
+		const unsigned i = slot(item, index);
+
+		if (_offsets[i] != NO_RECORD) {
+			_live_size -= sizeof(RecordHeader) + _lengths[i];
+			_offsets[i] = NO_RECORD;
+			_lengths[i] = 0;
+		}
+	}
+}
+
+int DatamanLog::append(int fd, uint32_t offset, const RecordHeader &header, const void *data)
+{
+	// header and data in a single write, so a record is never split by other writes
+	memcpy(_record, &header, sizeof(header));
+
+	if ((header.length > 0) && (data != _record + sizeof(header))) {
+		memcpy(_record + sizeof(header), data, header.length);
+	}
+
+	const ssize_t record_size = sizeof(header) + header.length;
+
+	if (lseek(fd, offset, SEEK_SET) != (off_t)offset) {
+		return -1;
+	}
+
+	if (::write(fd, _record, record_size) != record_size) {
+		return -1;
+	}
+
+	return 0;
+}
+
+ssize_t DatamanLog::write(unsigned item, unsigned index, const void *buf, size_t count)
+{
+	if ((_fd < 0) || !validIndex(item, index)) {
+		return -1;
+	}
+
+	if (count > MAX_DATA_LENGTH) {
+		return -E2BIG;
+	}
+
+	RecordHeader header{};
+	header.sync = RECORD_SYNC;
+	header.item = item;
+	header.length = count;
+	header.index = index;
+	header.type = RecordType::Write;
+	header.crc = recordCrc(header, static_cast<const uint8_t *>(buf));
+
+	if (append(_fd, _log_size, header, buf) != 0) {
+		PX4_ERR("dataman log: write failed %d", errno);
+		// make sure a partial record gets overwritten by the next one
+		lseek(_fd, _log_size, SEEK_SET);
+		return -1;
+	}
+
+	const unsigned i = slot(item, index);
+
+	if (_offsets[i] != NO_RECORD) {
+		_live_size -= sizeof(RecordHeader) + _lengths[i];
+	}
+
+	_offsets[i] = _log_size;
+	_lengths[i] = count;
+	_live_size += sizeof(RecordHeader) + count;
+
+	_log_size += sizeof(RecordHeader) + count;
+	++_records;
+	_dirty = true;
+
+	return count;
+}
+
+ssize_t DatamanLog::read(unsigned item, unsigned index, void *buf, size_t count)
+{
+	if ((_fd < 0) || !validIndex(item, index)) {
+		return -1;
+	}
+
+	const unsigned i = slot(item, index);
+
+	if (_offsets[i] == NO_RECORD || _lengths[i] == 0) {
+		memset(buf, 0, count);
+		return 0;
+	}
+
+	/* We got more than requested!!! */
+	if (_lengths[i] > count) {
+		return -1;
+	}
+
+	const uint32_t offset = _offsets[i] + sizeof(RecordHeader);
+
+	if ((lseek(_fd, offset, SEEK_SET) != (off_t)offset) || (::read(_fd, buf, _lengths[i]) != _lengths[i])) {
+		PX4_ERR("dataman log: read failed %d", errno);
+		return -1;
+	}
+
+	return _lengths[i];
+}
+
+int DatamanLog::clear(unsigned item)
+{
+	if ((_fd < 0) || (item >= _num_items)) {
+		return -1;
+	}
+
+	bool empty = true;
+
+	for (unsigned index = 0; index < _max_index[item]; ++index) {
+		if (_offsets[slot(item, index)] != NO_RECORD) {
+			empty = false;
+			break;
+		}
+	}
+
+	/* Avoid wear by only writing when necessary */
+	if (empty) {
+		return 0;
+	}
+
+	RecordHeader header{};
+	header.sync = RECORD_SYNC;
+	header.item = item;
+	header.type = RecordType::Clear;
+	header.crc = recordCrc(header, nullptr);
+
+	if (append(_fd, _log_size, header, nullptr) != 0) {
+		lseek(_fd, _log_size, SEEK_SET);
+		return -1;
+	}
+
+	dropItem(item);
+
+	_log_size += sizeof(RecordHeader);
+	++_records;
+	_dirty = true;
+
+	return 0;
+}
+
+int DatamanLog::sync()
+{
+	if (!_dirty) {
+		return 0;
+	}
+
+	_dirty = false;
+	++_syncs;
+
+	return (fsync(_fd) == 0) ? 0 : -1;
+}
+
+bool DatamanLog::needsCompaction() const
+{
+	return (_fd >= 0) && (_log_size > COMPACT_MIN_SIZE) && (_log_size - sizeof(FileHeader) > 2 * _live_size);
+}
+
+int DatamanLog::compact()
+{
+	if (_fd < 0) {
+		return -1;
+	}
+
+	int fd = ::open(_compact_path, O_RDWR | O_CREAT | O_TRUNC | O_BINARY, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		return -1;
+	}
+
+	FileHeader file_header{};
+	file_header.magic = FILE_MAGIC;
+	file_header.version = FILE_VERSION;
+
+	bool success = (::write(fd, &file_header, sizeof(file_header)) == sizeof(file_header));
+	uint32_t offset = sizeof(file_header);
+
+	// read the data in place of the record buffer, append() then only adds the header
+	uint8_t *data = _record + sizeof(RecordHeader);
+
+	for (unsigned item = 0; success && (item < _num_items); ++item) {
+		for (unsigned index = 0; success && (index < _max_index[item]); ++index) {
+			const unsigned i = slot(item, index);
+
+			if (_offsets[i] == NO_RECORD) {
+				continue;
+			}
+
+			success = (read(item, index, data, MAX_DATA_LENGTH) == _lengths[i]);
+
+			if (success) {
+				RecordHeader header{};
+				header.sync = RECORD_SYNC;
+				header.item = item;
+				header.length = _lengths[i];
+				header.index = index;
+				header.type = RecordType::Write;
+				header.crc = recordCrc(header, data);
+
+				success = (append(fd, offset, header, data) == 0);
+				offset += sizeof(RecordHeader) + header.length;
+			}
+		}
+	}
+
+	success = success && (fsync(fd) == 0);
+	::close(fd);
+
+	// rename() atomically replaces the log where supported. Otherwise the old log is removed first,
+	// open() then picks up the compacted file if power is lost in between.
+	if (success && (rename(_compact_path, _path) != 0)) {
+		success = (unlink(_path) == 0) && (rename(_compact_path, _path) == 0);
+	}
+
+	if (!success) {
+		PX4_ERR("dataman log: compaction failed %d", errno);
+
+		// keep the compacted file if it is the only copy left
+		if (access(_path, F_OK) == 0) {
+			unlink(_compact_path);
+		}
+
+		return -1;
+	}
+
+	// Open the compacted log before giving up the old one, which still matches the current offsets
+	const int compacted_fd = ::open(_path, O_RDWR | O_BINARY, PX4_O_MODE_666);
+
+	if (compacted_fd < 0) {
+		PX4_ERR("dataman log: reopen failed %d", errno);
+		return -1;
+	}
+
+	::close(_fd);
+	_fd = compacted_fd;
+
+	// Records were written in slot order
+	offset = sizeof(file_header);
+	_records = 0;
+
+	for (unsigned i = 0; i < _num_slots; ++i) {
+		if (_offsets[i] != NO_RECORD) {
+			_offsets[i] = offset;
+			offset += sizeof(RecordHeader) + _lengths[i];
+			++_records;
+		}
+	}
+
+	_log_size = offset;
+	_dirty = false;
+	++_compactions;
+
+	return 0;
+}
+
+void DatamanLog::printStatus() const
+{
+	PX4_INFO("log size %" PRIu32 " bytes, live %" PRIu32 " bytes, %u records", _log_size, _live_size, _records);
+	PX4_INFO("syncs %u, compactions %u", _syncs, _compactions);
+}
@@ -0,0 +1,170 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file DatamanLog.hpp
+ *
+ * Log-structured dataman storage. Items are appended to a journal file, an in-RAM
+ * table maps each item/index to its latest record. Appends are not flushed
+ * individually, sync() commits all records written since the last call at once.
+ * Records superseded by newer writes are dropped by compact().
+ *
+ * File layout: FileHeader, followed by records of RecordHeader + data.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <sys/types.h>
+
+class DatamanLog
+{
+public:
+	/**
+	 * @param max_index Table of the maximum number of indexes for each item
+	 * @param num_items Number of items in max_index
+	 */
+	DatamanLog(const unsigned *max_index, unsigned num_items);
+	~DatamanLog();
+
+	DatamanLog(const DatamanLog &) = delete;
+	DatamanLog &operator=(const DatamanLog &) = delete;
+
+	/**
+	 * Open or create the log file and rebuild the index from it.
+	 * A torn or corrupted tail (e.g. after power loss) is truncated.
+	 * @return 0 on success, <0 on error
+	 */
+	int open(const char *path);
+	void close();
+
+	ssize_t write(unsigned item, unsigned index, const void *buf, size_t count);
+	ssize_t read(unsigned item, unsigned index, void *buf, size_t count);
+	int clear(unsigned item);
+
+	/**
+	 * Make all records appended since the last call persistent (group commit)
+	 * @return 0 on success, <0 on error
+	 */
+	int sync();
+
+	/**
+	 * @return true if the log grew beyond COMPACT_MIN_SIZE and holds more stale than live data
+	 */
+	bool needsCompaction() const;
+
+	/**
+	 * Rewrite the live records into a new file, which then atomically replaces the log.
+	 * @return 0 on success, <0 on error (the current log stays in use)
+	 */
+	int compact();
+
+	bool isOpen() const { return _fd >= 0; }
+
+	/** @return true if the log file existed before open() */
+	bool existed() const { return _existed; }
+
+	uint32_t size() const { return _log_size; }
+	uint32_t liveSize() const { return _live_size; }
+
+	void printStatus() const;
+
+	static constexpr uint32_t COMPACT_MIN_SIZE{32 * 1024};
+	static constexpr unsigned MAX_DATA_LENGTH{UINT8_MAX};
+
+private:
+	struct FileHeader {
+		uint32_t magic;
+		uint16_t version;
+		uint16_t reserved;
+	};
+
+	enum class RecordType : uint8_t {
+		Write = 0,
+		Clear = 1,
+	};
+
+	struct RecordHeader {
+		uint16_t sync;
+		uint8_t item;
+		uint8_t length;
+		uint16_t index;
+		RecordType type;
+		uint8_t reserved;
+		uint32_t crc;	///< over the header (with crc = 0) and data
+	};
+
+	static_assert(sizeof(FileHeader) == 8, "unexpected FileHeader size");
+	static_assert(sizeof(RecordHeader) == 12, "unexpected RecordHeader size");
+
+	static constexpr uint32_t FILE_MAGIC{0x474c4d44};	// "DMLG"
+	static constexpr uint16_t FILE_VERSION{1};
+	static constexpr uint16_t RECORD_SYNC{0xa55a};
+	static constexpr uint32_t NO_RECORD{0};		// offset 0 is the file header
+
+	static uint32_t recordCrc(const RecordHeader &header, const uint8_t *data);
+
+	bool validIndex(unsigned item, unsigned index) const { return (item < _num_items) && (index < _max_index[item]); }
+	unsigned slot(unsigned item, unsigned index) const { return _item_base[item] + index; }
+
+	/* append a record at the end of the log */
+	int append(int fd, uint32_t offset, const RecordHeader &header, const void *data);
+
+	/* rebuild the index from the file, returns the end of the last valid record */
+	uint32_t replay();
+
+	void dropItem(unsigned item);
+
+	const unsigned *_max_index;
+	const unsigned _num_items;
+
+	unsigned *_item_base{nullptr};	///< first slot of each item
+	uint32_t *_offsets{nullptr};	///< record offset of each slot, NO_RECORD if empty
+	uint8_t *_lengths{nullptr};	///< data length of each slot
+	unsigned _num_slots{0};
+
+	int _fd{-1};
+	char *_path{nullptr};
+	char *_compact_path{nullptr};
+	bool _existed{false};
+	bool _dirty{false};
+
+	uint32_t _log_size{0};
+	uint32_t _live_size{0};
+
+	unsigned _syncs{0};
+	unsigned _compactions{0};
+	unsigned _records{0};
+
+	uint8_t _record[sizeof(RecordHeader) + MAX_DATA_LENGTH];
+};
@@ -0,0 +1,186 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test for DatamanLog
+ */
+
+#include <gtest/gtest.h>
+#include "DatamanLog.hpp"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+namespace
+{
+
+constexpr unsigned max_index[] = {4, 100, 1};
+constexpr unsigned num_items = sizeof(max_index) / sizeof(max_index[0]);
+constexpr char log_path[] = "dataman_log_test";
+
+class DatamanLogTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		unlink(log_path);
+		ASSERT_EQ(_log.open(log_path), 0);
+		EXPECT_FALSE(_log.existed());
+	}
+
+	void TearDown() override
+	{
+		_log.close();
+		unlink(log_path);
+	}
+
+	void fill(uint8_t *data, size_t size, unsigned seed)
+	{
+		for (size_t i = 0; i < size; ++i) {
+			data[i] = seed + i;
+		}
+	}
+
+	DatamanLog _log{max_index, num_items};
+};
+
+} // namespace
+
+TEST_F(DatamanLogTest, WriteReadReopen)
+{
+	uint8_t data[40];
+	uint8_t read_data[40];
+
+	for (unsigned index = 0; index < max_index[1]; ++index) {
+		fill(data, sizeof(data), index);
+		ASSERT_EQ(_log.write(1, index, data, sizeof(data)), (ssize_t)sizeof(data));
+	}
+
+	EXPECT_EQ(_log.write(1, max_index[1], data, sizeof(data)), -1);
+	EXPECT_EQ(_log.write(num_items, 0, data, sizeof(data)), -1);
+
+	// unwritten entries read back empty
+	EXPECT_EQ(_log.read(0, 0, read_data, sizeof(read_data)), 0);
+
+	// the data fits, but not into a smaller buffer
+	EXPECT_EQ(_log.read(1, 0, read_data, 10), -1);
+
+	_log.close();
+	ASSERT_EQ(_log.open(log_path), 0);
+	EXPECT_TRUE(_log.existed());
+
+	for (unsigned index = 0; index < max_index[1]; ++index) {
+		fill(data, sizeof(data), index);
+		ASSERT_EQ(_log.read(1, index, read_data, sizeof(read_data)), (ssize_t)sizeof(data));
+		EXPECT_EQ(memcmp(data, read_data, sizeof(data)), 0);
+	}
+}
+
+TEST_F(DatamanLogTest, TornTail)
+{
+	uint8_t data[40];
+	uint8_t read_data[40];
+
+	fill(data, sizeof(data), 1);
+	ASSERT_EQ(_log.write(0, 0, data, sizeof(data)), (ssize_t)sizeof(data));
+	ASSERT_EQ(_log.write(0, 1, data, sizeof(data)), (ssize_t)sizeof(data));
+	ASSERT_EQ(_log.sync(), 0);
+	const uint32_t committed_size = _log.size();
+
+	fill(data, sizeof(data), 2);
+	ASSERT_EQ(_log.write(0, 1, data, sizeof(data)), (ssize_t)sizeof(data));
+	_log.close();
+
+	// simulate a power loss in the middle of the last record
+	ASSERT_EQ(truncate(log_path, committed_size + 20), 0);
+
+	ASSERT_EQ(_log.open(log_path), 0);
+	EXPECT_EQ(_log.size(), committed_size);
+
+	fill(data, sizeof(data), 1);
+	ASSERT_EQ(_log.read(0, 1, read_data, sizeof(read_data)), (ssize_t)sizeof(data));
+	EXPECT_EQ(memcmp(data, read_data, sizeof(data)), 0);
+
+	// a corrupted record invalidates everything after it
+	_log.close();
+	int fd = open(log_path, O_RDWR);
+	ASSERT_GE(fd, 0);
+	const uint8_t garbage = 0xff;
+	ASSERT_EQ(pwrite(fd, &garbage, 1, committed_size - 1), 1);
+	close(fd);
+
+	ASSERT_EQ(_log.open(log_path), 0);
+	EXPECT_EQ(_log.read(0, 1, read_data, sizeof(read_data)), 0);
+	EXPECT_EQ(_log.read(0, 0, read_data, sizeof(read_data)), (ssize_t)sizeof(data));
+}
+
+TEST_F(DatamanLogTest, ClearAndCompact)
+{
+	uint8_t data[56];
+	uint8_t read_data[56];
+
+	fill(data, sizeof(data), 3);
+	ASSERT_EQ(_log.write(2, 0, data, sizeof(data)), (ssize_t)sizeof(data));
+
+	// rewrite the same mission many times
+	for (unsigned upload = 0; upload < 10; ++upload) {
+		for (unsigned index = 0; index < max_index[1]; ++index) {
+			fill(data, sizeof(data), upload + index);
+			ASSERT_EQ(_log.write(1, index, data, sizeof(data)), (ssize_t)sizeof(data));
+		}
+
+		ASSERT_EQ(_log.sync(), 0);
+	}
+
+	ASSERT_EQ(_log.clear(0), 0);
+	EXPECT_TRUE(_log.needsCompaction());
+
+	const uint32_t live_size = _log.liveSize();
+	ASSERT_EQ(_log.compact(), 0);
+	EXPECT_FALSE(_log.needsCompaction());
+	EXPECT_EQ(_log.liveSize(), live_size);
+	EXPECT_EQ(_log.size(), live_size + 8);
+
+	ASSERT_EQ(_log.clear(2), 0);
+	_log.close();
+	ASSERT_EQ(_log.open(log_path), 0);
+
+	EXPECT_EQ(_log.read(2, 0, read_data, sizeof(read_data)), 0);
+
+	for (unsigned index = 0; index < max_index[1]; ++index) {
+		fill(data, sizeof(data), 9 + index);
+		ASSERT_EQ(_log.read(1, index, read_data, sizeof(read_data)), (ssize_t)sizeof(data));
+		EXPECT_EQ(memcmp(data, read_data, sizeof(data)), 0);
+	}
+}
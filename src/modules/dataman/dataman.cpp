@@ -59,6 +59,10 @@
 
 #include "dataman.h"
 
+#ifdef CONFIG_DATAMAN_LOG_STORAGE
+#include "DatamanLog.hpp"
+#endif
+
 __BEGIN_DECLS
 __EXPORT int dataman_main(int argc, char *argv[]);
 __END_DECLS
@@ -74,6 +78,17 @@ static int _file_initialize(unsigned max_offset);
 static void _file_shutdown();
 #endif
 
+#ifdef CONFIG_DATAMAN_LOG_STORAGE
+/* Private log-structured file based Operations */
+static ssize_t _log_write(dm_item_t item, unsigned index, const void *buf, size_t count);
+static ssize_t _log_read(dm_item_t item, unsigned index, void *buf, size_t count);
+static int _log_clear(dm_item_t item);
+static int _log_initialize(unsigned max_offset);
+static void _log_shutdown();
+static int _log_sync();
+static void _log_idle();
+#endif
+
 /* Private Ram based Operations */
 static ssize_t _ram_write(dm_item_t item, unsigned index, const void *buf, size_t count);
 static ssize_t _ram_read(dm_item_t item, unsigned index, void *buf, size_t count);
@@ -88,6 +103,8 @@ typedef struct dm_operations_t {
 	int (*initialize)(unsigned max_offset);
 	void (*shutdown)();
 	int (*wait)(px4_sem_t *sem);
+	int (*sync)();		///< commit pending writes, responses to writes are deferred until then (optional)
+	void (*idle)();		///< background maintenance while there are no requests (optional)
 } dm_operations_t;
 
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
@@ -98,6 +115,21 @@ static constexpr dm_operations_t dm_file_operations = {
 	.initialize = _file_initialize,
 	.shutdown = _file_shutdown,
 	.wait = px4_sem_wait,
+	.sync = nullptr,
+	.idle = nullptr,
+};
+#endif
+
+#ifdef CONFIG_DATAMAN_LOG_STORAGE
+static constexpr dm_operations_t dm_log_operations = {
+	.write   = _log_write,
+	.read    = _log_read,
+	.clear   = _log_clear,
+	.initialize = _log_initialize,
+	.shutdown = _log_shutdown,
+	.wait = px4_sem_wait,
+	.sync = _log_sync,
+	.idle = _log_idle,
 };
 #endif
 
@@ -108,6 +140,8 @@ static constexpr dm_operations_t dm_ram_operations = {
 	.initialize = _ram_initialize,
 	.shutdown = _ram_shutdown,
 	.wait = px4_sem_wait,
+	.sync = nullptr,
+	.idle = nullptr,
 };
 
 static const dm_operations_t *g_dm_ops;
@@ -121,6 +155,11 @@ static struct {
 			uint8_t *data;
 			uint8_t *data_end;
 		} ram;
+#ifdef CONFIG_DATAMAN_LOG_STORAGE
+		struct {
+			DatamanLog *log;
+		} log;
+#endif
 	};
 	bool running;
 	bool silence = false;
@@ -159,17 +198,64 @@ static const char *default_device_path = PX4_STORAGEDIR "/dataman";
 static char *k_data_manager_device_path = nullptr;
 #endif
 
+#ifdef CONFIG_DATAMAN_LOG_STORAGE
+/* The log uses its own file, its format is not compatible with the file backend */
+static const char *default_log_device_path = PX4_STORAGEDIR "/dataman.log";
+#endif
+
 static enum {
 	BACKEND_NONE = 0,
 	BACKEND_FILE,
 	BACKEND_RAM,
+	BACKEND_LOG,
 	BACKEND_LAST
 } backend = BACKEND_NONE;
 
 static px4_sem_t g_init_sema;
 
+/* Write responses waiting for the backend to commit, at most one per queued request */
+static constexpr unsigned DEFERRED_RESPONSES_MAX = dataman_request_s::ORB_QUEUE_LENGTH;
+static dataman_response_s g_deferred_responses[DEFERRED_RESPONSES_MAX];
+static unsigned g_num_deferred_responses = 0;
+
+/* Recently applied writes and clears of a backend with deferred commits. A client retries after 100 ms,
+ * which a slow commit can exceed, the retry must not be appended to the log a second time. */
+struct applied_request_s {
+	uint8_t client_id;
+	uint16_t sequence;
+};
+static constexpr unsigned APPLIED_REQUESTS_MAX = 2 * dataman_request_s::ORB_QUEUE_LENGTH;
+static applied_request_s g_applied_requests[APPLIED_REQUESTS_MAX] {};
+static unsigned g_applied_requests_next = 0;
+
 static bool g_task_should_exit;	/**< if true, dataman task should exit */
 
+static bool
+is_applied_request(const dataman_request_s &request)
+{
+	if (!g_dm_ops->sync || (request.sequence == 0)) {
+		return false;
+	}
+
+	for (const applied_request_s &applied : g_applied_requests) {
+		if ((applied.client_id == request.client_id) && (applied.sequence == request.sequence)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void
+add_applied_request(const dataman_request_s &request)
+{
+	if (g_dm_ops->sync && (request.sequence != 0)) {
+		g_applied_requests[g_applied_requests_next].client_id = request.client_id;
+		g_applied_requests[g_applied_requests_next].sequence = request.sequence;
+		g_applied_requests_next = (g_applied_requests_next + 1) % APPLIED_REQUESTS_MAX;
+	}
+}
+
 /* Work queue management functions */
 
 static bool is_running()
@@ -542,27 +628,10 @@ _file_clear(dm_item_t item)
 #endif
 
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
-static int
-_file_initialize(unsigned max_offset)
+/* Reset the stored items if the storage is new or was written by an incompatible version */
+static void
+reset_incompatible_storage(bool storage_existed)
 {
-	const bool file_existed = (access(k_data_manager_device_path, F_OK) == 0);
-
-	/* Open or create the data manager file */
-	dm_operations_data.file.fd = open(k_data_manager_device_path, O_RDWR | O_CREAT | O_BINARY, PX4_O_MODE_666);
-
-	if (dm_operations_data.file.fd < 0) {
-		PX4_WARN("Could not open data manager file %s", k_data_manager_device_path);
-		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
-		return -1;
-	}
-
-	if ((unsigned)lseek(dm_operations_data.file.fd, max_offset, SEEK_SET) != max_offset) {
-		close(dm_operations_data.file.fd);
-		PX4_WARN("Could not seek data manager file %s", k_data_manager_device_path);
-		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
-		return -1;
-	}
-
 	dataman_compat_s compat_state{};
 
 	dm_operations_data.silence = true;
@@ -571,7 +640,7 @@ _file_initialize(unsigned max_offset)
 
 	dm_operations_data.silence = false;
 
-	if (!file_existed || (compat_state.key != DM_COMPAT_KEY)) {
+	if (!storage_existed || (compat_state.key != DM_COMPAT_KEY)) {
 
 		/* Write current compat info */
 		compat_state.key = DM_COMPAT_KEY;
@@ -602,6 +671,32 @@ _file_initialize(unsigned max_offset)
 		g_dm_ops->write(DM_KEY_FENCE_POINTS_STATE, 0, reinterpret_cast<uint8_t *>(&stats), sizeof(mission_stats_entry_s));
 		g_dm_ops->write(DM_KEY_SAFE_POINTS_STATE, 0, reinterpret_cast<uint8_t *>(&stats), sizeof(mission_stats_entry_s));
 	}
+}
+#endif
+
+#ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
+static int
+_file_initialize(unsigned max_offset)
+{
+	const bool file_existed = (access(k_data_manager_device_path, F_OK) == 0);
+
+	/* Open or create the data manager file */
+	dm_operations_data.file.fd = open(k_data_manager_device_path, O_RDWR | O_CREAT | O_BINARY, PX4_O_MODE_666);
+
+	if (dm_operations_data.file.fd < 0) {
+		PX4_WARN("Could not open data manager file %s", k_data_manager_device_path);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	if ((unsigned)lseek(dm_operations_data.file.fd, max_offset, SEEK_SET) != max_offset) {
+		close(dm_operations_data.file.fd);
+		PX4_WARN("Could not seek data manager file %s", k_data_manager_device_path);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	reset_incompatible_storage(file_existed);
 
 	dm_operations_data.running = true;
 
@@ -644,6 +739,111 @@ _ram_shutdown()
 	dm_operations_data.running = false;
 }
 
+#ifdef CONFIG_DATAMAN_LOG_STORAGE
+static ssize_t
+_log_write(dm_item_t item, unsigned index, const void *buf, size_t count)
+{
+	/* Make sure caller has not given us more data than we can handle */
+	if ((item < DM_KEY_NUM_KEYS) && (count > g_per_item_size[item])) {
+		return -E2BIG;
+	}
+
+	return dm_operations_data.log.log->write(item, index, buf, count);
+}
+
+static ssize_t
+_log_read(dm_item_t item, unsigned index, void *buf, size_t count)
+{
+	return dm_operations_data.log.log->read(item, index, buf, count);
+}
+
+static int
+_log_clear(dm_item_t item)
+{
+	return dm_operations_data.log.log->clear(item);
+}
+
+static int
+_log_initialize(unsigned max_offset)
+{
+	dm_operations_data.log.log = new DatamanLog(g_per_item_max_index, DM_KEY_NUM_KEYS);
+
+	if (dm_operations_data.log.log == nullptr) {
+		PX4_WARN("Could not allocate dataman log");
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	const int ret = dm_operations_data.log.log->open(k_data_manager_device_path);
+
+	if (ret != 0) {
+		PX4_WARN("Could not open data manager log %s (%d)", k_data_manager_device_path, ret);
+		delete dm_operations_data.log.log;
+		dm_operations_data.log.log = nullptr;
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	reset_incompatible_storage(dm_operations_data.log.log->existed());
+	dm_operations_data.log.log->sync();
+
+	dm_operations_data.running = true;
+
+	return 0;
+}
+
+static void
+_log_shutdown()
+{
+	delete dm_operations_data.log.log;
+	dm_operations_data.log.log = nullptr;
+	dm_operations_data.running = false;
+}
+
+static int
+_log_sync()
+{
+	return dm_operations_data.log.log->sync();
+}
+
+static void
+_log_idle()
+{
+	if (dm_operations_data.log.log->needsCompaction()) {
+		dm_operations_data.log.log->compact();
+	}
+}
+#endif
+
+static void
+publish_deferred_responses(uORB::Publication<dataman_response_s> &dataman_response_pub)
+{
+	if (g_num_deferred_responses == 0) {
+		return;
+	}
+
+	const bool synced = (g_dm_ops->sync() == 0);
+
+	if (!synced) {
+		// the writes were not committed, let the retries through
+		memset(g_applied_requests, 0, sizeof(g_applied_requests));
+	}
+
+	for (unsigned i = 0; i < g_num_deferred_responses; ++i) {
+		dataman_response_s &response = g_deferred_responses[i];
+
+		if (!synced && (response.status == dataman_response_s::STATUS_SUCCESS)) {
+			response.status = (response.request_type == DM_WRITE) ? dataman_response_s::STATUS_FAILURE_WRITE_FAILED :
+					  dataman_response_s::STATUS_FAILURE_CLEAR_FAILED;
+		}
+
+		response.timestamp = hrt_absolute_time();
+		dataman_response_pub.publish(response);
+	}
+
+	g_num_deferred_responses = 0;
+}
+
 static int
 task_main(int argc, char *argv[])
 {
@@ -660,6 +860,13 @@ task_main(int argc, char *argv[])
 		g_dm_ops = &dm_ram_operations;
 		break;
 
+#ifdef CONFIG_DATAMAN_LOG_STORAGE
+
+	case BACKEND_LOG:
+		g_dm_ops = &dm_log_operations;
+		break;
+#endif
+
 	default:
 		PX4_WARN("No valid backend set.");
 		return -1;
@@ -711,6 +918,14 @@ task_main(int argc, char *argv[])
 		PX4_INFO("data manager RAM size is %u bytes", max_offset);
 		break;
 
+#ifdef CONFIG_DATAMAN_LOG_STORAGE
+
+	case BACKEND_LOG:
+		PX4_INFO("data manager log '%s' size is %" PRIu32 " bytes", k_data_manager_device_path,
+			 dm_operations_data.log.log->size());
+		break;
+#endif
+
 	default:
 		break;
 	}
@@ -732,7 +947,8 @@ task_main(int argc, char *argv[])
 			bool updated = false;
 			orb_check(dataman_request_sub, &updated);
 
-			if (updated) {
+			// Serve all queued requests, clients can have several requests in flight
+			while (updated) {
 
 				dataman_request_s request;
 				orb_copy(ORB_ID(dataman_request), dataman_request_sub, &request);
@@ -742,6 +958,7 @@ task_main(int argc, char *argv[])
 				response.request_type = request.request_type;
 				response.item = request.item;
 				response.index = request.index;
+				response.tag = request.tag;
 				response.status = dataman_response_s::STATUS_FAILURE_NO_DATA;
 
 				ssize_t result;
@@ -763,6 +980,12 @@ task_main(int argc, char *argv[])
 
 				case DM_WRITE:
 
+					if (is_applied_request(request)) {
+						// retry of a write that was already applied
+						response.status = dataman_response_s::STATUS_SUCCESS;
+						break;
+					}
+
 					g_func_counts[DM_WRITE]++;
 					perf_begin(_dm_write_perf);
 					result = g_dm_ops->write(static_cast<dm_item_t>(request.item), request.index,
@@ -771,6 +994,7 @@ task_main(int argc, char *argv[])
 
 					if (result > 0) {
 						response.status = dataman_response_s::STATUS_SUCCESS;
+						add_applied_request(request);
 
 					} else {
 						response.status = dataman_response_s::STATUS_FAILURE_WRITE_FAILED;
@@ -798,11 +1022,17 @@ task_main(int argc, char *argv[])
 
 				case DM_CLEAR:
 
+					if (is_applied_request(request)) {
+						response.status = dataman_response_s::STATUS_SUCCESS;
+						break;
+					}
+
 					g_func_counts[DM_CLEAR]++;
 					result = g_dm_ops->clear(static_cast<dm_item_t>(request.item));
 
 					if (result == 0) {
 						response.status = dataman_response_s::STATUS_SUCCESS;
+						add_applied_request(request);
 
 					} else {
 						response.status = dataman_response_s::STATUS_FAILURE_CLEAR_FAILED;
@@ -816,8 +1046,26 @@ task_main(int argc, char *argv[])
 				}
 
 				response.timestamp = hrt_absolute_time();
-				dataman_response_pub.publish(response);
+
+				if (g_dm_ops->sync && ((request.request_type == DM_WRITE) || (request.request_type == DM_CLEAR))) {
+					/* Group commit: acknowledge writes only once they are persistent */
+					g_deferred_responses[g_num_deferred_responses++] = response;
+
+					if (g_num_deferred_responses == DEFERRED_RESPONSES_MAX) {
+						publish_deferred_responses(dataman_response_pub);
+					}
+
+				} else {
+					dataman_response_pub.publish(response);
+				}
+
+				orb_check(dataman_request_sub, &updated);
 			}
+
+			publish_deferred_responses(dataman_response_pub);
+
+		} else if ((ret == 0) && g_dm_ops->idle) {
+			g_dm_ops->idle();
 		}
 
 		/* time to go???? */
@@ -877,7 +1125,94 @@ status()
 
 	perf_print_counter(_dm_read_perf);
 	perf_print_counter(_dm_write_perf);
+
+#ifdef CONFIG_DATAMAN_LOG_STORAGE
+
+	if (backend == BACKEND_LOG) {
+		dm_operations_data.log.log->printStatus();
+	}
+
+#endif
+}
+
+#ifdef CONFIG_DATAMAN_LOG_STORAGE
+static void
+bench_print(const char *name, unsigned num_items, hrt_abstime elapsed)
+{
+	PX4_INFO("%-32s %8.1f ms %10.1f items/s", name, (double)elapsed / 1e3,
+		 (double)num_items / ((double)elapsed / 1e6));
+}
+
+/* Compare writing a mission with the file backend pattern to the log backend */
+static int
+bench(const char *path, unsigned num_items)
+{
+	uint8_t buffer[MISSION_ITEM_SIZE + DM_SECTOR_HDR_SIZE] {};
+	buffer[0] = MISSION_ITEM_SIZE;
+
+	/* File backend: seek, write and fsync for every item */
+	int fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_BINARY, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("open %s failed (%i)", path, errno);
+		return -1;
+	}
+
+	hrt_abstime start = hrt_absolute_time();
+
+	for (unsigned index = 0; index < num_items; ++index) {
+		buffer[DM_SECTOR_HDR_SIZE] = index;
+		const off_t offset = index * sizeof(buffer);
+
+		if ((lseek(fd, offset, SEEK_SET) != offset) || (write(fd, buffer, sizeof(buffer)) != sizeof(buffer))) {
+			PX4_ERR("write failed (%i)", errno);
+			break;
+		}
+
+		fsync(fd);
+	}
+
+	bench_print("file: fsync per item", num_items, hrt_elapsed_time(&start));
+	close(fd);
+	unlink(path);
+
+	/* Log backend: commit once per request window (as the dataman task does) and once per upload */
+	const unsigned max_index[] = {num_items};
+	const unsigned commit_intervals[] = {DEFERRED_RESPONSES_MAX, num_items};
+	const char *names[] = {"log: fsync per request window", "log: fsync per upload"};
+
+	for (unsigned i = 0; i < sizeof(commit_intervals) / sizeof(commit_intervals[0]); ++i) {
+		DatamanLog *log = new DatamanLog(max_index, 1);
+
+		if ((log == nullptr) || (log->open(path) != 0)) {
+			PX4_ERR("log open %s failed", path);
+			delete log;
+			return -1;
+		}
+
+		start = hrt_absolute_time();
+
+		for (unsigned index = 0; index < num_items; ++index) {
+			buffer[DM_SECTOR_HDR_SIZE] = index;
+
+			if (log->write(0, index, buffer + DM_SECTOR_HDR_SIZE, MISSION_ITEM_SIZE) != MISSION_ITEM_SIZE) {
+				PX4_ERR("log write failed");
+				break;
+			}
+
+			if (((index + 1) % commit_intervals[i] == 0) || (index + 1 == num_items)) {
+				log->sync();
+			}
+		}
+
+		bench_print(names[i], num_items, hrt_elapsed_time(&start));
+		delete log;
+		unlink(path);
+	}
+
+	return 0;
 }
+#endif
 
 static void
 stop()
@@ -903,6 +1238,10 @@ Each type has a specific type and a fixed maximum amount of storage items, so th
 ### Implementation
 Reading and writing a single item is always atomic.
 
+The log-structured backend (-l) appends every write to a journal and keeps an index of the latest record of each item
+in RAM. Writes received together are committed with a single fsync before they are acknowledged, and stale records are
+compacted while dataman is idle. The file uses a different format than the default file backend.
+
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("dataman", "system");
@@ -911,8 +1250,16 @@ Reading and writing a single item is always atomic.
 	PRINT_MODULE_USAGE_PARAM_STRING('f', nullptr, "<file>", "Storage file", true);
 #endif
 	PRINT_MODULE_USAGE_PARAM_FLAG('r', "Use RAM backend (NOT persistent)", true);
+#ifdef CONFIG_DATAMAN_LOG_STORAGE
+	PRINT_MODULE_USAGE_PARAM_FLAG('l', "Use log-structured file backend (file 'dataman.log' unless set with -f)", true);
+#endif
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
 	PRINT_MODULE_USAGE_PARAM_COMMENT("The options -f and -r are mutually exclusive. If nothing is specified, a file 'dataman' is used");
+#endif
+#ifdef CONFIG_DATAMAN_LOG_STORAGE
+	PRINT_MODULE_USAGE_COMMAND_DESCR("bench", "Benchmark mission writes of the file and log backends");
+	PRINT_MODULE_USAGE_PARAM_STRING('f', PX4_STORAGEDIR "/dataman_bench", "<file>", "Temporary file", true);
+	PRINT_MODULE_USAGE_PARAM_INT('n', 500, 1, 65535, "Number of items", true);
 #endif
 	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
 }
@@ -936,6 +1283,41 @@ dataman_main(int argc, char *argv[])
 		return -1;
 	}
 
+#ifdef CONFIG_DATAMAN_LOG_STORAGE
+
+	if (!strcmp(argv[1], "bench")) {
+		int ch;
+		int dmoptind = 1;
+		const char *dmoptarg = nullptr;
+		const char *path = PX4_STORAGEDIR "/dataman_bench";
+		int num_items = 500;
+
+		while ((ch = px4_getopt(argc, argv, "f:n:", &dmoptind, &dmoptarg)) != EOF) {
+			switch (ch) {
+			case 'f':
+				path = dmoptarg;
+				break;
+
+			case 'n':
+				num_items = strtol(dmoptarg, nullptr, 0);
+				break;
+
+			default:
+				usage();
+				return -1;
+			}
+		}
+
+		if ((num_items < 1) || (num_items > UINT16_MAX)) {
+			usage();
+			return -1;
+		}
+
+		return bench(path, num_items);
+	}
+
+#endif
+
 	if (!strcmp(argv[1], "start")) {
 
 		if (is_running()) {
@@ -946,10 +1328,11 @@ dataman_main(int argc, char *argv[])
 		int ch;
 		int dmoptind = 1;
 		const char *dmoptarg = nullptr;
+		bool use_log = false;
 
 		/* jump over start and look at options first */
 
-		while ((ch = px4_getopt(argc, argv, "f:r", &dmoptind, &dmoptarg)) != EOF) {
+		while ((ch = px4_getopt(argc, argv, "f:rl", &dmoptind, &dmoptarg)) != EOF) {
 			switch (ch) {
 			case 'f':
 				if (backend_check()) {
@@ -974,6 +1357,14 @@ dataman_main(int argc, char *argv[])
 				backend = BACKEND_RAM;
 				break;
 
+			case 'l':
+#ifdef CONFIG_DATAMAN_LOG_STORAGE
+				use_log = true;
+#else
+				PX4_WARN("dataman does not support log-structured storage. Using the default backend.");
+#endif
+				break;
+
 			//no break
 			default:
 				usage();
@@ -981,6 +1372,26 @@ dataman_main(int argc, char *argv[])
 			}
 		}
 
+#ifdef CONFIG_DATAMAN_LOG_STORAGE
+
+		if (use_log) {
+			if (backend == BACKEND_RAM) {
+				PX4_WARN("-l and -r are mutually exclusive");
+				usage();
+				return -1;
+			}
+
+			if (backend == BACKEND_NONE) {
+				k_data_manager_device_path = strdup(default_log_device_path);
+			}
+
+			backend = BACKEND_LOG;
+		}
+
+#else
+		(void)use_log;
+#endif
+
 		if (backend == BACKEND_NONE) {
 #ifdef CONFIG_DATAMAN_PERSISTENT_STORAGE
 			backend = BACKEND_FILE;
@@ -37,12 +37,15 @@
  * If the board supports persistent storage (i.e., the KConfig variable DATAMAN_PERSISTENT_STORAGE is set),
  * the 'Default storage' backend uses a file on persistent storage. If not supported, this backend uses
  * non-persistent storage in RAM.
+ * The 'Log-structured storage' backend (KConfig variable DATAMAN_LOG_STORAGE) uses a journal file with
+ * grouped commits, which needs far fewer flash writes for mission uploads. It falls back to the default
+ * storage if not supported. Changing between file based backends does not migrate the stored data.
  *
  * @group System
  * @value -1 Dataman disabled
  * @value 0 Default storage
  * @value 1 RAM storage
- * @boolean
+ * @value 2 Log-structured storage
  * @reboot_required true
  */
 PARAM_DEFINE_INT32(SYS_DM_BACKEND, 0);
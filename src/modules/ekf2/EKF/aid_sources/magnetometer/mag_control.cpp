@@ -626,9 +626,10 @@ float Ekf::getMagDeclination()
 bool Ekf::updateWorldMagneticModel(const double latitude_deg, const double longitude_deg)
 {
 	// set the magnetic field data returned by the geo library using the current GPS position
-	const float declination_rad = math::radians(get_mag_declination_degrees(latitude_deg, longitude_deg));
-	const float inclination_rad = math::radians(get_mag_inclination_degrees(latitude_deg, longitude_deg));
-	const float strength_gauss = get_mag_strength_gauss(latitude_deg, longitude_deg);
+	const MagneticField field = get_mag_field(latitude_deg, longitude_deg);
+	const float declination_rad = math::radians(field.declination_deg);
+	const float inclination_rad = math::radians(field.inclination_deg);
+	const float strength_gauss = field.strength_gauss;
 
 	if (PX4_ISFINITE(declination_rad) && PX4_ISFINITE(inclination_rad) && PX4_ISFINITE(strength_gauss)) {
 
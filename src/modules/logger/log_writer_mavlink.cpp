@@ -68,9 +68,16 @@ void LogWriterMavlink::start_log()
 		_ulog_stream_ack_sub = orb_subscribe(ORB_ID(ulog_stream_ack));
 	}
 
-	// make sure we don't get any stale ack's by doing an orb_copy
-	ulog_stream_ack_s ack;
-	orb_copy(ORB_ID(ulog_stream_ack), _ulog_stream_ack_sub, &ack);
+	// make sure we don't get any stale ack's by draining the queue
+	bool updated = true;
+
+	while (orb_check(_ulog_stream_ack_sub, &updated) == 0 && updated) {
+		ulog_stream_ack_s ack;
+		orb_copy(ORB_ID(ulog_stream_ack), _ulog_stream_ack_sub, &ack);
+	}
+
+	_num_unacked = 0;
+	_ack_window_size = 1;
 
 	_ulog_stream_data.msg_sequence = 0;
 	_ulog_stream_data.length = 0;
@@ -122,6 +129,12 @@ void LogWriterMavlink::set_need_reliable_transfer(bool need_reliable)
 			// make sure to send previous data using reliable transfer
 			publish_message();
 		}
+
+		// everything sent reliably must be acked before continuing with unreliable data
+		if (is_started() && wait_for_acks(true)) {
+			PX4_ERR("Ack timeout. Stopping mavlink log");
+			stop_log();
+		}
 	}
 
 	_need_reliable_transfer = need_reliable;
@@ -139,37 +152,15 @@ int LogWriterMavlink::publish_message()
 	_ulog_stream_pub.publish(_ulog_stream_data);
 
 	if (_need_reliable_transfer) {
-		// we need to wait for an ack. Note that this blocks the main logger thread, so if a file logging
-		// is already running, it will miss samples.
-		px4_pollfd_struct_t fds[1];
-		fds[0].fd = _ulog_stream_ack_sub;
-		fds[0].events = POLLIN;
-		bool got_ack = false;
-		const int timeout_ms = ulog_stream_ack_s::ACK_TIMEOUT * ulog_stream_ack_s::ACK_MAX_TRIES;
+		// We need to wait for an ack, or with a window for a free slot. Note that this blocks the main
+		// logger thread, so if a file logging is already running, it will miss samples.
+		if (_num_unacked < ulog_stream_ack_s::MAX_WINDOW_SIZE) {
+			_unacked_sequences[_num_unacked++] = _ulog_stream_data.msg_sequence;
+		}
 
 		hrt_abstime started = hrt_absolute_time();
 
-		do {
-			int ret = px4_poll(fds, sizeof(fds) / sizeof(fds[0]), timeout_ms);
-
-			if (ret <= 0) {
-				break;
-			}
-
-			if (fds[0].revents & POLLIN) {
-				ulog_stream_ack_s ack;
-				orb_copy(ORB_ID(ulog_stream_ack), _ulog_stream_ack_sub, &ack);
-
-				if (ack.msg_sequence == _ulog_stream_data.msg_sequence) {
-					got_ack = true;
-				}
-
-			} else {
-				break;
-			}
-		} while (!got_ack && hrt_elapsed_time(&started) / 1000 < timeout_ms);
-
-		if (!got_ack) {
+		if (wait_for_acks(false)) {
 			PX4_ERR("Ack timeout. Stopping mavlink log");
 			stop_log();
 			return -2;
@@ -184,5 +175,45 @@ int LogWriterMavlink::publish_message()
 	return 0;
 }
 
+int LogWriterMavlink::wait_for_acks(bool all)
+{
+	px4_pollfd_struct_t fds[1];
+	fds[0].fd = _ulog_stream_ack_sub;
+	fds[0].events = POLLIN;
+	const int timeout_ms = ulog_stream_ack_s::ACK_TIMEOUT * ulog_stream_ack_s::ACK_MAX_TRIES;
+
+	hrt_abstime started = hrt_absolute_time();
+
+	// the window size is re-evaluated on every ack, it grows once the streamer announced it
+	while (_num_unacked > (all ? 0 : _ack_window_size - 1)) {
+		if (hrt_elapsed_time(&started) / 1000 >= (hrt_abstime)timeout_ms) {
+			return -1;
+		}
+
+		int ret = px4_poll(fds, sizeof(fds) / sizeof(fds[0]), timeout_ms);
+
+		if (ret <= 0 || !(fds[0].revents & POLLIN)) {
+			return -1;
+		}
+
+		ulog_stream_ack_s ack;
+		orb_copy(ORB_ID(ulog_stream_ack), _ulog_stream_ack_sub, &ack);
+		handle_ack(ack);
+	}
+
+	return 0;
+}
+
+void LogWriterMavlink::handle_ack(const ulog_stream_ack_s &ack)
+{
+	for (int i = 0; i < _num_unacked; i++) {
+		if (_unacked_sequences[i] == ack.msg_sequence) {
+			_unacked_sequences[i] = _unacked_sequences[--_num_unacked];
+			_ack_window_size = math::constrain((int)ack.window_size, 1, (int)ulog_stream_ack_s::MAX_WINDOW_SIZE);
+			return;
+		}
+	}
+}
+
 }
 }
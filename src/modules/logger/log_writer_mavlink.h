@@ -76,9 +76,21 @@ private:
 	/** publish message, wait for ack if needed & reset message */
 	int publish_message();
 
+	/**
+	 * process incoming acks until the window has a free slot
+	 * @param all wait until all messages are acked
+	 * @return 0 on success, -1 on timeout
+	 */
+	int wait_for_acks(bool all);
+
+	void handle_ack(const ulog_stream_ack_s &ack);
+
 	ulog_stream_s _ulog_stream_data{};
 	uORB::Publication<ulog_stream_s> _ulog_stream_pub{ORB_ID(ulog_stream)};
 	int _ulog_stream_ack_sub{-1};
+	uint16_t _unacked_sequences[ulog_stream_ack_s::MAX_WINDOW_SIZE] {}; ///< reliable messages in flight
+	int _num_unacked{0};
+	int _ack_window_size{1}; ///< as announced by the streamer, 1 until the first ack arrives
 	bool _need_reliable_transfer{false};
 	bool _is_started{false};
 };
@@ -42,7 +42,10 @@
 #include <errno.h>
 #include <cstring>
 
+#include <mathlib/mathlib.h>
+
 #include "mavlink_ftp.h"
+#include "mavlink_parameter_blob.h"
 #include "mavlink_tests/mavlink_ftp_test.h"
 
 #include "mavlink_main.h"
@@ -50,6 +53,7 @@
 using namespace time_literals;
 
 constexpr const char MavlinkFTP::_root_dir[];
+constexpr const char MavlinkFTP::kParameterBlobFile[];
 
 MavlinkFTP::MavlinkFTP(Mavlink &mavlink) :
 	_mavlink(mavlink)
@@ -62,6 +66,7 @@ MavlinkFTP::~MavlinkFTP()
 {
 	delete[] _work_buffer1;
 	delete[] _work_buffer2;
+	delete[] _read_ahead_buffer;
 }
 
 unsigned
@@ -309,6 +314,17 @@ bool MavlinkFTP::_ensure_buffers_exist()
 		_work_buffer2 = new char[_work_buffer2_len];
 	}
 
+	// optional, reads go directly to the file if this fails
+	if (!_read_ahead_buffer) {
+		_read_ahead_buffer = new uint8_t[2 * kReadAheadBlockSize];
+
+		if (_read_ahead_buffer) {
+			_read_ahead[0].data = _read_ahead_buffer;
+			_read_ahead[1].data = _read_ahead_buffer + kReadAheadBlockSize;
+			_invalidateReadAhead();
+		}
+	}
+
 	return _work_buffer1 && _work_buffer2;
 }
 
@@ -508,7 +524,21 @@ MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 		return kErrNoSessionsAvailable;
 	}
 
-	_constructPath(_work_buffer1, _work_buffer1_len, _data_as_cstring(payload));
+	if (oflag == O_RDONLY && strcmp(_data_as_cstring(payload), MavlinkParameterBlob::FTP_PATH) == 0) {
+		// virtual file: export the current parameter set, then serve it like any other file
+		snprintf(_work_buffer1, _work_buffer1_len, kParameterBlobFile, _mavlink.get_instance_id());
+
+		int ret = MavlinkParameterBlob::write(_work_buffer1);
+
+		if (ret != 0) {
+			_our_errno = -ret;
+			PX4_ERR("parameter export failed: %s", strerror(_our_errno));
+			return kErrFailErrno;
+		}
+
+	} else {
+		_constructPath(_work_buffer1, _work_buffer1_len, _data_as_cstring(payload));
+	}
 
 	PX4_DEBUG("FTP: open '%s'", _work_buffer1);
 
@@ -544,6 +574,9 @@ MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 	_session_info.fd = fd;
 	_session_info.file_size = fileSize;
 	_session_info.stream_download = false;
+	_session_info.stream_offset = 0;
+	_session_info.stream_burst_loss = false;
+	_invalidateReadAhead();
 
 	payload->session = 0;
 	payload->size = sizeof(uint32_t);
@@ -568,15 +601,12 @@ MavlinkFTP::_workRead(PayloadHeader *payload)
 		return kErrEOF;
 	}
 
-	PX4_DEBUG("lseek with offset: %ld", payload->offset);
-
-	if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-		_our_errno = errno;
-		PX4_ERR("seek fail: %s", strerror(_our_errno));
-		return kErrFailErrno;
+	// reading data before the burst position means the GCS fills a gap of a burst
+	if (payload->offset < _session_info.stream_offset) {
+		_session_info.stream_burst_loss = true;
 	}
 
-	int bytes_read = ::read(_session_info.fd, &payload->data[0], payload->size);
+	int bytes_read = _readSession(payload->offset, &payload->data[0], payload->size);
 
 	if (bytes_read < 0) {
 		// Negative return indicates error other than eof
@@ -600,10 +630,17 @@ MavlinkFTP::_workBurst(PayloadHeader *payload, uint8_t target_system_id, uint8_t
 	}
 
 	PX4_DEBUG("FTP: burst offset:%" PRIu32, payload->offset);
+
+	// restarting before the current position means data of the previous burst got lost
+	if (payload->offset < _session_info.stream_offset) {
+		_session_info.stream_burst_loss = true;
+	}
+
 	// Setup for streaming sends
 	_session_info.stream_download = true;
 	_session_info.stream_offset = payload->offset;
 	_session_info.stream_chunk_transmitted = 0;
+	_session_info.stream_burst_start = hrt_absolute_time();
 	_session_info.stream_seq_number = payload->seq_number + 1;
 	_session_info.stream_target_system_id = target_system_id;
 	_session_info.stream_target_component_id = target_component_id;
@@ -631,6 +668,8 @@ MavlinkFTP::_workWrite(PayloadHeader *payload)
 	}
 
 	PX4_DEBUG("write %d bytes", payload->size);
+	_invalidateReadAhead();
+
 	int bytes_written = ::write(_session_info.fd, &payload->data[0], payload->size);
 
 	if (bytes_written < 0) {
@@ -798,6 +837,7 @@ MavlinkFTP::_workTerminate(PayloadHeader *payload)
 	::close(_session_info.fd);
 	_session_info.fd = -1;
 	_session_info.stream_download = false;
+	_invalidateReadAhead();
 
 	payload->size = 0;
 
@@ -1025,6 +1065,9 @@ void MavlinkFTP::send()
 				delete[] _work_buffer2;
 				_work_buffer2 = nullptr;
 			}
+
+			delete[] _read_ahead_buffer;
+			_read_ahead_buffer = nullptr;
 		}
 
 	} else if (_session_info.fd != -1) {
@@ -1082,18 +1125,12 @@ void MavlinkFTP::send()
 		}
 
 		if (error_code == kErrNone) {
-			if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-				error_code = kErrFailErrno;
-				PX4_WARN("stream download: seek fail");
-			}
-		}
-
-		if (error_code == kErrNone) {
-			int bytes_read = ::read(_session_info.fd, &payload->data[0], kMaxDataLength);
+			int bytes_read = _readSession(payload->offset, &payload->data[0], kMaxDataLength);
 
 			if (bytes_read < 0) {
 				// Negative return indicates error other than eof
 				error_code = kErrFailErrno;
+				_our_errno = errno;
 				PX4_WARN("stream download: read fail");
 
 			} else {
@@ -1122,10 +1159,11 @@ void MavlinkFTP::send()
 			if (max_bytes_to_send < (get_size() * 2)) {
 				more_data = false;
 
-				/* perform transfers in 35K chunks - this is determined empirical */
-				if (_session_info.stream_chunk_transmitted > 35000) {
+				/* perform transfers in chunks of the burst window */
+				if (_session_info.stream_chunk_transmitted > _burst_window) {
 					payload->burst_complete = true;
 					_session_info.stream_download = false;
+					_updateBurstWindow();
 					_session_info.stream_chunk_transmitted = 0;
 				}
 
@@ -1147,6 +1185,92 @@ void MavlinkFTP::send()
 	} while (more_data);
 }
 
+int
+MavlinkFTP::_readSession(uint32_t offset, uint8_t *dst, unsigned len)
+{
+	if (!_read_ahead_buffer) {
+		if (lseek(_session_info.fd, offset, SEEK_SET) < 0) {
+			return -1;
+		}
+
+		return ::read(_session_info.fd, dst, len);
+	}
+
+	unsigned copied = 0;
+
+	while (copied < len) {
+		const uint32_t pos = offset + copied;
+		ReadAheadBlock *block = nullptr;
+
+		for (int i = 0; i < 2; i++) {
+			if (_read_ahead[i].len > 0 && pos >= _read_ahead[i].offset && pos < _read_ahead[i].offset + _read_ahead[i].len) {
+				block = &_read_ahead[i];
+				_read_ahead_next = 1 - i;
+				break;
+			}
+		}
+
+		if (block == nullptr) {
+			// read the whole block containing pos, replacing the least recently used one
+			block = &_read_ahead[_read_ahead_next];
+			_read_ahead_next = 1 - _read_ahead_next;
+
+			block->offset = pos - (pos % kReadAheadBlockSize);
+			block->len = 0;
+
+			if (lseek(_session_info.fd, block->offset, SEEK_SET) < 0) {
+				return -1;
+			}
+
+			const int bytes_read = ::read(_session_info.fd, block->data, kReadAheadBlockSize);
+
+			if (bytes_read < 0) {
+				return -1;
+			}
+
+			block->len = bytes_read;
+
+			if (pos >= block->offset + block->len) {
+				// EOF
+				break;
+			}
+		}
+
+		const unsigned available = block->offset + block->len - pos;
+		const unsigned n = (len - copied < available) ? len - copied : available;
+		memcpy(&dst[copied], &block->data[pos - block->offset], n);
+		copied += n;
+	}
+
+	return copied;
+}
+
+void
+MavlinkFTP::_invalidateReadAhead()
+{
+	_read_ahead[0].len = 0;
+	_read_ahead[1].len = 0;
+}
+
+void
+MavlinkFTP::_updateBurstWindow()
+{
+	const float dt = hrt_elapsed_time(&_session_info.stream_burst_start) * 1e-6f;
+
+	if (_session_info.stream_burst_loss) {
+		// the GCS had to request data again, back off
+		_burst_window = math::max(_burst_window / 2, kBurstWindowMin);
+
+	} else if (dt > 0.f) {
+		// grow, at least to what the link delivered within the targeted burst duration
+		const unsigned target = static_cast<unsigned>(_session_info.stream_chunk_transmitted / dt * kBurstDuration);
+		_burst_window = math::constrain(math::max(_burst_window + _burst_window / 4, target), kBurstWindowMin,
+						kBurstWindowMax);
+	}
+
+	_session_info.stream_burst_loss = false;
+}
+
 bool MavlinkFTP::_validatePathIsWritable(const char *path)
 {
 #ifdef __PX4_NUTTX
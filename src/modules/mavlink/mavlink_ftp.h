@@ -158,6 +158,18 @@ private:
 
 	bool _validatePathIsWritable(const char *path);
 
+	/**
+	 * Read from the session file, using the read-ahead buffer if available
+	 * @return number of bytes read, -1 on error (errno set)
+	 */
+	int _readSession(uint32_t offset, uint8_t *dst, unsigned len);
+
+	/// @brief Drop the read-ahead buffer contents, e.g. when the session file changes
+	void _invalidateReadAhead();
+
+	/// @brief Adapt the burst window at the end of a burst
+	void _updateBurstWindow();
+
 	/**
 	 * make sure that the working buffers _work_buffer* are allocated
 	 * @return true if buffers exist, false if allocation failed
@@ -180,6 +192,8 @@ private:
 		uint8_t		stream_target_system_id;
 		uint8_t         stream_target_component_id;
 		unsigned	stream_chunk_transmitted;
+		hrt_abstime	stream_burst_start;		///< time the current burst started
+		bool		stream_burst_loss;		///< data of the current burst was requested again
 	};
 	struct SessionInfo _session_info {};	///< Session info, fd=-1 for no active session
 
@@ -199,6 +213,33 @@ private:
 	static constexpr int _work_buffer2_len = 256;
 	hrt_abstime _last_work_buffer_access{0}; ///< timestamp when the buffers were last accessed
 
+	/* read-ahead buffer for the session file: two blocks, so that retransmit requests for data of the
+	 * previous block are still served from memory. Allocated and freed together with the work buffers. */
+#if defined(__PX4_POSIX)
+	static constexpr unsigned kReadAheadBlockSize = 32 * 1024;
+#else
+	static constexpr unsigned kReadAheadBlockSize = 1024;
+#endif
+	struct ReadAheadBlock {
+		uint8_t		*data;
+		uint32_t	offset;
+		uint32_t	len;		///< 0 if the block is empty
+	};
+	uint8_t *_read_ahead_buffer{nullptr};
+	ReadAheadBlock _read_ahead[2] {};
+	int _read_ahead_next{0};		///< block to replace next
+
+	/* adaptive burst window: bytes sent per burst before waiting for the next request from the GCS */
+	static constexpr unsigned kBurstWindowDefault = 35000; ///< determined empirically
+	static constexpr unsigned kBurstWindowMin = 4 * 1024;
+#if defined(__PX4_POSIX)
+	static constexpr unsigned kBurstWindowMax = 16 * kBurstWindowDefault;
+#else
+	static constexpr unsigned kBurstWindowMax = 2 * kBurstWindowDefault;
+#endif
+	static constexpr float kBurstDuration = 0.5f; ///< targeted duration of a burst [s]
+	unsigned _burst_window{kBurstWindowDefault};
+
 	// prepend a root directory to each file/dir access to avoid enumerating the full FS tree (e.g. on Linux).
 	// Note that requests can still fall outside of the root dir by using ../..
 #ifdef MAVLINK_FTP_UNIT_TEST
@@ -208,6 +249,10 @@ private:
 #endif
 	static constexpr const int _root_dir_len = sizeof(_root_dir) - 1;
 
+	/// File the parameter export is written to when MavlinkParameterBlob::FTP_PATH is opened,
+	/// one per mavlink instance so that concurrent downloads don't share a file (%d: instance id)
+	static constexpr const char kParameterBlobFile[] = PX4_STORAGEDIR "/params_%d.pxb";
+
 	bool _last_reply_valid = false;
 	uint8_t _last_reply[MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL_LEN - MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN
 								      + sizeof(PayloadHeader) + sizeof(uint32_t)];
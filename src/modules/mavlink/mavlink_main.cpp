@@ -180,6 +180,10 @@ Mavlink::~Mavlink()
 	perf_free(_loop_interval_perf);
 	perf_free(_send_byte_error_perf);
 	perf_free(_forwarding_error_perf);
+
+#if defined(MAVLINK_UDP_BATCH)
+	delete _udp_batch;
+#endif // MAVLINK_UDP_BATCH
 }
 
 void
@@ -760,9 +764,26 @@ void Mavlink::send_finish()
 
 	int ret = -1;
 
+#if defined(MAVLINK_UDP_BATCH)
+
+	// hold the message back, it is sent with the next batch
+	if (_udp_batch != nullptr) {
+		if (!_udp_batch->add(_buf, _buf_fill, _last_write_try_time)) {
+			send_udp_batch();
+			_udp_batch->add(_buf, _buf_fill, _last_write_try_time);
+		}
+
+		_buf_fill = 0;
+		pthread_mutex_unlock(&_send_mutex);
+		return;
+	}
+
+#endif // MAVLINK_UDP_BATCH
+
 	// send message to UART
 	if (get_protocol() == Protocol::SERIAL) {
 		ret = ::write(_uart_fd, _buf, _buf_fill);
+		count_tx_syscalls(1);
 	}
 
 #if defined(MAVLINK_UDP)
@@ -774,6 +795,7 @@ void Mavlink::send_finish()
 		if (_src_addr_initialized) {
 # endif // CONFIG_NET
 			ret = sendto(_socket_fd, _buf, _buf_fill, 0, (struct sockaddr *)&_src_addr, sizeof(_src_addr));
+			count_tx_syscalls(1);
 # if defined(CONFIG_NET)
 		}
 
@@ -789,6 +811,7 @@ void Mavlink::send_finish()
 			if (_broadcast_address_found && _buf_fill > 0) {
 
 				int bret = sendto(_socket_fd, _buf, _buf_fill, 0, (struct sockaddr *)&_bcast_addr, sizeof(_bcast_addr));
+				count_tx_syscalls(1);
 
 				if (bret <= 0) {
 					if (!_broadcast_failed_warned) {
@@ -832,6 +855,77 @@ void Mavlink::send_bytes(const uint8_t *buf, unsigned packet_len)
 	}
 }
 
+#if defined(MAVLINK_UDP_BATCH)
+void Mavlink::send_udp_batch()
+{
+	if (_udp_batch->empty()) {
+		return;
+	}
+
+	const unsigned pending_bytes = _udp_batch->get_pending_bytes();
+	unsigned bytes = 0;
+	unsigned messages = 0;
+
+	_udp_batch->send(_socket_fd, _src_addr, bytes, messages);
+	count_tx_syscalls(1);
+
+	if ((_mode != MAVLINK_MODE_ONBOARD) && broadcast_enabled() &&
+	    (!get_client_source_initialized() || !is_gcs_connected())) {
+
+		if (!_broadcast_address_found) {
+			find_broadcast_address();
+		}
+
+		if (_broadcast_address_found) {
+			unsigned bcast_bytes = 0;
+			unsigned bcast_messages = 0;
+			int bret = _udp_batch->send(_socket_fd, _bcast_addr, bcast_bytes, bcast_messages);
+			count_tx_syscalls(1);
+
+			if (bret <= 0) {
+				if (!_broadcast_failed_warned) {
+					PX4_ERR("sending broadcast failed, errno: %d: %s", errno, strerror(errno));
+					_broadcast_failed_warned = true;
+				}
+
+			} else {
+				_broadcast_failed_warned = false;
+			}
+		}
+	}
+
+	if (bytes > 0) {
+		_tstatus.tx_message_count += messages;
+		count_txbytes(bytes);
+		_last_write_success_time = _last_write_try_time;
+	}
+
+	if (bytes < pending_bytes) {
+		count_txerrbytes(pending_bytes - bytes);
+	}
+
+	_udp_batch->clear();
+}
+#endif // MAVLINK_UDP_BATCH
+
+void Mavlink::flush_udp_batch(const hrt_abstime &t)
+{
+#if defined(MAVLINK_UDP_BATCH)
+
+	if (_udp_batch == nullptr) {
+		return;
+	}
+
+	pthread_mutex_lock(&_send_mutex);
+
+	if (!_udp_batch->empty() && (t >= _udp_batch->get_oldest() + _udp_batch_deadline)) {
+		send_udp_batch();
+	}
+
+	pthread_mutex_unlock(&_send_mutex);
+#endif // MAVLINK_UDP_BATCH
+}
+
 #ifdef MAVLINK_UDP
 void Mavlink::find_broadcast_address()
 {
@@ -1008,6 +1102,19 @@ void Mavlink::init_udp()
 	}
 
 	_src_addr.sin_port = htons(_remote_port);
+
+# if defined(MAVLINK_UDP_BATCH)
+
+	if (udp_batching_enabled() && _udp_batch == nullptr) {
+		_udp_batch = new MavlinkUDPBatch();
+
+		if (_udp_batch == nullptr) {
+			PX4_ERR("UDP batch alloc failed, batching disabled");
+			_udp_batch_deadline = -1;
+		}
+	}
+
+# endif // MAVLINK_UDP_BATCH
 }
 #endif // MAVLINK_UDP
 
@@ -1168,6 +1275,8 @@ Mavlink::configure_stream(const char *stream_name, const float rate)
 
 	for (const auto &stream : _streams) {
 		if (strcmp(stream_name, stream->get_name()) == 0) {
+			_stream_dispatcher.invalidate();
+
 			if (interval != 0) {
 				/* set new interval */
 				stream->set_interval(interval);
@@ -1188,7 +1297,9 @@ Mavlink::configure_stream(const char *stream_name, const float rate)
 
 	if (stream != nullptr) {
 		stream->set_interval(interval);
+		stream->set_priority(MavlinkStreamScheduler::default_priority(stream->get_id()));
 		_streams.add(stream);
+		_stream_dispatcher.invalidate();
 
 		return OK;
 	}
@@ -1204,7 +1315,7 @@ Mavlink::configure_stream(const char *stream_name, const float rate)
 }
 
 void
-Mavlink::configure_stream_threadsafe(const char *stream_name, const float rate)
+Mavlink::configure_stream_threadsafe(const char *stream_name, const float rate, int priority)
 {
 	/* orb subscription must be done from the main thread,
 	 * set _subscribe_to_stream and _subscribe_to_stream_rate fields
@@ -1222,6 +1333,7 @@ Mavlink::configure_stream_threadsafe(const char *stream_name, const float rate)
 
 		/* set subscription task */
 		_subscribe_to_stream_rate = rate;
+		_subscribe_to_stream_priority = priority;
 		_subscribe_to_stream = s;
 
 		/* wait for subscription */
@@ -1345,6 +1457,14 @@ Mavlink::update_rate_mult()
 		PX4_ERR("instance %d: RADIO_STATUS timeout", _instance_id);
 	}
 
+	if (_priority_scheduling) {
+		// streams keep their configured rates, the scheduler fills the link budget by priority instead
+		const float budget = _datarate * mavlink_ulog_streaming_rate_inv * fminf(hardware_mult, 1.f);
+		_stream_scheduler.set_budget(fmaxf(budget, 0.05f * _datarate));
+		_rate_mult = 1.0f;
+		return;
+	}
+
 	/* pick the minimum from bandwidth mult and hardware mult as limit */
 	_rate_mult = fminf(bandwidth_mult, hardware_mult);
 
@@ -1933,7 +2053,7 @@ Mavlink::task_main(int argc, char *argv[])
 	int temp_int_arg;
 #endif
 
-	while ((ch = px4_getopt(argc, argv, "b:r:d:n:u:o:m:t:c:F:fswxzZp", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "b:r:d:n:u:o:m:t:c:F:U:fswxzZpP", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 		case 'b':
 			if (px4_get_parameter_value(myoptarg, _baudrate) != 0) {
@@ -2159,6 +2279,25 @@ Mavlink::task_main(int argc, char *argv[])
 			_ftp_on = true;
 			break;
 
+		case 'P':
+			_priority_scheduling = true;
+			break;
+
+		case 'U':
+#if defined(MAVLINK_UDP_BATCH)
+			if (px4_get_parameter_value(myoptarg, temp_int_arg) != 0) {
+				PX4_ERR("invalid UDP batch deadline");
+				err_flag = true;
+
+			} else {
+				_udp_batch_deadline = (temp_int_arg >= 0) ? temp_int_arg * 1000 : -1;
+			}
+
+#else
+			PX4_WARN("UDP batching not supported on this platform");
+#endif // MAVLINK_UDP_BATCH
+			break;
+
 		case 'z':
 			_flow_control = FLOW_CONTROL_ON;
 			break;
@@ -2365,6 +2504,7 @@ Mavlink::task_main(int argc, char *argv[])
 			handleStatus();
 			handleCommands();
 			handleAndGetCurrentCommandAck();
+			flush_udp_batch(hrt_absolute_time());
 			continue;
 		}
 
@@ -2394,11 +2534,32 @@ Mavlink::task_main(int argc, char *argv[])
 
 		check_requested_subscriptions();
 
-		/* update streams */
-		for (const auto &stream : _streams) {
-			stream->update(t);
+		/* update streams, only touching the ones that are due */
+		const int num_due = _stream_dispatcher.collect(t, _streams);
+
+		if (num_due < 0) {
+			// no memory for the schedule, poll all streams
+			for (const auto &stream : _streams) {
+				stream->update(t);
+			}
+
+		} else {
+			MavlinkStream *const *due = _stream_dispatcher.collected();
+
+			if (_priority_scheduling) {
+				_stream_scheduler.update(t, due, num_due);
+
+			} else {
+				for (int i = 0; i < num_due; i++) {
+					due[i]->update(t);
+				}
+			}
+
+			_stream_dispatcher.reschedule();
+		}
 
-			if (!_first_heartbeat_sent) {
+		if (!_first_heartbeat_sent) {
+			for (const auto &stream : _streams) {
 				if (_mode == MAVLINK_MODE_IRIDIUM) {
 					if (stream->get_id() == MAVLINK_MSG_ID_HIGH_LATENCY2) {
 						_first_heartbeat_sent = stream->first_message_sent();
@@ -2473,6 +2634,8 @@ Mavlink::task_main(int argc, char *argv[])
 			}
 		}
 
+		flush_udp_batch(t);
+
 		/* update TX/RX rates*/
 		if (t > _bytes_timestamp + 1_s) {
 			if (_bytes_timestamp != 0) {
@@ -2482,9 +2645,22 @@ Mavlink::task_main(int argc, char *argv[])
 				_tstatus.tx_error_rate_avg = _bytes_txerr / dt;
 				_tstatus.rx_rate_avg = _bytes_rx / dt;
 
+				_stream_dispatcher.update_statistics(dt);
+
+				for (const auto &stream : _streams) {
+					if (stream->update_rate_achieved(dt) && _priority_scheduling) {
+						publish_stream_status(stream);
+					}
+				}
+
+				_tx_syscall_rate = _tx_syscalls / dt;
+				_rx_syscall_rate = _rx_syscalls / dt;
+
 				_bytes_tx = 0;
 				_bytes_txerr = 0;
 				_bytes_rx = 0;
+				_tx_syscalls = 0;
+				_rx_syscalls = 0;
 			}
 
 			_bytes_timestamp = t;
@@ -2737,7 +2913,10 @@ void Mavlink::handleAndGetCurrentCommandAck()
 void Mavlink::check_requested_subscriptions()
 {
 	if (_subscribe_to_stream != nullptr) {
-		if (_subscribe_to_stream_rate < -1.5f) {
+		if (_subscribe_to_stream_rate < -2.5f) {
+			// rate unchanged, only the priority is configured below
+
+		} else if (_subscribe_to_stream_rate < -1.5f) {
 			if (configure_streams_to_default(_subscribe_to_stream) == 0) {
 				if (get_protocol() == Protocol::SERIAL) {
 					PX4_DEBUG("stream %s on device %s set to default rate", _subscribe_to_stream, _device_name);
@@ -2802,10 +2981,41 @@ void Mavlink::check_requested_subscriptions()
 #endif // MAVLINK_UDP
 		}
 
+		if (_subscribe_to_stream_priority >= 0) {
+			bool found = false;
+
+			for (const auto &stream : _streams) {
+				if (strcmp(_subscribe_to_stream, stream->get_name()) == 0) {
+					stream->set_priority(_subscribe_to_stream_priority);
+					found = true;
+					break;
+				}
+			}
+
+			if (!found) {
+				PX4_ERR("stream %s not enabled, cannot set priority", _subscribe_to_stream);
+			}
+		}
+
 		_subscribe_to_stream = nullptr;
 	}
 }
 
+void Mavlink::publish_stream_status(MavlinkStream *stream)
+{
+	mavlink_stream_status_s status{};
+	status.instance = _instance_id;
+	status.msg_id = stream->get_id();
+	status.priority = stream->get_priority();
+
+	const int interval = stream->get_interval();
+	status.rate_requested = (interval > 0) ? 1e6f / interval : ((interval < 0) ? -1.f : 0.f);
+	status.rate_achieved = stream->get_rate_achieved();
+	status.deferred_count = stream->get_deferred_count();
+	status.timestamp = hrt_absolute_time();
+	_mavlink_stream_status_pub.publish(status);
+}
+
 void Mavlink::publish_telemetry_status()
 {
 	// many fields are populated in place
@@ -3018,8 +3228,24 @@ Mavlink::display_status()
 	printf("\t  txerr: %.1f B/s\n", (double)_tstatus.tx_error_rate_avg);
 	printf("\t  tx rate mult: %.3f\n", (double)_rate_mult);
 	printf("\t  tx rate max: %i B/s\n", _datarate);
+
+	if (_priority_scheduling) {
+		printf("\t  priority scheduling budget: %.1f B/s (%.0f B available)\n", (double)_stream_scheduler.get_budget(),
+		       (double)_stream_scheduler.get_tokens());
+	}
+
 	printf("\t  rx: %.1f B/s\n", (double)_tstatus.rx_rate_avg);
 	printf("\t  rx loss: %.1f%%\n", (double)_tstatus.rx_message_lost_rate);
+	printf("\t  syscalls: tx %.1f/s, rx %.1f/s\n", (double)_tx_syscall_rate, (double)_rx_syscall_rate);
+
+#if defined(MAVLINK_UDP_BATCH)
+
+	if (_udp_batch != nullptr) {
+		printf("\t  UDP batching: deadline %" PRIi32 " ms, %.1f msgs/datagram\n", _udp_batch_deadline / 1000,
+		       (double)_udp_batch->get_messages_per_datagram());
+	}
+
+#endif // MAVLINK_UDP_BATCH
 
 #if !defined(CONSTRAINED_FLASH)
 	_receiver.print_detailed_rx_stats();
@@ -3028,6 +3254,12 @@ Mavlink::display_status()
 	if (_mavlink_ulog) {
 		printf("\tULog rate: %.1f%% of max %.1f%%\n", (double)_mavlink_ulog->current_data_rate() * 100.,
 		       (double)_mavlink_ulog->maximum_data_rate() * 100.);
+
+		if (_mavlink_ulog->window_size() > 1) {
+			printf("\tULog window: %.1f of %i, RTT %.1f ms, %" PRIu32 " retransmissions\n",
+			       (double)_mavlink_ulog->congestion_window(), _mavlink_ulog->window_size(),
+			       (double)_mavlink_ulog->round_trip_time(), _mavlink_ulog->retransmissions());
+		}
 	}
 
 	printf("\tFTP enabled: %s, TX enabled: %s\n",
@@ -3083,7 +3315,16 @@ Mavlink::display_status()
 void
 Mavlink::display_status_streams()
 {
-	printf("\t%-20s%-16s %s\n", "Name", "Rate Config (current) [Hz]", "Message Size (if active) [B]");
+	printf("\tdispatch: %d streams, %.1f checked per loop, %.1f us per loop, %.1f rebuilds/s\n",
+	       _stream_dispatcher.get_num_streams(), (double)_stream_dispatcher.get_checked_per_loop(),
+	       (double)_stream_dispatcher.get_time_per_loop(), (double)_stream_dispatcher.get_rebuild_rate());
+
+	if (_priority_scheduling) {
+		printf("\t%-20s%-16s %s\n", "Name", "Rate Config (achieved) [Hz]", "Prio Deferred Message Size (if active) [B]");
+
+	} else {
+		printf("\t%-20s%-16s %s\n", "Name", "Rate Config (current) [Hz]", "Message Size (if active) [B]");
+	}
 
 	const float rate_mult = _rate_mult;
 
@@ -3100,11 +3341,20 @@ Mavlink::display_status_streams()
 			// Note that the actual current rate can be lower if the associated uORB topic updates at a
 			// lower rate.
 			float rate_current = stream->const_rate() ? rate : rate * rate_mult;
+
+			if (_priority_scheduling) {
+				rate_current = stream->get_rate_achieved();
+			}
+
 			snprintf(rate_str, sizeof(rate_str), "%6.2f (%.3f)", (double)rate, (double)rate_current);
 		}
 
 		printf("\t%-30s%-16s", stream->get_name(), rate_str);
 
+		if (_priority_scheduling) {
+			printf(" %4u %8" PRIu32, stream->get_priority(), stream->get_deferred_count());
+		}
+
 		if (size > 0) {
 			printf(" %3u\n", size);
 
@@ -3232,6 +3482,8 @@ Mavlink::stream_command(int argc, char *argv[])
 	const char *device_name = DEFAULT_DEVICE_NAME;
 	float rate = -1.0f;
 	const char *stream_name = nullptr;
+	int priority = -1;
+	bool provided_rate = false;
 #ifdef MAVLINK_UDP
 	int temp_int_arg;
 	unsigned short network_port = 0;
@@ -3258,6 +3510,7 @@ Mavlink::stream_command(int argc, char *argv[])
 
 		if (0 == strcmp(argv[i], "-r") && i < argc - 1) {
 			rate = strtod(argv[i + 1], nullptr);
+			provided_rate = true;
 
 			if (rate < 0.0f) {
 				err_flag = true;
@@ -3265,6 +3518,15 @@ Mavlink::stream_command(int argc, char *argv[])
 
 			i++;
 
+		} else if (0 == strcmp(argv[i], "-p") && i < argc - 1) {
+			priority = strtol(argv[i + 1], nullptr, 10);
+
+			if (priority < MavlinkStream::PRIORITY_LOW || priority > MavlinkStream::PRIORITY_CRITICAL) {
+				err_flag = true;
+			}
+
+			i++;
+
 		} else if (0 == strcmp(argv[i], "-d") && i < argc - 1) {
 			provided_device = true;
 			device_name = argv[i + 1];
@@ -3314,12 +3576,15 @@ Mavlink::stream_command(int argc, char *argv[])
 			return 1;
 		}
 
-		if (rate < 0.0f) {
+		if (!provided_rate && priority >= 0) {
+			rate = -3.0f; // keep the current rate
+
+		} else if (rate < 0.0f) {
 			rate = -2.0f; // use default rate
 		}
 
 		if (inst != nullptr) {
-			inst->configure_stream_threadsafe(stream_name, rate);
+			inst->configure_stream_threadsafe(stream_name, rate, priority);
 
 		} else {
 
@@ -3412,6 +3677,7 @@ $ mavlink stream -u 14556 -s HIGHRES_IMU -r 50
 	PRINT_MODULE_USAGE_PARAM_INT('u', 14556, 0, 65536, "Select UDP Network Port (local)", true);
 	PRINT_MODULE_USAGE_PARAM_INT('o', 14550, 0, 65536, "Select UDP Network Port (remote)", true);
 	PRINT_MODULE_USAGE_PARAM_STRING('t', "127.0.0.1", nullptr, "Partner IP (broadcasting can be enabled via -p flag)", true);
+	PRINT_MODULE_USAGE_PARAM_INT('U', -1, -1, 100, "Batch UDP messages, sent at the latest after this deadline in ms (Linux only)", true);
 #endif
 	PRINT_MODULE_USAGE_PARAM_STRING('m', "normal", "custom|camera|onboard|osd|magic|config|iridium|minimal|extvision|extvisionmin|gimbal|onboard_low_bandwidth|uavionix|low_bandwidth|distance_sensor",
 					"Mode: sets default streams and rates", true);
@@ -3423,6 +3689,7 @@ $ mavlink stream -u 14556 -s HIGHRES_IMU -r 50
 	PRINT_MODULE_USAGE_PARAM_FLAG('f', "Enable message forwarding to other Mavlink instances", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('w', "Wait to send, until first message received", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('x', "Enable FTP", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('P', "Enable priority stream scheduling within the link budget", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('z', "Force hardware flow control always on", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('Z', "Force hardware flow control always off", true);
 
@@ -3445,6 +3712,7 @@ $ mavlink stream -u 14556 -s HIGHRES_IMU -r 50
 	PRINT_MODULE_USAGE_PARAM_STRING('d', nullptr, "<file:dev>", "Select Mavlink instance via Serial Device", true);
 	PRINT_MODULE_USAGE_PARAM_STRING('s', nullptr, nullptr, "Mavlink stream to configure", false);
 	PRINT_MODULE_USAGE_PARAM_FLOAT('r', -1.0f, 0.0f, 2000.0f, "Rate in Hz (0 = turn off, -1 = set to default)", false);
+	PRINT_MODULE_USAGE_PARAM_INT('p', -1, 0, 3, "Scheduling priority (0 = low, 3 = critical), used with -P", true);
 
 	PRINT_MODULE_USAGE_COMMAND_DESCR("boot_complete",
 					 "Enable sending of messages. (Must be) called as last step in startup script.");
@@ -72,6 +72,7 @@
 #include <uORB/Publication.hpp>
 #include <uORB/PublicationMulti.hpp>
 #include <uORB/SubscriptionInterval.hpp>
+#include <uORB/topics/mavlink_stream_status.h>
 #include <uORB/topics/parameter_update.h>
 #include <uORB/topics/radio_status.h>
 #include <uORB/topics/telemetry_status.h>
@@ -84,6 +85,8 @@
 #include "mavlink_messages.h"
 #include "mavlink_receiver.h"
 #include "mavlink_shell.h"
+#include "mavlink_stream_dispatcher.h"
+#include "mavlink_stream_scheduler.h"
 #include "mavlink_ulog.h"
 
 #define DEFAULT_BAUD_RATE       57600
@@ -96,6 +99,11 @@
 # define DEFAULT_REMOTE_PORT_UDP 14550 ///< GCS port per MAVLink spec
 #endif // CONFIG_NET || __PX4_POSIX
 
+#if defined(MAVLINK_UDP) && defined(__PX4_LINUX)
+# define MAVLINK_UDP_BATCH ///< sendmmsg/recvmmsg are available
+# include "mavlink_udp_batch.h"
+#endif // MAVLINK_UDP && __PX4_LINUX
+
 enum class Protocol {
 	SERIAL = 0,
 #if defined(MAVLINK_UDP)
@@ -330,7 +338,7 @@ public:
 
 	mavlink_channel_t	get_channel() const { return _channel; }
 
-	void			configure_stream_threadsafe(const char *stream_name, float rate = -1.0f);
+	void			configure_stream_threadsafe(const char *stream_name, float rate = -1.0f, int priority = -1);
 
 	orb_advert_t		*get_mavlink_log_pub() { return &_mavlink_log_pub; }
 
@@ -392,7 +400,14 @@ public:
 	/**
 	 * Count transmitted bytes
 	 */
-	void			count_txbytes(unsigned n) { _bytes_tx += n; };
+	void			count_txbytes(unsigned n) { _bytes_tx += n; _bytes_tx_total += n; };
+
+	/**
+	 * Get the total number of transmitted bytes (wraps around)
+	 */
+	unsigned		get_bytes_tx_total() const { return _bytes_tx_total; }
+
+	bool			priority_scheduling_enabled() const { return _priority_scheduling; }
 
 	/**
 	 * Count bytes not transmitted because of errors
@@ -404,6 +419,17 @@ public:
 	 */
 	void			count_rxbytes(unsigned n) { _bytes_rx += n; };
 
+	/**
+	 * Count read and write syscalls on the link
+	 */
+	void			count_tx_syscalls(unsigned n) { _tx_syscalls += n; }
+	void			count_rx_syscalls(unsigned n) { _rx_syscalls += n; }
+
+	/**
+	 * @return true if UDP messages are sent and received in batches
+	 */
+	bool			udp_batching_enabled() const { return _udp_batch_deadline >= 0; }
+
 	/**
 	 * Get the receive status of this MAVLink link
 	 */
@@ -460,7 +486,7 @@ public:
 	{
 		if (_mavlink_ulog) { return; }
 
-		_mavlink_ulog = MavlinkULog::try_start(_datarate, 0.7f, target_system, target_component);
+		_mavlink_ulog = MavlinkULog::try_start(_datarate, 0.7f, target_system, target_component, _param_mav_ulog_win.get());
 	}
 
 	const events::SendProtocol &get_events_protocol() const { return _events; };
@@ -507,6 +533,7 @@ private:
 
 	uORB::Publication<vehicle_command_ack_s> _vehicle_command_ack_pub{ORB_ID(vehicle_command_ack)};
 	uORB::PublicationMulti<telemetry_status_s> _telemetry_status_pub{ORB_ID(telemetry_status)};
+	uORB::PublicationMulti<mavlink_stream_status_s> _mavlink_stream_status_pub{ORB_ID(mavlink_stream_status)};
 
 	uORB::Subscription _event_sub{ORB_ID(event)};
 	uORB::SubscriptionInterval _parameter_update_sub{ORB_ID(parameter_update), 1_s};
@@ -537,6 +564,10 @@ private:
 
 	List<MavlinkStream *>		_streams;
 
+	MavlinkStreamDispatcher	_stream_dispatcher{this};
+	MavlinkStreamScheduler	_stream_scheduler{this};
+	bool			_priority_scheduling{false};	///< serve streams by priority within the link budget instead of scaling all rates
+
 	MavlinkShell		*_mavlink_shell{nullptr};
 	pthread_mutex_t		_mavlink_shell_mutex{};
 	MavlinkULog		*_mavlink_ulog{nullptr};
@@ -570,7 +601,8 @@ private:
 	unsigned int		_mavlink_param_queue_index{0};
 
 	char			*_subscribe_to_stream{nullptr};
-	float			_subscribe_to_stream_rate{0.0f};  ///< rate of stream to subscribe to (0=disable, -1=unlimited, -2=default)
+	float			_subscribe_to_stream_rate{0.0f};  ///< rate of stream to subscribe to (0=disable, -1=unlimited, -2=default, -3=unchanged)
+	int			_subscribe_to_stream_priority{-1}; ///< priority of stream to subscribe to (-1=unchanged)
 	bool			_udp_initialised{false};
 
 	FLOW_CONTROL_MODE	_flow_control_mode{Mavlink::FLOW_CONTROL_OFF};
@@ -581,10 +613,21 @@ private:
 	uint8_t _protocol_version = 0; ///< after initialization the only values are 1 and 2
 
 	unsigned		_bytes_tx{0};
+	unsigned		_bytes_tx_total{0};
 	unsigned		_bytes_txerr{0};
 	unsigned		_bytes_rx{0};
 	hrt_abstime		_bytes_timestamp{0};
 
+	unsigned		_tx_syscalls{0};
+	unsigned		_rx_syscalls{0};
+	float			_tx_syscall_rate{0.f};
+	float			_rx_syscall_rate{0.f};
+
+	int32_t			_udp_batch_deadline{-1};	///< max time a message is held back in the UDP batch [us], disabled if negative
+#if defined(MAVLINK_UDP_BATCH)
+	MavlinkUDPBatch		*_udp_batch {nullptr};
+#endif // MAVLINK_UDP_BATCH
+
 #if defined(MAVLINK_UDP)
 	BROADCAST_MODE		_mav_broadcast {BROADCAST_MODE_OFF};
 
@@ -634,6 +677,7 @@ private:
 		(ParamBool<px4::params::MAV_HASH_CHK_EN>) _param_mav_hash_chk_en,
 		(ParamBool<px4::params::MAV_HB_FORW_EN>) _param_mav_hb_forw_en,
 		(ParamInt<px4::params::MAV_RADIO_TOUT>)      _param_mav_radio_timeout,
+		(ParamInt<px4::params::MAV_ULOG_WIN>)        _param_mav_ulog_win,
 		(ParamInt<px4::params::SYS_HITL>) _param_sys_hitl,
 		(ParamBool<px4::params::SYS_FAILURE_EN>) _param_sys_failure_injection_enabled
 	)
@@ -675,6 +719,11 @@ private:
 
 	void publish_telemetry_status();
 
+	/**
+	 * Publish the requested and achieved rate of a stream
+	 */
+	void publish_stream_status(MavlinkStream *stream);
+
 	void check_requested_subscriptions();
 
 	void handleCommands();
@@ -704,6 +753,18 @@ private:
 	void init_udp();
 #endif // MAVLINK_UDP
 
+#if defined(MAVLINK_UDP_BATCH)
+	/**
+	 * Send the pending UDP batch. Must be called with the send mutex locked.
+	 */
+	void send_udp_batch();
+#endif // MAVLINK_UDP_BATCH
+
+	/**
+	 * Send the pending UDP batch if its oldest message reached the flush deadline
+	 */
+	void flush_udp_batch(const hrt_abstime &t);
+
 
 	bool set_channel();
 
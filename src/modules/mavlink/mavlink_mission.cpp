@@ -259,6 +259,24 @@ MavlinkMissionManager::update_safepoint_count(dm_item_t safepoint_dataman_id, un
 	return PX4_OK;
 }
 
+bool
+MavlinkMissionManager::write_transfer_item(uint16_t seq, const uint8_t *buffer, uint32_t length)
+{
+	// collect responses of earlier writes to free up the window
+	_dataman_client.update();
+
+	if (!_dataman_client.writeBatchAsync(_transfer_dataman_id, seq, 1, buffer, length)) {
+		return false;
+	}
+
+	if (!_dataman_client.batchIdle()) {
+		// window full: the item was not copied yet, wait for the pending writes
+		return _dataman_client.waitBatch();
+	}
+
+	return true;
+}
+
 void
 MavlinkMissionManager::send_mission_ack(uint8_t sysid, uint8_t compid, uint8_t type, uint32_t opaque_id)
 {
@@ -990,6 +1008,9 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 				return;
 			}
 
+			// drop writes still pending from an aborted transfer
+			_dataman_client.abortBatch();
+
 			_state = MAVLINK_WPM_STATE_GETLIST;
 			_transfer_seq = 0;
 			_transfer_count = wpc.count;
@@ -1156,9 +1177,8 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 
 					} else {
 
-						write_failed = !_dataman_client.writeSync(_transfer_dataman_id, wp.seq,
-								reinterpret_cast<uint8_t *>(&mission_item),
-								sizeof(struct mission_item_s));
+						write_failed = !write_transfer_item(wp.seq, reinterpret_cast<uint8_t *>(&mission_item),
+										    sizeof(struct mission_item_s));
 
 						// Check for land start marker
 						if ((mission_item.nav_cmd == MAV_CMD_DO_LAND_START) && (_transfer_land_start_marker == -1)) {
@@ -1208,16 +1228,15 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 					mission_fence_point.frame = mission_item.frame;
 
 					if (!check_failed) {
-						write_failed = !_dataman_client.writeSync(_transfer_dataman_id, wp.seq,
-								reinterpret_cast<uint8_t *>(&mission_fence_point), sizeof(mission_fence_point_s));
+						write_failed = !write_transfer_item(wp.seq, reinterpret_cast<uint8_t *>(&mission_fence_point),
+										    sizeof(mission_fence_point_s));
 					}
 
 				}
 				break;
 
 			case MAV_MISSION_TYPE_RALLY: { // Write a safe point / rally point
-					write_failed = !_dataman_client.writeSync(_transfer_dataman_id, wp.seq,
-							reinterpret_cast<uint8_t *>(&mission_item), sizeof(mission_item_s), 2_s);
+					write_failed = !write_transfer_item(wp.seq, reinterpret_cast<uint8_t *>(&mission_item), sizeof(mission_item_s));
 				}
 				break;
 
@@ -1228,6 +1247,11 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 				break;
 			}
 
+			if (!write_failed && !check_failed && (wp.seq + 1 == _transfer_count)) {
+				// last item: all writes need to be stored before the transfer is acknowledged
+				write_failed = !_dataman_client.waitBatch();
+			}
+
 			if (write_failed || check_failed) {
 				PX4_DEBUG("WPM: MISSION_ITEM ERROR: error writing seq %u to dataman ID %i", wp.seq, _transfer_dataman_id);
 
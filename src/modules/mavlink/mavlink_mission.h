@@ -200,6 +200,9 @@ private:
 	/** load safe point stats from dataman */
 	bool load_safepoint_stats();
 
+	/** queue a write of a received item to the transfer storage, only blocks when the write window is full */
+	bool write_transfer_item(uint16_t seq, const uint8_t *buffer, uint32_t length);
+
 	/**
 	 *  @brief Sends an waypoint ack message
 	 */
@@ -0,0 +1,262 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mavlink_parameter_blob.cpp
+ * Compressed bulk export of the used parameters.
+ */
+
+#include "mavlink_parameter_blob.h"
+#include "mavlink_bridge_header.h"
+
+#include <crc32.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <parameters/param.h>
+#include <px4_platform_common/posix.h>
+
+extern "C" {
+#include <lib/heatshrink/heatshrink/heatshrink_encoder.h>
+}
+
+constexpr const char MavlinkParameterBlob::FTP_PATH[];
+
+unsigned
+MavlinkParameterBlob::serialize_chunk(unsigned first, unsigned count, uint8_t *buf)
+{
+	unsigned len = 0;
+
+	for (unsigned used_index = first; used_index < first + count; used_index++) {
+		const param_t param = param_for_used_index(used_index);
+
+		if (param == PARAM_INVALID) {
+			continue;
+		}
+
+		const char *name = param_name(param);
+		size_t name_len = strlen(name);
+
+		if (name_len > MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN) {
+			name_len = MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN;
+		}
+
+		const uint16_t index = used_index;
+		memcpy(&buf[len], &index, sizeof(index));
+		len += sizeof(index);
+
+		union {
+			int32_t i;
+			float f;
+		} value{};
+
+		if (param_type(param) == PARAM_TYPE_INT32) {
+			buf[len++] = MAVLINK_TYPE_INT32_T;
+			param_get(param, &value.i);
+
+		} else {
+			buf[len++] = MAVLINK_TYPE_FLOAT;
+			param_get(param, &value.f);
+		}
+
+		buf[len++] = name_len;
+		memcpy(&buf[len], name, name_len);
+		len += name_len;
+
+		memcpy(&buf[len], &value, sizeof(value));
+		len += sizeof(value);
+	}
+
+	return len;
+}
+
+unsigned
+MavlinkParameterBlob::compress(const uint8_t *in, unsigned in_size, uint8_t *out, unsigned out_size)
+{
+	heatshrink_encoder *hse = new heatshrink_encoder;
+
+	if (hse == nullptr) {
+		return 0;
+	}
+
+	heatshrink_encoder_reset(hse);
+
+	size_t in_pos = 0;
+	size_t out_pos = 0;
+	bool finished = false;
+
+	while (out_pos < out_size) {
+		if (in_pos < in_size) {
+			size_t sunk = 0;
+			heatshrink_encoder_sink(hse, (uint8_t *)&in[in_pos], in_size - in_pos, &sunk);
+			in_pos += sunk;
+
+		} else if (heatshrink_encoder_finish(hse) == HSER_FINISH_DONE) {
+			finished = true;
+			break;
+		}
+
+		HSE_poll_res res;
+
+		do {
+			size_t polled = 0;
+			res = heatshrink_encoder_poll(hse, &out[out_pos], out_size - out_pos, &polled);
+			out_pos += polled;
+		} while (res == HSER_POLL_MORE && out_pos < out_size);
+	}
+
+	delete hse;
+
+	return finished ? out_pos : 0;
+}
+
+int
+MavlinkParameterBlob::write_chunks(int fd, ChunkEntry *chunks, unsigned chunk_count, uint8_t *raw, uint8_t *compressed)
+{
+	uint32_t offset = sizeof(Header) + chunk_count * sizeof(ChunkEntry);
+
+	// the header and chunk table are written once all chunks are known
+	if (lseek(fd, offset, SEEK_SET) < 0) {
+		return -errno;
+	}
+
+	for (unsigned i = 0; i < chunk_count; i++) {
+		const unsigned size = serialize_chunk(i * CHUNK_PARAMS, CHUNK_PARAMS, raw);
+		unsigned stored_size = (size > 1) ? compress(raw, size, compressed, size - 1) : 0;
+		const uint8_t *data = compressed;
+
+		if (stored_size == 0) {
+			// not compressible, store as is
+			stored_size = size;
+			data = raw;
+		}
+
+		chunks[i].offset = offset;
+		chunks[i].stored_size = stored_size;
+		chunks[i].size = size;
+		chunks[i].crc = crc32part(raw, size, 0);
+
+		if (::write(fd, data, stored_size) != (ssize_t)stored_size) {
+			return -EIO;
+		}
+
+		offset += stored_size;
+	}
+
+	return 0;
+}
+
+int
+MavlinkParameterBlob::replace_file(const char *from, const char *to)
+{
+	if (::rename(from, to) == 0) {
+		return 0;
+	}
+
+	// not all file systems replace an existing target
+	if (errno == EEXIST && ::unlink(to) == 0 && ::rename(from, to) == 0) {
+		return 0;
+	}
+
+	return -errno;
+}
+
+int
+MavlinkParameterBlob::write(const char *path)
+{
+	const unsigned param_count = param_count_used();
+	const unsigned chunk_count = (param_count + CHUNK_PARAMS - 1) / CHUNK_PARAMS;
+
+	Header header{};
+	header.magic = MAGIC;
+	header.version = VERSION;
+	header.window_bits = HEATSHRINK_STATIC_WINDOW_BITS;
+	header.lookahead_bits = HEATSHRINK_STATIC_LOOKAHEAD_BITS;
+	header.param_count = param_count;
+	header.chunk_count = chunk_count;
+	header.param_hash = param_hash_check();
+
+	ChunkEntry *chunks = new ChunkEntry[chunk_count + 1];
+	uint8_t *raw = new uint8_t[MAX_CHUNK_SIZE];
+	uint8_t *compressed = new uint8_t[MAX_CHUNK_SIZE];
+
+	// write to a temporary file and rename it, so a file that is still being read is never truncated
+	char tmp_path[PATH_MAX_LEN];
+	const int tmp_path_len = snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+	int ret = -ENOMEM;
+
+	if (tmp_path_len < 0 || tmp_path_len >= (int)sizeof(tmp_path)) {
+		ret = -ENAMETOOLONG;
+
+	} else if (chunks != nullptr && raw != nullptr && compressed != nullptr) {
+		int fd = ::open(tmp_path, O_CREAT | O_WRONLY | O_TRUNC, PX4_O_MODE_666);
+
+		if (fd >= 0) {
+			ret = write_chunks(fd, chunks, chunk_count, raw, compressed);
+
+			const ssize_t table_size = chunk_count * sizeof(ChunkEntry);
+
+			if (ret == 0 && (lseek(fd, 0, SEEK_SET) < 0
+					 || ::write(fd, &header, sizeof(header)) != (ssize_t)sizeof(header)
+					 || ::write(fd, chunks, table_size) != table_size)) {
+				ret = -EIO;
+			}
+
+			if (::close(fd) != 0 && ret == 0) {
+				ret = -errno;
+			}
+
+			if (ret == 0) {
+				ret = replace_file(tmp_path, path);
+			}
+
+			if (ret != 0) {
+				::unlink(tmp_path);
+			}
+
+		} else {
+			ret = -errno;
+		}
+	}
+
+	delete[] chunks;
+	delete[] raw;
+	delete[] compressed;
+
+	return ret;
+}
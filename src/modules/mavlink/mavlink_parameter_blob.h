@@ -0,0 +1,152 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mavlink_parameter_blob.h
+ * Compressed bulk export of the used parameters.
+ *
+ * Instead of requesting the full list with one PARAM_VALUE message per
+ * parameter, a GCS can download the parameter set via MAVLink FTP by opening
+ * FTP_PATH. The file is generated when it is opened and has the layout
+ * (little endian):
+ *
+ *  Header
+ *   uint32 magic ("PXPB")
+ *   uint8  version
+ *   uint8  heatshrink window bits
+ *   uint8  heatshrink lookahead bits
+ *   uint8  reserved
+ *   uint16 number of parameters
+ *   uint16 number of chunks
+ *   uint32 hash of the parameter set (same as _HASH_CHECK)
+ *
+ *  Chunk table, one entry per chunk
+ *   uint32 file offset of the chunk data
+ *   uint16 stored size
+ *   uint16 uncompressed size
+ *   uint32 CRC32 of the uncompressed chunk
+ *
+ *  Chunk data, each chunk compressed independently with heatshrink, or stored
+ *  uncompressed if the stored size equals the uncompressed size. An uncompressed
+ *  chunk contains up to CHUNK_PARAMS parameters in used index order:
+ *   uint16 used index
+ *   uint8  type (MAVLINK_TYPE_INT32_T or MAVLINK_TYPE_FLOAT)
+ *   uint8  name length
+ *   char   name[name length]
+ *   4 byte value
+ *
+ * The content is deterministic for a given parameter set, so a GCS that cached
+ * an earlier download only needs to read the header and chunk table, and then
+ * the chunks whose CRC changed, using FTP reads at the chunk offsets. An
+ * interrupted download is resumed the same way.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class MavlinkParameterBlob
+{
+public:
+	/**
+	 * Virtual FTP path of the export
+	 */
+	static constexpr const char FTP_PATH[] = "@PARAM/params.pxb";
+
+	static constexpr uint32_t MAGIC{0x42505850}; ///< "PXPB"
+	static constexpr uint8_t VERSION{1};
+
+	static constexpr unsigned CHUNK_PARAMS{32};
+
+	struct __attribute__((packed)) Header {
+		uint32_t magic;
+		uint8_t version;
+		uint8_t window_bits;
+		uint8_t lookahead_bits;
+		uint8_t reserved;
+		uint16_t param_count;
+		uint16_t chunk_count;
+		uint32_t param_hash;
+	};
+
+	struct __attribute__((packed)) ChunkEntry {
+		uint32_t offset;
+		uint16_t stored_size;
+		uint16_t size;
+		uint32_t crc;
+	};
+
+	/**
+	 * Write the export of the current parameter set to a file
+	 *
+	 * The export is written to path.tmp first and then renamed to path,
+	 * so an earlier export that is still open keeps its content.
+	 *
+	 * @return 0 on success, -errno otherwise
+	 */
+	static int write(const char *path);
+
+private:
+	/**
+	 * Serialize the parameters [first, first + count) in used index order
+	 *
+	 * @return number of bytes written to buf
+	 */
+	static unsigned serialize_chunk(unsigned first, unsigned count, uint8_t *buf);
+
+	/**
+	 * Compress a chunk
+	 *
+	 * @return compressed size, or 0 if it did not fit into out_size
+	 */
+	static unsigned compress(const uint8_t *in, unsigned in_size, uint8_t *out, unsigned out_size);
+
+	/**
+	 * Serialize, compress and write all chunks after the header and chunk table, and fill the table
+	 *
+	 * @return 0 on success, -errno otherwise
+	 */
+	static int write_chunks(int fd, ChunkEntry *chunks, unsigned chunk_count, uint8_t *raw, uint8_t *compressed);
+
+	/**
+	 * Rename from to to, replacing an existing file
+	 *
+	 * @return 0 on success, -errno otherwise
+	 */
+	static int replace_file(const char *from, const char *to);
+
+	static constexpr unsigned PATH_MAX_LEN{128};
+	static constexpr unsigned MAX_PARAM_SIZE{2 + 1 + 1 + 16 + 4};
+	static constexpr unsigned MAX_CHUNK_SIZE{CHUNK_PARAMS * MAX_PARAM_SIZE};
+};
@@ -154,3 +154,17 @@ PARAM_DEFINE_INT32(MAV_HB_FORW_EN, 1);
  * @max 250
  */
 PARAM_DEFINE_INT32(MAV_RADIO_TOUT, 5);
+
+/**
+ * ULog streaming window size
+ *
+ * Maximum number of acknowledged ULog streaming messages (log header and definitions)
+ * in flight. Unacknowledged messages are retransmitted individually and the effective
+ * window adapts to losses and the round trip time measured via timesync.
+ * Set to 1 to wait for each acknowledgement before sending the next message.
+ *
+ * @min 1
+ * @max 16
+ * @group MAVLink
+ */
+PARAM_DEFINE_INT32(MAV_ULOG_WIN, 1);
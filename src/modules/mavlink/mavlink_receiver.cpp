@@ -76,8 +76,10 @@ MavlinkReceiver::~MavlinkReceiver()
 	delete _px4_accel;
 	delete _px4_gyro;
 	delete _px4_mag;
+	delete[] _udp_rx_buffer;
 #if !defined(CONSTRAINED_FLASH)
 	delete[] _received_msg_stats;
+	delete[] _dispatch_stats;
 #endif // !CONSTRAINED_FLASH
 
 	_distance_sensor_pub.unadvertise();
@@ -107,6 +109,105 @@ static constexpr vehicle_odometry_s vehicle_odometry_empty {
 	.quality = 0
 };
 
+const MavlinkReceiver::MessageHandler MavlinkReceiver::_message_handlers[] = {
+	{MAVLINK_MSG_ID_COMMAND_LONG, &MavlinkReceiver::handle_message_command_long, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_COMMAND_INT, &MavlinkReceiver::handle_message_command_int, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_COMMAND_ACK, &MavlinkReceiver::handle_message_command_ack, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_OPTICAL_FLOW_RAD, &MavlinkReceiver::handle_message_optical_flow_rad, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_PING, &MavlinkReceiver::handle_message_ping, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_SET_MODE, &MavlinkReceiver::handle_message_set_mode, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_ATT_POS_MOCAP, &MavlinkReceiver::handle_message_att_pos_mocap, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED, &MavlinkReceiver::handle_message_set_position_target_local_ned, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_SET_POSITION_TARGET_GLOBAL_INT, &MavlinkReceiver::handle_message_set_position_target_global_int, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_SET_ATTITUDE_TARGET, &MavlinkReceiver::handle_message_set_attitude_target, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_VISION_POSITION_ESTIMATE, &MavlinkReceiver::handle_message_vision_position_estimate, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_ODOMETRY, &MavlinkReceiver::handle_message_odometry, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_SET_GPS_GLOBAL_ORIGIN, &MavlinkReceiver::handle_message_set_gps_global_origin, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_RADIO_STATUS, &MavlinkReceiver::handle_message_radio_status, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_MANUAL_CONTROL, &MavlinkReceiver::handle_message_manual_control, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE, &MavlinkReceiver::handle_message_rc_channels_override, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_HEARTBEAT, &MavlinkReceiver::handle_message_heartbeat, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_DISTANCE_SENSOR, &MavlinkReceiver::handle_message_distance_sensor, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_FOLLOW_TARGET, &MavlinkReceiver::handle_message_follow_target, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_LANDING_TARGET, &MavlinkReceiver::handle_message_landing_target, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_CELLULAR_STATUS, &MavlinkReceiver::handle_message_cellular_status, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_ADSB_VEHICLE, &MavlinkReceiver::handle_message_adsb_vehicle, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_GPS_RTCM_DATA, &MavlinkReceiver::handle_message_gps_rtcm_data, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_BATTERY_STATUS, &MavlinkReceiver::handle_message_battery_status, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_SERIAL_CONTROL, &MavlinkReceiver::handle_message_serial_control, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_LOGGING_ACK, &MavlinkReceiver::handle_message_logging_ack, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_PLAY_TUNE, &MavlinkReceiver::handle_message_play_tune, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_PLAY_TUNE_V2, &MavlinkReceiver::handle_message_play_tune_v2, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_OBSTACLE_DISTANCE, &MavlinkReceiver::handle_message_obstacle_distance, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_TUNNEL, &MavlinkReceiver::handle_message_tunnel, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_ONBOARD_COMPUTER_STATUS, &MavlinkReceiver::handle_message_onboard_computer_status, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_GENERATOR_STATUS, &MavlinkReceiver::handle_message_generator_status, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_STATUSTEXT, &MavlinkReceiver::handle_message_statustext, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID, &MavlinkReceiver::handle_message_open_drone_id_operator_id, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID, &MavlinkReceiver::handle_message_open_drone_id_self_id, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM, &MavlinkReceiver::handle_message_open_drone_id_system, DispatchGate::NONE},
+#if !defined(CONSTRAINED_FLASH)
+	{MAVLINK_MSG_ID_NAMED_VALUE_FLOAT, &MavlinkReceiver::handle_message_named_value_float, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_NAMED_VALUE_INT, &MavlinkReceiver::handle_message_named_value_int, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_DEBUG, &MavlinkReceiver::handle_message_debug, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_DEBUG_VECT, &MavlinkReceiver::handle_message_debug_vect, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_DEBUG_FLOAT_ARRAY, &MavlinkReceiver::handle_message_debug_float_array, DispatchGate::NONE},
+#endif // !CONSTRAINED_FLASH
+	{MAVLINK_MSG_ID_GIMBAL_MANAGER_SET_ATTITUDE, &MavlinkReceiver::handle_message_gimbal_manager_set_attitude, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_GIMBAL_MANAGER_SET_MANUAL_CONTROL, &MavlinkReceiver::handle_message_gimbal_manager_set_manual_control, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_GIMBAL_DEVICE_INFORMATION, &MavlinkReceiver::handle_message_gimbal_device_information, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_REQUEST_EVENT, &MavlinkReceiver::handle_message_request_event, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_GIMBAL_DEVICE_ATTITUDE_STATUS, &MavlinkReceiver::handle_message_gimbal_device_attitude_status, DispatchGate::NONE},
+#if defined(MAVLINK_MSG_ID_SET_VELOCITY_LIMITS) // For now only defined if development.xml is used
+	{MAVLINK_MSG_ID_SET_VELOCITY_LIMITS, &MavlinkReceiver::handle_message_set_velocity_limits, DispatchGate::NONE},
+#endif
+
+	/*
+	 * Only decode hil messages in HIL mode.
+	 *
+	 * The HIL mode is enabled by the HIL bit flag
+	 * in the system mode. Either send a set mode
+	 * COMMAND_LONG message or a SET_MODE message
+	 *
+	 * Accept HIL GPS messages if use_hil_gps flag is true.
+	 * This allows to provide fake gps measurements to the system.
+	 */
+	{MAVLINK_MSG_ID_HIL_SENSOR, &MavlinkReceiver::handle_message_hil_sensor, DispatchGate::HIL},
+	{MAVLINK_MSG_ID_HIL_STATE_QUATERNION, &MavlinkReceiver::handle_message_hil_state_quaternion, DispatchGate::HIL},
+	{MAVLINK_MSG_ID_HIL_OPTICAL_FLOW, &MavlinkReceiver::handle_message_hil_optical_flow, DispatchGate::HIL},
+	{MAVLINK_MSG_ID_HIL_GPS, &MavlinkReceiver::handle_message_hil_gps, DispatchGate::HIL_GPS},
+
+	/* mission manager */
+	{MAVLINK_MSG_ID_MISSION_ACK, &MavlinkReceiver::handle_message_mission, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_MISSION_SET_CURRENT, &MavlinkReceiver::handle_message_mission, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_MISSION_REQUEST_LIST, &MavlinkReceiver::handle_message_mission, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_MISSION_REQUEST, &MavlinkReceiver::handle_message_mission, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_MISSION_REQUEST_INT, &MavlinkReceiver::handle_message_mission, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_MISSION_COUNT, &MavlinkReceiver::handle_message_mission, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_MISSION_ITEM, &MavlinkReceiver::handle_message_mission, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_MISSION_ITEM_INT, &MavlinkReceiver::handle_message_mission, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_MISSION_CLEAR_ALL, &MavlinkReceiver::handle_message_mission, DispatchGate::NONE},
+
+	/* parameter component, only once the mavlink app has booted */
+	{MAVLINK_MSG_ID_PARAM_REQUEST_LIST, &MavlinkReceiver::handle_message_param, DispatchGate::BOOT_COMPLETE},
+	{MAVLINK_MSG_ID_PARAM_SET, &MavlinkReceiver::handle_message_param, DispatchGate::BOOT_COMPLETE},
+	{MAVLINK_MSG_ID_PARAM_REQUEST_READ, &MavlinkReceiver::handle_message_param, DispatchGate::BOOT_COMPLETE},
+	{MAVLINK_MSG_ID_PARAM_MAP_RC, &MavlinkReceiver::handle_message_param, DispatchGate::BOOT_COMPLETE},
+
+	/* ftp component */
+	{MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL, &MavlinkReceiver::handle_message_ftp, DispatchGate::FTP},
+
+	/* log component */
+	{MAVLINK_MSG_ID_LOG_REQUEST_LIST, &MavlinkReceiver::handle_message_log, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_LOG_REQUEST_DATA, &MavlinkReceiver::handle_message_log, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_LOG_REQUEST_END, &MavlinkReceiver::handle_message_log, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_LOG_ERASE, &MavlinkReceiver::handle_message_log, DispatchGate::NONE},
+
+	/* timesync component */
+	{MAVLINK_MSG_ID_TIMESYNC, &MavlinkReceiver::handle_message_timesync, DispatchGate::NONE},
+	{MAVLINK_MSG_ID_SYSTEM_TIME, &MavlinkReceiver::handle_message_timesync, DispatchGate::NONE},
+};
+
 MavlinkReceiver::MavlinkReceiver(Mavlink &parent) :
 	ModuleParams(nullptr),
 	_mavlink(parent),
@@ -116,6 +217,20 @@ MavlinkReceiver::MavlinkReceiver(Mavlink &parent) :
 	_parameters_manager(parent),
 	_mavlink_timesync(parent)
 {
+	static_assert(arraySize(_message_handlers) < DISPATCH_TABLE_SIZE, "dispatch table too small");
+
+	memset(_dispatch_table, DISPATCH_SLOT_EMPTY, sizeof(_dispatch_table));
+
+	for (unsigned i = 0; i < arraySize(_message_handlers); i++) {
+		unsigned slot = dispatch_slot(_message_handlers[i].msg_id);
+
+		// linear probing, entries for the same msgid stay in registration order
+		while (_dispatch_table[slot] != DISPATCH_SLOT_EMPTY) {
+			slot = (slot + 1) & (DISPATCH_TABLE_SIZE - 1);
+		}
+
+		_dispatch_table[slot] = i;
+	}
 }
 
 void
@@ -133,276 +248,65 @@ MavlinkReceiver::acknowledge(uint8_t sysid, uint8_t compid, uint16_t command, ui
 	_cmd_ack_pub.publish(command_ack);
 }
 
-void
-MavlinkReceiver::handle_message(mavlink_message_t *msg)
+bool
+MavlinkReceiver::dispatch_gate_open(DispatchGate gate, const mavlink_message_t &msg) const
 {
-	switch (msg->msgid) {
-	case MAVLINK_MSG_ID_COMMAND_LONG:
-		handle_message_command_long(msg);
-		break;
-
-	case MAVLINK_MSG_ID_COMMAND_INT:
-		handle_message_command_int(msg);
-		break;
-
-	case MAVLINK_MSG_ID_COMMAND_ACK:
-		handle_message_command_ack(msg);
-		break;
-
-	case MAVLINK_MSG_ID_OPTICAL_FLOW_RAD:
-		handle_message_optical_flow_rad(msg);
-		break;
-
-	case MAVLINK_MSG_ID_PING:
-		handle_message_ping(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_MODE:
-		handle_message_set_mode(msg);
-		break;
-
-	case MAVLINK_MSG_ID_ATT_POS_MOCAP:
-		handle_message_att_pos_mocap(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED:
-		handle_message_set_position_target_local_ned(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_POSITION_TARGET_GLOBAL_INT:
-		handle_message_set_position_target_global_int(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_ATTITUDE_TARGET:
-		handle_message_set_attitude_target(msg);
-		break;
-
-	case MAVLINK_MSG_ID_VISION_POSITION_ESTIMATE:
-		handle_message_vision_position_estimate(msg);
-		break;
-
-	case MAVLINK_MSG_ID_ODOMETRY:
-		handle_message_odometry(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_GPS_GLOBAL_ORIGIN:
-		handle_message_set_gps_global_origin(msg);
-		break;
-
-	case MAVLINK_MSG_ID_RADIO_STATUS:
-		handle_message_radio_status(msg);
-		break;
-
-	case MAVLINK_MSG_ID_MANUAL_CONTROL:
-		handle_message_manual_control(msg);
-		break;
-
-	case MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE:
-		handle_message_rc_channels_override(msg);
-		break;
-
-	case MAVLINK_MSG_ID_HEARTBEAT:
-		handle_message_heartbeat(msg);
-		break;
-
-	case MAVLINK_MSG_ID_DISTANCE_SENSOR:
-		handle_message_distance_sensor(msg);
-		break;
-
-	case MAVLINK_MSG_ID_FOLLOW_TARGET:
-		handle_message_follow_target(msg);
-		break;
-
-	case MAVLINK_MSG_ID_LANDING_TARGET:
-		handle_message_landing_target(msg);
-		break;
-
-	case MAVLINK_MSG_ID_CELLULAR_STATUS:
-		handle_message_cellular_status(msg);
-		break;
-
-	case MAVLINK_MSG_ID_ADSB_VEHICLE:
-		handle_message_adsb_vehicle(msg);
-		break;
-
-	case MAVLINK_MSG_ID_GPS_RTCM_DATA:
-		handle_message_gps_rtcm_data(msg);
-		break;
-
-	case MAVLINK_MSG_ID_BATTERY_STATUS:
-		handle_message_battery_status(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SERIAL_CONTROL:
-		handle_message_serial_control(msg);
-		break;
-
-	case MAVLINK_MSG_ID_LOGGING_ACK:
-		handle_message_logging_ack(msg);
-		break;
-
-	case MAVLINK_MSG_ID_PLAY_TUNE:
-		handle_message_play_tune(msg);
-		break;
-
-	case MAVLINK_MSG_ID_PLAY_TUNE_V2:
-		handle_message_play_tune_v2(msg);
-		break;
-
-	case MAVLINK_MSG_ID_OBSTACLE_DISTANCE:
-		handle_message_obstacle_distance(msg);
-		break;
-
-	case MAVLINK_MSG_ID_TUNNEL:
-		handle_message_tunnel(msg);
-		break;
-
-	case MAVLINK_MSG_ID_ONBOARD_COMPUTER_STATUS:
-		handle_message_onboard_computer_status(msg);
-		break;
-
-	case MAVLINK_MSG_ID_GENERATOR_STATUS:
-		handle_message_generator_status(msg);
-		break;
-
-	case MAVLINK_MSG_ID_STATUSTEXT:
-		handle_message_statustext(msg);
-		break;
+	switch (gate) {
+	case DispatchGate::HIL:
+		return _mavlink.get_hil_enabled();
 
-	case MAVLINK_MSG_ID_OPEN_DRONE_ID_OPERATOR_ID:
-		handle_message_open_drone_id_operator_id(msg);
-		break;
+	case DispatchGate::HIL_GPS:
+		return _mavlink.get_hil_enabled() || (_mavlink.get_use_hil_gps() && msg.sysid == mavlink_system.sysid);
 
-	case MAVLINK_MSG_ID_OPEN_DRONE_ID_SELF_ID:
-		handle_message_open_drone_id_self_id(msg);
-		break;
+	case DispatchGate::FTP:
+		return _mavlink.ftp_enabled();
 
-	case MAVLINK_MSG_ID_OPEN_DRONE_ID_SYSTEM:
-		handle_message_open_drone_id_system(msg);
-		break;
-
-#if !defined(CONSTRAINED_FLASH)
-
-	case MAVLINK_MSG_ID_NAMED_VALUE_FLOAT:
-		handle_message_named_value_float(msg);
-		break;
-
-	case MAVLINK_MSG_ID_NAMED_VALUE_INT:
-		handle_message_named_value_int(msg);
-		break;
-
-	case MAVLINK_MSG_ID_DEBUG:
-		handle_message_debug(msg);
-		break;
-
-	case MAVLINK_MSG_ID_DEBUG_VECT:
-		handle_message_debug_vect(msg);
-		break;
-
-	case MAVLINK_MSG_ID_DEBUG_FLOAT_ARRAY:
-		handle_message_debug_float_array(msg);
-		break;
-#endif // !CONSTRAINED_FLASH
-
-	case MAVLINK_MSG_ID_GIMBAL_MANAGER_SET_ATTITUDE:
-		handle_message_gimbal_manager_set_attitude(msg);
-		break;
-
-	case MAVLINK_MSG_ID_GIMBAL_MANAGER_SET_MANUAL_CONTROL:
-		handle_message_gimbal_manager_set_manual_control(msg);
-		break;
-
-	case MAVLINK_MSG_ID_GIMBAL_DEVICE_INFORMATION:
-		handle_message_gimbal_device_information(msg);
-		break;
-
-	case MAVLINK_MSG_ID_REQUEST_EVENT:
-		handle_message_request_event(msg);
-		break;
-
-	case MAVLINK_MSG_ID_GIMBAL_DEVICE_ATTITUDE_STATUS:
-		handle_message_gimbal_device_attitude_status(msg);
-		break;
-
-#if defined(MAVLINK_MSG_ID_SET_VELOCITY_LIMITS) // For now only defined if development.xml is used
-
-	case MAVLINK_MSG_ID_SET_VELOCITY_LIMITS:
-		handle_message_set_velocity_limits(msg);
-		break;
-#endif
+	case DispatchGate::BOOT_COMPLETE:
+		// make sure mavlink app has booted before we start processing parameter sync
+		return _mavlink.boot_complete();
 
+	case DispatchGate::NONE:
 	default:
-		break;
+		return true;
 	}
+}
 
-	/*
-	 * Only decode hil messages in HIL mode.
-	 *
-	 * The HIL mode is enabled by the HIL bit flag
-	 * in the system mode. Either send a set mode
-	 * COMMAND_LONG message or a SET_MODE message
-	 *
-	 * Accept HIL GPS messages if use_hil_gps flag is true.
-	 * This allows to provide fake gps measurements to the system.
-	 */
-	if (_mavlink.get_hil_enabled()) {
-		switch (msg->msgid) {
-		case MAVLINK_MSG_ID_HIL_SENSOR:
-			handle_message_hil_sensor(msg);
-			break;
-
-		case MAVLINK_MSG_ID_HIL_STATE_QUATERNION:
-			handle_message_hil_state_quaternion(msg);
-			break;
-
-		case MAVLINK_MSG_ID_HIL_OPTICAL_FLOW:
-			handle_message_hil_optical_flow(msg);
-			break;
-
-		default:
-			break;
-		}
+void
+MavlinkReceiver::handle_message(mavlink_message_t *msg)
+{
+	if (!_mavlink.boot_complete() && (hrt_elapsed_time(&_mavlink.get_first_start_time()) > 20_s)) {
+		PX4_ERR("system boot did not complete in 20 seconds");
+		_mavlink.set_boot_complete();
 	}
 
+	for (unsigned slot = dispatch_slot(msg->msgid); _dispatch_table[slot] != DISPATCH_SLOT_EMPTY;
+	     slot = (slot + 1) & (DISPATCH_TABLE_SIZE - 1)) {
 
-	if (_mavlink.get_hil_enabled() || (_mavlink.get_use_hil_gps() && msg->sysid == mavlink_system.sysid)) {
-		switch (msg->msgid) {
-		case MAVLINK_MSG_ID_HIL_GPS:
-			handle_message_hil_gps(msg);
-			break;
+		const uint8_t index = _dispatch_table[slot];
+		const MessageHandler &entry = _message_handlers[index];
 
-		default:
-			break;
+		if ((entry.msg_id != msg->msgid) || !dispatch_gate_open(entry.gate, *msg)) {
+			continue;
 		}
 
-	}
+		(this->*entry.handler)(msg);
 
-	/* handle packet with mission manager */
-	_mission_manager.handle_message(msg);
+#if !defined(CONSTRAINED_FLASH)
 
-	/* handle packet with parameter component */
-	if (_mavlink.boot_complete()) {
-		// make sure mavlink app has booted before we start processing parameter sync
-		_parameters_manager.handle_message(msg);
+		if (_dispatch_stats && (_rx_timestamp != 0)) {
+			const uint32_t latency_us = hrt_elapsed_time(&_rx_timestamp);
+			DispatchStats &stats = _dispatch_stats[index];
+			stats.count++;
+			stats.latency_sum_us += latency_us;
 
-	} else {
-		if (hrt_elapsed_time(&_mavlink.get_first_start_time()) > 20_s) {
-			PX4_ERR("system boot did not complete in 20 seconds");
-			_mavlink.set_boot_complete();
+			if (latency_us > stats.latency_max_us) {
+				stats.latency_max_us = latency_us;
+			}
 		}
-	}
 
-	if (_mavlink.ftp_enabled()) {
-		/* handle packet with ftp component */
-		_mavlink_ftp.handle_message(msg);
+#endif // !CONSTRAINED_FLASH
 	}
 
-	/* handle packet with log component */
-	_mavlink_log_handler.handle_message(msg);
-
-	/* handle packet with timesync component */
-	_mavlink_timesync.handle_message(msg);
-
 	/* handle packet with parent object */
 	_mavlink.handle_message(msg);
 }
@@ -3119,6 +3023,104 @@ void MavlinkReceiver::handle_message_open_drone_id_system(
 
 	_open_drone_id_system_pub.publish(odid_system);
 }
+#if defined(MAVLINK_UDP)
+/**
+ * Lock on to the UDP partner, either the first one on localhost or any after 3 seconds.
+ * @return true once messages from srcaddr can be accepted
+ */
+static bool check_udp_source(Mavlink &mavlink, const sockaddr_in &srcaddr)
+{
+	struct sockaddr_in &srcaddr_last = mavlink.get_client_source_address();
+
+	int localhost = (127 << 24) + 1;
+
+	if (!mavlink.get_client_source_initialized()) {
+
+		// set the address either if localhost or if 3 seconds have passed
+		// this ensures that a GCS running on localhost can get a hold of
+		// the system within the first N seconds
+		hrt_abstime stime = mavlink.get_start_time();
+
+		if ((stime != 0 && (hrt_elapsed_time(&stime) > 3_s))
+		    || (srcaddr_last.sin_addr.s_addr == htonl(localhost))) {
+
+			srcaddr_last.sin_addr.s_addr = srcaddr.sin_addr.s_addr;
+			srcaddr_last.sin_port = srcaddr.sin_port;
+
+			mavlink.set_client_source_initialized();
+
+			PX4_INFO("partner IP: %s", inet_ntoa(srcaddr.sin_addr));
+		}
+	}
+
+	return mavlink.get_client_source_initialized();
+}
+#endif // MAVLINK_UDP
+
+void
+MavlinkReceiver::parse_received(const uint8_t *buf, ssize_t nread)
+{
+	mavlink_message_t msg;
+
+	// reference for the receive to publish latency of every message parsed from this read
+	_rx_timestamp = hrt_absolute_time();
+
+	/* if read failed, this loop won't execute */
+	for (ssize_t i = 0; i < nread; i++) {
+		if (mavlink_parse_char(_mavlink.get_channel(), buf[i], &msg, &_status)) {
+
+			// If we receive a complete MAVLink 2 packet, also switch the outgoing protocol version
+			if (!(_mavlink.get_status()->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1)
+			    && _mavlink.getProtocolVersion() != 2) {
+				PX4_INFO("Upgrade to MAVLink v2 because of incoming packet");
+				_mavlink.setProtocolVersion(2);
+			}
+
+			switch (_mavlink.get_mode()) {
+			case Mavlink::MAVLINK_MODE::MAVLINK_MODE_GIMBAL:
+				handle_messages_in_gimbal_mode(msg);
+				break;
+
+			default:
+				handle_message(&msg);
+				break;
+			}
+
+			_mavlink.set_has_received_messages(true); // Received first message, unlock wait to transmit '-w' command-line flag
+			update_rx_stats(msg);
+
+			if (_message_statistics_enabled) {
+				update_message_statistics(msg);
+			}
+		}
+	}
+
+	/* count received bytes (nread will be -1 on read error) */
+	if (nread > 0) {
+		_mavlink.count_rxbytes(nread);
+
+		telemetry_status_s &tstatus = _mavlink.telemetry_status();
+		tstatus.rx_message_count = _total_received_counter;
+		tstatus.rx_message_lost_count = _total_lost_counter;
+		tstatus.rx_message_lost_rate = static_cast<float>(_total_lost_counter) / static_cast<float>(_total_received_counter);
+
+		if (_mavlink_status_last_buffer_overrun != _status.buffer_overrun) {
+			tstatus.rx_buffer_overruns++;
+			_mavlink_status_last_buffer_overrun = _status.buffer_overrun;
+		}
+
+		if (_mavlink_status_last_parse_error != _status.parse_error) {
+			tstatus.rx_parse_errors++;
+			_mavlink_status_last_parse_error = _status.parse_error;
+		}
+
+		if (_mavlink_status_last_packet_rx_drop_count != _status.packet_rx_drop_count) {
+			tstatus.rx_packet_drop_count++;
+			_mavlink_status_last_packet_rx_drop_count = _status.packet_rx_drop_count;
+		}
+	}
+}
+
 void
 MavlinkReceiver::run()
 {
@@ -3142,7 +3144,6 @@ MavlinkReceiver::run()
 	/* the serial port buffers internally as well, we just need to fit a small chunk */
 	uint8_t buf[64];
 #endif
-	mavlink_message_t msg;
 
 	struct pollfd fds[1] = {};
 
@@ -3183,103 +3184,50 @@ MavlinkReceiver::run()
 			if (_mavlink.get_protocol() == Protocol::SERIAL) {
 				/* non-blocking read. read may return negative values */
 				nread = ::read(fds[0].fd, buf, sizeof(buf));
+				_mavlink.count_rx_syscalls(1);
 
 				if (nread == -1 && errno == ENOTCONN) { // Not connected (can happen for USB)
 					usleep(100000);
 				}
+
+				parse_received(buf, nread);
 			}
 
 #if defined(MAVLINK_UDP)
 
 			else if (_mavlink.get_protocol() == Protocol::UDP) {
 				if (fds[0].revents & POLLIN) {
-					nread = recvfrom(_mavlink.get_socket_fd(), buf, sizeof(buf), 0, (struct sockaddr *)&srcaddr, &addrlen);
-				}
-
-				struct sockaddr_in &srcaddr_last = _mavlink.get_client_source_address();
-
-				int localhost = (127 << 24) + 1;
-
-				if (!_mavlink.get_client_source_initialized()) {
-
-					// set the address either if localhost or if 3 seconds have passed
-					// this ensures that a GCS running on localhost can get a hold of
-					// the system within the first N seconds
-					hrt_abstime stime = _mavlink.get_start_time();
-
-					if ((stime != 0 && (hrt_elapsed_time(&stime) > 3_s))
-					    || (srcaddr_last.sin_addr.s_addr == htonl(localhost))) {
-
-						srcaddr_last.sin_addr.s_addr = srcaddr.sin_addr.s_addr;
-						srcaddr_last.sin_port = srcaddr.sin_port;
+#if defined(MAVLINK_UDP_BATCH)
 
-						_mavlink.set_client_source_initialized();
-
-						PX4_INFO("partner IP: %s", inet_ntoa(srcaddr.sin_addr));
-					}
-				}
-			}
-
-			// only start accepting messages on UDP once we're sure who we talk to
-			if (_mavlink.get_protocol() != Protocol::UDP || _mavlink.get_client_source_initialized()) {
-#endif // MAVLINK_UDP
-
-				/* if read failed, this loop won't execute */
-				for (ssize_t i = 0; i < nread; i++) {
-					if (mavlink_parse_char(_mavlink.get_channel(), buf[i], &msg, &_status)) {
-
-						// If we receive a complete MAVLink 2 packet, also switch the outgoing protocol version
-						if (!(_mavlink.get_status()->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1)
-						    && _mavlink.getProtocolVersion() != 2) {
-							PX4_INFO("Upgrade to MAVLink v2 because of incoming packet");
-							_mavlink.setProtocolVersion(2);
+					if (_mavlink.udp_batching_enabled()) {
+						if (_udp_rx_buffer == nullptr) {
+							_udp_rx_buffer = new uint8_t[MavlinkUDPBatch::RX_BUFFER_SIZE];
 						}
 
-						switch (_mavlink.get_mode()) {
-						case Mavlink::MAVLINK_MODE::MAVLINK_MODE_GIMBAL:
-							handle_messages_in_gimbal_mode(msg);
-							break;
+						MavlinkUDPBatch::RxDatagram datagrams[MavlinkUDPBatch::MAX_RX_DATAGRAMS];
+						const int received = (_udp_rx_buffer != nullptr) ?
+								     MavlinkUDPBatch::receive(_mavlink.get_socket_fd(), _udp_rx_buffer, MavlinkUDPBatch::RX_BUFFER_SIZE, datagrams) : -1;
+						_mavlink.count_rx_syscalls(1);
 
-						default:
-							handle_message(&msg);
-							break;
+						// the datagrams can come from different sources, handle each on its own like a recvfrom() result
+						for (int i = 0; i < received; i++) {
+							if (check_udp_source(_mavlink, datagrams[i].src_addr)) {
+								parse_received(datagrams[i].data, datagrams[i].len);
+							}
 						}
 
-						_mavlink.set_has_received_messages(true); // Received first message, unlock wait to transmit '-w' command-line flag
-						update_rx_stats(msg);
+					} else
+#endif // MAVLINK_UDP_BATCH
+					{
+						nread = recvfrom(_mavlink.get_socket_fd(), buf, sizeof(buf), 0, (struct sockaddr *)&srcaddr, &addrlen);
+						_mavlink.count_rx_syscalls(1);
 
-						if (_message_statistics_enabled) {
-							update_message_statistics(msg);
+						// only start accepting messages on UDP once we're sure who we talk to
+						if (check_udp_source(_mavlink, srcaddr)) {
+							parse_received(buf, nread);
 						}
 					}
 				}
-
-				/* count received bytes (nread will be -1 on read error) */
-				if (nread > 0) {
-					_mavlink.count_rxbytes(nread);
-
-					telemetry_status_s &tstatus = _mavlink.telemetry_status();
-					tstatus.rx_message_count = _total_received_counter;
-					tstatus.rx_message_lost_count = _total_lost_counter;
-					tstatus.rx_message_lost_rate = static_cast<float>(_total_lost_counter) / static_cast<float>(_total_received_counter);
-
-					if (_mavlink_status_last_buffer_overrun != _status.buffer_overrun) {
-						tstatus.rx_buffer_overruns++;
-						_mavlink_status_last_buffer_overrun = _status.buffer_overrun;
-					}
-
-					if (_mavlink_status_last_parse_error != _status.parse_error) {
-						tstatus.rx_parse_errors++;
-						_mavlink_status_last_parse_error = _status.parse_error;
-					}
-
-					if (_mavlink_status_last_packet_rx_drop_count != _status.packet_rx_drop_count) {
-						tstatus.rx_packet_drop_count++;
-						_mavlink_status_last_packet_rx_drop_count = _status.packet_rx_drop_count;
-					}
-				}
-
-#if defined(MAVLINK_UDP)
 			}
 
 #endif // MAVLINK_UDP
@@ -3393,6 +3341,10 @@ void MavlinkReceiver::update_message_statistics(const mavlink_message_t &message
 		_received_msg_stats = new ReceivedMessageStats[MAX_MSG_STAT_SLOTS];
 	}
 
+	if (_dispatch_stats == nullptr) {
+		_dispatch_stats = new DispatchStats[arraySize(_message_handlers)];
+	}
+
 	if (_received_msg_stats) {
 		const hrt_abstime now_ms = hrt_absolute_time() / 1000;
 
@@ -3494,6 +3446,24 @@ void MavlinkReceiver::print_detailed_rx_stats() const
 			}
 		}
 	}
+
+#if !defined(CONSTRAINED_FLASH)
+
+	if (_message_statistics_enabled && _dispatch_stats) {
+		printf("\tReceive to publish latency:\n");
+
+		for (unsigned i = 0; i < arraySize(_message_handlers); i++) {
+			const DispatchStats &stats = _dispatch_stats[i];
+
+			if (stats.count > 0) {
+				printf("\t  msgid:%5" PRIu32 ", count:%8" PRIu32 ", avg:%7.1f us, max:%7" PRIu32 " us\n",
+				       _message_handlers[i].msg_id, stats.count,
+				       (double)stats.latency_sum_us / stats.count, stats.latency_max_us);
+			}
+		}
+	}
+
+#endif // !CONSTRAINED_FLASH
 }
 
 void MavlinkReceiver::start()
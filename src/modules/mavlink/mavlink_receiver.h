@@ -157,6 +157,48 @@ private:
 	void handle_message(mavlink_message_t *msg);
 	void handle_messages_in_gimbal_mode(mavlink_message_t &msg);
 
+	/**
+	 * Parse and handle a chunk of received bytes, i.e. a serial read or a single UDP datagram
+	 */
+	void parse_received(const uint8_t *buf, ssize_t nread);
+
+	/**
+	 * Conditions under which a registered handler is called.
+	 */
+	enum class DispatchGate : uint8_t {
+		NONE,
+		HIL,           ///< only in HIL mode
+		HIL_GPS,       ///< in HIL mode, or if HIL GPS is accepted from our own system
+		FTP,           ///< only if FTP is enabled on this instance
+		BOOT_COMPLETE, ///< only once the mavlink app has booted
+	};
+
+	/**
+	 * Entry of the message dispatch table. Each handler is registered for exactly
+	 * the msgids it consumes, so handle_message() does a single hash lookup instead
+	 * of walking a switch and every sub-component for each message.
+	 */
+	struct MessageHandler {
+		uint32_t msg_id;
+		void (MavlinkReceiver::*handler)(mavlink_message_t *msg);
+		DispatchGate gate;
+	};
+
+	static const MessageHandler _message_handlers[];
+
+	static constexpr unsigned DISPATCH_TABLE_BITS{7};
+	static constexpr unsigned DISPATCH_TABLE_SIZE{1u << DISPATCH_TABLE_BITS};
+	static constexpr uint8_t DISPATCH_SLOT_EMPTY{UINT8_MAX};
+
+	static unsigned dispatch_slot(uint32_t msg_id) { return (msg_id * 2654435761u) >> (32 - DISPATCH_TABLE_BITS); }
+	bool dispatch_gate_open(DispatchGate gate, const mavlink_message_t &msg) const;
+
+	void handle_message_ftp(mavlink_message_t *msg) { _mavlink_ftp.handle_message(msg); }
+	void handle_message_log(mavlink_message_t *msg) { _mavlink_log_handler.handle_message(msg); }
+	void handle_message_mission(mavlink_message_t *msg) { _mission_manager.handle_message(msg); }
+	void handle_message_param(mavlink_message_t *msg) { _parameters_manager.handle_message(msg); }
+	void handle_message_timesync(mavlink_message_t *msg) { _mavlink_timesync.handle_message(msg); }
+
 	void handle_message_adsb_vehicle(mavlink_message_t *msg);
 	void handle_message_att_pos_mocap(mavlink_message_t *msg);
 	void handle_message_battery_status(mavlink_message_t *msg);
@@ -285,8 +327,19 @@ private:
 		uint8_t component_id{0};
 	};
 	ReceivedMessageStats *_received_msg_stats{nullptr};
+
+	struct DispatchStats {
+		uint64_t latency_sum_us{0};
+		uint32_t latency_max_us{0};
+		uint32_t count{0};
+	};
+	DispatchStats *_dispatch_stats{nullptr}; ///< per entry of _message_handlers
 #endif // !CONSTRAINED_FLASH
 
+	uint8_t _dispatch_table[DISPATCH_TABLE_SIZE] {}; ///< msgid hash slot -> index into _message_handlers
+	hrt_abstime _rx_timestamp{0};                     ///< time the current receive buffer was read
+	uint8_t *_udp_rx_buffer{nullptr};                 ///< receive slots for batched UDP, allocated on first use
+
 	uint64_t _total_received_counter{0};                            ///< The total number of successfully received messages
 	uint64_t _total_lost_counter{0};                                ///< Total messages lost during transmission.
 
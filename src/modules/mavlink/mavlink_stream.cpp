@@ -58,39 +58,41 @@ MavlinkStream::update(const hrt_abstime &t)
 {
 	update_data();
 
-	// If the message has never been sent before we want
-	// to send it immediately and can return right away
-	if (_last_sent == 0) {
-		// this will give different messages on the same run a different
-		// initial timestamp which will help spacing them out
-		// on the link scheduling
-		if (send()) {
-			_last_sent = hrt_absolute_time();
+	return send_if_due(t);
+}
 
-			if (!_first_message_sent) {
-				_first_message_sent = true;
-			}
-		}
+int
+MavlinkStream::get_interval_scaled()
+{
+	int interval = _interval;
 
-		return 0;
+	if (!const_rate()) {
+		interval /= _mavlink->get_rate_mult();
+	}
+
+	return interval;
+}
+
+bool
+MavlinkStream::is_due(const hrt_abstime &t)
+{
+	// If the message has never been sent before we want
+	// to send it immediately
+	if (_last_sent == 0) {
+		return true;
 	}
 
 	// One of the previous iterations sent the update
 	// already before the deadline
 	if (_last_sent > t) {
-		return -1;
+		return false;
 	}
 
-	int64_t dt = t - _last_sent;
-	int interval = _interval;
-
-	if (!const_rate()) {
-		interval /= _mavlink->get_rate_mult();
-	}
+	const int interval = get_interval_scaled();
 
 	// We don't need to send anything if the inverval is 0. send() will be called manually.
 	if (interval == 0) {
-		return 0;
+		return false;
 	}
 
 	const bool unlimited_rate = interval < 0;
@@ -104,27 +106,101 @@ MavlinkStream::update(const hrt_abstime &t)
 	// needs to be accounted for as well.
 	// This method is not theoretically optimal but a suitable
 	// stopgap as it hits its deadlines well (0.5 Hz, 50 Hz and 250 Hz)
+	const int64_t dt = t - _last_sent;
 
-	if (unlimited_rate || (dt > (interval - (_mavlink->get_main_loop_delay() / 10) * 3))) {
-		// interval expired, send message
+	return unlimited_rate || (dt > (interval - (_mavlink->get_main_loop_delay() / 10) * 3));
+}
 
-		// If the interval is non-zero and dt is smaller than 1.5 times the interval
-		// do not use the actual time but increment at a fixed rate, so that processing delays do not
-		// distort the average rate. The check of the maximum interval is done to ensure that after a
-		// long time not sending anything, sending multiple messages in a short time is avoided.
-		if (send()) {
-			_last_sent = ((interval > 0) && ((int64_t)(1.5f * interval) > dt)) ? _last_sent + interval : t;
+hrt_abstime
+MavlinkStream::get_deadline()
+{
+	const int interval = get_interval_scaled();
+
+	if (_last_sent == 0 || interval <= 0) {
+		return _last_sent;
+	}
+
+	return _last_sent + interval;
+}
+
+hrt_abstime
+MavlinkStream::get_next_due()
+{
+	if (_last_sent == 0) {
+		return 0;
+	}
+
+	const int interval = get_interval_scaled();
+
+	if (interval == 0) {
+		return UINT64_MAX;
+	}
 
-			if (!_first_message_sent) {
-				_first_message_sent = true;
-			}
+	if (interval < 0) {
+		return 0;
+	}
 
-			return 0;
+	// see is_due(): sent once dt exceeds the interval reduced by 30% of the main loop delay
+	const int64_t offset = interval - (_mavlink->get_main_loop_delay() / 10) * 3;
 
-		} else {
-			return -1;
+	return _last_sent + ((offset >= 0) ? offset + 1 : 0);
+}
+
+int
+MavlinkStream::send_if_due(const hrt_abstime &t)
+{
+	if (!is_due(t)) {
+		return -1;
+	}
+
+	if (_last_sent == 0) {
+		// this will give different messages on the same run a different
+		// initial timestamp which will help spacing them out
+		// on the link scheduling
+		if (send()) {
+			_last_sent = hrt_absolute_time();
+			_first_message_sent = true;
+			_sent_count++;
 		}
+
+		return 0;
+	}
+
+	const int64_t dt = t - _last_sent;
+	const int interval = get_interval_scaled();
+
+	// If the interval is non-zero and dt is smaller than 1.5 times the interval
+	// do not use the actual time but increment at a fixed rate, so that processing delays do not
+	// distort the average rate. The check of the maximum interval is done to ensure that after a
+	// long time not sending anything, sending multiple messages in a short time is avoided.
+	if (send()) {
+		_last_sent = ((interval > 0) && ((int64_t)(1.5f * interval) > dt)) ? _last_sent + interval : t;
+		_first_message_sent = true;
+		_sent_count++;
+
+		return 0;
 	}
 
 	return -1;
 }
+
+bool
+MavlinkStream::update_rate_achieved(float dt)
+{
+	const float rate_achieved_prev = _rate_achieved;
+
+	if (dt > 0.f) {
+		_rate_achieved = _sent_count / dt;
+	}
+
+	_sent_count = 0;
+
+	// ignore small jitter of the measured rate
+	const bool changed = (fabsf(_rate_achieved - rate_achieved_prev) > 0.1f * fmaxf(rate_achieved_prev, 1.f))
+			     || (_deferred_count != _deferred_count_reported) || (_interval != _interval_reported);
+
+	_deferred_count_reported = _deferred_count;
+	_interval_reported = _interval;
+
+	return changed;
+}
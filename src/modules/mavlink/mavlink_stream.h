@@ -46,6 +46,7 @@
 #include <containers/List.hpp>
 
 class Mavlink;
+class MavlinkStreamScheduler;
 
 class MavlinkStream : public ListNode<MavlinkStream *>
 {
@@ -79,6 +80,47 @@ public:
 	 * @return 0 if updated / sent, -1 if unchanged
 	 */
 	int update(const hrt_abstime &t);
+
+	/**
+	 * Check if the stream is due to be sent at time t, without sending anything
+	 */
+	bool is_due(const hrt_abstime &t);
+
+	/**
+	 * @return time at which the stream is (or was) due, 0 if it was never sent
+	 */
+	hrt_abstime get_deadline();
+
+	/**
+	 * @return earliest time at which is_due() can return true, 0 if it is due at any time
+	 *         and UINT64_MAX if it is only sent on request
+	 */
+	hrt_abstime get_next_due();
+
+	/**
+	 * Scheduling priority, used by the stream scheduler to decide which streams are
+	 * sent first when the link budget is exhausted. Higher is more important.
+	 */
+	enum Priority : uint8_t {
+		PRIORITY_LOW = 0,
+		PRIORITY_NORMAL,
+		PRIORITY_HIGH,
+		PRIORITY_CRITICAL,
+	};
+
+	void set_priority(uint8_t priority) { _priority = priority; }
+	uint8_t get_priority() const { return _priority; }
+
+	/**
+	 * Update the achieved rate with the number of messages sent since the last call
+	 *
+	 * @param dt time since the last call in seconds
+	 * @return true if the scheduling status (rates or deferrals) changed since the last call
+	 */
+	bool update_rate_achieved(float dt);
+
+	float get_rate_achieved() const { return _rate_achieved; }
+	uint32_t get_deferred_count() const { return _deferred_count; }
 	virtual const char *get_name() const = 0;
 	virtual uint16_t get_id() = 0;
 
@@ -87,6 +129,11 @@ public:
 	 */
 	virtual bool const_rate() { return false; }
 
+	/**
+	 * @return true if the stream implements update_data() and needs to be updated at every iteration
+	 */
+	virtual bool needs_update_data() { return false; }
+
 	/**
 	 * Get maximal total messages size on update
 	 */
@@ -137,7 +184,27 @@ protected:
 	virtual void update_data() { }
 
 private:
+	friend class MavlinkStreamScheduler; // for update_data() and send_if_due()
+
+	/**
+	 * Send the message if it is due
+	 *
+	 * @return 0 if sent, -1 otherwise
+	 */
+	int send_if_due(const hrt_abstime &t);
+
+	/**
+	 * @return interval scaled by the rate multiplier of the instance
+	 */
+	int get_interval_scaled();
+
 	hrt_abstime _last_sent{0};
+	float _rate_achieved{0.f};
+	uint32_t _deferred_count{0};
+	uint32_t _deferred_count_reported{0};
+	int _interval_reported{0};
+	uint16_t _sent_count{0};
+	uint8_t _priority{PRIORITY_NORMAL};
 	bool _first_message_sent{false};
 };
 
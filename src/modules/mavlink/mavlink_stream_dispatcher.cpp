@@ -0,0 +1,227 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mavlink_stream_dispatcher.cpp
+ * Deadline ordered stream dispatch.
+ */
+
+#include "mavlink_stream_dispatcher.h"
+#include "mavlink_main.h"
+
+MavlinkStreamDispatcher::~MavlinkStreamDispatcher()
+{
+	delete[] _heap;
+	delete[] _collected;
+}
+
+bool
+MavlinkStreamDispatcher::reserve(int count)
+{
+	if (count <= _capacity) {
+		return true;
+	}
+
+	Entry *heap = new Entry[count];
+	MavlinkStream **collected = new MavlinkStream *[count];
+
+	if (heap == nullptr || collected == nullptr) {
+		delete[] heap;
+		delete[] collected;
+		return false;
+	}
+
+	delete[] _heap;
+	delete[] _collected;
+	_heap = heap;
+	_collected = collected;
+	_capacity = count;
+	return true;
+}
+
+hrt_abstime
+MavlinkStreamDispatcher::due_time(MavlinkStream *stream)
+{
+	if (stream->needs_update_data()) {
+		return 0;
+	}
+
+	return stream->get_next_due();
+}
+
+void
+MavlinkStreamDispatcher::rebuild(List<MavlinkStream *> &streams)
+{
+	_num_streams = 0;
+	_num_collected = 0;
+	_rate_mult = _mavlink->get_rate_mult();
+
+	if (!reserve(streams.size())) {
+		return;
+	}
+
+	for (const auto &stream : streams) {
+		_heap[_num_streams++] = {due_time(stream), stream};
+	}
+
+	for (int i = _num_streams / 2 - 1; i >= 0; i--) {
+		sift_down(i);
+	}
+
+	_rebuild = false;
+	_rebuilds++;
+}
+
+void
+MavlinkStreamDispatcher::sift_down(int i)
+{
+	const Entry entry = _heap[i];
+
+	for (;;) {
+		int child = 2 * i + 1;
+
+		if (child >= _num_streams) {
+			break;
+		}
+
+		if (child + 1 < _num_streams && _heap[child + 1].due < _heap[child].due) {
+			child++;
+		}
+
+		if (entry.due <= _heap[child].due) {
+			break;
+		}
+
+		_heap[i] = _heap[child];
+		i = child;
+	}
+
+	_heap[i] = entry;
+}
+
+void
+MavlinkStreamDispatcher::push(MavlinkStream *stream)
+{
+	const Entry entry{due_time(stream), stream};
+	int i = _num_streams++;
+
+	while (i > 0) {
+		const int parent = (i - 1) / 2;
+
+		if (_heap[parent].due <= entry.due) {
+			break;
+		}
+
+		_heap[i] = _heap[parent];
+		i = parent;
+	}
+
+	_heap[i] = entry;
+}
+
+void
+MavlinkStreamDispatcher::pop()
+{
+	_heap[0] = _heap[--_num_streams];
+
+	if (_num_streams > 0) {
+		sift_down(0);
+	}
+}
+
+int
+MavlinkStreamDispatcher::collect(const hrt_abstime &t, List<MavlinkStream *> &streams)
+{
+	const hrt_abstime start = hrt_absolute_time();
+
+	// The due times depend on the rate multiplier, rebuild if it changed significantly.
+	// A smaller change only delays or advances the streams by a fraction of their interval.
+	const float rate_mult = _mavlink->get_rate_mult();
+
+	if (fabsf(rate_mult - _rate_mult) > RATE_MULT_TOLERANCE * _rate_mult) {
+		_rebuild = true;
+	}
+
+	if (_rebuild) {
+		rebuild(streams);
+
+		if (_rebuild) {
+			return -1;
+		}
+	}
+
+	_num_collected = 0;
+
+	while (_num_streams > 0 && _heap[0].due <= t) {
+		_collected[_num_collected++] = _heap[0].stream;
+		pop();
+	}
+
+	_loops++;
+	_checked += _num_collected;
+	_elapsed += hrt_elapsed_time(&start);
+
+	return _num_collected;
+}
+
+void
+MavlinkStreamDispatcher::reschedule()
+{
+	const hrt_abstime start = hrt_absolute_time();
+
+	for (int i = 0; i < _num_collected; i++) {
+		push(_collected[i]);
+	}
+
+	_num_collected = 0;
+	_elapsed += hrt_elapsed_time(&start);
+}
+
+void
+MavlinkStreamDispatcher::update_statistics(float dt)
+{
+	if (_loops > 0) {
+		_checked_per_loop = (float)_checked / _loops;
+		_time_per_loop = (float)_elapsed / _loops;
+	}
+
+	if (dt > 0.f) {
+		_rebuild_rate = _rebuilds / dt;
+	}
+
+	_loops = 0;
+	_checked = 0;
+	_elapsed = 0;
+	_rebuilds = 0;
+}
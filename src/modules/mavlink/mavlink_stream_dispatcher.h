@@ -0,0 +1,140 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mavlink_stream_dispatcher.h
+ * Deadline ordered stream dispatch.
+ *
+ * Streams are kept in a min-heap ordered by the time they become due, so that
+ * each iteration of the main loop only touches the streams that need to be
+ * updated instead of polling all of them. Streams that are always due
+ * (unlimited rate, never sent, or implementing update_data()) are kept at the
+ * top of the heap with a due time of 0.
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <containers/List.hpp>
+
+#include "mavlink_stream.h"
+
+class Mavlink;
+
+class MavlinkStreamDispatcher
+{
+public:
+	MavlinkStreamDispatcher(Mavlink *mavlink) : _mavlink(mavlink) {}
+	~MavlinkStreamDispatcher();
+
+	// no copy, assignment, move, move assignment
+	MavlinkStreamDispatcher(const MavlinkStreamDispatcher &) = delete;
+	MavlinkStreamDispatcher &operator=(const MavlinkStreamDispatcher &) = delete;
+	MavlinkStreamDispatcher(MavlinkStreamDispatcher &&) = delete;
+	MavlinkStreamDispatcher &operator=(MavlinkStreamDispatcher &&) = delete;
+
+	/**
+	 * Rebuild the schedule before the next dispatch. Must be called whenever
+	 * streams are added, removed or their interval changes.
+	 */
+	void invalidate() { _rebuild = true; }
+
+	/**
+	 * Collect the streams that need to be updated at time t.
+	 * They have to be handed back with reschedule() once they were updated.
+	 *
+	 * @return number of collected streams, or -1 if the schedule could not be allocated
+	 *         (in which case all streams need to be updated)
+	 */
+	int collect(const hrt_abstime &t, List<MavlinkStream *> &streams);
+
+	MavlinkStream *const *collected() const { return _collected; }
+
+	/**
+	 * Put the streams returned by the last collect() back into the schedule
+	 */
+	void reschedule();
+
+	/**
+	 * Update the statistics, to be called periodically
+	 *
+	 * @param dt time since the last call in seconds
+	 */
+	void update_statistics(float dt);
+
+	int get_num_streams() const { return _num_streams; }
+	float get_checked_per_loop() const { return _checked_per_loop; }	///< average number of streams touched per loop
+	float get_time_per_loop() const { return _time_per_loop; }		///< average dispatch overhead per loop [us]
+	float get_rebuild_rate() const { return _rebuild_rate; }		///< schedule rebuilds per second
+
+	/**
+	 * Relative change of the rate multiplier that triggers a rebuild of the schedule
+	 */
+	static constexpr float RATE_MULT_TOLERANCE{0.01f};
+
+private:
+	struct Entry {
+		hrt_abstime due;
+		MavlinkStream *stream;
+	};
+
+	bool reserve(int count);
+	void rebuild(List<MavlinkStream *> &streams);
+	void push(MavlinkStream *stream);
+	void pop();
+	void sift_down(int i);
+
+	static hrt_abstime due_time(MavlinkStream *stream);
+
+	Mavlink *const _mavlink;
+
+	Entry *_heap{nullptr};
+	MavlinkStream **_collected{nullptr};
+	int _capacity{0};
+	int _num_streams{0};	///< number of streams in the heap
+	int _num_collected{0};
+
+	float _rate_mult{1.f};	///< rate multiplier the schedule was built with
+	bool _rebuild{true};
+
+	// statistics
+	uint32_t _loops{0};
+	uint32_t _checked{0};
+	uint32_t _rebuilds{0};
+	uint64_t _elapsed{0};
+
+	float _checked_per_loop{0.f};
+	float _time_per_loop{0.f};
+	float _rebuild_rate{0.f};
+};
@@ -0,0 +1,188 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mavlink_stream_scheduler.cpp
+ * Priority-aware stream scheduler with link bandwidth budgeting.
+ */
+
+#include "mavlink_stream_scheduler.h"
+#include "mavlink_main.h"
+
+MavlinkStreamScheduler::~MavlinkStreamScheduler()
+{
+	delete[] _due;
+}
+
+uint8_t
+MavlinkStreamScheduler::default_priority(uint16_t msg_id)
+{
+	switch (msg_id) {
+	case MAVLINK_MSG_ID_HEARTBEAT:
+	case MAVLINK_MSG_ID_HIGH_LATENCY2:
+	case MAVLINK_MSG_ID_STATUSTEXT:
+	case MAVLINK_MSG_ID_COMMAND_LONG:
+	case MAVLINK_MSG_ID_TIMESYNC:
+		return MavlinkStream::PRIORITY_CRITICAL;
+
+	case MAVLINK_MSG_ID_ATTITUDE:
+	case MAVLINK_MSG_ID_ATTITUDE_QUATERNION:
+	case MAVLINK_MSG_ID_GLOBAL_POSITION_INT:
+	case MAVLINK_MSG_ID_LOCAL_POSITION_NED:
+	case MAVLINK_MSG_ID_ODOMETRY:
+	case MAVLINK_MSG_ID_SYS_STATUS:
+	case MAVLINK_MSG_ID_EXTENDED_SYS_STATE:
+	case MAVLINK_MSG_ID_BATTERY_STATUS:
+	case MAVLINK_MSG_ID_GPS_RAW_INT:
+	case MAVLINK_MSG_ID_HOME_POSITION:
+	case MAVLINK_MSG_ID_VFR_HUD:
+		return MavlinkStream::PRIORITY_HIGH;
+
+	case MAVLINK_MSG_ID_DEBUG:
+	case MAVLINK_MSG_ID_DEBUG_VECT:
+	case MAVLINK_MSG_ID_DEBUG_FLOAT_ARRAY:
+	case MAVLINK_MSG_ID_NAMED_VALUE_FLOAT:
+	case MAVLINK_MSG_ID_SCALED_IMU:
+	case MAVLINK_MSG_ID_SCALED_IMU2:
+	case MAVLINK_MSG_ID_SCALED_IMU3:
+	case MAVLINK_MSG_ID_SCALED_PRESSURE:
+	case MAVLINK_MSG_ID_SCALED_PRESSURE2:
+	case MAVLINK_MSG_ID_SCALED_PRESSURE3:
+	case MAVLINK_MSG_ID_SERVO_OUTPUT_RAW:
+	case MAVLINK_MSG_ID_ACTUATOR_OUTPUT_STATUS:
+	case MAVLINK_MSG_ID_ESC_STATUS:
+	case MAVLINK_MSG_ID_ESC_INFO:
+	case MAVLINK_MSG_ID_VIBRATION:
+	case MAVLINK_MSG_ID_ESTIMATOR_STATUS:
+	case MAVLINK_MSG_ID_RAW_RPM:
+		return MavlinkStream::PRIORITY_LOW;
+
+	default:
+		return MavlinkStream::PRIORITY_NORMAL;
+	}
+}
+
+bool
+MavlinkStreamScheduler::reserve(int count)
+{
+	if (count <= _due_capacity) {
+		return true;
+	}
+
+	MavlinkStream **due = new MavlinkStream *[count];
+
+	if (due == nullptr) {
+		return false;
+	}
+
+	delete[] _due;
+	_due = due;
+	_due_capacity = count;
+	return true;
+}
+
+bool
+MavlinkStreamScheduler::has_precedence(MavlinkStream *a, MavlinkStream *b)
+{
+	if (a->get_priority() != b->get_priority()) {
+		return a->get_priority() > b->get_priority();
+	}
+
+	return a->get_deadline() < b->get_deadline();
+}
+
+void
+MavlinkStreamScheduler::update(const hrt_abstime &t, MavlinkStream *const *streams, int count)
+{
+	// Refill the bucket, and pay for everything that was sent since the last round.
+	// This includes traffic not generated by streams (parameters, FTP, forwarding, ...).
+	const unsigned bytes_tx = _mavlink->get_bytes_tx_total();
+	const float burst = fmaxf(_budget * BURST_DURATION_S, MAVLINK_MAX_PACKET_LEN);
+
+	if (_last_update != 0 && t > _last_update) {
+		_tokens += _budget * (t - _last_update) * 1e-6f;
+	}
+
+	_tokens = fminf(_tokens - (float)(bytes_tx - _bytes_tx_last), burst);
+	_bytes_tx_last = bytes_tx;
+	_last_update = t;
+
+	if (!reserve(count)) {
+		// no memory for the schedule, fall back to updating the streams in order
+		for (int i = 0; i < count; i++) {
+			streams[i]->update(t);
+		}
+
+		return;
+	}
+
+	// Collect the due streams, sorted by priority and deadline
+	int num_due = 0;
+
+	for (int j = 0; j < count; j++) {
+		MavlinkStream *stream = streams[j];
+		stream->update_data();
+
+		if (stream->is_due(t)) {
+			int i = num_due++;
+
+			for (; i > 0 && has_precedence(stream, _due[i - 1]); i--) {
+				_due[i] = _due[i - 1];
+			}
+
+			_due[i] = stream;
+		}
+	}
+
+	// Serve them within the budget. Bytes needed by a deferred stream are reserved,
+	// so that lower priority streams cannot take its place.
+	float reserved = 0.f;
+
+	for (int i = 0; i < num_due; i++) {
+		MavlinkStream *stream = _due[i];
+		const unsigned size = stream->get_size_avg();
+
+		if (size == 0 || (_tokens - reserved) >= size) {
+			stream->send_if_due(t);
+
+			const unsigned bytes_tx_now = _mavlink->get_bytes_tx_total();
+			_tokens -= (float)(bytes_tx_now - _bytes_tx_last);
+			_bytes_tx_last = bytes_tx_now;
+
+		} else {
+			stream->_deferred_count++;
+			reserved += size;
+		}
+	}
+}
@@ -0,0 +1,114 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mavlink_stream_scheduler.h
+ * Priority-aware stream scheduler with link bandwidth budgeting.
+ *
+ * The link budget is modelled as a token bucket that is refilled with the
+ * available link data rate. Streams that are due are served in order of
+ * priority and then deadline, as long as the bucket holds enough bytes for
+ * their average message size. Streams that do not fit are deferred and keep
+ * their deadline, so they are sent first in the next round with budget left.
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+
+#include "mavlink_stream.h"
+
+class Mavlink;
+
+class MavlinkStreamScheduler
+{
+public:
+	MavlinkStreamScheduler(Mavlink *mavlink) : _mavlink(mavlink) {}
+	~MavlinkStreamScheduler();
+
+	// no copy, assignment, move, move assignment
+	MavlinkStreamScheduler(const MavlinkStreamScheduler &) = delete;
+	MavlinkStreamScheduler &operator=(const MavlinkStreamScheduler &) = delete;
+	MavlinkStreamScheduler(MavlinkStreamScheduler &&) = delete;
+	MavlinkStreamScheduler &operator=(MavlinkStreamScheduler &&) = delete;
+
+	/**
+	 * Set the link budget
+	 *
+	 * @param bytes_per_second data rate available for the streams
+	 */
+	void set_budget(float bytes_per_second) { _budget = bytes_per_second; }
+	float get_budget() const { return _budget; }
+
+	/**
+	 * @return bytes currently available in the bucket (negative if in debt)
+	 */
+	float get_tokens() const { return _tokens; }
+
+	/**
+	 * Run one scheduling round: update the given streams and send the due ones within the budget
+	 *
+	 * @param streams streams to update, as collected by the stream dispatcher
+	 * @param count number of streams
+	 */
+	void update(const hrt_abstime &t, MavlinkStream *const *streams, int count);
+
+	/**
+	 * Default priority of a stream, based on its message ID
+	 */
+	static uint8_t default_priority(uint16_t msg_id);
+
+	/**
+	 * Maximum burst, as time of link budget that can be accumulated
+	 */
+	static constexpr float BURST_DURATION_S{0.1f};
+
+private:
+	bool reserve(int count);
+
+	/**
+	 * @return true if a should be served before b
+	 */
+	static bool has_precedence(MavlinkStream *a, MavlinkStream *b);
+
+	Mavlink *const _mavlink;
+
+	MavlinkStream **_due{nullptr};	///< streams due in the current round, sorted
+	int _due_capacity{0};
+
+	float _budget{0.f};
+	float _tokens{0.f};
+	hrt_abstime _last_update{0};
+	unsigned _bytes_tx_last{0};
+};
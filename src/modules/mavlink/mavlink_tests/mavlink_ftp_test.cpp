@@ -41,6 +41,13 @@
 
 #include "mavlink_ftp_test.h"
 #include "../mavlink_ftp.h"
+#include "../mavlink_parameter_blob.h"
+
+#include <parameters/param.h>
+
+extern "C" {
+#include <lib/heatshrink/heatshrink/heatshrink_decoder.h>
+}
 
 #ifdef __PX4_NUTTX
 #define PX4_MAVLINK_TEST_DATA_DIR CONFIG_BOARD_ROOT_PATH "/ftp_unit_test_data"
@@ -996,6 +1003,217 @@ bool MavlinkFtpTest::_send_receive_msg(MavlinkFTP::PayloadHeader	*payload_header
 	return _decode_message(&_reply_msg, payload_reply);
 }
 
+/// @brief Decompresses a heatshrink compressed parameter blob chunk
+///	@return size of the uncompressed data, or -1 on error
+static int decompress_chunk(const uint8_t *in, unsigned in_size, uint8_t *out, unsigned out_size)
+{
+	static heatshrink_decoder hsd;
+	heatshrink_decoder_reset(&hsd);
+
+	size_t in_pos = 0;
+	size_t out_pos = 0;
+
+	while (true) {
+		if (in_pos < in_size) {
+			size_t sunk = 0;
+
+			if (heatshrink_decoder_sink(&hsd, const_cast<uint8_t *>(&in[in_pos]), in_size - in_pos, &sunk) < 0) {
+				return -1;
+			}
+
+			in_pos += sunk;
+		}
+
+		HSD_poll_res pres;
+
+		do {
+			size_t polled = 0;
+			pres = heatshrink_decoder_poll(&hsd, &out[out_pos], out_size - out_pos, &polled);
+			out_pos += polled;
+		} while (pres == HSDR_POLL_MORE && out_pos < out_size);
+
+		if (pres != HSDR_POLL_EMPTY && pres != HSDR_POLL_MORE) {
+			return -1;
+		}
+
+		if (in_pos == in_size) {
+			const HSD_finish_res fres = heatshrink_decoder_finish(&hsd);
+
+			if (fres == HSDR_FINISH_DONE) {
+				return out_pos;
+
+			} else if (fres != HSDR_FINISH_MORE || out_pos == out_size) {
+				return -1;
+			}
+		}
+	}
+}
+
+/// @brief Checks the parameters of an uncompressed parameter blob chunk against the parameter system
+bool MavlinkFtpTest::_check_parameter_chunk(const uint8_t *data, unsigned size, unsigned first_index)
+{
+	unsigned pos = 0;
+	unsigned used_index = first_index;
+
+	while (pos < size) {
+		ut_assert("Truncated parameter entry", pos + 4 <= size);
+
+		uint16_t index;
+		memcpy(&index, &data[pos], sizeof(index));
+		const uint8_t type = data[pos + 2];
+		const uint8_t name_len = data[pos + 3];
+		pos += 4;
+
+		ut_assert("Truncated parameter entry", pos + name_len + 4 <= size);
+		ut_compare("Used index not in order", index, used_index);
+
+		const param_t param = param_for_used_index(index);
+		ut_assert("Invalid used index", param != PARAM_INVALID);
+
+		char name[MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN + 1] {};
+		ut_assert("Name too long", name_len <= MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN);
+		memcpy(name, &data[pos], name_len);
+		pos += name_len;
+		ut_compare("Name differs", strncmp(name, param_name(param), MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN), 0);
+
+		if (param_type(param) == PARAM_TYPE_INT32) {
+			int32_t value;
+			int32_t expected = 0;
+			memcpy(&value, &data[pos], sizeof(value));
+			param_get(param, &expected);
+			ut_compare("Type differs", type, MAVLINK_TYPE_INT32_T);
+			ut_compare("Value differs", value, expected);
+
+		} else {
+			float value;
+			float expected = 0.f;
+			memcpy(&value, &data[pos], sizeof(value));
+			param_get(param, &expected);
+			ut_compare("Type differs", type, MAVLINK_TYPE_FLOAT);
+			ut_compare("Value differs", memcmp(&value, &expected, sizeof(value)), 0);
+		}
+
+		pos += 4;
+		used_index++;
+	}
+
+	return true;
+}
+
+/// @brief Tests downloading the parameter export and decoding it
+bool MavlinkFtpTest::_parameter_blob_test()
+{
+	MavlinkFTP::PayloadHeader		payload {};
+	const MavlinkFTP::PayloadHeader		*reply;
+
+	payload.opcode = MavlinkFTP::kCmdOpenFileRO;
+	payload.offset = 0;
+	payload.size = strlen(MavlinkParameterBlob::FTP_PATH) + 1;
+
+	bool success = _send_receive_msg(&payload,		// FTP payload header
+					 (const uint8_t *)MavlinkParameterBlob::FTP_PATH,	// Data to start into FTP message payload
+					 payload.size,	// size in bytes of data
+					 &reply);		// Payload inside FTP message response
+
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+	ut_compare("Reply containing file size wrong", reply->size, sizeof(uint32_t));
+	const uint32_t size = *reinterpret_cast<const uint32_t *>(&reply->data[0]);
+	ut_assert("File too small", size >= sizeof(MavlinkParameterBlob::Header));
+
+	uint8_t *bytes = new uint8_t[size];
+	ut_assert("new failed", bytes != nullptr);
+
+	payload.opcode = MavlinkFTP::kCmdReadFile;
+	payload.session = reply->session;
+	payload.offset = 0;
+
+	while (payload.offset < size) {
+		payload.size = size - payload.offset > MAX_DATA_LEN ? MAX_DATA_LEN : size - payload.offset;
+
+		success = _send_receive_msg(&payload,	// FTP payload header
+					    nullptr,	// Data to start into FTP message payload
+					    0,		// size in bytes of data
+					    &reply);	// Payload inside FTP message response
+
+		if (!success || reply->opcode != MavlinkFTP::kRspAck || reply->size != payload.size) {
+			delete[] bytes;
+			ut_assert("Read failed", false);
+		}
+
+		memcpy(bytes + payload.offset, reply->data, reply->size);
+		payload.offset += reply->size;
+	}
+
+	payload.opcode = MavlinkFTP::kCmdTerminateSession;
+	payload.size = 0;
+
+	if (!_send_receive_msg(&payload, nullptr, 0, &reply) || reply->opcode != MavlinkFTP::kRspAck) {
+		delete[] bytes;
+		ut_assert("Terminate failed", false);
+	}
+
+	MavlinkParameterBlob::Header header;
+	memcpy(&header, bytes, sizeof(header));
+
+	const uint32_t table_end = sizeof(header) + header.chunk_count * sizeof(MavlinkParameterBlob::ChunkEntry);
+	const unsigned max_chunk_size = MavlinkParameterBlob::CHUNK_PARAMS * (4 + MAVLINK_MSG_PARAM_VALUE_FIELD_PARAM_ID_LEN + 4);
+	uint8_t *chunk = new uint8_t[max_chunk_size];
+
+	bool ok = (chunk != nullptr)
+		  && header.magic == MavlinkParameterBlob::MAGIC
+		  && header.version == MavlinkParameterBlob::VERSION
+		  && header.window_bits == HEATSHRINK_STATIC_WINDOW_BITS
+		  && header.lookahead_bits == HEATSHRINK_STATIC_LOOKAHEAD_BITS
+		  && header.param_count == param_count_used()
+		  && header.chunk_count == (header.param_count + MavlinkParameterBlob::CHUNK_PARAMS - 1) / MavlinkParameterBlob::CHUNK_PARAMS
+		  && header.param_hash == param_hash_check()
+		  && table_end <= size;
+
+	uint32_t expected_offset = table_end;
+
+	for (unsigned i = 0; ok && i < header.chunk_count; i++) {
+		MavlinkParameterBlob::ChunkEntry entry;
+		memcpy(&entry, bytes + sizeof(header) + i * sizeof(entry), sizeof(entry));
+
+		// chunks follow each other without gaps
+		ok = entry.offset == expected_offset && entry.offset + entry.stored_size <= size && entry.size <= max_chunk_size;
+
+		if (ok) {
+			int chunk_size = entry.size;
+
+			if (entry.stored_size == entry.size) {
+				memcpy(chunk, bytes + entry.offset, entry.size);
+
+			} else {
+				chunk_size = decompress_chunk(bytes + entry.offset, entry.stored_size, chunk, max_chunk_size);
+			}
+
+			ok = chunk_size == entry.size
+			     && crc32part(chunk, entry.size, 0) == entry.crc
+			     && _check_parameter_chunk(chunk, entry.size, i * MavlinkParameterBlob::CHUNK_PARAMS);
+		}
+
+		expected_offset += entry.stored_size;
+	}
+
+	ok = ok && expected_offset == size;
+
+	delete[] chunk;
+	delete[] bytes;
+
+	char blob_file[64];
+	snprintf(blob_file, sizeof(blob_file), MavlinkFTP::kParameterBlobFile, _mavlink.get_instance_id());
+	::unlink(blob_file);
+
+	ut_assert("Parameter export does not decode to the parameter set", ok);
+
+	return true;
+}
+
 /// @brief Cleans up an files created on microsd during testing
 void MavlinkFtpTest::_cleanup_microsd()
 {
@@ -1020,6 +1238,7 @@ bool MavlinkFtpTest::run_tests()
 	ut_run_test(_removedirectory_test);
 	ut_run_test(_createdirectory_test);
 	ut_run_test(_removefile_test);
+	ut_run_test(_parameter_blob_test);
 
 	return (_tests_failed == 0);
 
@@ -93,6 +93,8 @@ private:
 	bool _removedirectory_test(void);
 	bool _createdirectory_test(void);
 	bool _removefile_test(void);
+	bool _parameter_blob_test(void);
+	bool _check_parameter_chunk(const uint8_t *data, unsigned size, unsigned first_index);
 
 	void _receive_message_handler_generic(const mavlink_file_transfer_protocol_t *ftp_req);
 	bool _setup_ftp_msg(const MavlinkFTP::PayloadHeader *payload_header,
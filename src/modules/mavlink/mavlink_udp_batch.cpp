@@ -0,0 +1,180 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mavlink_udp_batch.cpp
+ * Batched UDP transport.
+ */
+
+#if defined(__PX4_LINUX)
+
+#include "mavlink_udp_batch.h"
+
+#include <string.h>
+#include <sys/socket.h>
+
+bool
+MavlinkUDPBatch::add(const uint8_t *buf, unsigned len, const hrt_abstime &now)
+{
+	if (len > DATAGRAM_SIZE) {
+		return false;
+	}
+
+	int current = _num_datagrams - 1;
+
+	if (current < 0 || _len[current] + len > DATAGRAM_SIZE) {
+		if (_num_datagrams >= MAX_DATAGRAMS) {
+			return false;
+		}
+
+		current = _num_datagrams++;
+		_len[current] = 0;
+		_messages[current] = 0;
+	}
+
+	if (_len[0] == 0) {
+		_oldest = now;
+	}
+
+	memcpy(&_data[current][_len[current]], buf, len);
+	_len[current] += len;
+	_messages[current]++;
+
+	return true;
+}
+
+int
+MavlinkUDPBatch::send(int socket_fd, const sockaddr_in &dest, unsigned &bytes, unsigned &messages) const
+{
+	bytes = 0;
+	messages = 0;
+
+	if (_num_datagrams == 0) {
+		return 0;
+	}
+
+	iovec iov[MAX_DATAGRAMS];
+	mmsghdr msgs[MAX_DATAGRAMS] {};
+
+	for (int i = 0; i < _num_datagrams; i++) {
+		iov[i].iov_base = (void *)_data[i];
+		iov[i].iov_len = _len[i];
+		msgs[i].msg_hdr.msg_name = (void *)&dest;
+		msgs[i].msg_hdr.msg_namelen = sizeof(dest);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	const int sent = sendmmsg(socket_fd, msgs, _num_datagrams, 0);
+
+	for (int i = 0; i < sent; i++) {
+		bytes += _len[i];
+		messages += _messages[i];
+	}
+
+	return sent;
+}
+
+void
+MavlinkUDPBatch::clear()
+{
+	for (int i = 0; i < _num_datagrams; i++) {
+		_messages_total += _messages[i];
+	}
+
+	_datagrams_total += _num_datagrams;
+	_num_datagrams = 0;
+	_len[0] = 0;
+}
+
+unsigned
+MavlinkUDPBatch::get_pending_bytes() const
+{
+	unsigned bytes = 0;
+
+	for (int i = 0; i < _num_datagrams; i++) {
+		bytes += _len[i];
+	}
+
+	return bytes;
+}
+
+unsigned
+MavlinkUDPBatch::get_pending_messages() const
+{
+	unsigned messages = 0;
+
+	for (int i = 0; i < _num_datagrams; i++) {
+		messages += _messages[i];
+	}
+
+	return messages;
+}
+
+int
+MavlinkUDPBatch::receive(int socket_fd, uint8_t *buf, size_t buf_len, RxDatagram *datagrams)
+{
+	int num_slots = buf_len / RX_DATAGRAM_SIZE;
+
+	if (num_slots > MAX_RX_DATAGRAMS) {
+		num_slots = MAX_RX_DATAGRAMS;
+	}
+
+	if (num_slots < 1) {
+		return -1;
+	}
+
+	iovec iov[MAX_RX_DATAGRAMS];
+	mmsghdr msgs[MAX_RX_DATAGRAMS] {};
+
+	for (int i = 0; i < num_slots; i++) {
+		iov[i].iov_base = &buf[i * RX_DATAGRAM_SIZE];
+		iov[i].iov_len = RX_DATAGRAM_SIZE;
+		msgs[i].msg_hdr.msg_name = &datagrams[i].src_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(datagrams[i].src_addr);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	const int received = recvmmsg(socket_fd, msgs, num_slots, MSG_DONTWAIT, nullptr);
+
+	for (int i = 0; i < received; i++) {
+		datagrams[i].data = &buf[i * RX_DATAGRAM_SIZE];
+		datagrams[i].len = msgs[i].msg_len;
+	}
+
+	return received;
+}
+
+#endif // __PX4_LINUX
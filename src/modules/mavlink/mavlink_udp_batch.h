@@ -0,0 +1,134 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mavlink_udp_batch.h
+ * Batched UDP transport.
+ *
+ * Outgoing messages are packed into datagrams of up to one MTU, which are
+ * sent together with a single sendmmsg() call. Incoming datagrams are read
+ * with recvmmsg(), so that a burst of datagrams costs a single syscall.
+ */
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <netinet/in.h>
+#include <stdint.h>
+
+class MavlinkUDPBatch
+{
+public:
+	MavlinkUDPBatch() = default;
+	~MavlinkUDPBatch() = default;
+
+	static constexpr int MAX_DATAGRAMS{16};
+
+	/**
+	 * Datagram payload size: Ethernet MTU minus IPv4 and UDP headers, to avoid IP fragmentation
+	 */
+	static constexpr unsigned DATAGRAM_SIZE{1500 - 20 - 8};
+
+	/**
+	 * Size of a receive slot, same as the largest datagram accepted without batching
+	 */
+	static constexpr unsigned RX_DATAGRAM_SIZE{1600 * 5};
+
+	static constexpr int MAX_RX_DATAGRAMS{8};
+	static constexpr size_t RX_BUFFER_SIZE{MAX_RX_DATAGRAMS * RX_DATAGRAM_SIZE};
+
+	struct RxDatagram {
+		const uint8_t *data;
+		size_t len;
+		sockaddr_in src_addr;
+	};
+
+	/**
+	 * Append a message to the pending datagrams
+	 *
+	 * @return false if the batch is full and needs to be sent first
+	 */
+	bool add(const uint8_t *buf, unsigned len, const hrt_abstime &now);
+
+	bool empty() const { return _num_datagrams == 0; }
+
+	/**
+	 * @return time at which the oldest pending message was added
+	 */
+	hrt_abstime get_oldest() const { return _oldest; }
+
+	/**
+	 * Send all pending datagrams to dest with a single syscall. The batch is kept, so that
+	 * it can be sent to multiple destinations, and needs to be cleared afterwards.
+	 *
+	 * @param bytes set to the number of bytes sent
+	 * @param messages set to the number of messages sent
+	 * @return number of datagrams sent, -1 on error
+	 */
+	int send(int socket_fd, const sockaddr_in &dest, unsigned &bytes, unsigned &messages) const;
+
+	void clear();
+
+	/**
+	 * @return total number of bytes and messages currently pending
+	 */
+	unsigned get_pending_bytes() const;
+	unsigned get_pending_messages() const;
+
+	/**
+	 * Average number of messages packed into each datagram
+	 */
+	float get_messages_per_datagram() const { return _datagrams_total > 0 ? (float)_messages_total / _datagrams_total : 0.f; }
+
+	/**
+	 * Read all available datagrams with a single syscall, without blocking.
+	 * buf is split into slots of RX_DATAGRAM_SIZE, one per datagram.
+	 *
+	 * @param datagrams set to the data, length and source address of each datagram read,
+	 *                  needs room for MAX_RX_DATAGRAMS entries
+	 * @return number of datagrams read, -1 on error
+	 */
+	static int receive(int socket_fd, uint8_t *buf, size_t buf_len, RxDatagram *datagrams);
+
+private:
+	uint8_t _data[MAX_DATAGRAMS][DATAGRAM_SIZE];
+	uint16_t _len[MAX_DATAGRAMS] {};
+	uint16_t _messages[MAX_DATAGRAMS] {};
+	int _num_datagrams{0};
+
+	hrt_abstime _oldest{0};
+
+	uint32_t _datagrams_total{0};
+	uint32_t _messages_total{0};
+};
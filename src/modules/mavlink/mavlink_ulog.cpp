@@ -48,13 +48,18 @@ MavlinkULog *MavlinkULog::_instance = nullptr;
 px4_sem_t MavlinkULog::_lock;
 
 
-MavlinkULog::MavlinkULog(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component)
+MavlinkULog::MavlinkULog(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component,
+			 int window_size)
 	: _target_system(target_system), _target_component(target_component),
 	  _max_rate_factor(max_rate_factor),
 	  _max_num_messages(math::max(1, (int)ceilf((_rate_calculation_delta_t / 1e6f) * _max_rate_factor * datarate /
 				      (MAVLINK_MSG_ID_LOGGING_DATA_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES)))),
-	  _current_rate_factor(max_rate_factor)
+	  _current_rate_factor(max_rate_factor),
+	  _window_size(math::constrain(window_size, 1, (int)ulog_stream_ack_s::MAX_WINDOW_SIZE)),
+	  _slow_start_threshold(_window_size)
 {
+	_in_flight = new InFlightMessage[_window_size] {};
+
 	// make sure we won't read any old messages
 	while (_ulog_stream_sub.update()) {
 
@@ -67,6 +72,7 @@ MavlinkULog::MavlinkULog(int datarate, float max_rate_factor, uint8_t target_sys
 
 MavlinkULog::~MavlinkULog()
 {
+	delete[] _in_flight;
 	perf_free(_msg_missed_ulog_stream_perf);
 }
 
@@ -95,45 +101,33 @@ int MavlinkULog::handle_update(mavlink_channel_t channel)
 		return 0;
 	}
 
-	// check if we're waiting for an ACK
-	if (_last_sent_time) {
-		bool check_for_updates = false;
-
-		if (_ack_received) {
-			_last_sent_time = 0;
-			check_for_updates = true;
-
-		} else {
-
-			if (hrt_elapsed_time(&_last_sent_time) > ulog_stream_ack_s::ACK_TIMEOUT * 1000) {
-				if (++_sent_tries > ulog_stream_ack_s::ACK_MAX_TRIES) {
-					return -ETIMEDOUT;
+	if (_window_size > 1) {
+		for (auto &timesync_status_sub : _timesync_status_subs) {
+			timesync_status_s timesync_status;
 
-				} else {
-					PX4_DEBUG("re-sending ulog mavlink message (try=%i)", _sent_tries);
-					_last_sent_time = hrt_absolute_time();
-
-					const ulog_stream_s &ulog_data = _ulog_stream_sub.get();
-
-					mavlink_logging_data_acked_t msg;
-					msg.sequence = ulog_data.msg_sequence;
-					msg.length = ulog_data.length;
-					msg.first_message_offset = ulog_data.first_message_offset;
-					msg.target_system = _target_system;
-					msg.target_component = _target_component;
-					memcpy(msg.data, ulog_data.data, sizeof(msg.data));
-					mavlink_msg_logging_data_acked_send_struct(channel, &msg);
-				}
+			if (timesync_status_sub.update(&timesync_status)
+			    && (timesync_status.source_protocol == timesync_status_s::SOURCE_PROTOCOL_MAVLINK)) {
+				lock();
+				update_round_trip_time(timesync_status.round_trip_time);
+				unlock();
 			}
 		}
-
-		if (!check_for_updates) {
-			return 0;
-		}
 	}
 
+	hrt_abstime t = hrt_absolute_time();
 
-	while ((_current_num_msgs < _max_num_messages) && _ulog_stream_sub.updated()) {
+	lock();
+	const int ret = retransmit_overdue(channel, t);
+	// no new messages while the (congestion) window is full
+	const int max_in_flight = math::min(_window_size, (int)_congestion_window);
+	bool window_full = _num_in_flight >= max_in_flight;
+	unlock();
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	while (!window_full && (_current_num_msgs < _max_num_messages) && _ulog_stream_sub.updated()) {
 		const unsigned last_generation = _ulog_stream_sub.get_last_generation();
 		_ulog_stream_sub.update();
 
@@ -145,22 +139,11 @@ int MavlinkULog::handle_update(mavlink_channel_t channel)
 
 		if (ulog_data.timestamp > 0) {
 			if (ulog_data.flags & ulog_stream_s::FLAGS_NEED_ACK) {
-				_sent_tries = 1;
-				_last_sent_time = hrt_absolute_time();
 				lock();
-				_wait_for_ack_sequence = ulog_data.msg_sequence;
-				_ack_received = false;
+				send_acked(channel, ulog_data);
+				window_full = _num_in_flight >= max_in_flight;
 				unlock();
 
-				mavlink_logging_data_acked_t msg;
-				msg.sequence = ulog_data.msg_sequence;
-				msg.length = ulog_data.length;
-				msg.first_message_offset = ulog_data.first_message_offset;
-				msg.target_system = _target_system;
-				msg.target_component = _target_component;
-				memcpy(msg.data, ulog_data.data, sizeof(msg.data));
-				mavlink_msg_logging_data_acked_send_struct(channel, &msg);
-
 			} else {
 				mavlink_logging_data_t msg;
 				msg.sequence = ulog_data.msg_sequence;
@@ -177,7 +160,7 @@ int MavlinkULog::handle_update(mavlink_channel_t channel)
 	}
 
 	//need to update the rate?
-	hrt_abstime t = hrt_absolute_time();
+	t = hrt_absolute_time();
 
 	if (t > _next_rate_check) {
 		if (_current_num_msgs < _max_num_messages) {
@@ -196,6 +179,105 @@ int MavlinkULog::handle_update(mavlink_channel_t channel)
 	return 0;
 }
 
+void MavlinkULog::send_acked(mavlink_channel_t channel, const ulog_stream_s &ulog_data)
+{
+	InFlightMessage *slot = nullptr;
+
+	for (int i = 0; i < _window_size; i++) {
+		if (!_in_flight[i].used) {
+			slot = &_in_flight[i];
+			break;
+		}
+	}
+
+	if (slot == nullptr) {
+		// cannot happen, the caller checks the window before reading
+		return;
+	}
+
+	slot->data = ulog_data;
+	slot->first_sent = hrt_absolute_time();
+	slot->last_sent = slot->first_sent;
+	slot->retransmitted = false;
+	slot->used = true;
+	++_num_in_flight;
+
+	mavlink_logging_data_acked_t msg;
+	msg.sequence = ulog_data.msg_sequence;
+	msg.length = ulog_data.length;
+	msg.first_message_offset = ulog_data.first_message_offset;
+	msg.target_system = _target_system;
+	msg.target_component = _target_component;
+	memcpy(msg.data, ulog_data.data, sizeof(msg.data));
+	mavlink_msg_logging_data_acked_send_struct(channel, &msg);
+}
+
+int MavlinkULog::retransmit_overdue(mavlink_channel_t channel, const hrt_abstime &now)
+{
+	const hrt_abstime timeout = retransmit_timeout();
+	bool congestion = false;
+
+	for (int i = 0; i < _window_size; i++) {
+		InFlightMessage &in_flight = _in_flight[i];
+
+		if (!in_flight.used || (now < in_flight.last_sent + timeout)) {
+			continue;
+		}
+
+		if (now > in_flight.first_sent + ulog_stream_ack_s::ACK_TIMEOUT * ulog_stream_ack_s::ACK_MAX_TRIES * 1000) {
+			return -ETIMEDOUT;
+		}
+
+		PX4_DEBUG("re-sending ulog mavlink message %i", in_flight.data.msg_sequence);
+		in_flight.last_sent = now;
+		in_flight.retransmitted = true;
+		congestion = true;
+		++_retransmissions;
+
+		mavlink_logging_data_acked_t msg;
+		msg.sequence = in_flight.data.msg_sequence;
+		msg.length = in_flight.data.length;
+		msg.first_message_offset = in_flight.data.first_message_offset;
+		msg.target_system = _target_system;
+		msg.target_component = _target_component;
+		memcpy(msg.data, in_flight.data.data, sizeof(msg.data));
+		mavlink_msg_logging_data_acked_send_struct(channel, &msg);
+	}
+
+	// multiplicative decrease, at most once per round trip
+	if (congestion && (now > _last_congestion_event + timeout)) {
+		_slow_start_threshold = math::max(_congestion_window * 0.5f, 1.f);
+		_congestion_window = _slow_start_threshold;
+		_last_congestion_event = now;
+	}
+
+	return 0;
+}
+
+void MavlinkULog::update_round_trip_time(float rtt_us)
+{
+	// RFC 6298 estimator
+	if (_srtt_us > 0.f) {
+		_rttvar_us = 0.75f * _rttvar_us + 0.25f * fabsf(_srtt_us - rtt_us);
+		_srtt_us = 0.875f * _srtt_us + 0.125f * rtt_us;
+
+	} else {
+		_srtt_us = rtt_us;
+		_rttvar_us = 0.5f * rtt_us;
+	}
+}
+
+hrt_abstime MavlinkULog::retransmit_timeout() const
+{
+	static constexpr hrt_abstime fixed_timeout = ulog_stream_ack_s::ACK_TIMEOUT * 1000;
+
+	if ((_window_size == 1) || (_srtt_us <= 0.f)) {
+		return fixed_timeout;
+	}
+
+	return math::constrain((hrt_abstime)(_srtt_us + 4.f * _rttvar_us), (hrt_abstime)5_ms, (hrt_abstime)1_s);
+}
+
 void MavlinkULog::initialize()
 {
 	if (_init) {
@@ -207,14 +289,19 @@ void MavlinkULog::initialize()
 }
 
 MavlinkULog *MavlinkULog::try_start(int datarate, float max_rate_factor, uint8_t target_system,
-				    uint8_t target_component)
+				    uint8_t target_component, int window_size)
 {
 	MavlinkULog *ret = nullptr;
 	bool failed = false;
 	lock();
 
 	if (!_instance) {
-		ret = _instance = new MavlinkULog(datarate, max_rate_factor, target_system, target_component);
+		ret = _instance = new MavlinkULog(datarate, max_rate_factor, target_system, target_component, window_size);
+
+		if (_instance && !_instance->_in_flight) {
+			delete _instance;
+			ret = _instance = nullptr;
+		}
 
 		if (!_instance) {
 			failed = true;
@@ -247,9 +334,30 @@ void MavlinkULog::handle_ack(mavlink_logging_ack_t ack)
 	lock();
 
 	if (_instance) { // make sure stop() was not called right before
-		if (_wait_for_ack_sequence == ack.sequence) {
-			_ack_received = true;
-			publish_ack(ack.sequence);
+		for (int i = 0; i < _window_size; i++) {
+			InFlightMessage &in_flight = _in_flight[i];
+
+			if (in_flight.used && (in_flight.data.msg_sequence == ack.sequence)) {
+				if (!in_flight.retransmitted) {
+					update_round_trip_time((float)hrt_elapsed_time(&in_flight.last_sent));
+				}
+
+				in_flight.used = false;
+				--_num_in_flight;
+
+				// slow start up to the threshold, then additive increase
+				if (_congestion_window < _slow_start_threshold) {
+					_congestion_window += 1.f;
+
+				} else {
+					_congestion_window += 1.f / _congestion_window;
+				}
+
+				_congestion_window = math::min(_congestion_window, (float)_window_size);
+
+				publish_ack(ack.sequence);
+				break;
+			}
 		}
 	}
 
@@ -261,6 +369,7 @@ void MavlinkULog::publish_ack(uint16_t sequence)
 	ulog_stream_ack_s ack;
 	ack.timestamp = hrt_absolute_time();
 	ack.msg_sequence = sequence;
+	ack.window_size = _window_size;
 
 	_ulog_stream_ack_pub.publish(ack);
 }
@@ -49,6 +49,8 @@
 
 #include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionMultiArray.hpp>
+#include <uORB/topics/timesync_status.h>
 #include <uORB/topics/ulog_stream.h>
 #include <uORB/topics/ulog_stream_ack.h>
 
@@ -59,6 +61,12 @@ using namespace time_literals;
 /**
  * @class MavlinkULog
  * ULog streaming class. At most one instance (stream) can exist, assigned to a specific mavlink channel.
+ *
+ * Messages that need an ack are tracked in a sliding window: up to window_size of them can be in flight,
+ * each one is retransmitted individually when its ack is overdue (selective repeat). Within the window, a
+ * congestion window grows with incoming acks and halves on retransmissions, and the retransmission timeout
+ * follows the round trip time measured by timesync and by the acks themselves.
+ * A window size of 1 is the classic stop-and-wait mode with a fixed timeout.
  */
 class MavlinkULog
 {
@@ -75,9 +83,11 @@ public:
 	 * @param max_rate_factor let ulog streaming use a maximum of max_rate_factor * datarate
 	 * @param target_system ID for mavlink message
 	 * @param target_component ID for mavlink message
+	 * @param window_size maximum number of acked messages in flight
 	 * @return instance, or nullptr
 	 */
-	static MavlinkULog *try_start(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component);
+	static MavlinkULog *try_start(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component,
+				      int window_size = 1);
 
 	/**
 	 * stop the stream. It also deletes the singleton object, so make sure cleanup
@@ -101,9 +111,14 @@ public:
 	float current_data_rate() const { return _current_rate_factor; }
 	float maximum_data_rate() const { return _max_rate_factor; }
 
+	int window_size() const { return _window_size; }
+	float congestion_window() const { return _congestion_window; }
+	float round_trip_time() const { return _srtt_us * 1e-3f; } ///< smoothed RTT [ms], 0 if unknown
+	uint32_t retransmissions() const { return _retransmissions; }
+
 private:
 
-	MavlinkULog(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component);
+	MavlinkULog(int datarate, float max_rate_factor, uint8_t target_system, uint8_t target_component, int window_size);
 
 	~MavlinkULog();
 
@@ -117,8 +132,25 @@ private:
 		px4_sem_post(&_lock);
 	}
 
+	struct InFlightMessage {
+		ulog_stream_s data;
+		hrt_abstime first_sent;  ///< first transmission, for the overall timeout
+		hrt_abstime last_sent;   ///< latest (re-)transmission
+		bool retransmitted;      ///< RTT is not sampled from retransmitted messages
+		bool used;
+	};
+
 	void publish_ack(uint16_t sequence);
 
+	void send_acked(mavlink_channel_t channel, const ulog_stream_s &ulog_data);
+
+	/** check for overdue acks and retransmit. @return 0 on success, -ETIMEDOUT if a message was never acked */
+	int retransmit_overdue(mavlink_channel_t channel, const hrt_abstime &now);
+
+	void update_round_trip_time(float rtt_us);
+
+	hrt_abstime retransmit_timeout() const;
+
 	static px4_sem_t _lock;
 	static bool _init;
 	static MavlinkULog *_instance;
@@ -126,10 +158,7 @@ private:
 
 	uORB::SubscriptionData<ulog_stream_s> _ulog_stream_sub{ORB_ID(ulog_stream)};
 	uORB::Publication<ulog_stream_ack_s> _ulog_stream_ack_pub{ORB_ID(ulog_stream_ack)};
-	uint16_t _wait_for_ack_sequence;
-	uint8_t _sent_tries = 0;
-	volatile bool _ack_received = false; ///< set to true if a matching ack received
-	hrt_abstime _last_sent_time = 0; ///< last time we sent a message that requires an ack
+	hrt_abstime _last_sent_time = 0; ///< used while waiting for the logger to start
 	bool _waiting_for_initial_ack = false;
 	const uint8_t _target_system;
 	const uint8_t _target_component;
@@ -140,6 +169,18 @@ private:
 	int _current_num_msgs = 0;  ///< number of messages sent within the current time interval
 	hrt_abstime _next_rate_check; ///< next timestamp at which to update the rate
 
+	const int _window_size;
+	InFlightMessage *_in_flight{nullptr}; ///< messages waiting for an ack, _window_size entries
+	int _num_in_flight{0};
+	float _congestion_window{1.f};       ///< number of acked messages currently allowed in flight
+	float _slow_start_threshold;
+	hrt_abstime _last_congestion_event{0};
+	float _srtt_us{0.f};                 ///< smoothed round trip time
+	float _rttvar_us{0.f};               ///< round trip time variation
+	uint32_t _retransmissions{0};
+
+	uORB::SubscriptionMultiArray<timesync_status_s> _timesync_status_subs{ORB_ID::timesync_status};
+
 	perf_counter_t _msg_missed_ulog_stream_perf{perf_alloc(PC_COUNT, MODULE_NAME": ulog_stream messages missed")};
 
 	/* do not allow copying this class */
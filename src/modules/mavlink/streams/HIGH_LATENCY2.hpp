@@ -79,6 +79,8 @@ public:
 
 	bool const_rate() override { return true; }
 
+	bool needs_update_data() override { return true; }
+
 private:
 	explicit MavlinkStreamHighLatency2(Mavlink *mavlink) :
 		MavlinkStream(mavlink),
@@ -48,7 +48,8 @@ MulticopterRateControl::MulticopterRateControl(bool vtol) :
 	WorkItem(MODULE_NAME, px4::wq_configurations::rate_ctrl),
 	_vehicle_thrust_setpoint_pub(vtol ? ORB_ID(vehicle_thrust_setpoint_virtual_mc) : ORB_ID(vehicle_thrust_setpoint)),
 	_vehicle_torque_setpoint_pub(vtol ? ORB_ID(vehicle_torque_setpoint_virtual_mc) : ORB_ID(vehicle_torque_setpoint)),
-	_loop_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle"))
+	_loop_perf(perf_alloc(PC_HISTOGRAM, MODULE_NAME": cycle")),
+	_loop_interval_perf(perf_alloc(PC_HISTOGRAM, MODULE_NAME": interval"))
 {
 	_vehicle_status.vehicle_type = vehicle_status_s::VEHICLE_TYPE_ROTARY_WING;
 
@@ -59,6 +60,7 @@ MulticopterRateControl::MulticopterRateControl(bool vtol) :
 MulticopterRateControl::~MulticopterRateControl()
 {
 	perf_free(_loop_perf);
+	perf_free(_loop_interval_perf);
 }
 
 bool
@@ -109,6 +111,7 @@ MulticopterRateControl::Run()
 	}
 
 	perf_begin(_loop_perf);
+	perf_count(_loop_interval_perf);
 
 	// Check if parameters have changed
 	if (_parameter_update_sub.updated()) {
@@ -119,6 +119,7 @@ private:
 	hrt_abstime _last_run{0};
 
 	perf_counter_t	_loop_perf;			/**< loop duration performance counter */
+	perf_counter_t	_loop_interval_perf;		/**< loop interval (jitter) performance counter */
 
 	// keep setpoint values between updates
 	matrix::Vector3f _acro_rate_max;		/**< max attitude rates in acro mode */
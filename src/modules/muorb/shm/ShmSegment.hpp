@@ -0,0 +1,174 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ShmSegment.hpp
+ *
+ * Layout of the shared-memory segment used by the muorb_shm channel, together
+ * with the seqlock read/write helpers. This header has no PX4 dependencies so
+ * that external processes (ROS 2 nodes, companion software on the same host)
+ * can include it directly to exchange topics with PX4 without serialization.
+ *
+ * The segment starts with a ShmSegmentHeader followed by num_slots slots, each
+ * slot_stride bytes apart. A slot carries one uORB topic instance as the raw
+ * uORB struct. Every slot has exactly one writer: PX4 for ShmDirection::Export
+ * slots, an external process for ShmDirection::Import slots. Readers never block
+ * the writer; they retry if the sequence changed while copying.
+ *
+ * Any process with write access can modify the header and slot metadata at any
+ * time, so after initialization PX4 only uses the slot addresses and sizes it
+ * computed itself and never trusts values read back from the segment.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace muorb_shm
+{
+
+static constexpr uint32_t SHM_MAGIC = 0x50583453; // 'PX4S'
+static constexpr uint16_t SHM_VERSION = 1;
+static constexpr size_t SHM_TOPIC_NAME_LENGTH = 48;
+static constexpr size_t SHM_CACHE_LINE = 64;
+
+enum class ShmDirection : uint8_t {
+	Export = 0, ///< written by PX4, read by external processes
+	Import = 1, ///< written by one external process, published to uORB by PX4
+};
+
+struct alignas(SHM_CACHE_LINE) ShmSegmentHeader {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t num_slots;
+	uint32_t slot_stride;  ///< distance between slots in bytes
+	uint32_t segment_size; ///< total mapped size in bytes
+	std::atomic<uint32_t> ready; ///< set to 1 once all slots are initialized
+};
+
+struct alignas(SHM_CACHE_LINE) ShmSlot {
+	char topic_name[SHM_TOPIC_NAME_LENGTH]; ///< uORB topic name, e.g. "vehicle_odometry"
+	uint32_t size;        ///< uORB struct size (o_size)
+	ShmDirection direction;
+	uint8_t _padding[3];
+	std::atomic<uint32_t> sequence; ///< odd while a write is in progress, 0 if never written
+
+	uint8_t *data() { return reinterpret_cast<uint8_t *>(this) + sizeof(ShmSlot); }
+	const uint8_t *data() const { return reinterpret_cast<const uint8_t *>(this) + sizeof(ShmSlot); }
+};
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+	      "shared-memory atomics must be lock free");
+
+/** bytes used by a slot carrying a topic of the given size, keeping slots cache line aligned */
+static constexpr size_t shm_slot_stride(size_t topic_size)
+{
+	return (sizeof(ShmSlot) + topic_size + SHM_CACHE_LINE - 1) & ~(SHM_CACHE_LINE - 1);
+}
+
+static constexpr size_t shm_segment_size(size_t num_slots, size_t slot_stride)
+{
+	return sizeof(ShmSegmentHeader) + num_slots * slot_stride;
+}
+
+inline ShmSlot *shm_slot(ShmSegmentHeader *header, unsigned index)
+{
+	return reinterpret_cast<ShmSlot *>(reinterpret_cast<uint8_t *>(header) + sizeof(ShmSegmentHeader)
+					   + index * header->slot_stride);
+}
+
+/**
+ * Write a new sample into a slot. Must only be called by the single writer of the slot.
+ * @param slot slot to write
+ * @param data sample to copy
+ * @param size bytes to copy, at most the topic size the slot was created for (not slot->size,
+ *             which another process might have modified)
+ */
+inline void shm_slot_write(ShmSlot *slot, const void *data, size_t size)
+{
+	const uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+
+	// odd sequence marks the write in progress
+	slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	memcpy(slot->data(), data, size);
+
+	slot->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/**
+ * Copy the latest sample out of a slot.
+ * @param slot slot to read
+ * @param data destination, at least size bytes
+ * @param size expected topic size; the slot is rejected if its size field does not match
+ * @param last_sequence sequence of the last sample seen by this reader, updated on success
+ * @return true if a new, consistent sample was copied
+ */
+inline bool shm_slot_read(const ShmSlot *slot, void *data, size_t size, uint32_t &last_sequence)
+{
+	static constexpr int MAX_RETRIES = 16;
+
+	if (slot->size != size) {
+		// corrupted metadata, never copy more than the caller expects
+		return false;
+	}
+
+	for (int retry = 0; retry < MAX_RETRIES; ++retry) {
+		const uint32_t sequence_begin = slot->sequence.load(std::memory_order_acquire);
+
+		if (sequence_begin == last_sequence || sequence_begin == 0) {
+			return false;
+		}
+
+		if (sequence_begin & 1) {
+			// writer active
+			continue;
+		}
+
+		memcpy(data, slot->data(), size);
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (slot->sequence.load(std::memory_order_relaxed) == sequence_begin) {
+			last_sequence = sequence_begin;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+} // namespace muorb_shm
@@ -0,0 +1,197 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test for the shared-memory segment layout and seqlock
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "ShmSegment.hpp"
+
+using namespace muorb_shm;
+
+namespace
+{
+
+struct test_s {
+	uint64_t timestamp;
+	uint32_t values[63];
+};
+
+class ShmSegmentTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		_header->num_slots = 2;
+		_header->slot_stride = shm_slot_stride(sizeof(test_s));
+
+		for (unsigned i = 0; i < 2; i++) {
+			shm_slot(_header, i)->size = sizeof(test_s);
+		}
+	}
+
+	// zero filled like a freshly truncated shared-memory object
+	alignas(SHM_CACHE_LINE) uint8_t _buffer[shm_segment_size(2, shm_slot_stride(sizeof(test_s)))] {};
+	ShmSegmentHeader *_header{reinterpret_cast<ShmSegmentHeader *>(_buffer)};
+};
+
+} // namespace
+
+TEST_F(ShmSegmentTest, Layout)
+{
+	EXPECT_EQ(sizeof(ShmSegmentHeader) % SHM_CACHE_LINE, 0u);
+	EXPECT_EQ(sizeof(ShmSlot) % SHM_CACHE_LINE, 0u);
+	EXPECT_EQ(shm_slot_stride(1), 2 * SHM_CACHE_LINE);
+	EXPECT_EQ(shm_slot_stride(SHM_CACHE_LINE), 2 * SHM_CACHE_LINE);
+
+	// slots must not overlap
+	ShmSlot *slot0 = shm_slot(_header, 0);
+	ShmSlot *slot1 = shm_slot(_header, 1);
+	EXPECT_GE((uint8_t *)slot1, slot0->data() + sizeof(test_s));
+	EXPECT_LE(slot1->data() + sizeof(test_s), _buffer + sizeof(_buffer));
+}
+
+TEST_F(ShmSegmentTest, ReadWrite)
+{
+	ShmSlot *slot = shm_slot(_header, 0);
+	uint32_t last_sequence = 0;
+	test_s out{};
+
+	// nothing written yet
+	EXPECT_FALSE(shm_slot_read(slot, &out, sizeof(out), last_sequence));
+
+	test_s in{};
+	in.timestamp = 1234;
+	in.values[10] = 42;
+	shm_slot_write(slot, &in, sizeof(in));
+
+	ASSERT_TRUE(shm_slot_read(slot, &out, sizeof(out), last_sequence));
+	EXPECT_EQ(out.timestamp, 1234u);
+	EXPECT_EQ(out.values[10], 42u);
+
+	// same sample is not returned twice
+	EXPECT_FALSE(shm_slot_read(slot, &out, sizeof(out), last_sequence));
+
+	in.timestamp = 5678;
+	shm_slot_write(slot, &in, sizeof(in));
+	ASSERT_TRUE(shm_slot_read(slot, &out, sizeof(out), last_sequence));
+	EXPECT_EQ(out.timestamp, 5678u);
+
+	// the other slot is untouched
+	uint32_t other_sequence = 0;
+	EXPECT_FALSE(shm_slot_read(shm_slot(_header, 1), &out, sizeof(out), other_sequence));
+}
+
+TEST_F(ShmSegmentTest, CorruptedSizeRejected)
+{
+	ShmSlot *slot = shm_slot(_header, 0);
+	uint32_t last_sequence = 0;
+
+	test_s in{};
+	in.timestamp = 1234;
+	shm_slot_write(slot, &in, sizeof(in));
+
+	// another process overwrites the size field with a larger value
+	slot->size = 4096;
+
+	// the reader only copies what it expects and rejects the slot, leaving the guard bytes untouched
+	struct {
+		test_s sample;
+		uint8_t guard[64];
+	} out{};
+	memset(out.guard, 0xAA, sizeof(out.guard));
+
+	EXPECT_FALSE(shm_slot_read(slot, &out.sample, sizeof(out.sample), last_sequence));
+	EXPECT_EQ(last_sequence, 0u);
+
+	for (auto &b : out.guard) {
+		EXPECT_EQ(b, 0xAA);
+	}
+
+	// a smaller size is rejected as well
+	slot->size = 8;
+	EXPECT_FALSE(shm_slot_read(slot, &out.sample, sizeof(out.sample), last_sequence));
+
+	// once restored the sample is read again
+	slot->size = sizeof(test_s);
+	ASSERT_TRUE(shm_slot_read(slot, &out.sample, sizeof(out.sample), last_sequence));
+	EXPECT_EQ(out.sample.timestamp, 1234u);
+}
+
+TEST_F(ShmSegmentTest, ConcurrentReaderNeverSeesTornSample)
+{
+	ShmSlot *slot = shm_slot(_header, 0);
+	std::atomic<bool> done{false};
+
+	std::thread writer([&]() {
+		test_s in{};
+
+		for (uint64_t i = 1; i <= 200000; i++) {
+			in.timestamp = i;
+
+			for (auto &v : in.values) {
+				v = (uint32_t)i;
+			}
+
+			shm_slot_write(slot, &in, sizeof(in));
+		}
+
+		done = true;
+	});
+
+	uint32_t last_sequence = 0;
+	uint64_t last_timestamp = 0;
+	int samples = 0;
+	test_s out{};
+
+	while (!done || shm_slot_read(slot, &out, sizeof(out), last_sequence)) {
+		if (shm_slot_read(slot, &out, sizeof(out), last_sequence)) {
+			for (auto &v : out.values) {
+				ASSERT_EQ(v, (uint32_t)out.timestamp);
+			}
+
+			ASSERT_GT(out.timestamp, last_timestamp);
+			last_timestamp = out.timestamp;
+			samples++;
+		}
+	}
+
+	writer.join();
+
+	EXPECT_GT(samples, 0);
+}
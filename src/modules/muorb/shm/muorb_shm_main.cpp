@@ -0,0 +1,149 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <string.h>
+
+#include <px4_platform_common/getopt.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/module.h>
+
+#include "uORBShmChannel.hpp"
+#include "uORB/uORBManager.hpp"
+
+extern "C" __EXPORT int muorb_shm_main(int argc, char *argv[]);
+
+static void usage()
+{
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+Exposes selected uORB topics to other processes on the same host through a POSIX shared-memory segment.
+Each topic occupies one seqlock protected slot holding the raw uORB struct, so external processes
+(e.g. ROS 2 nodes on the same SoC) can read and write PX4 topics without serialization or a network stack.
+The segment layout is defined in `src/modules/muorb/shm/ShmSegment.hpp`, which external processes include.
+
+Exported topics are written by PX4 on every publication. Imported topics must have exactly one external
+writer and are polled at 1 kHz and published into uORB.
+
+Topics are matched by name only: all instances of a multi-instance topic are merged into the same slot,
+which then holds whichever instance was published last. Imported topics are published as instance 0.
+
+The channel replaces any other uORB communicator and cannot be stopped once started.
+
+### Example
+$ muorb_shm start -e vehicle_odometry,vehicle_status -i trajectory_setpoint,offboard_control_mode
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME("muorb_shm", "communication");
+	PRINT_MODULE_USAGE_COMMAND("start");
+	PRINT_MODULE_USAGE_PARAM_STRING('n', "/px4_uorb", nullptr, "Shared-memory object name", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('e', nullptr, "<topic>,<topic>", "Topics exported by PX4", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('i', nullptr, "<topic>,<topic>", "Topics imported from external processes", true);
+	PRINT_MODULE_USAGE_COMMAND("status");
+}
+
+int muorb_shm_main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		usage();
+		return -1;
+	}
+
+	if (!strcmp(argv[1], "start")) {
+		if (uORB::ShmChannel::isInstance()) {
+			PX4_WARN("already running");
+			return -1;
+		}
+
+		const char *segment_name = "/px4_uorb";
+		const char *export_topics = nullptr;
+		const char *import_topics = nullptr;
+
+		int ch;
+		int myoptind = 1;
+		const char *myoptarg = nullptr;
+
+		while ((ch = px4_getopt(argc, argv, "n:e:i:", &myoptind, &myoptarg)) != EOF) {
+			switch (ch) {
+			case 'n':
+				segment_name = myoptarg;
+				break;
+
+			case 'e':
+				export_topics = myoptarg;
+				break;
+
+			case 'i':
+				import_topics = myoptarg;
+				break;
+
+			default:
+				usage();
+				return -1;
+			}
+		}
+
+		uORB::ShmChannel *channel = uORB::ShmChannel::GetInstance();
+
+		if (channel == nullptr || !channel->Initialize(segment_name, export_topics, import_topics)) {
+			// not registered yet, so it can be deleted to allow starting again
+			uORB::ShmChannel::DeleteInstance();
+			PX4_ERR("start failed");
+			return -1;
+		}
+
+		uORB::Manager::get_instance()->set_uorb_communicator(channel);
+
+		if (!channel->Start()) {
+			// the channel is registered with the uORB manager now and stays, exports keep working
+			PX4_ERR("failed to start receive task");
+			return -1;
+		}
+
+		return 0;
+	}
+
+	if (!strcmp(argv[1], "status")) {
+		if (uORB::ShmChannel::isInstance()) {
+			uORB::ShmChannel::GetInstance()->PrintStatus();
+
+		} else {
+			PX4_INFO("not running");
+		}
+
+		return 0;
+	}
+
+	usage();
+	return -1;
+}
@@ -0,0 +1,336 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "uORBShmChannel.hpp"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/posix.h>
+#include <uORB/topics/uORBTopics.hpp>
+
+using namespace muorb_shm;
+
+uORB::ShmChannel *uORB::ShmChannel::_InstancePtr = nullptr;
+
+static const orb_metadata *find_topic(const char *name)
+{
+	const orb_metadata *const *topics = orb_get_topics();
+
+	for (size_t i = 0; i < orb_topics_count(); i++) {
+		if (strcmp(topics[i]->o_name, name) == 0) {
+			return topics[i];
+		}
+	}
+
+	return nullptr;
+}
+
+uORB::ShmChannel::~ShmChannel()
+{
+	for (int i = 0; i < _num_exports; i++) {
+		pthread_mutex_destroy(&_exports[i].mutex);
+	}
+
+	for (int i = 0; i < _num_imports; i++) {
+		pthread_mutex_destroy(&_imports[i].mutex);
+	}
+
+	if (_segment != nullptr) {
+		munmap(_segment, _segment_size);
+		shm_unlink(_segment_name);
+	}
+
+	delete[] _rx_buffer;
+}
+
+int uORB::ShmChannel::add_slots(const char *topic_list, ShmDirection direction, const orb_metadata **metas,
+				ShmDirection *directions, int num_slots)
+{
+	if (topic_list == nullptr) {
+		return num_slots;
+	}
+
+	char *list = strdup(topic_list);
+
+	if (list == nullptr) {
+		return -1;
+	}
+
+	char *save_ptr = nullptr;
+
+	for (char *name = strtok_r(list, ",", &save_ptr); name != nullptr; name = strtok_r(nullptr, ",", &save_ptr)) {
+		const orb_metadata *meta = find_topic(name);
+
+		if (meta == nullptr) {
+			PX4_ERR("unknown topic %s", name);
+			num_slots = -1;
+			break;
+		}
+
+		if (strlen(meta->o_name) >= SHM_TOPIC_NAME_LENGTH) {
+			PX4_ERR("topic name too long: %s", name);
+			num_slots = -1;
+			break;
+		}
+
+		if (num_slots >= MAX_SLOTS) {
+			PX4_ERR("too many topics (max %i)", MAX_SLOTS);
+			num_slots = -1;
+			break;
+		}
+
+		for (int i = 0; i < num_slots; i++) {
+			if (metas[i] == meta) {
+				PX4_ERR("topic %s listed twice", name);
+				free(list);
+				return -1;
+			}
+		}
+
+		metas[num_slots] = meta;
+		directions[num_slots] = direction;
+		num_slots++;
+	}
+
+	free(list);
+	return num_slots;
+}
+
+bool uORB::ShmChannel::Initialize(const char *segment_name, const char *export_topics, const char *import_topics)
+{
+	if (_segment != nullptr) {
+		PX4_ERR("already initialized");
+		return false;
+	}
+
+	const orb_metadata *metas[MAX_SLOTS] {};
+	ShmDirection directions[MAX_SLOTS] {};
+
+	int num_slots = add_slots(export_topics, ShmDirection::Export, metas, directions, 0);
+
+	if (num_slots >= 0) {
+		num_slots = add_slots(import_topics, ShmDirection::Import, metas, directions, num_slots);
+	}
+
+	if (num_slots <= 0) {
+		PX4_ERR("no valid topics given");
+		return false;
+	}
+
+	size_t max_topic_size = 0;
+
+	for (int i = 0; i < num_slots; i++) {
+		if (metas[i]->o_size > max_topic_size) {
+			max_topic_size = metas[i]->o_size;
+		}
+	}
+
+	const size_t slot_stride = shm_slot_stride(max_topic_size);
+	_segment_size = shm_segment_size(num_slots, slot_stride);
+	strncpy(_segment_name, segment_name, sizeof(_segment_name) - 1);
+
+	// a stale segment of a previous run might still exist, readers holding it keep their mapping
+	shm_unlink(_segment_name);
+
+	int fd = shm_open(_segment_name, O_CREAT | O_EXCL | O_RDWR, 0660);
+
+	if (fd < 0) {
+		PX4_ERR("shm_open %s failed (%i)", _segment_name, errno);
+		return false;
+	}
+
+	if (ftruncate(fd, _segment_size) != 0) {
+		PX4_ERR("ftruncate failed (%i)", errno);
+		close(fd);
+		shm_unlink(_segment_name);
+		return false;
+	}
+
+	void *addr = mmap(nullptr, _segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (addr == MAP_FAILED) {
+		PX4_ERR("mmap failed (%i)", errno);
+		shm_unlink(_segment_name);
+		return false;
+	}
+
+	// the segment is zero filled by ftruncate, which is a valid initial state for the atomics
+	_segment = static_cast<ShmSegmentHeader *>(addr);
+	_segment->magic = SHM_MAGIC;
+	_segment->version = SHM_VERSION;
+	_segment->num_slots = num_slots;
+	_segment->slot_stride = slot_stride;
+	_segment->segment_size = _segment_size;
+
+	for (int i = 0; i < num_slots; i++) {
+		ShmSlot *slot = shm_slot(_segment, i);
+		strncpy(slot->topic_name, metas[i]->o_name, sizeof(slot->topic_name) - 1);
+		slot->size = metas[i]->o_size;
+		slot->direction = directions[i];
+
+		SlotBinding &binding = (directions[i] == ShmDirection::Export) ? _exports[_num_exports++] : _imports[_num_imports++];
+		binding.meta = metas[i];
+		binding.slot = slot;
+		binding.last_sequence = 0;
+		binding.transfers = 0;
+		pthread_mutex_init(&binding.mutex, nullptr);
+	}
+
+	if (_num_imports > 0) {
+		_rx_buffer = new uint8_t[max_topic_size];
+
+		if (_rx_buffer == nullptr) {
+			PX4_ERR("alloc failed");
+			return false;
+		}
+	}
+
+	_segment->ready.store(1, std::memory_order_release);
+
+	PX4_INFO("shared memory %s: %i exported, %i imported topics (%zu bytes)", _segment_name, _num_exports, _num_imports,
+		 _segment_size);
+
+	return true;
+}
+
+bool uORB::ShmChannel::Start()
+{
+	if (_segment == nullptr || _rx_handler == nullptr) {
+		return false;
+	}
+
+	if (_num_imports == 0) {
+		return true;
+	}
+
+	for (int i = 0; i < _num_imports; i++) {
+		_rx_handler->process_remote_topic(_imports[i].meta->o_name);
+	}
+
+	_rx_task = px4_task_spawn_cmd("muorb_shm_rx", SCHED_DEFAULT, SCHED_PRIORITY_DEFAULT, 2048,
+				      (px4_main_t)&rx_task_trampoline, nullptr);
+
+	if (_rx_task < 0) {
+		PX4_ERR("task start failed");
+		return false;
+	}
+
+	return true;
+}
+
+int uORB::ShmChannel::rx_task_trampoline(int argc, char *argv[])
+{
+	_InstancePtr->rx_loop();
+	return 0;
+}
+
+void uORB::ShmChannel::rx_loop()
+{
+	while (true) {
+		for (int i = 0; i < _num_imports; i++) {
+			SlotBinding &binding = _imports[i];
+
+			// the size comes from the topic metadata, the slot header is writable by other processes
+			if (shm_slot_read(binding.slot, _rx_buffer, binding.meta->o_size, binding.last_sequence)) {
+				_rx_handler->process_received_message(binding.meta->o_name, binding.meta->o_size, _rx_buffer);
+				binding.transfers++;
+			}
+		}
+
+		px4_usleep(RX_INTERVAL_US);
+	}
+}
+
+int16_t uORB::ShmChannel::topic_advertised(const char *messageName)
+{
+	return 0;
+}
+
+int16_t uORB::ShmChannel::add_subscription(const char *messageName, int32_t msgRateInHz)
+{
+	return 0;
+}
+
+int16_t uORB::ShmChannel::remove_subscription(const char *messageName)
+{
+	return 0;
+}
+
+int16_t uORB::ShmChannel::register_handler(uORBCommunicator::IChannelRxHandler *handler)
+{
+	_rx_handler = handler;
+	return 0;
+}
+
+int16_t uORB::ShmChannel::send_message(const char *messageName, int32_t length, uint8_t *data)
+{
+	// called for every uORB publication, the name is always the o_name pointer of the topic metadata
+	for (int i = 0; i < _num_exports; i++) {
+		SlotBinding &binding = _exports[i];
+
+		if (binding.meta->o_name == messageName) {
+			pthread_mutex_lock(&binding.mutex);
+			const size_t size = ((size_t)length < binding.meta->o_size) ? (size_t)length : binding.meta->o_size;
+			shm_slot_write(binding.slot, data, size);
+			binding.transfers++;
+			pthread_mutex_unlock(&binding.mutex);
+			return 0;
+		}
+	}
+
+	return 0;
+}
+
+void uORB::ShmChannel::PrintStatus()
+{
+	if (_segment == nullptr) {
+		PX4_INFO("not initialized");
+		return;
+	}
+
+	PX4_INFO("segment %s, %zu bytes", _segment_name, _segment_size);
+
+	for (int i = 0; i < _num_exports; i++) {
+		PX4_INFO_RAW("  export %-32s %8u updates\n", _exports[i].meta->o_name, (unsigned)_exports[i].transfers);
+	}
+
+	for (int i = 0; i < _num_imports; i++) {
+		PX4_INFO_RAW("  import %-32s %8u updates\n", _imports[i].meta->o_name, (unsigned)_imports[i].transfers);
+	}
+}
@@ -0,0 +1,189 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef _uORBShmChannel_hpp_
+#define _uORBShmChannel_hpp_
+
+#include <stdint.h>
+#include <pthread.h>
+
+#include <px4_platform_common/tasks.h>
+#include <uORB/uORB.h>
+
+#include "uORB/uORBCommunicator.hpp"
+#include "ShmSegment.hpp"
+
+namespace uORB
+{
+class ShmChannel;
+}
+
+/**
+ * uORB communicator channel exposing selected topics to other processes on the
+ * same host through a POSIX shared-memory segment (see ShmSegment.hpp).
+ *
+ * Exported topics are copied into their slot on every publication. Imported
+ * topics are polled by a receive task and published into uORB through the
+ * registered IChannelRxHandler. Topics are identified by name only, all
+ * instances of a multi-instance topic share one slot.
+ */
+class uORB::ShmChannel final : public uORBCommunicator::IChannel
+{
+public:
+	static constexpr int MAX_SLOTS = 32;
+	static constexpr uint32_t RX_INTERVAL_US = 1000;
+
+	/**
+	 * static method to get the IChannel Implementor.
+	 */
+	static uORB::ShmChannel *GetInstance()
+	{
+		if (_InstancePtr == nullptr) {
+			_InstancePtr = new uORB::ShmChannel();
+		}
+
+		return _InstancePtr;
+	}
+
+	/**
+	 * Static method to check if there is an instance.
+	 */
+	static bool isInstance()
+	{
+		return (_InstancePtr != nullptr);
+	}
+
+	/**
+	 * Delete the instance after a failed Initialize(), before it got registered with the uORB manager.
+	 */
+	static void DeleteInstance()
+	{
+		delete _InstancePtr;
+		_InstancePtr = nullptr;
+	}
+
+	/**
+	 * @brief Create the shared-memory segment and its slots.
+	 *
+	 * @param segment_name
+	 * 	POSIX shared-memory object name, e.g. "/px4_uorb".
+	 * @param export_topics
+	 * 	Comma separated list of topics written by PX4, may be nullptr.
+	 * @param import_topics
+	 * 	Comma separated list of topics written by external processes, may be nullptr.
+	 * @return
+	 * 	true on success.
+	 */
+	bool Initialize(const char *segment_name, const char *export_topics, const char *import_topics);
+
+	/**
+	 * @brief Advertise the imported topics and start the receive task.
+	 * Must be called after the channel has been registered with the uORB manager.
+	 */
+	bool Start();
+
+	void PrintStatus();
+
+	/**
+	 * @brief Interface to notify the remote entity of a topic being advertised.
+	 * Exported topics are fixed at startup, this is a no-op.
+	 */
+	int16_t topic_advertised(const char *messageName) override;
+
+	/**
+	 * @brief Interface to notify the remote entity of interest of a
+	 * subscription for a message. External readers poll their slots, this is a no-op.
+	 */
+	int16_t add_subscription(const char *messageName, int32_t msgRateInHz) override;
+
+	/**
+	 * @brief Interface to notify the remote entity of removal of a subscription.
+	 * This is a no-op.
+	 */
+	int16_t remove_subscription(const char *messageName) override;
+
+	/**
+	 * Register Message Handler.  This is internal for the IChannel implementer*
+	 */
+	int16_t register_handler(uORBCommunicator::IChannelRxHandler *handler) override;
+
+	/**
+	 * @brief Copy the data into the slot of an exported topic.
+	 * @param messageName
+	 * 	The uORB message name; topics that are not exported are ignored.
+	 * @param length
+	 * 	The length of the data buffer to be sent.
+	 * @param data
+	 * 	The actual data to be sent.
+	 * @return
+	 *  0 = success (including topics that are not exported).
+	 *  otherwise = failure.
+	 */
+	int16_t send_message(const char *messageName, int32_t length, uint8_t *data) override;
+
+private:
+	struct SlotBinding {
+		const orb_metadata *meta;
+		muorb_shm::ShmSlot *slot;
+		uint32_t last_sequence;
+		uint32_t transfers;
+		pthread_mutex_t mutex; ///< serializes multiple PX4 publishers of an exported topic
+	};
+
+	ShmChannel() = default;
+	~ShmChannel();
+
+	int add_slots(const char *topic_list, muorb_shm::ShmDirection direction, const orb_metadata **metas,
+		      muorb_shm::ShmDirection *directions, int num_slots);
+
+	static int rx_task_trampoline(int argc, char *argv[]);
+	void rx_loop();
+
+	static uORB::ShmChannel *_InstancePtr;
+
+	uORBCommunicator::IChannelRxHandler *_rx_handler{nullptr};
+
+	char _segment_name[32] {};
+	muorb_shm::ShmSegmentHeader *_segment{nullptr};
+	size_t _segment_size{0};
+
+	SlotBinding _exports[MAX_SLOTS] {};
+	int _num_exports{0};
+	SlotBinding _imports[MAX_SLOTS] {};
+	int _num_imports{0};
+
+	uint8_t *_rx_buffer{nullptr};
+	px4_task_t _rx_task{-1};
+};
+
+#endif /* _uORBShmChannel_hpp_ */
@@ -0,0 +1,485 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file GeofenceIndex.cpp
+ */
+
+#include "GeofenceIndex.hpp"
+
+#include <float.h>
+#include <string.h>
+
+#include <mathlib/mathlib.h>
+
+namespace
+{
+
+/**
+ * Orientation of c relative to the line a->b: 1 (left), -1 (right) or 0 (collinear)
+ */
+int orientation(float a_lat, float a_lon, float b_lat, float b_lon, float c_lat, float c_lon)
+{
+	const float cross = (b_lat - a_lat) * (c_lon - a_lon) - (b_lon - a_lon) * (c_lat - a_lat);
+	return (cross > 0.f) - (cross < 0.f);
+}
+
+bool overlaps(float a0, float a1, float b0, float b1)
+{
+	return math::max(a0, a1) >= math::min(b0, b1) && math::max(b0, b1) >= math::min(a0, a1);
+}
+
+} // namespace
+
+GeofenceIndex::~GeofenceIndex()
+{
+	clear();
+}
+
+void GeofenceIndex::clear()
+{
+	delete[] _vertices;
+	delete[] _polygons;
+	delete[] _band_start;
+	delete[] _band_edges;
+
+	_vertices = nullptr;
+	_polygons = nullptr;
+	_band_start = nullptr;
+	_band_edges = nullptr;
+
+	_max_polygons = 0;
+	_max_vertices = 0;
+	_num_polygons = 0;
+	_num_vertices = 0;
+	_num_bands = 0;
+	_num_enabled_inclusion = 0;
+	_polygon_first_vertex = -1;
+	_built = false;
+}
+
+bool GeofenceIndex::reset(int max_polygons, int max_vertices)
+{
+	clear();
+
+	if (max_polygons <= 0 || max_vertices <= 0) {
+		return true;
+	}
+
+	// edges reference vertices and polygons with 16 bit indices (same range as the dataman index)
+	if (max_polygons > UINT16_MAX || max_vertices > UINT16_MAX) {
+		return false;
+	}
+
+	_vertices = new Vertex[max_vertices];
+	_polygons = new Polygon[max_polygons];
+
+	if (!_vertices || !_polygons) {
+		clear();
+		return false;
+	}
+
+	_max_polygons = max_polygons;
+	_max_vertices = max_vertices;
+	return true;
+}
+
+bool GeofenceIndex::beginPolygon(bool inclusion)
+{
+	if (_built || _polygon_first_vertex >= 0 || _num_polygons >= _max_polygons) {
+		return false;
+	}
+
+	Polygon &polygon = _polygons[_num_polygons];
+	polygon.first_vertex = _num_vertices;
+	polygon.vertex_count = 0;
+	polygon.lat_min = FLT_MAX;
+	polygon.lat_max = -FLT_MAX;
+	polygon.lon_min = FLT_MAX;
+	polygon.lon_max = -FLT_MAX;
+	polygon.inclusion = inclusion;
+	polygon.enabled = true;
+
+	_polygon_first_vertex = _num_vertices;
+	return true;
+}
+
+bool GeofenceIndex::addVertex(double lat, double lon)
+{
+	if (_polygon_first_vertex < 0 || _num_vertices >= _max_vertices) {
+		return false;
+	}
+
+	if (_num_vertices == 0) {
+		_ref_lat = lat;
+		_ref_lon = lon;
+	}
+
+	Vertex &vertex = _vertices[_num_vertices++];
+	vertex.lat = static_cast<float>(lat - _ref_lat);
+	vertex.lon = static_cast<float>(lon - _ref_lon);
+
+	Polygon &polygon = _polygons[_num_polygons];
+	++polygon.vertex_count;
+	polygon.lat_min = math::min(polygon.lat_min, vertex.lat);
+	polygon.lat_max = math::max(polygon.lat_max, vertex.lat);
+	polygon.lon_min = math::min(polygon.lon_min, vertex.lon);
+	polygon.lon_max = math::max(polygon.lon_max, vertex.lon);
+
+	return true;
+}
+
+int GeofenceIndex::endPolygon()
+{
+	if (_polygon_first_vertex < 0) {
+		return -1;
+	}
+
+	_polygon_first_vertex = -1;
+
+	if (_polygons[_num_polygons].vertex_count == 0) {
+		return -1;
+	}
+
+	if (_polygons[_num_polygons].inclusion) {
+		++_num_enabled_inclusion;
+	}
+
+	return _num_polygons++;
+}
+
+void GeofenceIndex::cancelPolygon()
+{
+	if (_polygon_first_vertex >= 0) {
+		_num_vertices = _polygon_first_vertex;
+		_polygon_first_vertex = -1;
+	}
+}
+
+int GeofenceIndex::bandOf(float lon, float band_scale, int num_bands) const
+{
+	const int band = static_cast<int>((lon - _lon_min) * band_scale);
+	return math::constrain(band, 0, num_bands - 1);
+}
+
+float GeofenceIndex::bandScale(int num_bands) const
+{
+	return (_lon_max > _lon_min) ? num_bands / (_lon_max - _lon_min) : 0.f;
+}
+
+int GeofenceIndex::countBandEdges(int num_bands) const
+{
+	const float band_scale = bandScale(num_bands);
+	int count = 0;
+
+	for (int p = 0; p < _num_polygons; ++p) {
+		const Polygon &polygon = _polygons[p];
+		int j = polygon.first_vertex + polygon.vertex_count - 1;
+
+		for (int i = polygon.first_vertex; i < polygon.first_vertex + polygon.vertex_count; j = i++) {
+			count += bandOf(math::max(_vertices[i].lon, _vertices[j].lon), band_scale, num_bands)
+				 - bandOf(math::min(_vertices[i].lon, _vertices[j].lon), band_scale, num_bands) + 1;
+		}
+	}
+
+	return count;
+}
+
+bool GeofenceIndex::build()
+{
+	if (_polygon_first_vertex >= 0) {
+		cancelPolygon();
+	}
+
+	delete[] _band_start;
+	delete[] _band_edges;
+	_band_start = nullptr;
+	_band_edges = nullptr;
+	_num_bands = 0;
+	_built = false;
+
+	if (_num_polygons == 0) {
+		return true;
+	}
+
+	_lon_min = FLT_MAX;
+	_lon_max = -FLT_MAX;
+
+	for (int p = 0; p < _num_polygons; ++p) {
+		_lon_min = math::min(_lon_min, _polygons[p].lon_min);
+		_lon_max = math::max(_lon_max, _polygons[p].lon_max);
+	}
+
+	// pick the number of bands so that each holds a handful of edges, but avoid blowing up memory
+	// if many edges span a large range of longitude
+	int num_bands = math::constrain(_num_vertices / EDGES_PER_BAND, 1, MAX_BANDS);
+	int num_band_edges = 0;
+
+	for (;;) {
+		num_band_edges = countBandEdges(num_bands);
+
+		if (num_bands == 1 || num_band_edges <= MAX_BAND_EDGES_PER_EDGE * _num_vertices) {
+			break;
+		}
+
+		num_bands /= 2;
+	}
+
+	_num_bands = num_bands;
+	_band_scale = bandScale(num_bands);
+
+	_band_start = new uint32_t[_num_bands + 1];
+	_band_edges = new Edge[num_band_edges];
+
+	if (!_band_start || !_band_edges) {
+		delete[] _band_start;
+		delete[] _band_edges;
+		_band_start = nullptr;
+		_band_edges = nullptr;
+		_num_bands = 0;
+		return false;
+	}
+
+	// count the edges per band, then turn the counts into the end offsets of each band
+	memset(_band_start, 0, sizeof(uint32_t) * (_num_bands + 1));
+
+	for (int p = 0; p < _num_polygons; ++p) {
+		const Polygon &polygon = _polygons[p];
+		int j = polygon.first_vertex + polygon.vertex_count - 1;
+
+		for (int i = polygon.first_vertex; i < polygon.first_vertex + polygon.vertex_count; j = i++) {
+			const int band_last = bandOf(math::max(_vertices[i].lon, _vertices[j].lon));
+
+			for (int band = bandOf(math::min(_vertices[i].lon, _vertices[j].lon)); band <= band_last; ++band) {
+				++_band_start[band];
+			}
+		}
+	}
+
+	for (int band = 1; band <= _num_bands; ++band) {
+		_band_start[band] += _band_start[band - 1];
+	}
+
+	// fill in reverse, moving each band end offset down to its start. This keeps the edges of a band
+	// grouped by polygon, which the queries rely on.
+	for (int p = _num_polygons - 1; p >= 0; --p) {
+		const Polygon &polygon = _polygons[p];
+
+		for (int i = polygon.first_vertex + polygon.vertex_count - 1; i >= polygon.first_vertex; --i) {
+			const int j = (i == polygon.first_vertex) ? polygon.first_vertex + polygon.vertex_count - 1 : i - 1;
+			const int band_last = bandOf(math::max(_vertices[i].lon, _vertices[j].lon));
+
+			for (int band = bandOf(math::min(_vertices[i].lon, _vertices[j].lon)); band <= band_last; ++band) {
+				Edge &edge = _band_edges[--_band_start[band]];
+				edge.vertex_i = i;
+				edge.vertex_j = j;
+				edge.polygon = p;
+			}
+		}
+	}
+
+	_built = true;
+	return true;
+}
+
+void GeofenceIndex::setEnabled(int polygon, bool enabled)
+{
+	if (polygon < 0 || polygon >= _num_polygons || _polygons[polygon].enabled == enabled) {
+		return;
+	}
+
+	_polygons[polygon].enabled = enabled;
+
+	if (_polygons[polygon].inclusion) {
+		_num_enabled_inclusion += enabled ? 1 : -1;
+	}
+}
+
+bool GeofenceIndex::insideBox(const Polygon &polygon, float lat, float lon) const
+{
+	return lat >= polygon.lat_min && lat <= polygon.lat_max && lon >= polygon.lon_min && lon <= polygon.lon_max;
+}
+
+bool GeofenceIndex::crossesRay(const Edge &edge, float lat, float lon) const
+{
+	/**
+	 * Adaptation of algorithm originally presented as
+	 * PNPOLY - Point Inclusion in Polygon Test
+	 * W. Randolph Franklin (WRF)
+	 * Only supports non-complex polygons (not self intersecting)
+	 */
+	const Vertex &vertex_i = _vertices[edge.vertex_i];
+	const Vertex &vertex_j = _vertices[edge.vertex_j];
+
+	return ((vertex_i.lon >= lon) != (vertex_j.lon >= lon))
+	       && (lat <= (vertex_j.lat - vertex_i.lat) * (lon - vertex_i.lon) / (vertex_j.lon - vertex_i.lon) + vertex_i.lat);
+}
+
+bool GeofenceIndex::insidePolygon(int polygon_id, double lat, double lon) const
+{
+	if (polygon_id < 0 || polygon_id >= _num_polygons) {
+		return false;
+	}
+
+	const Polygon &polygon = _polygons[polygon_id];
+	const float lat_offset = static_cast<float>(lat - _ref_lat);
+	const float lon_offset = static_cast<float>(lon - _ref_lon);
+
+	if (!insideBox(polygon, lat_offset, lon_offset)) {
+		return false;
+	}
+
+	bool c = false;
+	Edge edge{0, static_cast<uint16_t>(polygon.first_vertex + polygon.vertex_count - 1), static_cast<uint16_t>(polygon_id)};
+
+	for (int i = polygon.first_vertex; i < polygon.first_vertex + polygon.vertex_count; edge.vertex_j = i++) {
+		edge.vertex_i = i;
+
+		if (crossesRay(edge, lat_offset, lon_offset)) {
+			c = !c;
+		}
+	}
+
+	return c;
+}
+
+bool GeofenceIndex::checkPoint(double lat, double lon) const
+{
+	if (!_built) {
+		return true;
+	}
+
+	const float lat_offset = static_cast<float>(lat - _ref_lat);
+	const float lon_offset = static_cast<float>(lon - _ref_lon);
+
+	// cheap reject: the point has to be within the bounding box of every inclusion polygon
+	for (int p = 0; p < _num_polygons; ++p) {
+		if (_polygons[p].enabled && _polygons[p].inclusion && !insideBox(_polygons[p], lat_offset, lon_offset)) {
+			return false;
+		}
+	}
+
+	if (lon_offset < _lon_min || lon_offset > _lon_max) {
+		// no edge overlaps this longitude: the point is outside of all polygons
+		return _num_enabled_inclusion == 0;
+	}
+
+	const int band = bandOf(lon_offset);
+	int inside_inclusion = 0;
+	int polygon_id = -1;
+	bool skip = true;
+	bool c = false;
+
+	for (uint32_t e = _band_start[band]; e <= _band_start[band + 1]; ++e) {
+		const bool polygon_end = (e == _band_start[band + 1]) || (_band_edges[e].polygon != polygon_id);
+
+		if (polygon_end) {
+			if (polygon_id >= 0 && c) {
+				if (!_polygons[polygon_id].inclusion) {
+					return false;
+				}
+
+				++inside_inclusion;
+			}
+
+			if (e == _band_start[band + 1]) {
+				break;
+			}
+
+			polygon_id = _band_edges[e].polygon;
+			skip = !_polygons[polygon_id].enabled || !insideBox(_polygons[polygon_id], lat_offset, lon_offset);
+			c = false;
+		}
+
+		if (!skip && crossesRay(_band_edges[e], lat_offset, lon_offset)) {
+			c = !c;
+		}
+	}
+
+	return inside_inclusion == _num_enabled_inclusion;
+}
+
+bool GeofenceIndex::crossesEdge(double lat_start, double lon_start, double lat_end, double lon_end) const
+{
+	if (!_built) {
+		return false;
+	}
+
+	const float lat0 = static_cast<float>(lat_start - _ref_lat);
+	const float lon0 = static_cast<float>(lon_start - _ref_lon);
+	const float lat1 = static_cast<float>(lat_end - _ref_lat);
+	const float lon1 = static_cast<float>(lon_end - _ref_lon);
+
+	if (!overlaps(lon0, lon1, _lon_min, _lon_max)) {
+		return false;
+	}
+
+	const int band_last = bandOf(math::max(lon0, lon1));
+
+	for (int band = bandOf(math::min(lon0, lon1)); band <= band_last; ++band) {
+		for (uint32_t e = _band_start[band]; e < _band_start[band + 1]; ++e) {
+			const Edge &edge = _band_edges[e];
+			const Polygon &polygon = _polygons[edge.polygon];
+
+			if (!polygon.enabled || !overlaps(lat0, lat1, polygon.lat_min, polygon.lat_max)
+			    || !overlaps(lon0, lon1, polygon.lon_min, polygon.lon_max)) {
+				continue;
+			}
+
+			const Vertex &a = _vertices[edge.vertex_i];
+			const Vertex &b = _vertices[edge.vertex_j];
+
+			const int o1 = orientation(lat0, lon0, lat1, lon1, a.lat, a.lon);
+			const int o2 = orientation(lat0, lon0, lat1, lon1, b.lat, b.lon);
+			const int o3 = orientation(a.lat, a.lon, b.lat, b.lon, lat0, lon0);
+			const int o4 = orientation(a.lat, a.lon, b.lat, b.lon, lat1, lon1);
+
+			if (o1 * o2 > 0 || o3 * o4 > 0) {
+				continue;
+			}
+
+			if (o1 == 0 && o2 == 0) {
+				// collinear: only a crossing if the segments overlap
+				if (overlaps(lat0, lat1, a.lat, b.lat) && overlaps(lon0, lon1, a.lon, b.lon)) {
+					return true;
+				}
+
+				continue;
+			}
+
+			return true;
+		}
+	}
+
+	return false;
+}
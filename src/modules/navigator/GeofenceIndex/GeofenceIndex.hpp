@@ -0,0 +1,181 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file GeofenceIndex.hpp
+ *
+ * In-memory spatial index over the geofence polygons.
+ *
+ * The vertices are stored as float offsets from a reference vertex and the edges are
+ * bucketed into bands of longitude, so that a point or path query only has to test
+ * the edges that overlap its longitude instead of every vertex of every polygon.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+class GeofenceIndex
+{
+public:
+	GeofenceIndex() = default;
+	~GeofenceIndex();
+
+	GeofenceIndex(const GeofenceIndex &) = delete;
+	GeofenceIndex &operator=(const GeofenceIndex &) = delete;
+
+	/**
+	 * Drop the current index and allocate space for a new one.
+	 * Polygons are then added with beginPolygon(), addVertex() and endPolygon(), followed by build().
+	 * @return false if the allocation failed
+	 */
+	bool reset(int max_polygons, int max_vertices);
+
+	/**
+	 * Release all memory
+	 */
+	void clear();
+
+	/**
+	 * Start a new polygon
+	 * @param inclusion true for an inclusion, false for an exclusion polygon
+	 * @return false if the index is full
+	 */
+	bool beginPolygon(bool inclusion);
+
+	/**
+	 * Append a vertex to the current polygon
+	 * @return false if the index is full
+	 */
+	bool addVertex(double lat, double lon);
+
+	/**
+	 * Finish the current polygon
+	 * @return polygon id, or -1 if the polygon has no vertices
+	 */
+	int endPolygon();
+
+	/**
+	 * Discard the vertices of the current polygon
+	 */
+	void cancelPolygon();
+
+	/**
+	 * Bucket the edges of all added polygons into longitude bands. Must be called before any query.
+	 * @return false if the allocation failed
+	 */
+	bool build();
+
+	/**
+	 * Enable or disable a polygon for checkPoint() and crossesEdge()
+	 */
+	void setEnabled(int polygon, bool enabled);
+
+	/**
+	 * Check if a point is inside a single polygon
+	 */
+	bool insidePolygon(int polygon, double lat, double lon) const;
+
+	/**
+	 * Check a point against all enabled polygons
+	 * @return true if the point is inside every inclusion and outside every exclusion polygon
+	 */
+	bool checkPoint(double lat, double lon) const;
+
+	/**
+	 * Check if a straight path (in lat/lon) crosses an edge of an enabled polygon
+	 */
+	bool crossesEdge(double lat_start, double lon_start, double lat_end, double lon_end) const;
+
+	bool built() const { return _built; }
+	int numPolygons() const { return _num_polygons; }
+	int numVertices() const { return _num_vertices; }
+	int numBands() const { return _num_bands; }
+	int numBandEdges() const { return _num_bands > 0 ? _band_start[_num_bands] : 0; }
+
+private:
+	static constexpr int EDGES_PER_BAND = 8;	///< target number of edges per band
+	static constexpr int MAX_BANDS = 1024;
+	static constexpr int MAX_BAND_EDGES_PER_EDGE = 4;	///< reduce the band count if edges span too many bands
+
+	struct Vertex {
+		float lat;	///< [deg] offset from the reference latitude
+		float lon;	///< [deg] offset from the reference longitude
+	};
+
+	struct Polygon {
+		uint16_t first_vertex;
+		uint16_t vertex_count;
+		float lat_min;
+		float lat_max;
+		float lon_min;
+		float lon_max;
+		bool inclusion;
+		bool enabled;
+	};
+
+	struct Edge {
+		uint16_t vertex_i;
+		uint16_t vertex_j;
+		uint16_t polygon;
+	};
+
+	int bandOf(float lon) const { return bandOf(lon, _band_scale, _num_bands); }
+	int bandOf(float lon, float band_scale, int num_bands) const;
+	float bandScale(int num_bands) const;
+	int countBandEdges(int num_bands) const;
+	bool insideBox(const Polygon &polygon, float lat, float lon) const;
+	bool crossesRay(const Edge &edge, float lat, float lon) const;
+
+	Vertex *_vertices{nullptr};
+	Polygon *_polygons{nullptr};
+	uint32_t *_band_start{nullptr};	///< edges of band b are _band_edges[_band_start[b], _band_start[b + 1])
+	Edge *_band_edges{nullptr};
+
+	int _max_polygons{0};
+	int _max_vertices{0};
+	int _num_polygons{0};
+	int _num_vertices{0};
+	int _num_bands{0};
+	int _num_enabled_inclusion{0};
+	int _polygon_first_vertex{-1};	///< first vertex of the polygon being added, -1 if none
+
+	double _ref_lat{0.};
+	double _ref_lon{0.};
+	float _lon_min{0.f};
+	float _lon_max{0.f};
+	float _band_scale{0.f};	///< bands per degree of longitude
+
+	bool _built{false};
+};
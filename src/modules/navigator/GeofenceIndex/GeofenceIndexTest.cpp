@@ -0,0 +1,207 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "GeofenceIndex.hpp"
+
+#include <math.h>
+
+namespace
+{
+
+static constexpr double LAT = 47.397742;
+static constexpr double LON = 8.545594;
+
+/**
+ * Add a regular polygon around (lat, lon) with the given radius in degrees
+ */
+void addRegularPolygon(GeofenceIndex &index, bool inclusion, double lat, double lon, double radius, int vertices)
+{
+	ASSERT_TRUE(index.beginPolygon(inclusion));
+
+	for (int i = 0; i < vertices; ++i) {
+		const double angle = 2. * M_PI * i / vertices;
+		ASSERT_TRUE(index.addVertex(lat + radius * cos(angle), lon + radius * sin(angle)));
+	}
+
+	ASSERT_GE(index.endPolygon(), 0);
+}
+
+/**
+ * Plain PNPOLY over a regular polygon as reference
+ */
+bool insideRegularPolygon(double lat, double lon, double center_lat, double center_lon, double radius, int vertices)
+{
+	bool c = false;
+	double lat_j = center_lat + radius * cos(2. * M_PI * (vertices - 1) / vertices);
+	double lon_j = center_lon + radius * sin(2. * M_PI * (vertices - 1) / vertices);
+
+	for (int i = 0; i < vertices; ++i) {
+		const double lat_i = center_lat + radius * cos(2. * M_PI * i / vertices);
+		const double lon_i = center_lon + radius * sin(2. * M_PI * i / vertices);
+
+		if ((lon_i >= lon) != (lon_j >= lon) && (lat <= (lat_j - lat_i) * (lon - lon_i) / (lon_j - lon_i) + lat_i)) {
+			c = !c;
+		}
+
+		lat_j = lat_i;
+		lon_j = lon_i;
+	}
+
+	return c;
+}
+
+} // namespace
+
+TEST(GeofenceIndexTest, EmptyAcceptsAll)
+{
+	GeofenceIndex index;
+	ASSERT_TRUE(index.reset(0, 0));
+	ASSERT_TRUE(index.build());
+	EXPECT_TRUE(index.checkPoint(LAT, LON));
+	EXPECT_FALSE(index.crossesEdge(LAT, LON, LAT + 1., LON + 1.));
+}
+
+TEST(GeofenceIndexTest, InclusionAndExclusion)
+{
+	GeofenceIndex index;
+	ASSERT_TRUE(index.reset(2, 8));
+
+	// square inclusion of +-0.01 deg with a square exclusion of +-0.002 deg in the middle
+	ASSERT_TRUE(index.beginPolygon(true));
+	index.addVertex(LAT - 0.01, LON - 0.01);
+	index.addVertex(LAT + 0.01, LON - 0.01);
+	index.addVertex(LAT + 0.01, LON + 0.01);
+	index.addVertex(LAT - 0.01, LON + 0.01);
+	EXPECT_EQ(index.endPolygon(), 0);
+
+	ASSERT_TRUE(index.beginPolygon(false));
+	index.addVertex(LAT - 0.002, LON - 0.002);
+	index.addVertex(LAT + 0.002, LON - 0.002);
+	index.addVertex(LAT + 0.002, LON + 0.002);
+	index.addVertex(LAT - 0.002, LON + 0.002);
+	EXPECT_EQ(index.endPolygon(), 1);
+
+	ASSERT_TRUE(index.build());
+
+	EXPECT_TRUE(index.insidePolygon(0, LAT, LON));
+	EXPECT_TRUE(index.insidePolygon(1, LAT, LON));
+	EXPECT_FALSE(index.checkPoint(LAT, LON));
+	EXPECT_TRUE(index.checkPoint(LAT + 0.005, LON));
+	EXPECT_TRUE(index.checkPoint(LAT, LON - 0.005));
+	EXPECT_FALSE(index.checkPoint(LAT + 0.02, LON));
+	EXPECT_FALSE(index.checkPoint(LAT, LON + 0.02));
+
+	// path from inside the inclusion into the exclusion crosses an edge, a path within the free area does not
+	EXPECT_TRUE(index.crossesEdge(LAT + 0.005, LON, LAT, LON));
+	EXPECT_FALSE(index.crossesEdge(LAT + 0.005, LON - 0.005, LAT + 0.005, LON + 0.005));
+
+	// thin exclusion the path passes through without either end point being inside
+	EXPECT_TRUE(index.crossesEdge(LAT, LON - 0.005, LAT, LON + 0.005));
+
+	index.setEnabled(1, false);
+	EXPECT_TRUE(index.checkPoint(LAT, LON));
+	EXPECT_FALSE(index.crossesEdge(LAT, LON - 0.005, LAT, LON + 0.005));
+
+	index.setEnabled(0, false);
+	EXPECT_TRUE(index.checkPoint(LAT + 0.02, LON));
+}
+
+TEST(GeofenceIndexTest, CancelPolygon)
+{
+	GeofenceIndex index;
+	ASSERT_TRUE(index.reset(2, 6));
+
+	ASSERT_TRUE(index.beginPolygon(false));
+	index.addVertex(LAT, LON);
+	index.addVertex(LAT + 1., LON);
+	index.cancelPolygon();
+
+	addRegularPolygon(index, true, LAT, LON, 0.01, 6);
+	ASSERT_TRUE(index.build());
+
+	EXPECT_EQ(index.numPolygons(), 1);
+	EXPECT_EQ(index.numVertices(), 6);
+	EXPECT_TRUE(index.checkPoint(LAT, LON));
+}
+
+TEST(GeofenceIndexTest, MatchesBruteForce)
+{
+	// one inclusion circle with a grid of small exclusion polygons, ~2000 vertices in total
+	static constexpr int GRID = 6;
+	static constexpr double INCLUSION_RADIUS = 0.05;
+	static constexpr double EXCLUSION_RADIUS = 0.004;
+	static constexpr double SPACING = 0.012;
+	static constexpr int VERTICES = 50;
+
+	GeofenceIndex index;
+	ASSERT_TRUE(index.reset(1 + GRID * GRID, VERTICES * (1 + GRID * GRID)));
+
+	addRegularPolygon(index, true, LAT, LON, INCLUSION_RADIUS, VERTICES);
+
+	for (int x = 0; x < GRID; ++x) {
+		for (int y = 0; y < GRID; ++y) {
+			addRegularPolygon(index, false, LAT + (x - GRID / 2) * SPACING, LON + (y - GRID / 2) * SPACING,
+					  EXCLUSION_RADIUS, VERTICES);
+		}
+	}
+
+	ASSERT_TRUE(index.build());
+	EXPECT_GT(index.numBands(), 1);
+
+	int inside = 0;
+
+	for (int i = 0; i < 200; ++i) {
+		for (int j = 0; j < 200; ++j) {
+			const double lat = LAT - 0.06 + i * 0.0006 + 0.00001;
+			const double lon = LON - 0.06 + j * 0.0006 + 0.00001;
+
+			bool expected = insideRegularPolygon(lat, lon, LAT, LON, INCLUSION_RADIUS, VERTICES);
+
+			for (int x = 0; x < GRID; ++x) {
+				for (int y = 0; y < GRID; ++y) {
+					expected &= !insideRegularPolygon(lat, lon, LAT + (x - GRID / 2) * SPACING, LON + (y - GRID / 2) * SPACING,
+									  EXCLUSION_RADIUS, VERTICES);
+				}
+			}
+
+			ASSERT_EQ(index.checkPoint(lat, lon), expected) << "lat " << lat << " lon " << lon;
+			inside += expected;
+		}
+	}
+
+	// make sure the grid covered both outcomes
+	EXPECT_GT(inside, 0);
+	EXPECT_LT(inside, 200 * 200);
+}
@@ -260,6 +260,7 @@ void Geofence::_updateFence()
 
 				if (!_polygons) {
 					_num_polygons = 0;
+					_index.clear();
 					PX4_ERR("alloc failed");
 					return;
 				}
@@ -277,17 +278,7 @@ void Geofence::_updateFence()
 					current_seq += mission_fence_point.vertex_count;
 				}
 
-				// check if requiremetns for Home location are met
-				const bool home_check_okay = checkHomeRequirementsForGeofence(polygon);
-
-				// check if current position is inside the fence and vehicle is armed
-				const bool current_position_check_okay = checkCurrentPositionRequirementsForGeofence(polygon);
-
-				// discard the polygon if at least one check fails by not incrementing the counter in that case
-				if (home_check_okay && current_position_check_okay) {
-					++_num_polygons;
-
-				}
+				++_num_polygons;
 			}
 
 			break;
@@ -298,6 +289,107 @@ void Geofence::_updateFence()
 			break;
 		}
 	}
+
+	buildIndex();
+
+	// discard the polygons for which at least one check fails
+	int num_valid_polygons = 0;
+
+	for (int polygon_index = 0; polygon_index < _num_polygons; ++polygon_index) {
+		const PolygonInfo polygon = _polygons[polygon_index];
+
+		// check if requiremetns for Home location are met
+		const bool home_check_okay = checkHomeRequirementsForGeofence(polygon);
+
+		// check if current position is inside the fence and vehicle is armed
+		const bool current_position_check_okay = checkCurrentPositionRequirementsForGeofence(polygon);
+
+		if (home_check_okay && current_position_check_okay) {
+			_polygons[num_valid_polygons++] = polygon;
+
+		} else {
+			_index.setEnabled(polygon.index_id, false);
+		}
+	}
+
+	_num_polygons = num_valid_polygons;
+}
+
+void Geofence::buildIndex()
+{
+	int num_indexed_polygons = 0;
+	int num_vertices = 0;
+
+	for (int polygon_index = 0; polygon_index < _num_polygons; ++polygon_index) {
+		PolygonInfo &polygon = _polygons[polygon_index];
+		polygon.index_id = -1;
+
+		if (polygon.fence_type == NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION
+		    || polygon.fence_type == NAV_CMD_FENCE_POLYGON_VERTEX_EXCLUSION) {
+			++num_indexed_polygons;
+			num_vertices += polygon.vertex_count;
+		}
+	}
+
+	if (!_index.reset(num_indexed_polygons, num_vertices)) {
+		PX4_ERR("geofence index alloc failed");
+		return;
+	}
+
+	const dm_item_t fence_dataman_id{static_cast<dm_item_t>(_stats.dataman_id)};
+
+	for (int polygon_index = 0; polygon_index < _num_polygons; ++polygon_index) {
+		PolygonInfo &polygon = _polygons[polygon_index];
+
+		if (polygon.fence_type != NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION
+		    && polygon.fence_type != NAV_CMD_FENCE_POLYGON_VERTEX_EXCLUSION) {
+			continue;
+		}
+
+		bool valid = _index.beginPolygon(polygon.fence_type == NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION);
+
+		for (unsigned i = 0; valid && i < polygon.vertex_count; ++i) {
+			mission_fence_point_s vertex{};
+
+			if (!_dataman_cache.loadWait(fence_dataman_id, polygon.dataman_index + i,
+						     reinterpret_cast<uint8_t *>(&vertex), sizeof(mission_fence_point_s))) {
+				PX4_ERR("loadWait failed, seq: %i", polygon.dataman_index + i);
+				valid = false;
+				break;
+			}
+
+			switch (vertex.frame) {
+			case NAV_FRAME_GLOBAL:
+			case NAV_FRAME_GLOBAL_INT:
+			case NAV_FRAME_GLOBAL_RELATIVE_ALT:
+			case NAV_FRAME_GLOBAL_RELATIVE_ALT_INT:
+				valid = _index.addVertex(vertex.lat, vertex.lon);
+				break;
+
+			default:
+				// TODO: handle different frames
+				PX4_ERR("Frame type %i not supported", (int)vertex.frame);
+				valid = false;
+				break;
+			}
+		}
+
+		if (valid) {
+			polygon.index_id = _index.endPolygon();
+
+		} else {
+			// a polygon that is not in the index is never inside (see insidePolygon())
+			_index.cancelPolygon();
+		}
+	}
+
+	if (!_index.build()) {
+		PX4_ERR("geofence index alloc failed");
+
+		for (int polygon_index = 0; polygon_index < _num_polygons; ++polygon_index) {
+			_polygons[polygon_index].index_id = -1;
+		}
+	}
 }
 
 bool Geofence::checkHomeRequirementsForGeofence(const PolygonInfo &polygon)
@@ -392,16 +484,28 @@ bool Geofence::isInsidePolygonOrCircle(double lat, double lon, float altitude)
 		}
 	}
 
-	/* Horizontal check: iterate all polygons & circles */
-	bool checksPass = true;
+	/* Horizontal check: all indexed polygons at once, then the circles & polygons that are not in the index */
+	bool checksPass = _index.checkPoint(lat, lon);
 
 	for (int polygon_index = 0; polygon_index < _num_polygons; ++polygon_index) {
-		checksPass &= checkPointAgainstPolygonCircle(_polygons[polygon_index], lat, lon, altitude);
+		if (_polygons[polygon_index].index_id < 0) {
+			checksPass &= checkPointAgainstPolygonCircle(_polygons[polygon_index], lat, lon, altitude);
+		}
 	}
 
 	return checksPass;
 }
 
+bool Geofence::isPathInsidePolygons(double lat_start, double lon_start, double lat_end, double lon_end)
+{
+	if (isEmpty()) {
+		return true;
+	}
+
+	// a path starting outside is already caught by the point checks, otherwise crossing any polygon edge leaves the fence
+	return !_index.checkPoint(lat_start, lon_start) || !_index.crossesEdge(lat_start, lon_start, lat_end, lon_end);
+}
+
 bool Geofence::checkPointAgainstPolygonCircle(const PolygonInfo &polygon, double lat, double lon, float altitude)
 {
 	bool checksPass = true;
@@ -432,56 +536,7 @@ bool Geofence::checkPointAgainstPolygonCircle(const PolygonInfo &polygon, double
 
 bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon, float altitude)
 {
-	/**
-	 * Adaptation of algorithm originally presented as
-	 * PNPOLY - Point Inclusion in Polygon Test
-	 * W. Randolph Franklin (WRF)
-	 * Only supports non-complex polygons (not self intersecting)
-	 */
-
-	mission_fence_point_s temp_vertex_i{};
-	mission_fence_point_s temp_vertex_j{};
-	bool c = false;
-
-	for (unsigned i = 0, j = polygon.vertex_count - 1; i < polygon.vertex_count; j = i++) {
-
-		dm_item_t fence_dataman_id{static_cast<dm_item_t>(_stats.dataman_id)};
-		bool success = _dataman_cache.loadWait(fence_dataman_id, polygon.dataman_index + i,
-						       reinterpret_cast<uint8_t *>(&temp_vertex_i), sizeof(mission_fence_point_s));
-
-		if (!success) {
-			break;
-		}
-
-		success = _dataman_cache.loadWait(fence_dataman_id, polygon.dataman_index + j,
-						  reinterpret_cast<uint8_t *>(&temp_vertex_j), sizeof(mission_fence_point_s));
-
-		if (!success) {
-			break;
-		}
-
-		switch (temp_vertex_i.frame) {
-		case NAV_FRAME_GLOBAL:
-		case NAV_FRAME_GLOBAL_INT:
-		case NAV_FRAME_GLOBAL_RELATIVE_ALT:
-		case NAV_FRAME_GLOBAL_RELATIVE_ALT_INT:
-			break;
-
-		default:
-			// TODO: handle different frames
-			PX4_ERR("Frame type %i not supported", (int)temp_vertex_i.frame);
-			return c;
-
-		}
-
-		if (((double)temp_vertex_i.lon >= lon) != ((double)temp_vertex_j.lon >= lon) &&
-		    (lat <= (double)(temp_vertex_j.lat - temp_vertex_i.lat) * (lon - (double)temp_vertex_i.lon) /
-		     (double)(temp_vertex_j.lon - temp_vertex_i.lon) + (double)temp_vertex_i.lat)) {
-			c = !c;
-		}
-	}
-
-	return c;
+	return _index.insidePolygon(polygon.index_id, lat, lon);
 }
 
 bool Geofence::insideCircle(const PolygonInfo &polygon, double lat, double lon, float altitude)
@@ -721,4 +776,9 @@ void Geofence::printStatus()
 	PX4_INFO("Geofence: %i inclusion, %i exclusion polygons, %i inclusion circles, %i exclusion circles, %i total vertices",
 		 num_inclusion_polygons, num_exclusion_polygons, num_inclusion_circles, num_exclusion_circles,
 		 total_num_vertices);
+
+	if (_index.built()) {
+		PX4_INFO("Geofence index: %i polygons, %i bands, %i band edges", _index.numPolygons(), _index.numBands(),
+			 _index.numBandEdges());
+	}
 }
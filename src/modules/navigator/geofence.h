@@ -43,6 +43,7 @@
 #include <float.h>
 
 #include <dataman_client/DatamanClient.hpp>
+#include "GeofenceIndex/GeofenceIndex.hpp"
 #include <lib/mathlib/mathlib.h>
 #include <px4_platform_common/module_params.h>
 #include <drivers/drv_hrt.h>
@@ -109,6 +110,14 @@ public:
 
 	virtual bool isInsidePolygonOrCircle(double lat, double lon, float altitude);
 
+	/**
+	 * @brief check if the straight path between two points stays within the polygon fences
+	 * Catches polygons that a predicted test point would jump over. Circles are not considered.
+	 *
+	 * @return false if the path starts inside the fence and crosses a polygon edge
+	 */
+	bool isPathInsidePolygons(double lat_start, double lon_start, double lat_end, double lon_end);
+
 	bool valid();
 
 	/**
@@ -160,6 +169,7 @@ private:
 	struct PolygonInfo {
 		uint16_t fence_type; ///< one of MAV_CMD_NAV_FENCE_* (can also be a circular region)
 		uint16_t dataman_index;
+		int32_t index_id; ///< polygon id in _index, -1 for circles and polygons that could not be indexed
 		union {
 			uint16_t vertex_count;
 			float circle_radius;
@@ -182,6 +192,8 @@ private:
 
 	MapProjection _projection_reference{}; ///< class to convert (lon, lat) to local [m]
 
+	GeofenceIndex _index; ///< spatial index over the polygon vertices, so checks do not need to go through dataman
+
 	uint32_t _opaque_id{0}; ///< dataman geofence id: if it does not match, the polygon data was updated
 	bool _fence_updated{true};  ///< flag indicating if fence are updated to dataman cache
 	bool _initiate_fence_updated{true}; ///< flag indicating if fence updated is needed
@@ -193,6 +205,10 @@ private:
 	 */
 	void _updateFence();
 
+	/**
+	 * Load the vertices of all polygons from the dataman cache into _index
+	 */
+	void buildIndex();
 
 	/**
 	 * Check if a single point is within a polygon
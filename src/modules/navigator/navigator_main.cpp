@@ -993,20 +993,27 @@ void Navigator::geofence_breach_check()
 			test_point_altitude = current_altitude + vertical_test_point_distance;
 		}
 
+		bool inside_custom_fence = _geofence.isInsidePolygonOrCircle(test_point_latitude, test_point_longitude,
+					   test_point_altitude);
+
+		if (_geofence.getPredict()) {
+			// also catch thin exclusion areas between the vehicle and the predicted test point
+			inside_custom_fence = inside_custom_fence && _geofence.isPathInsidePolygons(current_latitude, current_longitude,
+					      test_point_latitude, test_point_longitude);
+		}
+
 		if (_time_loitering_after_gf_breach > 0) {
 			// if we are in the loitering state after breaching a GF, only allow new ones to be set, but not unset
 			_geofence_result.geofence_max_dist_triggered |= !_geofence.isCloserThanMaxDistToHome(test_point_latitude,
 					test_point_longitude, test_point_altitude);
 			_geofence_result.geofence_max_alt_triggered |= !_geofence.isBelowMaxAltitude(test_point_altitude);
-			_geofence_result.geofence_custom_fence_triggered |= !_geofence.isInsidePolygonOrCircle(test_point_latitude,
-					test_point_longitude, test_point_altitude);
+			_geofence_result.geofence_custom_fence_triggered |= !inside_custom_fence;
 
 		} else {
 			_geofence_result.geofence_max_dist_triggered = !_geofence.isCloserThanMaxDistToHome(test_point_latitude,
 					test_point_longitude, test_point_altitude);
 			_geofence_result.geofence_max_alt_triggered = !_geofence.isBelowMaxAltitude(test_point_altitude);
-			_geofence_result.geofence_custom_fence_triggered = !_geofence.isInsidePolygonOrCircle(test_point_latitude,
-					test_point_longitude, test_point_altitude);
+			_geofence_result.geofence_custom_fence_triggered = !inside_custom_fence;
 		}
 
 		_last_geofence_check = hrt_absolute_time();
@@ -34,7 +34,6 @@
 #include "SensorMagSim.hpp"
 
 #include <drivers/drv_sensor.h>
-#include <lib/world_magnetic_model/geo_mag_declination.h>
 
 using namespace matrix;
 
@@ -113,9 +112,10 @@ void SensorMagSim::Run()
 			if (gpos.eph < 1000) {
 
 				// magnetic field data returned by the geo library using the current GPS position
-				const float declination_rad = math::radians(get_mag_declination_degrees(gpos.lat, gpos.lon));
-				const float inclination_rad = math::radians(get_mag_inclination_degrees(gpos.lat, gpos.lon));
-				const float field_strength_gauss = get_mag_strength_gauss(gpos.lat, gpos.lon);
+				const MagneticField &field = _mag_field_cache.get(gpos.lat, gpos.lon);
+				const float declination_rad = math::radians(field.declination_deg);
+				const float inclination_rad = math::radians(field.inclination_deg);
+				const float field_strength_gauss = field.strength_gauss;
 
 				_mag_earth_pred = Dcmf(Eulerf(0, -inclination_rad, declination_rad)) * Vector3f(field_strength_gauss, 0, 0);
 
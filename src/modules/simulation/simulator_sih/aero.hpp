@@ -109,6 +109,7 @@ private:
 	float _kp, _kn;
 	float _ate, _ale, _afte, _afle;	// semi empirical coefficients for flat plates function of AR
 	float _tau_te, _tau_le, _fte, _fle; 	// leading and trailing edge functions
+	float _f_edge;		// 0.25 * (1 + sqrt(_fte))^2, function of _fte only
 	float _rho = 1.225f; 	// air density at current altitude [kg/m^3]
 	float _kD;		// for parabolic drag model
 	const float K0 = 0.87f;	// Oswald efficiency factor
@@ -128,9 +129,10 @@ private:
 	float _alpha_eff;	// effectie angle of attack
 	// float _alpha_eff_dot;	// effectie angle of attack derivative
 	float _alpha_eff_old;	// angle of attack [rad]
+	float _def_alpha;	// increase of the high angle of attack due to the flap deflection [rad]
+	float _cd90_eff;	// 90 deg angle of attack drag coefficient with the flap deflection
+	float _def_prev = NAN;	// deflection the deflection dependent coefficients were computed for
 
-	float _pressure; 	// pressure in Pa at current altitude
-	float _temperature;	// temperature in K at current altitude
 	float _prop_radius;	// propeller radius [m], used to create the slipstream
 	// float _v_slipstream;	// slipstream velocity [m/s], computed from momentum theory
 
@@ -200,6 +202,15 @@ public:
 		_C_BS = matrix::Dcmf(matrix::Eulerf(math::radians(dihedral_deg), 0.0f, 0.0f));
 		_prop_radius = prop_radius;
 		_kD = 1.0f / (M_PI_F * K0 * _ar);
+
+		// function of the flap chord only
+		_theta_f = acosf(2.0f * _cf / _mac - 1.0f);
+		_tau_f = 1.0f - (_theta_f - sinf(_theta_f)) / M_PI_F;
+
+		// the dynamic separation model doesn't seem to work, see aoa_coeff()
+		_fte = 1.0f;
+		_fle = 1.0f;
+		_f_edge = 0.25f * (1.0f + sqrtf(_fte)) * (1.0f + sqrtf(_fte));
 	}
 
 
@@ -219,10 +230,16 @@ public:
 	void update_aero(const matrix::Vector3f &v_B, const matrix::Vector3f &w_B, float alt = 0.0f, float def = 0.0f,
 			 float thrust = 0.0f)
 	{
-		// ISA model taken from Mustafa Cavcar, Anadolu University, Turkey
-		_pressure = P0 * powf(1.0f - 0.0065f * alt / T0_K, 5.2561f);
-		_temperature = T0_K + TEMP_GRADIENT * alt;
-		_rho = _pressure / R / _temperature;
+		update_aero_rho(v_B, w_B, air_density(alt), def, thrust);
+	}
+
+	/** same as update_aero(), with the air density from air_density() computed once for all segments
+	 * rho: air density [kg/m^3]
+	 */
+	void update_aero_rho(const matrix::Vector3f &v_B, const matrix::Vector3f &w_B, float rho, float def = 0.0f,
+			     float thrust = 0.0f)
+	{
+		_rho = rho;
 
 		_v_S = _C_BS.transpose() * (v_B + w_B % _p_B); 	// velocity in segment frame
 
@@ -246,13 +263,24 @@ public:
 		_alpha = matrix::wrap_pi(atan2f(_v_S(2), _v_S(0)) - _alpha_0);
 		// _alpha = atan2f(_v_S(2), _v_S(0));
 		aoa_coeff(_alpha, sqrtf(vxz2), def);
-		_Fa = _C_BS * (0.5f * _rho * vxz2 * _span * _mac) * matrix::Vector3f(_CL * sinf(_alpha) - _CD * cosf(_alpha),
+		const float sin_alpha = sinf(_alpha);
+		const float cos_alpha = cosf(_alpha);
+		_Fa = _C_BS * (0.5f * _rho * vxz2 * _span * _mac) * matrix::Vector3f(_CL * sin_alpha - _CD * cos_alpha,
 				0.0f,
-				-_CL * cosf(_alpha) - _CD * sinf(_alpha));
+				-_CL * cos_alpha - _CD * sin_alpha);
 		_Ma = _C_BS * (0.5f * _rho * vxz2 * _span * _mac * _mac) * matrix::Vector3f(0.0f, _CM,
 				0.0f) + _p_B % _Fa; 	// computed at vehicle _CM
 	}
 
+	// return the air density at the given altitude above mean sea level [kg/m^3]
+	static float air_density(float alt)
+	{
+		// ISA model taken from Mustafa Cavcar, Anadolu University, Turkey
+		const float pressure = P0 * powf(1.0f - 0.0065f * alt / T0_K, 5.2561f);
+		const float temperature = T0_K + TEMP_GRADIENT * alt;
+		return pressure / R / temperature;
+	}
+
 	// return the air density at current altitude, must be called after update_aero()
 	float get_rho() const { return _rho; }
 
@@ -282,15 +310,13 @@ private:
 		_tau_te = (vxz > 0.01f) ? 4.5f * _mac / vxz : 0.0f;
 		_tau_le = (vxz > 0.01f) ? 0.5f * _mac / vxz : 0.0f;
 
+		// the deflection changes at the actuator rate, which is lower than the simulation rate
+		if (def != _def_prev) {
+			deflection_coeff(def);
+		}
+
 		// model for the control surface deflection
 		if (_cf / _mac < 0.999f) {
-			_def_a = fminf(fabsf(def), math::radians(70.0f));
-			_eta_f = _def_a * _def_a * ETA_POLY[0] + _def_a * ETA_POLY[1] + ETA_POLY[2];	// second order fit
-			_theta_f = acosf(2.0f * _cf / _mac - 1.0f);
-			_tau_f = 1.0f - (_theta_f - sinf(_theta_f)) / M_PI_F;
-			_deltaCL = _kp * _tau_f * _eta_f * def;
-			_dCLmax = (1.0f - _cf / _mac) * _deltaCL;
-			_alf0eff = solve_alpha_eff(_kp, KV, _deltaCL, _alpha_0);
 			_alpha_eff = a - _alf0eff;
 
 			// this doesn't seem to work, so let's comment it
@@ -300,15 +326,6 @@ private:
 			// _fle = 0.5f * (1.0f - tanhf(_ale * ((_alpha_eff) - _tau_le * (_alpha_eff_dot)
 			// 	- math::radians(_afle))));	// normalized leading edge separation
 
-			_fte = 1.0f;
-			_fle = 1.0f;
-			_CLmax = fCL(_alpha_max - _alpha_0) + _dCLmax;
-			_alpha_eff_max = _alf0eff - solve_alpha_eff(_kp, KV * _fle * _fle,
-					 _CLmax / (0.25f * (1.0f + sqrtf(_fte)) * (1.0f + sqrtf(_fte))), _alpha_max - _alpha_0);
-			_CLmin = fCL(_alpha_min - _alpha_0) + _dCLmax;
-			_alpha_eff_min = _alf0eff - solve_alpha_eff(_kp, KV * _fle * _fle,
-					 _CLmin / (0.25f * (1.0f + sqrtf(_fte)) * (1.0f + sqrtf(_fte))), _alpha_min - _alpha_0);
-
 		} else { 	// this segment is a full flap
 			_alpha_eff = a + def;
 
@@ -318,15 +335,10 @@ private:
 			// 	- math::radians(_afte))));	// normalized trailing edge separation
 			// _fle = 0.5f * (1.0f - tanhf(_ale * ((_alpha_eff) - _tau_le * (_alpha_eff_dot)
 			// 	- math::radians(_afle))));	// normalized leading edge separation
-
-			_fte = 1.0f;
-			_fle = 1.0f;
-			_alpha_eff_max = _alpha_max;
-			_alpha_eff_min = _alpha_min;
 		}
 
 		// compute the aerodynamic coefficients
-		high_aoa_coeff(_alpha_eff, def);
+		high_aoa_coeff(_alpha_eff);
 		_CL_ = fCL(_alpha_eff);
 		_CD_ = CD0 + fabsf(_CL * tanf(_alpha_eff));
 		// _CD_ = CD0 + _kD*_CL_*_CL_; 	// alternative method
@@ -345,19 +357,46 @@ private:
 		_CM = _CM_ * _f_blend + _CM * (1.0f - _f_blend);
 	}
 
-	// high angle of attack coefficient based on flat plate
-	void high_aoa_coeff(float a, float def = 0.0f)
+	// coefficients which only depend on the deflection, so they are computed once per deflection change
+	void deflection_coeff(float def)
 	{
+		_def_prev = def;
+
+		// high angle of attack
 		float mac_eff = sqrtf((_mac - _cf) * (_mac - _cf) + _cf * _cf + 2.0f * (_mac - _cf) * _cf * cosf(fabsf(def)));
-		a += asinf(_cf / mac_eff * sinf(def));
-		float cd90_eff = CD90 + 0.21f * def - 0.0426f * def *
-				 def; // this might not be accurate for lower flap chord to chord ratio
+		_def_alpha = asinf(_cf / mac_eff * sinf(def));
+		_cd90_eff = CD90 + 0.21f * def - 0.0426f * def *
+			    def; // this might not be accurate for lower flap chord to chord ratio
+
+		if (_cf / _mac < 0.999f) {
+			_def_a = fminf(fabsf(def), math::radians(70.0f));
+			_eta_f = _def_a * _def_a * ETA_POLY[0] + _def_a * ETA_POLY[1] + ETA_POLY[2];	// second order fit
+			_deltaCL = _kp * _tau_f * _eta_f * def;
+			_dCLmax = (1.0f - _cf / _mac) * _deltaCL;
+			_alf0eff = solve_alpha_eff(_kp, KV, _deltaCL, _alpha_0);
+			_CLmax = fCL(_alpha_max - _alpha_0) + _dCLmax;
+			_alpha_eff_max = _alf0eff - solve_alpha_eff(_kp, KV * _fle * _fle, _CLmax / _f_edge, _alpha_max - _alpha_0);
+			_CLmin = fCL(_alpha_min - _alpha_0) + _dCLmax;
+			_alpha_eff_min = _alf0eff - solve_alpha_eff(_kp, KV * _fle * _fle, _CLmin / _f_edge, _alpha_min - _alpha_0);
+
+		} else {
+			_alpha_eff_max = _alpha_max;
+			_alpha_eff_min = _alpha_min;
+		}
+	}
+
+	// high angle of attack coefficient based on flat plate, the flap deflection is accounted in deflection_coeff()
+	void high_aoa_coeff(float a)
+	{
+		a += _def_alpha;
+		const float sin_a = sinf(a);
+		const float cos_a = cosf(a);
 		// normal coeff
-		float CN = cd90_eff * sinf(a) * (1.0f / (0.56f + 0.44f * sinf(fabsf(a))) - _kn);
+		float CN = _cd90_eff * sin_a * (1.0f / (0.56f + 0.44f * sinf(fabsf(a))) - _kn);
 		// tengential coeff
-		float CT = 0.5f * CD0 * cosf(a);
-		_CL = CN * cosf(a) - CT * sinf(a);
-		_CD = CN * sinf(a) + CT * cosf(a);
+		float CT = 0.5f * CD0 * cos_a;
+		_CL = CN * cos_a - CT * sin_a;
+		_CD = CN * sin_a + CT * cos_a;
 		_CM = -CN * (0.25f - 7.0f / 40.0f * (1.0f - 2.0f / M_PI_F * fabsf(a)));
 	}
 
@@ -402,9 +441,10 @@ private:
 		float a = a0; 	// init the search
 
 		for (int i = 0; i < 3; i++) {
-			a = a - (-Kp * sinf(a) * cosf(a) * cosf(a) - Kv * fabsf(sinf(a)) * sinf(a) * cosf(a) - dCL) /
-			    (Kv * fabsf(sinf(a)) * sinf(a) * sinf(a) - Kv * fabsf(sinf(a)) * cosf(a) * cosf(a) - Kp * cosf(a) * cosf(a) * cosf(
-				     a) + 2 * Kp * cosf(a) * sinf(a) * sinf(a) - Kv * matrix::sign(sinf(a)) * cosf(a) * cosf(a) * sinf(a));
+			const float s = sinf(a);
+			const float c = cosf(a);
+			a = a - (-Kp * s * c * c - Kv * fabsf(s) * s * c - dCL) /
+			    (Kv * fabsf(s) * s * s - Kv * fabsf(s) * c * c - Kp * c * c * c + 2 * Kp * c * s * s - Kv * matrix::sign(s) * c * c * s);
 		}
 
 		return a;
@@ -412,15 +452,17 @@ private:
 
 	float fCL(float a)
 	{
-		return 0.25f * (1.0f + sqrtf(_fte)) * (1.0f + sqrtf(_fte)) * (_kp * sinf(a) * cosf(a) * cosf(a)
-				+ _fle * _fle * KV * fabsf(sinf(a)) * sinf(a) * cosf(a));
+		const float s = sinf(a);
+		const float c = cosf(a);
+		return _f_edge * (_kp * s * c * c + _fle * _fle * KV * fabsf(s) * s * c);
 	}
 
 	float fCM(float a)
 	{
-		return -0.25f * (1.0f + sqrtf(_fte)) * (1.0f + sqrtf(_fte)) * 0.0625f * (-1.0f + 6.0f * sqrtf(
-					_fte) - 5.0f * _fte) * _kp * sinf(a) * cosf(a)
-		       + 0.17f * _fle * _fle * KV * fabsf(sinf(a)) * sinf(a);
+		const float s = sinf(a);
+		const float c = cosf(a);
+		return -_f_edge * 0.0625f * (-1.0f + 6.0f * sqrtf(_fte) - 5.0f * _fte) * _kp * s * c
+		       + 0.17f * _fle * _fle * KV * fabsf(s) * s;
 	}
 
 	// AeroSeg operator=(const AeroSeg&) const {
@@ -0,0 +1,134 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file gaussian_noise.hpp
+ * White Gaussian noise generator producing its samples in batches.
+ *
+ * The simulator needs a few noise samples every step. Instead of drawing them one by one
+ * with rand() and the polar Box-Muller method (rejection loop, global lock in rand()),
+ * a batch of samples is generated at once from independent xorshift streams with the
+ * basic Box-Muller transform. The refill loops have no branches and no loop carried
+ * dependencies across the streams, so the compiler can vectorize them.
+ */
+
+#pragma once
+
+#include <matrix/matrix/math.hpp>
+#include <math.h>
+#include <stdint.h>
+
+class GaussianNoise
+{
+public:
+	explicit GaussianNoise(uint32_t seed = 1234) { set_seed(seed); }
+
+	// restart the sequence, the same seed gives the same samples
+	void set_seed(uint32_t seed)
+	{
+		for (int i = 0; i < LANES; i++) {
+			// splitmix32 to get well distributed, non-zero xorshift states
+			uint32_t z = seed + 0x9e3779b9u * (uint32_t)(i + 1);
+			z = (z ^ (z >> 16)) * 0x85ebca6bu;
+			z = (z ^ (z >> 13)) * 0xc2b2ae35u;
+			z ^= z >> 16;
+			_state[i] = (z != 0) ? z : 0x6d2b79f5u;
+		}
+
+		_index = BATCH_SIZE;
+	}
+
+	// white Gaussian noise sample with zero mean and std=1
+	float next()
+	{
+		if (_index >= BATCH_SIZE) {
+			refill();
+		}
+
+		return _buffer[_index++];
+	}
+
+	// white Gaussian noise sample as a 3D vector with specified std
+	matrix::Vector3f next3f(float stdx, float stdy, float stdz)
+	{
+		const float x = next() * stdx;
+		const float y = next() * stdy;
+		const float z = next() * stdz;
+		return matrix::Vector3f(x, y, z);
+	}
+
+private:
+	static constexpr int LANES = 8;		///< independent xorshift streams
+	static constexpr int BATCH_SIZE = 64;	///< samples per refill, multiple of 2 * LANES
+	static constexpr int PAIRS = BATCH_SIZE / 2;
+	static constexpr float TO_UNIT = 1.f / 16777216.f;	///< 2^-24, scales the upper 24 random bits to [0, 1)
+
+	void refill()
+	{
+		float u1[PAIRS];
+		float u2[PAIRS];
+
+		for (int i = 0; i < PAIRS; i += LANES) {
+			for (int l = 0; l < LANES; l++) {
+				u1[i + l] = ((xorshift(l) >> 8) + 1) * TO_UNIT; // (0, 1], logf() must not see 0
+			}
+
+			for (int l = 0; l < LANES; l++) {
+				u2[i + l] = (xorshift(l) >> 8) * TO_UNIT; // [0, 1)
+			}
+		}
+
+		for (int i = 0; i < PAIRS; i++) {
+			const float r = sqrtf(-2.f * logf(u1[i]));
+			const float theta = 2.f * M_PI_F * u2[i];
+			_buffer[2 * i] = r * cosf(theta);
+			_buffer[2 * i + 1] = r * sinf(theta);
+		}
+
+		_index = 0;
+	}
+
+	uint32_t xorshift(int lane)
+	{
+		uint32_t x = _state[lane];
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		_state[lane] = x;
+		return x;
+	}
+
+	uint32_t _state[LANES];
+	float _buffer[BATCH_SIZE];
+	int _index{BATCH_SIZE};
+};
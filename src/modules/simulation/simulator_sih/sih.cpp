@@ -45,6 +45,7 @@
 
 #include <px4_platform_common/getopt.h>
 #include <px4_platform_common/log.h>
+#include <px4_platform_common/shutdown.h>
 
 #include <drivers/drv_pwm_output.h>         // to get PWM flags
 #include <lib/drivers/device/Device.hpp>
@@ -121,7 +122,18 @@ void Sih::lockstep_loop()
 	int rt_interval_us = int(roundf(sim_interval_us / speed_factor));
 
 	PX4_INFO("Simulation loop with %d Hz (%d us sim time interval)", rate, sim_interval_us);
-	PX4_INFO("Simulation with %.1fx speedup. Loop with (%d us wall time interval)", (double)speed_factor, rt_interval_us);
+
+	if (_free_running) {
+		PX4_INFO("Simulation free running, as fast as the flight stack allows");
+
+	} else {
+		PX4_INFO("Simulation with %.1fx speedup. Loop with (%d us wall time interval)", (double)speed_factor, rt_interval_us);
+	}
+
+	if (_sim_duration_us > 0) {
+		PX4_INFO("Shutting down after %.1f s simulated time", _sim_duration_us * 1e-6);
+	}
+
 	uint64_t pre_compute_wall_time_us;
 
 	while (!should_exit()) {
@@ -147,16 +159,50 @@ void Sih::lockstep_loop()
 			sleep_time = math::max(0, sim_interval_us - (int)(current_wall_time_us - pre_compute_wall_time_us));
 
 		} else {
+			if (_lockstep_start_wall_time_us == 0) {
+				_lockstep_start_wall_time_us = pre_compute_wall_time_us;
+				_lockstep_start_simulation_time_us = _current_simulation_time_us - sim_interval_us;
+			}
+
 			px4_lockstep_wait_for_components();
 			current_wall_time_us = micros();
-			sleep_time = math::max(0, rt_interval_us - (int)(current_wall_time_us - pre_compute_wall_time_us));
+
+			if (_free_running) {
+				sleep_time = 0;
+
+			} else {
+				sleep_time = math::max(0, rt_interval_us - (int)(current_wall_time_us - pre_compute_wall_time_us));
+			}
 		}
 
 		_achieved_speedup = 0.99f * _achieved_speedup + 0.01f * ((float)sim_interval_us / (float)(
 					    current_wall_time_us - pre_compute_wall_time_us + sleep_time));
-		usleep(sleep_time);
+
+		if (sleep_time > 0) {
+			usleep(sleep_time);
+		}
+
+		if ((_sim_duration_us > 0) && !_sim_duration_reached && (_current_simulation_time_us >= _sim_duration_us)) {
+			// keep stepping the time afterwards, the shutdown itself runs on simulated time
+			_sim_duration_reached = true;
+			print_speedup();
+			px4_shutdown_request();
+		}
 	}
 }
+
+void Sih::print_speedup()
+{
+	if (_lockstep_start_wall_time_us == 0) {
+		PX4_INFO("Lockstep not started yet");
+		return;
+	}
+
+	const double simulated_s = (_current_simulation_time_us - _lockstep_start_simulation_time_us) * 1e-6;
+	const double wall_s = (micros() - _lockstep_start_wall_time_us) * 1e-6;
+	PX4_INFO("Simulated %.1f s in %.1f s wall time: %.2fX average speedup", simulated_s, wall_s,
+		 wall_s > 0. ? simulated_s / wall_s : 0.);
+}
 #endif
 
 static void timer_callback(void *sem)
@@ -286,7 +332,7 @@ void Sih::parameters_updated()
 
 void Sih::init_variables()
 {
-	srand(1234);    // initialize the random seed once before calling generate_wgn()
+	_noise.set_seed(1234);
 
 	_lpos = Vector3f(0.0f, 0.0f, 0.0f);
 	_v_N = Vector3f(0.0f, 0.0f, 0.0f);
@@ -378,14 +424,14 @@ void Sih::generate_fw_aerodynamics(const float roll_cmd, const float pitch_cmd,
 				   const float throttle_cmd)
 {
 	const Vector3f v_B = _q_E.rotateVectorInverse(_v_E);
-	const float &alt = _lla.altitude();
+	const float rho = AeroSeg::air_density(_lla.altitude());
 
-	_wing_l.update_aero(v_B, _w_B, alt, roll_cmd * FLAP_MAX);
-	_wing_r.update_aero(v_B, _w_B, alt, -roll_cmd * FLAP_MAX);
+	_wing_l.update_aero_rho(v_B, _w_B, rho, roll_cmd * FLAP_MAX);
+	_wing_r.update_aero_rho(v_B, _w_B, rho, -roll_cmd * FLAP_MAX);
 
-	_tailplane.update_aero(v_B, _w_B, alt, -pitch_cmd * FLAP_MAX, _T_MAX * throttle_cmd);
-	_fin.update_aero(v_B, _w_B, alt, yaw_cmd * FLAP_MAX, _T_MAX * throttle_cmd);
-	_fuselage.update_aero(v_B, _w_B, alt);
+	_tailplane.update_aero_rho(v_B, _w_B, rho, -pitch_cmd * FLAP_MAX, _T_MAX * throttle_cmd);
+	_fin.update_aero_rho(v_B, _w_B, rho, yaw_cmd * FLAP_MAX, _T_MAX * throttle_cmd);
+	_fuselage.update_aero_rho(v_B, _w_B, rho);
 
 	// sum of aerodynamic forces
 	const Vector3f Fa_B = _wing_l.get_Fa() + _wing_r.get_Fa() + _tailplane.get_Fa() + _fin.get_Fa() + _fuselage.get_Fa() -
@@ -404,17 +450,17 @@ void Sih::generate_ts_aerodynamics()
 	// the aerodynamic is resolved in a frame like a standard aircraft (nose-right-belly)
 	Vector3f v_ts = _R_S2B.transpose() * v_B;
 	Vector3f w_ts = _R_S2B.transpose() * _w_B;
-	float altitude = _lpos_ref_alt - _lpos(2);
+	const float rho = AeroSeg::air_density(_lpos_ref_alt - _lpos(2));
 
 	Vector3f Fa_ts{};
 	Vector3f Ma_ts{};
 
 	for (int i = 0; i < NB_TS_SEG; i++) {
 		if (i <= NB_TS_SEG / 2) {
-			_ts[i].update_aero(v_ts, w_ts, altitude, _u[5]*TS_DEF_MAX, _T_MAX * _u[1]);
+			_ts[i].update_aero_rho(v_ts, w_ts, rho, _u[5]*TS_DEF_MAX, _T_MAX * _u[1]);
 
 		} else {
-			_ts[i].update_aero(v_ts, w_ts, altitude, -_u[4]*TS_DEF_MAX, _T_MAX * _u[0]);
+			_ts[i].update_aero_rho(v_ts, w_ts, rho, -_u[4]*TS_DEF_MAX, _T_MAX * _u[0]);
 		}
 
 		Fa_ts += _ts[i].get_Fa();
@@ -620,13 +666,13 @@ void Sih::reconstruct_sensors_signals(const hrt_abstime &time_now_us)
 	Vector3f gyro_noise;
 
 	if (_T_B.longerThan(FLT_EPSILON)) {
-		accel_noise = noiseGauss3f(0.5f, 1.7f, 1.4f);
-		gyro_noise = noiseGauss3f(0.14f, 0.07f, 0.03f);
+		accel_noise = _noise.next3f(0.5f, 1.7f, 1.4f);
+		gyro_noise = _noise.next3f(0.14f, 0.07f, 0.03f);
 
 	} else {
 		// Lower noise when not armed
-		accel_noise = noiseGauss3f(0.1f, 0.1f, 0.1f);
-		gyro_noise = noiseGauss3f(0.01f, 0.01f, 0.01f);
+		accel_noise = _noise.next3f(0.1f, 0.1f, 0.1f);
+		gyro_noise = _noise.next3f(0.01f, 0.01f, 0.01f);
 	}
 
 	Vector3f specific_force_B = R_E2B * _specific_force_E;
@@ -647,7 +693,7 @@ void Sih::send_airspeed(const hrt_abstime &time_now_us)
 	airspeed.timestamp_sample = time_now_us;
 
 	// regardless of vehicle type, body frame, etc this holds as long as wind=0
-	airspeed.true_airspeed_m_s = fmaxf(0.1f, _v_E.norm() + generate_wgn() * 0.2f);
+	airspeed.true_airspeed_m_s = fmaxf(0.1f, _v_E.norm() + _noise.next() * 0.2f);
 	airspeed.indicated_airspeed_m_s = airspeed.true_airspeed_m_s * sqrtf(_wing_l.get_rho() / RHO);
 	airspeed.confidence = 0.7f;
 	airspeed.timestamp = hrt_absolute_time();
@@ -763,45 +809,12 @@ void Sih::publish_ground_truth(const hrt_abstime &time_now_us)
 	}
 }
 
-float Sih::generate_wgn()   // generate white Gaussian noise sample with std=1
-{
-	// algorithm 1:
-	// float temp=((float)(rand()+1))/(((float)RAND_MAX+1.0f));
-	// return sqrtf(-2.0f*logf(temp))*cosf(2.0f*M_PI_F*rand()/RAND_MAX);
-	// algorithm 2: from BlockRandGauss.hpp
-	static float V1, V2, S;
-	static bool phase = true;
-	float X;
-
-	if (phase) {
-		do {
-			float U1 = (float)rand() / (float)RAND_MAX;
-			float U2 = (float)rand() / (float)RAND_MAX;
-			V1 = 2.0f * U1 - 1.0f;
-			V2 = 2.0f * U2 - 1.0f;
-			S = V1 * V1 + V2 * V2;
-		} while (S >= 1.0f || fabsf(S) < 1e-8f);
-
-		X = V1 * float(sqrtf(-2.0f * float(logf(S)) / S));
-
-	} else {
-		X = V2 * float(sqrtf(-2.0f * float(logf(S)) / S));
-	}
-
-	phase = !phase;
-	return X;
-}
-
-Vector3f Sih::noiseGauss3f(float stdx, float stdy, float stdz)
-{
-	return Vector3f(generate_wgn() * stdx, generate_wgn() * stdy, generate_wgn() * stdz);
-}
-
 int Sih::print_status()
 {
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 	PX4_INFO("Running in lockstep mode");
 	PX4_INFO("Achieved speedup: %.2fX", (double)_achieved_speedup);
+	print_speedup();
 #endif
 
 	if (_vehicle == VehicleType::Quadcopter) {
@@ -866,10 +879,53 @@ int Sih::task_spawn(int argc, char *argv[])
 
 Sih *Sih::instantiate(int argc, char *argv[])
 {
+	bool free_running = false;
+	float duration_s = 0.f;
+	bool error_flag = false;
+
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = nullptr;
+
+	while ((ch = px4_getopt(argc, argv, "fd:", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'f':
+			free_running = true;
+			break;
+
+		case 'd':
+			duration_s = strtof(myoptarg, nullptr);
+			break;
+
+		default:
+			PX4_WARN("unrecognized flag");
+			error_flag = true;
+			break;
+		}
+	}
+
+	if (error_flag) {
+		return nullptr;
+	}
+
+#if !defined(ENABLE_LOCKSTEP_SCHEDULER)
+
+	if (free_running || (duration_s > 0.f)) {
+		PX4_WARN("-f and -d require lockstep, ignoring");
+	}
+
+#endif
+
 	Sih *instance = new Sih();
 
 	if (instance == nullptr) {
 		PX4_ERR("alloc failed");
+
+	} else {
+#if defined(ENABLE_LOCKSTEP_SCHEDULER)
+		instance->_free_running = free_running;
+		instance->_sim_duration_us = (duration_s > 0.f) ? static_cast<uint64_t>(duration_s * 1e6f) : 0;
+#endif
 	}
 
 	return instance;
@@ -904,11 +960,17 @@ Quaternion representation is used for the attitude.
 Forward Euler is used for integration.
 Most of the variables are declared global in the .hpp file to avoid stack overflow.
 
+### Examples
+For batch runs (e.g. Monte-Carlo regression) in SITL, run headless as fast as possible and exit after 120 s of
+simulated time. The achieved speedup is printed at the end:
+$ simulator_sih start -f -d 120
 
 )DESCR_STR");
 
     PRINT_MODULE_USAGE_NAME("simulator_sih", "simulation");
     PRINT_MODULE_USAGE_COMMAND("start");
+    PRINT_MODULE_USAGE_PARAM_FLAG('f', "Free running: step as fast as possible instead of PX4_SIM_SPEED_FACTOR (lockstep only)", true);
+    PRINT_MODULE_USAGE_PARAM_FLOAT('d', 0.f, 0.f, 1e6f, "Shut down after this simulated time in seconds (lockstep only)", true);
     PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
 
     return 0;
@@ -80,6 +80,8 @@
 #include <uORB/topics/vehicle_global_position.h>
 #include <uORB/topics/vehicle_local_position.h>
 
+#include "gaussian_noise.hpp"
+
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 #include <sys/time.h>
 #endif
@@ -110,11 +112,6 @@ public:
 	/** @see ModuleBase::run() */
 	void run() override;
 
-	static float generate_wgn();    // generate white Gaussian noise sample
-
-	// generate white Gaussian noise sample as a 3D vector with specified std
-	static matrix::Vector3f noiseGauss3f(float stdx, float stdy, float stdz);
-
 private:
 	void parameters_updated();
 
@@ -130,6 +127,8 @@ private:
 	uORB::Publication<vehicle_local_position_s>   _local_position_ground_truth_pub{ORB_ID(vehicle_local_position_groundtruth)};
 	uORB::Publication<vehicle_global_position_s>  _global_position_ground_truth_pub{ORB_ID(vehicle_global_position_groundtruth)};
 
+	GaussianNoise _noise{};
+
 	uORB::SubscriptionInterval _parameter_update_sub{ORB_ID(parameter_update), 1_s};
 	uORB::Subscription _actuator_out_sub{ORB_ID(actuator_outputs)};
 
@@ -180,8 +179,15 @@ private:
 
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 	void lockstep_loop();
+	void print_speedup();
 	uint64_t _current_simulation_time_us{0};
 	float _achieved_speedup{0.f};
+
+	bool _free_running{false};          ///< do not pace the simulation to wall time
+	uint64_t _sim_duration_us{0};       ///< shut down after this simulated time, 0 to run forever
+	bool _sim_duration_reached{false};
+	uint64_t _lockstep_start_wall_time_us{0};
+	uint64_t _lockstep_start_simulation_time_us{0};
 #endif
 
 	void realtime_loop();
@@ -25,6 +25,7 @@ import os
 #include <uORB/Publication.hpp>
 #include <uORB/PublicationMulti.hpp>
 #include <uORB/uORB.h>
+#include <uORB/topics/dds_link_status.h>
 @[for include in type_includes]@
 #include <uORB/ucdr/@(include).h>
 #include <uORB/topics/@(include).h>
@@ -58,6 +59,16 @@ static constexpr uint32_t get_message_version() {
 	return MessageVersionHelper<T>::m;
 }
 
+enum class TopicPriority : uint8_t {
+	Low,    ///< coalesced under moderate and dropped to 1 Hz under severe congestion
+	Normal, ///< coalesced under severe congestion
+	High,   ///< always sent at the configured rate
+};
+
+// congestion levels, see dds_link_status
+static constexpr uint8_t CONGESTION_THROTTLE_FACTOR = 4;
+static constexpr uint64_t CONGESTION_DROPPED_INTERVAL_MS = 1000;
+
 struct SendSubscription {
 	const struct orb_metadata *orb_meta;
 	uxrObjectId data_writer;
@@ -67,6 +78,7 @@ struct SendSubscription {
 	uint32_t topic_size;
 	UcdrSerializeMethod ucdr_serialize_method;
 	uint64_t publish_interval_ms;
+	TopicPriority priority;
 };
 
 // Subscribers for messages to send
@@ -81,6 +93,7 @@ struct SendTopicsSubs {
 			  ucdr_topic_size_@(pub['simple_base_type'])(),
 			  &ucdr_serialize_@(pub['simple_base_type']),
 			  static_cast<uint64_t>((@(pub.get('rate_limit', 0)) > 0) ? (1e3 / @(pub.get('rate_limit', 1e3))) : UXRCE_DEFAULT_POLL_INTERVAL_MS),
+			  TopicPriority::@(pub['priority']),
 			},
 @[    end for]@
 	};
@@ -89,9 +102,15 @@ struct SendTopicsSubs {
 
 	uint32_t num_payload_sent{};
 
+	uint8_t congestion_level{};
+	uint16_t num_throttled{}; ///< publications currently coalesced or dropped
+
 	bool init(uxrSession *session, uxrStreamId reliable_out_stream_id, uxrStreamId reliable_in_stream_id, uxrStreamId best_effort_in_stream_id, uxrObjectId participant_id, const char *client_namespace);
 	void update(uxrSession *session, uxrStreamId reliable_out_stream_id, uxrStreamId best_effort_stream_id, uxrObjectId participant_id, const char *client_namespace);
 	void reset();
+
+	/** adapt the publication intervals to the link state, one of dds_link_status_s::CONGESTION_* */
+	void set_congestion_level(uint8_t level);
 };
 
 bool SendTopicsSubs::init(uxrSession *session, uxrStreamId reliable_out_stream_id, uxrStreamId reliable_in_stream_id, uxrStreamId best_effort_in_stream_id, uxrObjectId participant_id, const char *client_namespace) {
@@ -114,6 +133,8 @@ bool SendTopicsSubs::init(uxrSession *session, uxrStreamId reliable_out_stream_i
 
 void SendTopicsSubs::reset() {
 	num_payload_sent = 0;
+	congestion_level = 0;
+	num_throttled = 0;
 	for (unsigned idx = 0; idx < sizeof(send_subscriptions)/sizeof(send_subscriptions[0]); ++idx) {
 		send_subscriptions[idx].data_writer = uxr_object_id(0, UXR_INVALID_ID);
 		orb_unsubscribe(fds[idx].fd);
@@ -121,12 +142,44 @@ void SendTopicsSubs::reset() {
 	}
 };
 
+void SendTopicsSubs::set_congestion_level(uint8_t level)
+{
+	congestion_level = level;
+	num_throttled = 0;
+
+	for (unsigned idx = 0; idx < sizeof(send_subscriptions)/sizeof(send_subscriptions[0]); ++idx) {
+		const SendSubscription &sub = send_subscriptions[idx];
+		uint64_t interval_ms = sub.publish_interval_ms;
+
+		if (sub.priority == TopicPriority::Low && level >= dds_link_status_s::CONGESTION_SEVERE) {
+			interval_ms = math::max(interval_ms, CONGESTION_DROPPED_INTERVAL_MS);
+
+		} else if ((sub.priority == TopicPriority::Low && level >= dds_link_status_s::CONGESTION_MODERATE)
+			   || (sub.priority == TopicPriority::Normal && level >= dds_link_status_s::CONGESTION_SEVERE)) {
+			// the uORB interval coalesces updates, only the latest sample is sent
+			interval_ms *= CONGESTION_THROTTLE_FACTOR;
+		}
+
+		if (interval_ms != sub.publish_interval_ms) {
+			++num_throttled;
+		}
+
+		if (fds[idx].fd >= 0) {
+			orb_set_interval(fds[idx].fd, interval_ms);
+		}
+	}
+}
+
 void SendTopicsSubs::update(uxrSession *session, uxrStreamId reliable_out_stream_id, uxrStreamId best_effort_stream_id, uxrObjectId participant_id, const char *client_namespace)
 {
 	int64_t time_offset_us = session->time_offset / 1000; // ns -> us
 
 	alignas(sizeof(uint64_t)) char topic_data[max_topic_size];
 
+	// all updated topics are batched into the output stream and flushed together: a frame is only sent once
+	// it is full or at the end of the update, which reduces the per-message transport overhead
+	bool pending = false;
+
 	for (unsigned idx = 0; idx < sizeof(send_subscriptions)/sizeof(send_subscriptions[0]); ++idx) {
 		if (fds[idx].revents & POLLIN) {
 			// Topic updated, copy data and send
@@ -136,11 +189,19 @@ void SendTopicsSubs::update(uxrSession *session, uxrStreamId reliable_out_stream
 
 				ucdrBuffer ub;
 				uint32_t topic_size = send_subscriptions[idx].topic_size;
-				if (uxr_prepare_output_stream(session, best_effort_stream_id, send_subscriptions[idx].data_writer, &ub, topic_size) != UXR_INVALID_REQUEST_ID) {
-					send_subscriptions[idx].ucdr_serialize_method(&topic_data, ub, time_offset_us);
-					// TODO: fill up the MTU and then flush, which reduces the packet overhead
+				bool prepared = uxr_prepare_output_stream(session, best_effort_stream_id, send_subscriptions[idx].data_writer, &ub, topic_size) != UXR_INVALID_REQUEST_ID;
+
+				if (!prepared && pending) {
+					// frame is full: send it and retry with an empty one
 					uxr_flash_output_streams(session);
+					pending = false;
+					prepared = uxr_prepare_output_stream(session, best_effort_stream_id, send_subscriptions[idx].data_writer, &ub, topic_size) != UXR_INVALID_REQUEST_ID;
+				}
+
+				if (prepared) {
+					send_subscriptions[idx].ucdr_serialize_method(&topic_data, ub, time_offset_us);
 					num_payload_sent += topic_size;
+					pending = true;
 
 				} else {
 					//PX4_ERR("Error uxr_prepare_output_stream UXR_INVALID_REQUEST_ID %s", send_subscriptions[idx].subscription.get_topic()->o_name);
@@ -152,6 +213,10 @@ void SendTopicsSubs::update(uxrSession *session, uxrStreamId reliable_out_stream
 
 		}
 	}
+
+	if (pending) {
+		uxr_flash_output_streams(session);
+	}
 }
 
 // Publishers for received messages
@@ -109,6 +109,12 @@ if pubs_not_empty:
     for p in msg_map['publications']:
         process_message_type(p)
 
+        # priority under link congestion: high, normal (default) or low
+        priority = p.get('priority', 'normal')
+        if priority not in ('high', 'normal', 'low'):
+            raise ValueError(f"{p['topic']}: invalid priority '{priority}'")
+        p['priority'] = priority.capitalize()
+
 merged_em_globals['publications'] = msg_map['publications'] if pubs_not_empty else []
 
 subs_not_empty = msg_map['subscriptions'] is not None
@@ -59,19 +59,11 @@ static void on_time(uxrSession *session, int64_t current_time, int64_t client_tr
 		    int64_t agent_receive_timestamp, int64_t originate_timestamp, void *args)
 {
 	if (args) {
-		Timesync *timesync = static_cast<Timesync *>(args);
-		timesync->update(current_time / 1000, agent_receive_timestamp, originate_timestamp);
-
-		session->time_offset = -timesync->offset() * 1000; // us -> ns
+		UxrceddsClient *client = static_cast<UxrceddsClient *>(args);
+		client->handle_time(session, current_time, agent_receive_timestamp, originate_timestamp);
 	}
 }
 
-static void on_time_no_sync(uxrSession *session, int64_t current_time, int64_t client_transmit_timestamp,
-			    int64_t agent_receive_timestamp, int64_t originate_timestamp, void *args)
-{
-	session->time_offset = 0;
-}
-
 static void on_request(uxrSession *session, uxrObjectId object_id, uint16_t request_id, SampleIdentity *sample_id,
 		       ucdrBuffer *ub, uint16_t length, void *args)
 {
@@ -137,6 +129,7 @@ bool UxrceddsClient::init()
 
 			_comm = &_transport_serial->comm;
 			_fd = fd;
+			hookTransport(_comm);
 
 			return true;
 		}
@@ -161,6 +154,7 @@ bool UxrceddsClient::init()
 
 			_comm = &_transport_udp->comm;
 			_fd = _transport_udp->platform.poll_fd.fd;
+			hookTransport(_comm);
 
 			return true;
 
@@ -314,13 +308,8 @@ bool UxrceddsClient::setupSession(uxrSession *session)
 		return false;
 	}
 
-	// Set time-callback.
-	if (_synchronize_timestamps) {
-		uxr_set_time_callback(session, on_time, &_timesync);
-
-	} else {
-		uxr_set_time_callback(session, on_time_no_sync, nullptr);
-	}
+	// Set time-callback, also used to sample the round trip time
+	uxr_set_time_callback(session, on_time, this);
 
 	uxr_set_request_callback(session, on_request, this);
 	uint8_t sync_timeouts = 0;
@@ -463,6 +452,35 @@ static void fillMessageFormatResponse(const message_format_request_s &message_fo
 	message_format_response.timestamp = hrt_absolute_time();
 }
 
+void UxrceddsClient::hookTransport(uxrCommunication *comm)
+{
+	_transport_instance = comm->instance;
+	_transport_send_msg = comm->send_msg;
+	_transport_recv_msg = comm->recv_msg;
+
+	comm->instance = this;
+	comm->send_msg = sendMsg;
+	comm->recv_msg = recvMsg;
+}
+
+bool UxrceddsClient::sendMsg(void *instance, const uint8_t *buf, size_t len)
+{
+	UxrceddsClient *client = static_cast<UxrceddsClient *>(instance);
+	const bool sent = client->_transport_send_msg(client->_transport_instance, buf, len);
+
+	if (!sent) {
+		++client->_num_send_failures;
+	}
+
+	return sent;
+}
+
+bool UxrceddsClient::recvMsg(void *instance, uint8_t **buf, size_t *len, int timeout)
+{
+	UxrceddsClient *client = static_cast<UxrceddsClient *>(instance);
+	return client->_transport_recv_msg(client->_transport_instance, buf, len, timeout);
+}
+
 void UxrceddsClient::calculateTxRxRate()
 {
 	const hrt_abstime now = hrt_absolute_time();
@@ -474,9 +492,109 @@ void UxrceddsClient::calculateTxRxRate()
 		_last_num_payload_sent = _subs->num_payload_sent;
 		_last_num_payload_received = _pubs->num_payload_received;
 		_last_status_update = now;
+
+		updateLinkStatus(now);
 	}
 }
 
+void UxrceddsClient::handle_time(uxrSession *session, int64_t current_time, int64_t agent_receive_timestamp,
+				 int64_t originate_timestamp)
+{
+	if (_synchronize_timestamps) {
+		_timesync.update(current_time / 1000, agent_receive_timestamp, originate_timestamp);
+
+		session->time_offset = -_timesync.offset() * 1000; // us -> ns
+
+	} else {
+		session->time_offset = 0;
+	}
+
+	const int64_t rtt_us = (current_time - originate_timestamp) / 1000; // ns -> us
+
+	if (rtt_us > 0) {
+		const float rtt_ms = rtt_us / 1e3f;
+
+		if (_rtt_ms > 0.f) {
+			_rtt_ms += RTT_FILTER_GAIN * (rtt_ms - _rtt_ms);
+
+		} else {
+			_rtt_ms = rtt_ms;
+		}
+
+		updateRoundTripTimeMin(rtt_ms, hrt_absolute_time());
+	}
+}
+
+void UxrceddsClient::updateRoundTripTimeMin(float rtt_ms, const hrt_abstime &now)
+{
+	// start a new bucket periodically, dropping the oldest one
+	if (_rtt_min_bucket_start == 0 || now - _rtt_min_bucket_start > RTT_MIN_BUCKET_DURATION) {
+		_rtt_min_bucket = (_rtt_min_bucket + 1) % RTT_MIN_BUCKETS;
+		_rtt_min_buckets_ms[_rtt_min_bucket] = 0.f;
+		_rtt_min_bucket_start = now;
+	}
+
+	float &bucket_min = _rtt_min_buckets_ms[_rtt_min_bucket];
+
+	if (bucket_min <= 0.f || rtt_ms < bucket_min) {
+		bucket_min = rtt_ms;
+	}
+
+	_rtt_min_ms = 0.f;
+
+	for (const float rtt_min : _rtt_min_buckets_ms) {
+		if (rtt_min > 0.f && (_rtt_min_ms <= 0.f || rtt_min < _rtt_min_ms)) {
+			_rtt_min_ms = rtt_min;
+		}
+	}
+}
+
+void UxrceddsClient::updateLinkStatus(const hrt_abstime &now)
+{
+	const uint32_t send_failures = _num_send_failures - _last_num_send_failures;
+	_last_num_send_failures = _num_send_failures;
+
+	uint8_t congestion_level = _subs->congestion_level;
+
+	if (_param_uxrce_dds_adapt.get() > 0) {
+		// queueing delay shows up as round trip time growing well above the idle baseline
+		const bool rtt_inflated = (_rtt_min_ms > 0.f)
+					  && (_rtt_ms > math::max(RTT_CONGESTED_FACTOR * _rtt_min_ms, _rtt_min_ms + RTT_CONGESTED_MARGIN_MS));
+
+		if (send_failures > 0 || rtt_inflated) {
+			_num_link_good = 0;
+
+			if (congestion_level < dds_link_status_s::CONGESTION_SEVERE) {
+				congestion_level++;
+			}
+
+		} else if (congestion_level > dds_link_status_s::CONGESTION_NONE && ++_num_link_good >= LINK_RECOVERY_COUNT) {
+			// step down slowly to avoid oscillating around the link capacity
+			_num_link_good = 0;
+			congestion_level--;
+		}
+
+	} else {
+		congestion_level = dds_link_status_s::CONGESTION_NONE;
+	}
+
+	if (congestion_level != _subs->congestion_level) {
+		PX4_DEBUG("link congestion level %d -> %d", _subs->congestion_level, congestion_level);
+		_subs->set_congestion_level(congestion_level);
+	}
+
+	dds_link_status_s dds_link_status{};
+	dds_link_status.tx_rate = _last_payload_tx_rate;
+	dds_link_status.rx_rate = _last_payload_rx_rate;
+	dds_link_status.round_trip_time = _rtt_ms * 1e3f; // ms -> us
+	dds_link_status.round_trip_time_min = _rtt_min_ms * 1e3f;
+	dds_link_status.send_failures = send_failures;
+	dds_link_status.congestion_level = congestion_level;
+	dds_link_status.topics_throttled = _subs->num_throttled;
+	dds_link_status.timestamp = now;
+	_dds_link_status_pub.publish(dds_link_status);
+}
+
 void UxrceddsClient::handleMessageFormatRequest()
 {
 	message_format_request_s message_format_request;
@@ -567,6 +685,16 @@ void UxrceddsClient::resetConnectivityCounters()
 	_last_num_payload_received = 0;
 	_num_tx_rate_zero = 0;
 	_num_rx_rate_zero = 0;
+	_last_num_send_failures = _num_send_failures;
+	_num_link_good = 0;
+	_rtt_ms = 0.f;
+	_rtt_min_ms = 0.f;
+
+	for (float &rtt_min : _rtt_min_buckets_ms) {
+		rtt_min = 0.f;
+	}
+
+	_rtt_min_bucket_start = 0;
 }
 
 void UxrceddsClient::syncSystemClock(uxrSession *session)
@@ -699,6 +827,12 @@ void UxrceddsClient::run()
 				}
 
 				_timesync_converged = _timesync.sync_converged();
+
+			} else if (!_synchronize_timestamps && (_param_uxrce_dds_adapt.get() > 0)
+				   && hrt_elapsed_time(&last_sync_session) > 1_s) {
+				// no time sync running, probe the round trip time for the link monitor
+				uxr_sync_session(&session, 0);
+				last_sync_session = hrt_absolute_time();
 			}
 
 			handleMessageFormatRequest();
@@ -945,6 +1079,8 @@ int UxrceddsClient::print_status()
 	if (_connected) {
 		PX4_INFO("Payload tx:          %i B/s", _last_payload_tx_rate);
 		PX4_INFO("Payload rx:          %i B/s", _last_payload_rx_rate);
+		PX4_INFO("Round trip time:     %.1f ms (min %.1f ms)", (double)_rtt_ms, (double)_rtt_min_ms);
+		PX4_INFO("Congestion level:    %i (%i topics throttled)", _subs->congestion_level, _subs->num_throttled);
 	}
 
 	PX4_INFO("timesync converged: %s", _timesync.sync_converged() ? "true" : "false");
@@ -40,7 +40,9 @@
 
 #include <uORB/topics/message_format_request.h>
 #include <uORB/topics/message_format_response.h>
+#include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
+#include <uORB/topics/dds_link_status.h>
 
 #include <lib/timesync/Timesync.hpp>
 
@@ -115,6 +117,16 @@ public:
 	 */
 	void delete_repliers();
 
+	/**
+	 * @brief Time sync reply from the agent, updates the time offset and round trip time.
+	 * @param session session the reply was received on
+	 * @param current_time local receive time in ns
+	 * @param agent_receive_timestamp agent receive time in ns
+	 * @param originate_timestamp local transmit time in ns
+	 */
+	void handle_time(uxrSession *session, int64_t current_time, int64_t agent_receive_timestamp,
+			 int64_t originate_timestamp);
+
 private:
 
 	bool init();
@@ -127,12 +139,22 @@ private:
 
 	void handleMessageFormatRequest();
 
+	/**
+	 * Route the transport writes through sendMsg() to count failed writes
+	 * (e.g. a full serial TX buffer), which signal link congestion.
+	 */
+	void hookTransport(uxrCommunication *comm);
+	static bool sendMsg(void *instance, const uint8_t *buf, size_t len);
+	static bool recvMsg(void *instance, uint8_t **buf, size_t *len, int timeout);
+
 	void calculateTxRxRate();
+	void updateLinkStatus(const hrt_abstime &now);
 	void checkConnectivity(uxrSession *session);
 	void resetConnectivityCounters();
 
 	uORB::Publication<message_format_response_s> _message_format_response_pub{ORB_ID(message_format_response)};
 	uORB::Subscription _message_format_request_sub{ORB_ID(message_format_request)};
+	uORB::Publication<dds_link_status_s> _dds_link_status_pub{ORB_ID(dds_link_status)};
 
 	/** Synchronizes the system clock if the time is off by more than 5 seconds */
 	void syncSystemClock(uxrSession *session);
@@ -183,6 +205,11 @@ private:
 	uxrCommunication *_comm{nullptr};
 	int _fd{-1};
 
+	void *_transport_instance{nullptr};
+	send_msg_func _transport_send_msg{nullptr};
+	recv_msg_func _transport_recv_msg{nullptr};
+	uint32_t _num_send_failures{0}; ///< failed transport writes
+
 	hrt_abstime _last_status_update;
 	hrt_abstime _last_ping;
 	bool _had_ping_reply{false};
@@ -194,6 +221,23 @@ private:
 	int _last_payload_tx_rate{}; ///< in B/s
 	int _last_payload_rx_rate{}; ///< in B/s
 
+	// link congestion monitor
+	static constexpr float RTT_FILTER_GAIN = 0.25f;
+	static constexpr float RTT_CONGESTED_FACTOR = 2.f;
+	static constexpr float RTT_CONGESTED_MARGIN_MS = 20.f;
+	static constexpr int LINK_RECOVERY_COUNT = 5; ///< good 1 s intervals before stepping the congestion level down
+	static constexpr int RTT_MIN_BUCKETS = 3;
+	static constexpr hrt_abstime RTT_MIN_BUCKET_DURATION = 10_s; ///< the baseline is the minimum of the last 20-30 s
+	float _rtt_ms{0.f}; ///< filtered round trip time
+	float _rtt_min_ms{0.f}; ///< idle link baseline, windowed minimum so that it follows route changes
+	float _rtt_min_buckets_ms[RTT_MIN_BUCKETS] {}; ///< minimum per time bucket, 0 if no sample
+	int _rtt_min_bucket{0};
+	hrt_abstime _rtt_min_bucket_start{0};
+
+	void updateRoundTripTimeMin(float rtt_ms, const hrt_abstime &now);
+	uint32_t _last_num_send_failures{0};
+	int _num_link_good{0};
+
 	bool _connected{false};
 	bool _session_created{false};
 	bool _timesync_converged{false};
@@ -210,6 +254,7 @@ private:
 		(ParamInt<px4::params::UXRCE_DDS_SYNCC>) _param_uxrce_dds_syncc,
 		(ParamInt<px4::params::UXRCE_DDS_SYNCT>) _param_uxrce_dds_synct,
 		(ParamInt<px4::params::UXRCE_DDS_TX_TO>) _param_uxrce_dds_tx_to,
-		(ParamInt<px4::params::UXRCE_DDS_RX_TO>) _param_uxrce_dds_rx_to
+		(ParamInt<px4::params::UXRCE_DDS_RX_TO>) _param_uxrce_dds_rx_to,
+		(ParamInt<px4::params::UXRCE_DDS_ADAPT>) _param_uxrce_dds_adapt
 	)
 };
@@ -42,6 +42,8 @@
 #pragma once
 
 #include "zenoh_publisher.hpp"
+#include <drivers/drv_hrt.h>
+#include <mathlib/mathlib.h>
 #include <uORB/Subscription.hpp>
 #include <dds_serializer.h>
 
@@ -50,10 +52,12 @@
 class uORB_Zenoh_Publisher : public Zenoh_Publisher
 {
 public:
-	uORB_Zenoh_Publisher(const orb_metadata *meta, const uint32_t *ops, int instance) :
+	uORB_Zenoh_Publisher(const orb_metadata *meta, const uint32_t *ops, const UorbCdrFunctions &cdr, int instance) :
 		Zenoh_Publisher(),
 		_uorb_meta{meta},
-		_cdr_ops(ops)
+		_cdr_ops(ops),
+		_cdr(cdr),
+		_buffer_size(sizeof(ros2_header) + math::max((uint32_t)meta->o_size + CDR_SAFETY_MARGIN, cdr.cdr_size))
 	{
 		if (instance <= 0) { // default (<0) or =0
 			_uorb_sub = orb_subscribe(meta); // orb_subscribe subscribes to the 0th/first instance by default
@@ -61,9 +65,20 @@ public:
 		} else { // otherwise
 			_uorb_sub = orb_subscribe_multi(meta, instance);
 		}
+
+		// preallocated once, the payload is handed to zenoh without another copy
+		_buffer = new uint8_t[_buffer_size] {}; // zeroed, the specialized serializer never writes the CDR padding
+
+		if (_buffer) {
+			memcpy(_buffer, ros2_header, sizeof(ros2_header));
+		}
 	};
 
-	~uORB_Zenoh_Publisher() override = default;
+	~uORB_Zenoh_Publisher() override
+	{
+		orb_unsubscribe(_uorb_sub);
+		delete[] _buffer;
+	}
 
 	// Update the uORB Subscription and broadcast a Zenoh ROS2 message
 	virtual int8_t update() override
@@ -76,23 +91,47 @@ public:
 		}
 
 #endif
+
+		if (_buffer == nullptr) {
+			return _Z_ERR_SYSTEM_OUT_OF_MEMORY;
+		}
+
 		uint8_t data[_uorb_meta->o_size];
 		orb_copy(_uorb_meta, _uorb_sub, data);
 
-		uint8_t buf[_uorb_meta->o_size + 4 + CDR_SAFETY_MARGIN];
-		memcpy(buf, ros2_header, sizeof(ros2_header));
+		const hrt_abstime serialize_start = hrt_absolute_time();
+
+#if defined(CONFIG_ZENOH_CDR_SPECIALIZED)
+
+		if (_cdr.serialize) {
+			const uint32_t size = sizeof(ros2_header) + _cdr.serialize(data, &_buffer[sizeof(ros2_header)]);
+			_stats.update(hrt_elapsed_time(&serialize_start), size);
+
+			return publish_static(_buffer, size);
+		}
+
+#endif
 
 		dds_ostream_t os;
-		os.m_buffer = &buf[4];
+		os.m_buffer = &_buffer[sizeof(ros2_header)];
 		os.m_index = 0;
-		os.m_size = (uint32_t)sizeof(ros2_header) + _uorb_meta->o_size + CDR_SAFETY_MARGIN;
+		os.m_size = _buffer_size - sizeof(ros2_header);
 		os.m_xcdr_version = DDSI_RTPS_CDR_ENC_VERSION_1;
 
-		if (dds_stream_write(&os,
-				     &dds_allocator,
-				     (const char *)&data,
-				     _cdr_ops)) {
-			return publish((const uint8_t *)buf, os.m_size);
+		const bool serialized = dds_stream_write(&os, &dds_allocator, (const char *)&data, _cdr_ops);
+
+		if (os.m_buffer != &_buffer[sizeof(ros2_header)]) {
+			// the stream outgrew the preallocated buffer and reallocated, should not happen with the safety margin
+			dds_allocator.free(os.m_buffer);
+			return _Z_ERR_MESSAGE_SERIALIZATION_FAILED;
+		}
+
+		if (serialized) {
+			// only send the encoded bytes, not the whole buffer
+			const uint32_t size = sizeof(ros2_header) + os.m_index;
+			_stats.update(hrt_elapsed_time(&serialize_start), size);
+
+			return publish_static(_buffer, size);
 
 		} else {
 			return _Z_ERR_MESSAGE_SERIALIZATION_FAILED;
@@ -109,6 +148,12 @@ public:
 	{
 		printf("uORB %s -> ", _uorb_meta->o_name);
 		Zenoh_Publisher::print();
+
+		if (_stats.count > 0) {
+			printf("\tserialize: %" PRIu32 " msgs, %" PRIu64 " bytes, avg %" PRIu32 " B, avg %.1f us, max %" PRIu32 " us\n",
+			       _stats.count, _stats.bytes, (uint32_t)(_stats.bytes / _stats.count),
+			       (double)_stats.time_us / _stats.count, _stats.time_max_us);
+		}
 	}
 
 	const char *getName()
@@ -117,7 +162,29 @@ public:
 	}
 
 private:
+	/** per-topic serialization cost, to size the link on constrained radios */
+	struct SerializationStats {
+		uint64_t bytes{0};
+		uint64_t time_us{0};
+		uint32_t time_max_us{0};
+		uint32_t count{0};
+
+		void update(hrt_abstime elapsed_us, uint32_t size)
+		{
+			bytes += size;
+			time_us += elapsed_us;
+			time_max_us = math::max(time_max_us, (uint32_t)elapsed_us);
+			count++;
+		}
+	};
+
 	const orb_metadata *_uorb_meta;
 	int _uorb_sub;
 	const uint32_t *_cdr_ops;
+	const UorbCdrFunctions _cdr;
+
+	uint8_t *_buffer{nullptr};
+	const uint32_t _buffer_size;
+
+	SerializationStats _stats{};
 };
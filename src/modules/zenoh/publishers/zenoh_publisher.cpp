@@ -79,6 +79,21 @@ int Zenoh_Publisher::declare_publisher(z_owned_session_t s, const char *keyexpr,
 }
 
 int8_t Zenoh_Publisher::publish(const uint8_t *buf, int size)
+{
+	z_owned_bytes_t payload;
+	z_bytes_copy_from_buf(&payload, buf, size);
+	return put(payload);
+}
+
+int8_t Zenoh_Publisher::publish_static(const uint8_t *buf, int size)
+{
+	// zenoh-pico encodes the payload into the tx (batch) buffer before z_publisher_put() returns
+	z_owned_bytes_t payload;
+	z_bytes_from_static_buf(&payload, buf, size);
+	return put(payload);
+}
+
+int8_t Zenoh_Publisher::put(z_owned_bytes_t &payload)
 {
 	z_publisher_put_options_t options;
 	z_publisher_put_options_default(&options);
@@ -91,8 +106,6 @@ int8_t Zenoh_Publisher::publish(const uint8_t *buf, int size)
 
 	options.attachment = z_move(z_attachment);
 
-	z_owned_bytes_t payload;
-	z_bytes_copy_from_buf(&payload, buf, size);
 	return z_publisher_put(z_loan(_pub), z_move(payload), &options);
 }
 
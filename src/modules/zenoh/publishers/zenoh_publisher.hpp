@@ -67,6 +67,12 @@ public:
 protected:
 	int8_t publish(const uint8_t *, int size);
 
+	/** publish without copying, buf must stay valid until the call returns */
+	int8_t publish_static(const uint8_t *buf, int size);
+
 	z_owned_publisher_t _pub;
 	RmwAttachment _attachment;
+
+private:
+	int8_t put(z_owned_bytes_t &payload);
 };
@@ -50,10 +50,11 @@ class uORB_Zenoh_Subscriber : public Zenoh_Subscriber
 {
 public:
 	// d_instance: < (default if not in CSV) if we should create a new instance (safe), nonzero if we should use the 0 instance
-	uORB_Zenoh_Subscriber(const orb_metadata *meta, const uint32_t *ops, int d_instance) :
+	uORB_Zenoh_Subscriber(const orb_metadata *meta, const uint32_t *ops, const UorbCdrFunctions &cdr, int d_instance) :
 		Zenoh_Subscriber(),
 		_uorb_meta{meta},
-		_cdr_ops(ops)
+		_cdr_ops(ops),
+		_cdr(cdr)
 	{
 		if (d_instance < 0) { // default=-1; allocate a new instance
 			int instance;
@@ -85,11 +86,7 @@ public:
 
 		if (z_bytes_get_contiguous_view(payload, &view) == Z_OK) {
 			const uint8_t *ptr = z_slice_data(z_loan(view));
-
-			dds_istream_t is = {.m_buffer = (unsigned char *)(ptr + 4), .m_size = static_cast<int>(len),
-					    .m_index = 0, .m_xcdr_version = DDSI_RTPS_CDR_ENC_VERSION_1
-					   };
-			dds_stream_read(&is, data, &dds_allocator, _cdr_ops);
+			deserialize(ptr, len, data);
 
 		} else
 #endif
@@ -97,11 +94,7 @@ public:
 			unsigned char reassembled_payload[len];
 			z_bytes_reader_t reader = z_bytes_get_reader(payload);
 			z_bytes_reader_read(&reader, reassembled_payload, len);
-
-			dds_istream_t is = {.m_buffer = &reassembled_payload[4], .m_size = static_cast<int>(len),
-					    .m_index = 0, .m_xcdr_version = DDSI_RTPS_CDR_ENC_VERSION_1
-					   };
-			dds_stream_read(&is, data, &dds_allocator, _cdr_ops);
+			deserialize(reassembled_payload, len, data);
 		}
 
 		// As long as we don't have timesynchronization between Zenoh nodes
@@ -116,6 +109,24 @@ public:
 		orb_publish(_uorb_meta, _uorb_pub_handle, &data);
 	};
 
+	// Decode a ROS2 CDR payload (including the 4 byte encapsulation header)
+	void deserialize(const uint8_t *payload, size_t len, char *data)
+	{
+#if defined(CONFIG_ZENOH_CDR_SPECIALIZED)
+
+		if (_cdr.deserialize && len >= sizeof(ros2_header) + _cdr.cdr_size) {
+			_cdr.deserialize(&payload[sizeof(ros2_header)], data);
+			return;
+		}
+
+#endif
+
+		dds_istream_t is = {.m_buffer = (unsigned char *)(payload + sizeof(ros2_header)), .m_size = static_cast<int>(len),
+				    .m_index = 0, .m_xcdr_version = DDSI_RTPS_CDR_ENC_VERSION_1
+				   };
+		dds_stream_read(&is, data, &dds_allocator, _cdr_ops);
+	}
+
 	void fix_timestamp(char *data)
 	{
 		hrt_abstime now = hrt_absolute_time();
@@ -138,4 +149,5 @@ private:
 	const orb_metadata *_uorb_meta;
 	orb_advert_t _uorb_pub_handle;
 	const uint32_t *_cdr_ops;
+	const UorbCdrFunctions _cdr;
 };
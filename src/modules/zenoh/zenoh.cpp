@@ -416,6 +416,11 @@ void ZENOH::run()
 			//PX4_INFO("Zenoh poll timeout\n");
 
 		} else {
+#if defined(CONFIG_ZENOH_BATCHING) && Z_FEATURE_BATCHING == 1
+			// aggregate all samples of this tick into as few transport frames as possible
+			zp_batch_start(z_loan(_s));
+#endif
+
 			for (i = 0; i < _pub_count; i++) {
 				if (pfds[i].revents & POLLIN) {
 					ret = _zenoh_publishers[i]->update();
@@ -426,6 +431,11 @@ void ZENOH::run()
 					}
 				}
 			}
+
+#if defined(CONFIG_ZENOH_BATCHING) && Z_FEATURE_BATCHING == 1
+			// flushes the pending batch
+			zp_batch_stop(z_loan(_s));
+#endif
 		}
 	}
 
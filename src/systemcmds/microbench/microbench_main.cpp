@@ -42,9 +42,19 @@
 __BEGIN_DECLS
 
 extern int test_microbench_atomic(int argc, char *argv[]);
+#if defined(MICROBENCH_CDR)
+extern int test_microbench_cdr(int argc, char *argv[]);
+#endif
+extern int test_microbench_control_allocation(int argc, char *argv[]);
+#if defined(MICROBENCH_GEOFENCE)
+extern int test_microbench_geofence(int argc, char *argv[]);
+#endif
 extern int test_microbench_hrt(int argc, char *argv[]);
 extern int test_microbench_math(int argc, char *argv[]);
 extern int test_microbench_matrix(int argc, char *argv[]);
+#if defined(MICROBENCH_SIH)
+extern int test_microbench_sih(int argc, char *argv[]);
+#endif
 extern int test_microbench_uorb(int argc, char *argv[]);
 
 __END_DECLS
@@ -64,9 +74,19 @@ const struct {
 	{"all",		microbench_all,		OPT_NOALLTEST},
 
 	{"microbench_atomic",	test_microbench_atomic,	0},
+#if defined(MICROBENCH_CDR)
+	{"microbench_cdr",	test_microbench_cdr,	0},
+#endif
+	{"microbench_control_allocation",	test_microbench_control_allocation,	0},
+#if defined(MICROBENCH_GEOFENCE)
+	{"microbench_geofence",	test_microbench_geofence,	0},
+#endif
 	{"microbench_hrt",	test_microbench_hrt,	0},
 	{"microbench_math",	test_microbench_math,	0},
 	{"microbench_matrix",	test_microbench_matrix,	0},
+#if defined(MICROBENCH_SIH)
+	{"microbench_sih",	test_microbench_sih,	0},
+#endif
 	{"microbench_uorb",	test_microbench_uorb,	0},
 
 	{"null",			nullptr, 		0}
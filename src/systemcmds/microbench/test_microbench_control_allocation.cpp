@@ -0,0 +1,224 @@
+/****************************************************************************
+ *
+ *  Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_control_allocation.cpp
+ * Microbenchmark of the control allocation algorithms.
+ */
+
+#include <unit_test.h>
+
+#include <time.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <perf/perf_counter.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/micro_hal.h>
+
+#include <ControlAllocationActiveSet.hpp>
+#include <ControlAllocationPseudoInverse.hpp>
+#include <ControlAllocationSequentialDesaturation.hpp>
+
+namespace MicroBenchControlAllocation
+{
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+static irqstate_t flags;
+#endif
+
+void lock()
+{
+#ifdef __PX4_NUTTX
+	flags = px4_enter_critical_section();
+#endif
+}
+
+void unlock()
+{
+#ifdef __PX4_NUTTX
+	px4_leave_critical_section(flags);
+#endif
+}
+
+#define PERF(name, op, count) do { \
+		px4_usleep(1000); \
+		reset(); \
+		perf_counter_t p = perf_alloc(PC_ELAPSED, name); \
+		for (int i = 0; i < count; i++) { \
+			px4_usleep(1); \
+			lock(); \
+			perf_begin(p); \
+			op; \
+			perf_end(p); \
+			unlock(); \
+			reset(); \
+		} \
+		perf_print_counter(p); \
+		perf_free(p); \
+	} while (0)
+
+class MicroBenchControlAllocation : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	static constexpr int NUM_ROTORS = 8;
+
+	bool time_pseudo_inverse();
+	bool time_sequential_desaturation();
+	bool time_active_set();
+	bool time_allocated_control();
+
+	void init(ControlAllocation &allocation);
+	void reset();
+	void allocate(ControlAllocation &allocation);
+
+	matrix::Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS> _effectiveness;
+	matrix::Vector<float, ControlAllocation::NUM_AXES> _control_sp;
+	matrix::Vector<float, ControlAllocation::NUM_AXES> _allocated_control;
+	bool _saturated{false};
+
+	ControlAllocationPseudoInverse _pseudo_inverse;
+	ControlAllocationSequentialDesaturation _sequential_desaturation;
+	ControlAllocationActiveSet _active_set;
+};
+
+bool MicroBenchControlAllocation::run_tests()
+{
+	// Octorotor x geometry
+	for (int i = 0; i < NUM_ROTORS; i++) {
+		const float angle = M_PI_F / NUM_ROTORS + i * 2.f * M_PI_F / NUM_ROTORS;
+		const matrix::Vector3f position{cosf(angle), sinf(angle), 0.f};
+		const matrix::Vector3f axis{0.f, 0.f, -1.f};
+		const float km = (i % 2 == 0) ? 0.05f : -0.05f;
+		const matrix::Vector3f moment = position.cross(axis) - km * axis;
+
+		for (int j = 0; j < 3; j++) {
+			_effectiveness(j, i) = moment(j);
+			_effectiveness(j + 3, i) = axis(j);
+		}
+	}
+
+	init(_pseudo_inverse);
+	init(_sequential_desaturation);
+	init(_active_set);
+
+	ut_run_test(time_pseudo_inverse);
+	ut_run_test(time_sequential_desaturation);
+	ut_run_test(time_active_set);
+	ut_run_test(time_allocated_control);
+
+	return (_tests_failed == 0);
+}
+
+template<typename T>
+T random(T min, T max)
+{
+	const T scale = rand() / (T) RAND_MAX; /* [0, 1.0] */
+	return min + scale * (max - min);      /* [min, max] */
+}
+
+void MicroBenchControlAllocation::init(ControlAllocation &allocation)
+{
+	const ControlAllocation::ActuatorVector zero{};
+	allocation.setEffectivenessMatrix(_effectiveness, zero, zero, NUM_ROTORS, true);
+}
+
+void MicroBenchControlAllocation::reset()
+{
+	srand(time(nullptr));
+
+	// the random setpoints either stay within the actuator limits or saturate several actuators
+	const float torque_max = _saturated ? 2.f : 0.1f;
+	_control_sp(ControlAllocation::ROLL) = random(-torque_max, torque_max);
+	_control_sp(ControlAllocation::PITCH) = random(-torque_max, torque_max);
+	_control_sp(ControlAllocation::YAW) = random(-torque_max, torque_max);
+	_control_sp(ControlAllocation::THRUST_Z) = random(-0.9f, -0.1f);
+}
+
+void MicroBenchControlAllocation::allocate(ControlAllocation &allocation)
+{
+	allocation.setControlSetpoint(_control_sp);
+	allocation.allocate();
+	allocation.clipActuatorSetpoint();
+}
+
+bool MicroBenchControlAllocation::time_pseudo_inverse()
+{
+	_saturated = false;
+	PERF("pseudo-inverse octo (unsaturated)", allocate(_pseudo_inverse), 1000);
+	_saturated = true;
+	PERF("pseudo-inverse octo (saturated)", allocate(_pseudo_inverse), 1000);
+	return true;
+}
+
+bool MicroBenchControlAllocation::time_sequential_desaturation()
+{
+	_saturated = false;
+	PERF("sequential desaturation octo (unsaturated)", allocate(_sequential_desaturation), 1000);
+	_saturated = true;
+	PERF("sequential desaturation octo (saturated)", allocate(_sequential_desaturation), 1000);
+	return true;
+}
+
+bool MicroBenchControlAllocation::time_active_set()
+{
+	_saturated = false;
+	PERF("active set octo (unsaturated)", allocate(_active_set), 1000);
+	_saturated = true;
+	PERF("active set octo (saturated)", allocate(_active_set), 1000);
+
+	// worst case: cold start on every allocation
+	PERF("active set octo (saturated, cold start)", init(_active_set); allocate(_active_set), 1000);
+	return true;
+}
+
+bool MicroBenchControlAllocation::time_allocated_control()
+{
+	_saturated = false;
+	allocate(_pseudo_inverse);
+	const ControlAllocation::ActuatorVector &actuator_sp = _pseudo_inverse.getActuatorSetpoint();
+
+	PERF("allocated control octo (dense 6x16)", _allocated_control = _effectiveness * actuator_sp, 1000);
+	PERF("allocated control octo (configured actuators)", _allocated_control = _pseudo_inverse.getAllocatedControl(), 1000);
+	return true;
+}
+
+ut_declare_test_c(test_microbench_control_allocation, MicroBenchControlAllocation)
+
+} // namespace MicroBenchControlAllocation
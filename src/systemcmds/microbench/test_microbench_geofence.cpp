@@ -0,0 +1,262 @@
+/****************************************************************************
+ *
+ *  Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file test_microbench_geofence.cpp
+ * Compares a brute-force polygon containment check with the geofence spatial index on a 10k vertex fence.
+ */
+
+#include <unit_test.h>
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <drivers/drv_hrt.h>
+#include <mathlib/mathlib.h>
+#include <px4_platform_common/px4_config.h>
+
+#include <modules/navigator/GeofenceIndex/GeofenceIndex.hpp>
+
+namespace MicroBenchGeofence
+{
+
+static constexpr double LAT = 47.397742;
+static constexpr double LON = 8.545594;
+
+static constexpr int INCLUSION_VERTICES = 496;
+static constexpr double INCLUSION_RADIUS = 0.05;	///< [deg]
+
+static constexpr int GRID = 12;	///< GRID x GRID exclusion polygons inside the inclusion polygon
+static constexpr int EXCLUSION_VERTICES = 66;
+static constexpr double EXCLUSION_RADIUS = 0.002;	///< [deg]
+static constexpr double EXCLUSION_SPACING = 0.006;	///< [deg]
+
+static constexpr int NUM_POLYGONS = 1 + GRID * GRID;
+static constexpr int NUM_VERTICES = INCLUSION_VERTICES + GRID * GRID * EXCLUSION_VERTICES;
+
+static constexpr int NUM_POINTS = 1000;
+
+class MicroBenchGeofence : public UnitTest
+{
+public:
+	virtual bool run_tests();
+	virtual ~MicroBenchGeofence();
+
+private:
+	bool time_point_check();
+	bool time_path_check();
+
+	bool setup();
+	void addPolygon(bool inclusion, double lat, double lon, double radius, int vertices);
+	bool bruteForceCheck(double lat, double lon) const;
+
+	GeofenceIndex _index;
+
+	struct Polygon {
+		int first_vertex;
+		int vertex_count;
+		bool inclusion;
+	};
+
+	Polygon _polygons[NUM_POLYGONS] {};
+	int _num_polygons{0};
+
+	double *_lat{nullptr};
+	double *_lon{nullptr};
+	int _num_vertices{0};
+
+	double _point_lat[NUM_POINTS] {};
+	double _point_lon[NUM_POINTS] {};
+};
+
+MicroBenchGeofence::~MicroBenchGeofence()
+{
+	delete[] _lat;
+	delete[] _lon;
+}
+
+bool MicroBenchGeofence::run_tests()
+{
+	if (!setup()) {
+		return false;
+	}
+
+	ut_run_test(time_point_check);
+	ut_run_test(time_path_check);
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test_c(test_microbench_geofence, MicroBenchGeofence)
+
+void MicroBenchGeofence::addPolygon(bool inclusion, double lat, double lon, double radius, int vertices)
+{
+	Polygon &polygon = _polygons[_num_polygons++];
+	polygon.first_vertex = _num_vertices;
+	polygon.vertex_count = vertices;
+	polygon.inclusion = inclusion;
+
+	_index.beginPolygon(inclusion);
+
+	for (int i = 0; i < vertices; ++i) {
+		// slightly irregular outline
+		const double angle = 2. * M_PI * i / vertices;
+		const double r = radius * (1. + 0.1 * sin(7. * angle));
+
+		_lat[_num_vertices] = lat + r * cos(angle);
+		_lon[_num_vertices] = lon + r * sin(angle);
+		_index.addVertex(_lat[_num_vertices], _lon[_num_vertices]);
+		++_num_vertices;
+	}
+
+	_index.endPolygon();
+}
+
+bool MicroBenchGeofence::setup()
+{
+	_lat = new double[NUM_VERTICES];
+	_lon = new double[NUM_VERTICES];
+
+	if (!_lat || !_lon || !_index.reset(NUM_POLYGONS, NUM_VERTICES)) {
+		printf("alloc failed\n");
+		return false;
+	}
+
+	addPolygon(true, LAT, LON, INCLUSION_RADIUS, INCLUSION_VERTICES);
+
+	for (int x = 0; x < GRID; ++x) {
+		for (int y = 0; y < GRID; ++y) {
+			addPolygon(false, LAT + (x - GRID / 2 + 0.5) * EXCLUSION_SPACING, LON + (y - GRID / 2 + 0.5) * EXCLUSION_SPACING,
+				   EXCLUSION_RADIUS, EXCLUSION_VERTICES);
+		}
+	}
+
+	const hrt_abstime start = hrt_absolute_time();
+
+	if (!_index.build()) {
+		printf("index build failed\n");
+		return false;
+	}
+
+	printf("%i polygons, %i vertices, %i bands, %i band edges, build %" PRIu64 " us\n", _index.numPolygons(),
+	       _index.numVertices(), _index.numBands(), _index.numBandEdges(), hrt_elapsed_time(&start));
+
+	srand(0);
+
+	for (int i = 0; i < NUM_POINTS; ++i) {
+		_point_lat[i] = LAT + INCLUSION_RADIUS * 1.2 * (2. * rand() / RAND_MAX - 1.);
+		_point_lon[i] = LON + INCLUSION_RADIUS * 1.2 * (2. * rand() / RAND_MAX - 1.);
+	}
+
+	return true;
+}
+
+bool MicroBenchGeofence::bruteForceCheck(double lat, double lon) const
+{
+	bool checks_pass = true;
+
+	for (int p = 0; p < _num_polygons; ++p) {
+		const Polygon &polygon = _polygons[p];
+		bool c = false;
+
+		for (int i = polygon.first_vertex, j = polygon.first_vertex + polygon.vertex_count - 1;
+		     i < polygon.first_vertex + polygon.vertex_count; j = i++) {
+			if ((_lon[i] >= lon) != (_lon[j] >= lon) &&
+			    (lat <= (_lat[j] - _lat[i]) * (lon - _lon[i]) / (_lon[j] - _lon[i]) + _lat[i])) {
+				c = !c;
+			}
+		}
+
+		checks_pass &= polygon.inclusion ? c : !c;
+	}
+
+	return checks_pass;
+}
+
+bool MicroBenchGeofence::time_point_check()
+{
+	int mismatches = 0;
+	int inside = 0;
+
+	hrt_abstime start = hrt_absolute_time();
+
+	for (int i = 0; i < NUM_POINTS; ++i) {
+		inside += bruteForceCheck(_point_lat[i], _point_lon[i]);
+	}
+
+	const hrt_abstime brute_force_us = hrt_elapsed_time(&start);
+
+	for (int i = 0; i < NUM_POINTS; ++i) {
+		mismatches += _index.checkPoint(_point_lat[i], _point_lon[i]) != bruteForceCheck(_point_lat[i], _point_lon[i]);
+	}
+
+	start = hrt_absolute_time();
+	int inside_index = 0;
+
+	for (int i = 0; i < NUM_POINTS; ++i) {
+		inside_index += _index.checkPoint(_point_lat[i], _point_lon[i]);
+	}
+
+	const hrt_abstime index_us = hrt_elapsed_time(&start);
+
+	printf("point check: brute force %.2f us, index %.2f us (%.1fx), %i/%i points inside\n",
+	       (double)brute_force_us / NUM_POINTS, (double)index_us / NUM_POINTS,
+	       (double)brute_force_us / math::max(index_us, (hrt_abstime)1), inside, NUM_POINTS);
+
+	ut_compare("index and brute force mismatches", mismatches, 0);
+	ut_compare("inside count", inside_index, inside);
+
+	return true;
+}
+
+bool MicroBenchGeofence::time_path_check()
+{
+	int crossing = 0;
+
+	const hrt_abstime start = hrt_absolute_time();
+
+	// 20 m paths, about the distance a predicted geofence test point is ahead of the vehicle
+	for (int i = 0; i < NUM_POINTS; ++i) {
+		crossing += _index.crossesEdge(_point_lat[i], _point_lon[i], _point_lat[i] + 0.00018, _point_lon[i]);
+	}
+
+	const hrt_abstime index_us = hrt_elapsed_time(&start);
+
+	printf("path check: index %.2f us, %i/%i paths crossing an edge\n", (double)index_us / NUM_POINTS, crossing,
+	       NUM_POINTS);
+
+	return true;
+}
+
+} // namespace MicroBenchGeofence
@@ -0,0 +1,216 @@
+/****************************************************************************
+ *
+ *  Copyright (C) 2026 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file test_microbench_sih.cpp
+ * Simulation steps per second of the SIH noise generation and aerodynamic segment evaluation.
+ */
+
+#include <unit_test.h>
+
+#include <math.h>
+
+#include <drivers/drv_hrt.h>
+#include <px4_platform_common/px4_config.h>
+
+#include <modules/simulation/simulator_sih/aero.hpp>
+#include <modules/simulation/simulator_sih/gaussian_noise.hpp>
+
+namespace MicroBenchSih
+{
+
+static constexpr int NUM_STEPS = 20000;
+
+// the actuator outputs (control surface deflections) are updated at a lower rate than the simulation steps
+static constexpr int STEPS_PER_ACTUATOR_UPDATE = 16;
+
+// fixed-wing geometry as in sih.hpp
+static constexpr float SPAN = 0.86f;
+static constexpr float MAC = 0.21f;
+static constexpr float RP = 0.1f;
+static constexpr float FLAP_MAX = M_PI_F / 12.0f;
+
+// tailsitter geometry as in sih.hpp
+static constexpr int NB_TS_SEG = 11;
+static constexpr float TS_AR = 3.13f;
+static constexpr float TS_CM = 0.115f;
+static constexpr float TS_RP = 0.0625f;
+static constexpr float TS_DEF_MAX = math::radians(39.0f);
+
+class MicroBenchSih : public UnitTest
+{
+public:
+	virtual bool run_tests();
+
+private:
+	bool time_noise();
+	bool time_fixedwing_aero();
+	bool time_tailsitter_aero();
+
+	void print_steps_per_second(const char *name, hrt_abstime elapsed_us);
+
+	float _checksum{0.f};
+};
+
+bool MicroBenchSih::run_tests()
+{
+	ut_run_test(time_noise);
+	ut_run_test(time_fixedwing_aero);
+	ut_run_test(time_tailsitter_aero);
+
+	return (_tests_failed == 0);
+}
+
+ut_declare_test_c(test_microbench_sih, MicroBenchSih)
+
+void MicroBenchSih::print_steps_per_second(const char *name, hrt_abstime elapsed_us)
+{
+	printf("%s: %.2f us/step, %.0f steps/s\n", name, (double)elapsed_us / NUM_STEPS,
+	       1e6 * NUM_STEPS / (double)math::max(elapsed_us, (hrt_abstime)1));
+}
+
+bool MicroBenchSih::time_noise()
+{
+	GaussianNoise noise;
+	matrix::Vector3f sum{};
+	matrix::Vector3f sum_squares{};
+
+	const hrt_abstime start = hrt_absolute_time();
+
+	for (int i = 0; i < NUM_STEPS; ++i) {
+		// accelerometer, gyroscope and airspeed noise of one step
+		const matrix::Vector3f accel_noise = noise.next3f(1.f, 1.f, 1.f);
+		const matrix::Vector3f gyro_noise = noise.next3f(0.14f, 0.07f, 0.03f);
+		_checksum += gyro_noise(0) + noise.next();
+
+		sum += accel_noise;
+		sum_squares += accel_noise.emult(accel_noise);
+	}
+
+	print_steps_per_second("noise", hrt_elapsed_time(&start));
+
+	for (int i = 0; i < 3; ++i) {
+		const float mean = sum(i) / NUM_STEPS;
+		const float variance = sum_squares(i) / NUM_STEPS - mean * mean;
+		ut_assert("noise mean", fabsf(mean) < 0.05f);
+		ut_assert("noise variance", fabsf(variance - 1.f) < 0.05f);
+	}
+
+	return true;
+}
+
+bool MicroBenchSih::time_fixedwing_aero()
+{
+	AeroSeg wing_l(SPAN / 2.0f, MAC, -4.0f, matrix::Vector3f(0.0f, -SPAN / 4.0f, 0.0f), 3.0f, SPAN / MAC, MAC / 3.0f);
+	AeroSeg wing_r(SPAN / 2.0f, MAC, -4.0f, matrix::Vector3f(0.0f, SPAN / 4.0f, 0.0f), -3.0f, SPAN / MAC, MAC / 3.0f);
+	AeroSeg tailplane(0.3f, 0.1f, 0.0f, matrix::Vector3f(-0.4f, 0.0f, 0.0f), 0.0f, -1.0f, 0.05f, RP);
+	AeroSeg fin(0.25, 0.18, 0.0f, matrix::Vector3f(-0.45f, 0.0f, -0.1f), -90.0f, -1.0f, 0.12f, RP);
+	AeroSeg fuselage(0.2, 0.8, 0.0f, matrix::Vector3f(0.0f, 0.0f, 0.0f), -90.0f);
+
+	float cmd = 0.f;
+
+	const hrt_abstime start = hrt_absolute_time();
+
+	for (int i = 0; i < NUM_STEPS; ++i) {
+		if (i % STEPS_PER_ACTUATOR_UPDATE == 0) {
+			cmd = 0.5f * sinf(i * 1e-3f);
+		}
+
+		const matrix::Vector3f v_B(15.f + 5.f * sinf(i * 1e-3f), 1.f, 2.f * cosf(i * 1e-3f));
+		const matrix::Vector3f w_B(0.2f * sinf(i * 2e-3f), 0.1f, -0.1f);
+		const float rho = AeroSeg::air_density(100.f + i * 1e-3f);
+
+		wing_l.update_aero_rho(v_B, w_B, rho, cmd * FLAP_MAX);
+		wing_r.update_aero_rho(v_B, w_B, rho, -cmd * FLAP_MAX);
+		tailplane.update_aero_rho(v_B, w_B, rho, -cmd * FLAP_MAX, 2.f);
+		fin.update_aero_rho(v_B, w_B, rho, cmd * FLAP_MAX, 2.f);
+		fuselage.update_aero_rho(v_B, w_B, rho);
+
+		_checksum += (wing_l.get_Fa() + wing_r.get_Fa() + tailplane.get_Fa() + fin.get_Fa() + fuselage.get_Fa())(2);
+	}
+
+	print_steps_per_second("fixed-wing aerodynamics (5 segments)", hrt_elapsed_time(&start));
+
+	return true;
+}
+
+bool MicroBenchSih::time_tailsitter_aero()
+{
+	AeroSeg ts[NB_TS_SEG] = {
+		AeroSeg(0.0225f, 0.110f, 0.0f, matrix::Vector3f(0.083f - TS_CM, -0.239f, 0.0f), 0.0f, TS_AR),
+		AeroSeg(0.0383f, 0.125f, 0.0f, matrix::Vector3f(0.094f - TS_CM, -0.208f, 0.0f), 0.0f, TS_AR, 0.063f),
+		AeroSeg(0.0884f, 0.085f, 0.0f, matrix::Vector3f(0.158f - TS_CM, -0.143f, 0.0f), 0.0f, TS_AR),
+		AeroSeg(0.0884f, 0.063f, 0.0f, matrix::Vector3f(0.047f - TS_CM, -0.143f, 0.0f), 0.0f, TS_AR, 0.063f, TS_RP),
+		AeroSeg(0.0633f, 0.176f, 0.0f, matrix::Vector3f(0.132f - TS_CM, -0.068f, 0.0f), 0.0f, TS_AR, 0.063f),
+		AeroSeg(0.0750f, 0.231f, 0.0f, matrix::Vector3f(0.173f - TS_CM,  0.000f, 0.0f), 0.0f, TS_AR),
+		AeroSeg(0.0633f, 0.176f, 0.0f, matrix::Vector3f(0.132f - TS_CM,  0.068f, 0.0f), 0.0f, TS_AR, 0.063f),
+		AeroSeg(0.0884f, 0.085f, 0.0f, matrix::Vector3f(0.158f - TS_CM,  0.143f, 0.0f), 0.0f, TS_AR),
+		AeroSeg(0.0884f, 0.063f, 0.0f, matrix::Vector3f(0.047f - TS_CM,  0.143f, 0.0f), 0.0f, TS_AR, 0.063f, TS_RP),
+		AeroSeg(0.0383f, 0.125f, 0.0f, matrix::Vector3f(0.094f - TS_CM,  0.208f, 0.0f), 0.0f, TS_AR, 0.063f),
+		AeroSeg(0.0225f, 0.110f, 0.0f, matrix::Vector3f(0.083f - TS_CM,  0.239f, 0.0f), 0.0f, TS_AR)
+	};
+
+	float cmd = 0.f;
+
+	const hrt_abstime start = hrt_absolute_time();
+
+	for (int i = 0; i < NUM_STEPS; ++i) {
+		if (i % STEPS_PER_ACTUATOR_UPDATE == 0) {
+			cmd = 0.5f * sinf(i * 1e-3f);
+		}
+
+		const matrix::Vector3f v_ts(10.f + 5.f * sinf(i * 1e-3f), 0.5f, 3.f * cosf(i * 1e-3f));
+		const matrix::Vector3f w_ts(0.1f, 0.2f * sinf(i * 2e-3f), 0.f);
+		const float rho = AeroSeg::air_density(100.f + i * 1e-3f);
+		matrix::Vector3f Fa_ts{};
+
+		for (int s = 0; s < NB_TS_SEG; ++s) {
+			if (s <= NB_TS_SEG / 2) {
+				ts[s].update_aero_rho(v_ts, w_ts, rho, cmd * TS_DEF_MAX, 1.f);
+
+			} else {
+				ts[s].update_aero_rho(v_ts, w_ts, rho, -cmd * TS_DEF_MAX, 1.f);
+			}
+
+			Fa_ts += ts[s].get_Fa();
+		}
+
+		_checksum += Fa_ts(0);
+	}
+
+	print_steps_per_second("tailsitter aerodynamics (11 segments)", hrt_elapsed_time(&start));
+
+	return true;
+}
+
+} // namespace MicroBenchSih
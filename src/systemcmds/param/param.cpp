@@ -425,6 +425,21 @@ do_save(const char *param_file_name)
 }
 
 
+/**
+ * The journal holds the changes autosaved on top of the default file, and the backup file is written
+ * together with the default file. Importing either of them has to be followed by a journal replay.
+ */
+static bool
+is_journal_base(const char *param_file_name)
+{
+	const char *default_file = param_get_default_file();
+	const char *backup_file = param_get_backup_file();
+
+	return param_file_name
+	       && ((default_file && strcmp(param_file_name, default_file) == 0)
+		   || (backup_file && strcmp(param_file_name, backup_file) == 0));
+}
+
 static int
 do_load(const char *param_file_name)
 {
@@ -456,6 +471,11 @@ do_load(const char *param_file_name)
 		return 1;
 	}
 
+	if (is_journal_base(param_file_name)) {
+		// apply the changes autosaved on top of the file
+		param_replay_journal();
+	}
+
 	return 0;
 }
 
@@ -496,6 +516,11 @@ do_import(const char *param_file_name)
 		return 1;
 	}
 
+	if (is_journal_base(param_file_name)) {
+		// apply the changes autosaved on top of the file
+		param_replay_journal();
+	}
+
 	return 0;
 }
 
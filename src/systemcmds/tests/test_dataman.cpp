@@ -88,6 +88,9 @@ private:
 	bool testAsyncWriteReadAllItemsMaxSize();
 	bool testAsyncClearAll();
 
+	//Batch
+	bool testBatchWriteReadRange();
+
 	//Cache
 	bool testCache();
 
@@ -118,6 +121,11 @@ private:
 
 	uint16_t _max_index[DM_KEY_NUM_KEYS] {};
 
+	static constexpr uint32_t BATCH_TEST_COUNT{50};
+	uint8_t _batch_buffer_read[BATCH_TEST_COUNT * DM_MAX_DATA_SIZE];
+	uint8_t _batch_buffer_write[BATCH_TEST_COUNT * DM_MAX_DATA_SIZE];
+	uint32_t _batch_callback_count{0};
+
 	static constexpr uint32_t OVERFLOW_LENGTH = sizeof(_buffer_write) + 1;
 };
 
@@ -762,6 +770,79 @@ DatamanTest::testAsyncClearAll()
 	return true;
 }
 
+//Batch
+bool
+DatamanTest::testBatchWriteReadRange()
+{
+	const uint32_t length = g_per_item_size[DM_KEY_WAYPOINTS_OFFBOARD_0];
+
+	for (uint32_t i = 0; i < sizeof(_batch_buffer_write); ++i) {
+		_batch_buffer_write[i] = (uint8_t)((i / length + i) % UINT8_MAX);
+	}
+
+	memset(_batch_buffer_read, 0, sizeof(_batch_buffer_read));
+	_batch_callback_count = 0;
+
+	_dataman_client1.setBatchCallback([](void *context, bool success) {
+		if (success) {
+			++static_cast<DatamanTest *>(context)->_batch_callback_count;
+		}
+	}, this);
+
+	bool success = _dataman_client1.writeBatchAsync(DM_KEY_WAYPOINTS_OFFBOARD_0, 0, BATCH_TEST_COUNT, _batch_buffer_write,
+			length);
+
+	// a second range can only be queued once the first one is dispatched
+	if (!success || _dataman_client1.readBatchAsync(DM_KEY_WAYPOINTS_OFFBOARD_0, 0, 1, _batch_buffer_read, length)) {
+		PX4_ERR("writeBatchAsync failed");
+		return false;
+	}
+
+	hrt_abstime start_time = hrt_absolute_time();
+
+	//While loop represents a task
+	while (!_dataman_client1.batchCompleted(_response_success)) {
+
+		_dataman_client1.update();
+
+		if (hrt_elapsed_time(&start_time) > 5_s) {
+			PX4_ERR("Test timeout!");
+			return false;
+		}
+
+		px4_usleep(1_ms);
+	}
+
+	if (!_response_success || _batch_callback_count != 1) {
+		PX4_ERR("batch write failed");
+		return false;
+	}
+
+	success = _dataman_client1.readBatchAsync(DM_KEY_WAYPOINTS_OFFBOARD_0, 0, BATCH_TEST_COUNT, _batch_buffer_read,
+			length);
+
+	if (!success || !_dataman_client1.waitBatch()) {
+		PX4_ERR("batch read failed");
+		return false;
+	}
+
+	_dataman_client1.setBatchCallback(nullptr, nullptr);
+
+	if (_batch_callback_count != 2) {
+		PX4_ERR("batch callback not called");
+		return false;
+	}
+
+	for (uint32_t i = 0; i < sizeof(_batch_buffer_write); ++i) {
+		if (_batch_buffer_write[i] != _batch_buffer_read[i]) {
+			PX4_ERR("batch read mismatch at index %" PRIu32 ", element %" PRIu32, i / length, i % length);
+			return false;
+		}
+	}
+
+	return true;
+}
+
 //Cache
 bool
 DatamanTest::testCache()
@@ -1008,6 +1089,8 @@ bool DatamanTest::run_tests()
 	ut_run_test(testAsyncWriteReadAllItemsMaxSize);
 	ut_run_test(testAsyncClearAll);
 
+	ut_run_test(testBatchWriteReadRange);
+
 	ut_run_test(testCache);
 
 	ut_run_test(testResetItems);
@@ -69,5 +69,28 @@ test_perf(int argc, char *argv[])
 	perf_free(cc);
 	perf_free(ec);
 
+	perf_counter_t hc = perf_alloc(PC_HISTOGRAM, "test_histogram");
+
+	if (hc == NULL) {
+		printf("perf: histogram alloc failed\n");
+		return 1;
+	}
+
+	for (int i = 1; i <= 1000; i++) {
+		perf_set_elapsed(hc, i);
+	}
+
+	// percentiles are bucket upper bounds, at most 12.5% above the exact value
+	const uint32_t p50 = perf_percentile(hc, 0.5f);
+	const uint32_t p99 = perf_percentile(hc, 0.99f);
+	printf("perf: expect 1000 events, p50 500us, p99 990us\n");
+	perf_print_counter(hc);
+	perf_free(hc);
+
+	if ((p50 < 500) || (p50 > 563) || (p99 < 990) || (p99 > 1000)) {
+		printf("perf: histogram percentiles out of range (p50 %u, p99 %u)\n", (unsigned)p50, (unsigned)p99);
+		return 1;
+	}
+
 	return OK;
 }